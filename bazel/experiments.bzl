@@ -28,10 +28,13 @@ EXPERIMENTS = {
     "off": {
         "core_end2end_test": [
             "promise_based_client_call",
+            "promise_based_server_call",
         ],
         "endpoint_test": [
             "tcp_frame_size_tuning",
             "tcp_rcv_lowat",
+            "tcp_read_slab_hugepages",
+            "tcp_read_slabs",
         ],
         "event_engine_client_test": [
             "event_engine_client",
@@ -40,6 +43,7 @@ EXPERIMENTS = {
             "peer_state_based_framing",
             "tcp_frame_size_tuning",
             "tcp_rcv_lowat",
+            "tcp_read_slabs",
         ],
         "lame_client_test": [
             "promise_based_client_call",
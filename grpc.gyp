@@ -781,6 +781,7 @@
         'src/core/ext/xds/xds_http_stateful_session_filter.cc',
         'src/core/ext/xds/xds_lb_policy_registry.cc',
         'src/core/ext/xds/xds_listener.cc',
+        'src/core/ext/xds/xds_resource_cache.cc',
         'src/core/ext/xds/xds_route_config.cc',
         'src/core/ext/xds/xds_routing.cc',
         'src/core/ext/xds/xds_server_config_fetcher.cc',
@@ -800,8 +801,10 @@
         'src/core/lib/channel/promise_based_filter.cc',
         'src/core/lib/channel/status_util.cc',
         'src/core/lib/compression/compression.cc',
+        'src/core/lib/compression/compression_dictionary.cc',
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
+        'src/core/lib/compression/stream_compress.cc',
         'src/core/lib/config/core_configuration.cc',
         'src/core/lib/debug/event_log.cc',
         'src/core/lib/debug/histogram_view.cc',
@@ -944,6 +947,7 @@
         'src/core/lib/resource_quota/memory_quota.cc',
         'src/core/lib/resource_quota/periodic_update.cc',
         'src/core/lib/resource_quota/resource_quota.cc',
+        'src/core/lib/resource_quota/slab_allocator.cc',
         'src/core/lib/resource_quota/thread_quota.cc',
         'src/core/lib/resource_quota/trace.cc',
         'src/core/lib/security/authorization/authorization_policy_provider_vtable.cc',
@@ -1270,8 +1274,10 @@
         'src/core/lib/channel/promise_based_filter.cc',
         'src/core/lib/channel/status_util.cc',
         'src/core/lib/compression/compression.cc',
+        'src/core/lib/compression/compression_dictionary.cc',
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
+        'src/core/lib/compression/stream_compress.cc',
         'src/core/lib/config/core_configuration.cc',
         'src/core/lib/debug/event_log.cc',
         'src/core/lib/debug/histogram_view.cc',
@@ -1411,6 +1417,7 @@
         'src/core/lib/resource_quota/memory_quota.cc',
         'src/core/lib/resource_quota/periodic_update.cc',
         'src/core/lib/resource_quota/resource_quota.cc',
+        'src/core/lib/resource_quota/slab_allocator.cc',
         'src/core/lib/resource_quota/thread_quota.cc',
         'src/core/lib/resource_quota/trace.cc',
         'src/core/lib/security/authorization/authorization_policy_provider_vtable.cc',
@@ -1595,6 +1602,7 @@
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
         'src/cpp/server/xds_server_credentials.cc',
+        'src/cpp/thread_manager/handler_pool.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
         'src/cpp/util/status.cc',
@@ -1730,6 +1738,7 @@
         'src/cpp/server/server_context.cc',
         'src/cpp/server/server_credentials.cc',
         'src/cpp/server/server_posix.cc',
+        'src/cpp/thread_manager/handler_pool.cc',
         'src/cpp/thread_manager/thread_manager.cc',
         'src/cpp/util/byte_buffer_cc.cc',
         'src/cpp/util/status.cc',
@@ -1775,8 +1784,10 @@
         'src/core/lib/channel/promise_based_filter.cc',
         'src/core/lib/channel/status_util.cc',
         'src/core/lib/compression/compression.cc',
+        'src/core/lib/compression/compression_dictionary.cc',
         'src/core/lib/compression/compression_internal.cc',
         'src/core/lib/compression/message_compress.cc',
+        'src/core/lib/compression/stream_compress.cc',
         'src/core/lib/config/core_configuration.cc',
         'src/core/lib/debug/event_log.cc',
         'src/core/lib/debug/histogram_view.cc',
@@ -1912,6 +1923,7 @@
         'src/core/lib/resource_quota/memory_quota.cc',
         'src/core/lib/resource_quota/periodic_update.cc',
         'src/core/lib/resource_quota/resource_quota.cc',
+        'src/core/lib/resource_quota/slab_allocator.cc',
         'src/core/lib/resource_quota/thread_quota.cc',
         'src/core/lib/resource_quota/trace.cc',
         'src/core/lib/security/authorization/authorization_policy_provider_vtable.cc',
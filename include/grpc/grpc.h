@@ -124,6 +124,20 @@ GRPCAPI grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
                                               gpr_timespec deadline,
                                               void* reserved);
 
+/** Like grpc_completion_queue_next, but once an event is available also
+    returns the events queued behind it, up to max_events in all, so that
+    they are drained in one call instead of one call each.
+
+    max_events must be at least 1. Stores the events in events[0..n) and
+    returns n, which is at least 1. Events of type GRPC_QUEUE_TIMEOUT and
+    GRPC_QUEUE_SHUTDOWN are always returned alone. Only valid on completion
+    queues of type GRPC_CQ_NEXT. */
+GRPCAPI size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                                grpc_event* events,
+                                                size_t max_events,
+                                                gpr_timespec deadline,
+                                                void* reserved);
+
 /** Blocks until an event with tag 'tag' is available, the completion queue is
     being shutdown or deadline is reached.
 
@@ -530,6 +544,14 @@ GRPCAPI void grpc_resource_quota_resize(grpc_resource_quota* resource_quota,
 GRPCAPI void grpc_resource_quota_set_max_threads(
     grpc_resource_quota* resource_quota, int new_max_threads);
 
+/** EXPERIMENTAL.  Create a buffer pool for one tenant of \a parent: it draws
+    from \a parent's memory, with the first \a guaranteed_bytes set aside for
+    it and the rest shared with the parent's other tenants in proportion to
+    \a weight, which must be positive.  It shares \a parent's threads. */
+GRPCAPI grpc_resource_quota* grpc_resource_quota_create_tenant(
+    grpc_resource_quota* parent, const char* trace_name,
+    size_t guaranteed_bytes, size_t weight);
+
 /** EXPERIMENTAL.  Dumps xDS configs as a serialized ClientConfig proto.
     The full name of the proto is envoy.service.status.v3.ClientConfig. */
 GRPCAPI grpc_slice grpc_dump_xds_configs(void);
@@ -179,6 +179,12 @@ typedef struct {
    application will see the compressed message in the byte buffer. */
 #define GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION \
   "grpc.per_message_decompression"
+/** Messages of at least this many bytes are compressed and decompressed on
+   the EventEngine rather than on the thread polling the transport, so that
+   they do not hold up other calls. 0 does all of the work inline. Int valued,
+   bytes. Defaults to 256 KiB. */
+#define GRPC_ARG_COMPRESSION_OFFLOAD_THRESHOLD \
+  "grpc.compression_offload_threshold"
 /** Enable/disable support for deadline checking. Defaults to 1, unless
     GRPC_ARG_MINIMAL_STACK is enabled, in which case it defaults to 0 */
 #define GRPC_ARG_ENABLE_DEADLINE_CHECKS "grpc.enable_deadline_checking"
@@ -468,6 +474,31 @@ typedef struct {
  * channel arg. Int valued, milliseconds. Defaults to 10 minutes.*/
 #define GRPC_ARG_SERVER_CONFIG_CHANGE_DRAIN_GRACE_TIME_MS \
   "grpc.experimental.server_config_change_drain_grace_time_ms"
+/** Maximum number of incoming calls a server holds while waiting for the
+ * application to request them with grpc_server_request_call or
+ * grpc_server_request_registered_call. Further calls are rejected with
+ * RESOURCE_EXHAUSTED. Int valued, defaults to 10000. */
+#define GRPC_ARG_SERVER_MAX_PENDING_CALLS "grpc.server_max_pending_calls"
+/** EXPERIMENTAL. Enables CoDel load shedding of calls waiting for the
+ * application to request them: once the queue of such calls has not been
+ * empty for GRPC_ARG_SERVER_PENDING_CALL_INTERVAL_MS, calls that have waited
+ * longer than this are rejected with RESOURCE_EXHAUSTED. Int valued,
+ * milliseconds. Defaults to 0, which disables shedding. */
+#define GRPC_ARG_SERVER_PENDING_CALL_TARGET_DELAY_MS \
+  "grpc.experimental.server_pending_call_target_delay_ms"
+/** EXPERIMENTAL. With GRPC_ARG_SERVER_PENDING_CALL_TARGET_DELAY_MS set, how
+ * long the queue of calls waiting for the application must stay non-empty
+ * before it is considered overloaded; this is also the longest any call may
+ * wait. Int valued, milliseconds. Defaults to 100. */
+#define GRPC_ARG_SERVER_PENDING_CALL_INTERVAL_MS \
+  "grpc.experimental.server_pending_call_interval_ms"
+/** EXPERIMENTAL. If set on a C++ in-process channel (made by
+ * grpc::Server::InProcessChannel), protobuf messages sent by the client are
+ * handed to the server as objects instead of being serialized. Metadata,
+ * deadlines and cancellation are unaffected. Messages that would exceed the
+ * server's receive limit or the channel's send limit are serialized, so that
+ * those limits still apply. Boolean, defaults to false. */
+#define GRPC_ARG_INPROC_PASS_MESSAGES "grpc.experimental.inproc_pass_messages"
 /** \} */
 
 /** Result of a grpc call. If the caller satisfies the prerequisites of a
@@ -786,7 +817,9 @@ typedef struct grpc_completion_queue_functor {
   void (*functor_run)(struct grpc_completion_queue_functor*, int);
 
   /** The inlineable member specifies whether this functor can be run inline.
-      This should only be used for trivial internally-defined functors. */
+      This should only be used for trivial internally-defined functors.
+      GRPC_CQ_FUNCTOR_INLINE_ANY_THREAD also allows running it on a thread
+      that has no application callback context. */
   int inlineable;
 
   /** The following fields are not API. They are meant for internal use. */
@@ -794,6 +827,12 @@ typedef struct grpc_completion_queue_functor {
   struct grpc_completion_queue_functor* internal_next;
 } grpc_completion_queue_functor;
 
+/** EXPERIMENTAL. Value of grpc_completion_queue_functor::inlineable for a
+    functor that never blocks. It runs on the thread that completed it even
+    when that thread is one of the transport's, once the thread has released
+    its locks, instead of being handed to another thread. */
+#define GRPC_CQ_FUNCTOR_INLINE_ANY_THREAD 2
+
 #define GRPC_CQ_CURRENT_VERSION 2
 #define GRPC_CQ_VERSION_MINIMUM_FOR_CALLBACKABLE 2
 typedef struct grpc_completion_queue_attributes {
@@ -61,6 +61,15 @@ typedef enum {
   GRPC_COMPRESS_NONE = 0,
   GRPC_COMPRESS_DEFLATE,
   GRPC_COMPRESS_GZIP,
+  /** DEFLATE with a preset dictionary. Only available on channels and
+   * servers that have been given a dictionary, and only used with peers
+   * that have the same one. */
+  GRPC_COMPRESS_DEFLATE_DICTIONARY,
+  /** DEFLATE over the whole call rather than each message, so that messages
+   * can refer back to earlier ones. Must be requested explicitly; it is
+   * never chosen by compression level, and falls back to
+   * GRPC_COMPRESS_DEFLATE for peers that have not advertised it. */
+  GRPC_COMPRESS_DEFLATE_STREAM,
   /* TODO(ctiller): snappy */
   GRPC_COMPRESS_ALGORITHMS_COUNT
 } grpc_compression_algorithm;
@@ -80,6 +80,7 @@ class Channel final : public grpc::ChannelInterface,
           grpc::experimental::ClientInterceptorFactoryInterface>>
           interceptor_creators);
   friend class grpc::internal::InterceptedChannel;
+  friend class Server;
   Channel(const std::string& host, grpc_channel* c_channel,
           std::vector<std::unique_ptr<
               grpc::experimental::ClientInterceptorFactoryInterface>>
@@ -119,6 +120,10 @@ class Channel final : public grpc::ChannelInterface,
   std::vector<
       std::unique_ptr<grpc::experimental::ClientInterceptorFactoryInterface>>
       interceptor_creators_;
+
+  // Set by Server::InProcessChannel() for GRPC_ARG_INPROC_PASS_MESSAGES.
+  bool pass_messages_ = false;
+  size_t max_passed_message_size_ = 0;
 };
 
 }  // namespace grpc
@@ -32,6 +32,8 @@
 #ifndef GRPCPP_COMPLETION_QUEUE_H
 #define GRPCPP_COMPLETION_QUEUE_H
 
+#include <stddef.h>
+
 #include <list>
 
 #include <grpc/grpc.h>
@@ -186,6 +188,22 @@ class CompletionQueue : private grpc::internal::GrpcLibrary {
             GOT_EVENT);
   }
 
+  /// EXPERIMENTAL
+  /// Read up to \a max_events events from the queue, blocking until one is
+  /// available or the queue is shutting down. The events already queued
+  /// behind the first are read in the same call, which costs less than a
+  /// call to \a Next for each of them.
+  ///
+  /// \param[out] tags Updated to point to the read events' tags.
+  /// \param[out] oks Updated to whether each event succeeded. See
+  ///        documentation for CompletionQueue::Next for explanation of ok.
+  /// \param[in] max_events The number of elements of \a tags and \a oks,
+  ///        which must be at least 1.
+  ///
+  /// \return The number of events read, which may be less than are queued,
+  ///         or 0 if the queue is fully drained and shut down.
+  size_t NextBatch(void** tags, bool* oks, size_t max_events);
+
   /// Read from the queue, blocking up to \a deadline (or the queue's shutdown).
   /// Both \a tag and \a ok are updated upon success (if an event is available
   /// within the \a deadline).  A \a tag points to an arbitrary location usually
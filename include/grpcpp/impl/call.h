@@ -48,12 +48,15 @@ class Call final {
         max_receive_message_size_(-1) {}
 
   Call(grpc_call* call, CallHook* call_hook, grpc::CompletionQueue* cq,
-       experimental::ClientRpcInfo* rpc_info)
+       experimental::ClientRpcInfo* rpc_info, bool pass_messages = false,
+       size_t max_passed_message_size = 0)
       : call_hook_(call_hook),
         cq_(cq),
         call_(call),
         max_receive_message_size_(-1),
-        client_rpc_info_(rpc_info) {}
+        client_rpc_info_(rpc_info),
+        pass_messages_(pass_messages),
+        max_passed_message_size_(max_passed_message_size) {}
 
   Call(grpc_call* call, CallHook* call_hook, grpc::CompletionQueue* cq,
        int max_receive_message_size, experimental::ServerRpcInfo* rpc_info)
@@ -80,6 +83,12 @@ class Call final {
     return server_rpc_info_;
   }
 
+  /// Whether messages sent on this call may be handed to the peer without
+  /// being serialized; see GRPC_ARG_INPROC_PASS_MESSAGES.
+  bool pass_messages() const { return pass_messages_; }
+  /// The size, serialized, of the largest message that may be passed.
+  size_t max_passed_message_size() const { return max_passed_message_size_; }
+
  private:
   CallHook* call_hook_;
   grpc::CompletionQueue* cq_;
@@ -87,6 +96,8 @@ class Call final {
   int max_receive_message_size_;
   experimental::ClientRpcInfo* client_rpc_info_ = nullptr;
   experimental::ServerRpcInfo* server_rpc_info_ = nullptr;
+  bool pass_messages_ = false;
+  size_t max_passed_message_size_ = 0;
 };
 }  // namespace internal
 }  // namespace grpc
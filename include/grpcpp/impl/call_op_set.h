@@ -22,6 +22,8 @@
 #include <cstring>
 #include <map>
 #include <memory>
+#include <type_traits>
+#include <utility>
 
 #include <grpc/grpc.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -286,10 +288,36 @@ class CallOpSendInitialMetadata {
   } maybe_compression_level_;
 };
 
+// Whether SerializationTraits<M> can hand a message to an in-process peer
+// without serializing it (see PassedMessage).
+template <class M, class = void>
+struct CanPassMessage : std::false_type {};
+template <class M>
+struct CanPassMessage<M, decltype(void(SerializationTraits<M>::Pass(
+                             std::declval<const M&>(), std::declval<size_t>(),
+                             std::declval<ByteBuffer*>())))>
+    : std::true_type {};
+
 class CallOpSendMessage {
  public:
   CallOpSendMessage() : send_buf_() {}
 
+  /// Hands \a message to an in-process peer without serializing it, unless
+  /// it is larger than \a max_size. Returns false if it did not.
+  using Passer = bool (*)(const void* message, size_t max_size,
+                          ByteBuffer* buffer);
+
+  /// Returns the Passer for messages of type \a M sent through \a Base, or
+  /// nullptr if they cannot be passed.
+  template <class M, class Base = M>
+  static Passer PasserFor() {
+    return MakePasser<M, Base>(CanPassMessage<M>());
+  }
+
+  /// For a message sent by SendMessagePtr() through its base class: passes
+  /// it as its actual type, given by PasserFor().
+  void PassMessageWith(Passer passer) { passer_ = passer; }
+
   /// Send \a message using \a options for the write. The \a options are cleared
   /// after use.
   template <class M>
@@ -319,12 +347,21 @@ class CallOpSendMessage {
       return;
     }
     if (msg_ != nullptr) {
-      GPR_ASSERT(serializer_(msg_).ok());
+      if (pass_message_) {
+        pass_message_ =
+            passer_(msg_, max_passed_message_size_, send_buf_.bbuf_ptr());
+      }
+      if (!pass_message_) GPR_ASSERT(serializer_(msg_).ok());
     }
     serializer_ = nullptr;
+    passer_ = nullptr;
     grpc_op* op = &ops[(*nops)++];
     op->op = GRPC_OP_SEND_MESSAGE;
     op->flags = write_options_.flags();
+    // A passed message must reach the peer as it was sent.
+    if (std::exchange(pass_message_, false)) {
+      op->flags |= GRPC_WRITE_NO_COMPRESS;
+    }
     op->reserved = nullptr;
     op->data.send_message.send_message = send_buf_.c_buffer();
     // Flags are per-message: clear them after use.
@@ -345,6 +382,8 @@ class CallOpSendMessage {
   void SetInterceptionHookPoint(
       InterceptorBatchMethodsImpl* interceptor_methods) {
     if (msg_ == nullptr && !send_buf_.Valid()) return;
+    pass_message_ = passer_ != nullptr && interceptor_methods->PassesMessages();
+    max_passed_message_size_ = interceptor_methods->MaxPassedMessageSize();
     interceptor_methods->AddInterceptionHookPoint(
         experimental::InterceptionHookPoints::PRE_SEND_MESSAGE);
     interceptor_methods->SetSendMessage(&send_buf_, &msg_, &failed_send_,
@@ -376,6 +415,27 @@ class CallOpSendMessage {
   ByteBuffer send_buf_;
   WriteOptions write_options_;
   std::function<Status(const void*)> serializer_;
+  // Hands the message itself to an in-process peer, for message types that
+  // support it; tried before serializer_ if pass_message_ is set.
+  Passer passer_ = nullptr;
+  bool pass_message_ = false;
+  size_t max_passed_message_size_ = 0;
+
+  template <class M, class Base>
+  static bool PassMessage(const void* message, size_t max_size,
+                          ByteBuffer* buffer) {
+    return SerializationTraits<M>::Pass(
+        static_cast<const M&>(*static_cast<const Base*>(message)), max_size,
+        buffer);
+  }
+  template <class M, class Base>
+  static Passer MakePasser(std::true_type) {
+    return PassMessage<M, Base>;
+  }
+  template <class M, class Base>
+  static Passer MakePasser(std::false_type) {
+    return nullptr;
+  }
 };
 
 template <class M>
@@ -415,6 +475,7 @@ Status CallOpSendMessage::SendMessagePtr(const M* message,
     }
     return result;
   };
+  passer_ = PasserFor<M>();
   return Status();
 }
 
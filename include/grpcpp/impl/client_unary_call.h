@@ -42,13 +42,16 @@ template <class InputMessage, class OutputMessage,
           class BaseOutputMessage = OutputMessage>
 Status BlockingUnaryCall(ChannelInterface* channel, const RpcMethod& method,
                          grpc::ClientContext* context,
-                         const InputMessage& request, OutputMessage* result) {
+                         const InputMessage& request, OutputMessage* result,
+                        CallOpSendMessage::Passer passer = nullptr) {
   static_assert(std::is_base_of<BaseInputMessage, InputMessage>::value,
                 "Invalid input message specification");
   static_assert(std::is_base_of<BaseOutputMessage, OutputMessage>::value,
                 "Invalid output message specification");
+  // The request is passed to an in-process peer as its actual type.
   return BlockingUnaryCallImpl<BaseInputMessage, BaseOutputMessage>(
-             channel, method, context, request, result)
+             channel, method, context, request, result,
+             CallOpSendMessage::PasserFor<InputMessage, BaseInputMessage>())
       .status();
 }
 
@@ -57,7 +60,8 @@ class BlockingUnaryCallImpl {
  public:
   BlockingUnaryCallImpl(ChannelInterface* channel, const RpcMethod& method,
                         grpc::ClientContext* context,
-                        const InputMessage& request, OutputMessage* result) {
+                        const InputMessage& request, OutputMessage* result,
+                        CallOpSendMessage::Passer passer = nullptr) {
     grpc::CompletionQueue cq(grpc_completion_queue_attributes{
         GRPC_CQ_CURRENT_VERSION, GRPC_CQ_PLUCK, GRPC_CQ_DEFAULT_POLLING,
         nullptr});  // Pluckable completion queue
@@ -70,6 +74,7 @@ class BlockingUnaryCallImpl {
     if (!status_.ok()) {
       return;
     }
+    if (passer != nullptr) ops.PassMessageWith(passer);
     ops.SendInitialMetadata(&context->send_initial_metadata_,
                             context->initial_metadata_flags());
     ops.RecvInitialMetadata(context);
@@ -65,6 +65,13 @@
 #define GRPC_CUSTOM_CODEDINPUTSTREAM ::google::protobuf::io::CodedInputStream
 #endif
 
+// Protobuf 22 added ZeroCopyInputStream::ReadCord, through which absl::Cord
+// fields can share the input's memory instead of copying it.
+#if !defined(GRPC_PROTOBUF_CORD_SUPPORT_ENABLED) && \
+    defined(GOOGLE_PROTOBUF_VERSION) && GOOGLE_PROTOBUF_VERSION >= 4022000
+#define GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#endif
+
 #ifndef GRPC_CUSTOM_JSONUTIL
 #include <google/protobuf/util/json_util.h>
 #include <google/protobuf/util/type_resolver_util.h>
@@ -218,6 +218,16 @@ class InterceptorBatchMethodsImpl
   // Alternatively, RunInterceptors(std::function<void(void)> f) can be used.
   void SetCallOpSetInterface(CallOpSetInterface* ops) { ops_ = ops; }
 
+  // SetCall should have been called before this.
+  // Returns true if messages can be handed to the peer without being
+  // serialized: the call allows it, and no interceptor may look at them.
+  bool PassesMessages() {
+    return call_->pass_messages() && InterceptorsListEmpty();
+  }
+
+  // SetCall should have been called before this.
+  size_t MaxPassedMessageSize() { return call_->max_passed_message_size(); }
+
   // SetCall should have been called before this.
   // Returns true if the interceptors list is empty
   bool InterceptorsListEmpty() {
@@ -19,7 +19,9 @@
 #ifndef GRPCPP_IMPL_PROTO_UTILS_H
 #define GRPCPP_IMPL_PROTO_UTILS_H
 
+#include <memory>
 #include <type_traits>
+#include <utility>
 
 #include <grpc/byte_buffer_reader.h>
 #include <grpc/impl/codegen/grpc_types.h>
@@ -28,6 +30,7 @@
 #include <grpcpp/impl/codegen/config_protobuf.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/serialization_traits.h>
+#include <grpcpp/support/arena_message_allocator.h>
 #include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/proto_buffer_reader.h>
 #include <grpcpp/support/proto_buffer_writer.h>
@@ -41,6 +44,10 @@ namespace grpc {
 
 extern CoreCodegenInterface* g_core_codegen_interface;
 
+// Bytes left free before a message serialized into a single slice, so that
+// the transport can write the gRPC message header there in place.
+const int kSerializedMessageHeadroom = 5;
+
 // ProtoBufferWriter must be a subclass of ::protobuf::io::ZeroCopyOutputStream.
 template <class ProtoBufferWriter, class T>
 Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
@@ -61,6 +68,22 @@ Status GenericSerialize(const grpc::protobuf::MessageLite& msg, ByteBuffer* bb,
 
     return grpc::Status::OK;
   }
+  if (byte_size <= kProtoBufferWriterMaxBufferLength) {
+    // Serialize straight into one slice, with room before the message.
+    grpc_slice slice = grpc_slice_malloc(
+        static_cast<size_t>(byte_size + kSerializedMessageHeadroom));
+    slice = grpc_slice_sub_no_ref(
+        slice, kSerializedMessageHeadroom,
+        static_cast<size_t>(byte_size + kSerializedMessageHeadroom));
+    uint8_t* start = GRPC_SLICE_START_PTR(slice);
+    GPR_ASSERT(GRPC_SLICE_END_PTR(slice) ==
+               msg.SerializeWithCachedSizesToArray(start));
+    Slice message(slice, Slice::STEAL_REF);
+    ByteBuffer tmp(&message, 1);
+    bb->Swap(&tmp);
+
+    return grpc::Status::OK;
+  }
   ProtoBufferWriter writer(bb, kProtoBufferWriterMaxBufferLength, byte_size);
   return msg.SerializeToZeroCopyStream(&writer)
              ? grpc::Status::OK
@@ -92,6 +115,58 @@ Status GenericDeserialize(ByteBuffer* buffer,
   return result;
 }
 
+namespace internal {
+
+// Message types that can be copied and moved (i.e. generated messages) can be
+// handed to an in-process peer without being serialized.
+template <class T>
+struct IsPassableMessage
+    : std::integral_constant<bool, !std::is_abstract<T>::value &&
+                                       std::is_copy_constructible<T>::value &&
+                                       std::is_move_assignable<T>::value> {};
+
+template <class T>
+struct PassedProtoType {
+  static Status Serialize(const void* message, ByteBuffer* buffer) {
+    bool own_buffer;
+    return GenericSerialize<ProtoBufferWriter, T>(
+        *static_cast<const T*>(message), buffer, &own_buffer);
+  }
+  static void Destroy(void* message) { delete static_cast<T*>(message); }
+
+  static const PassedMessage::Type kType;
+};
+
+template <class T>
+const PassedMessage::Type PassedProtoType<T>::kType = {
+    PassedProtoType<T>::Serialize, PassedProtoType<T>::Destroy};
+
+// For receiving types that cannot take the passed message as it is: parses
+// it from its serialization.
+template <class T>
+Status TakePassedMessage(PassedMessage* /*passed*/, ByteBuffer* buffer,
+                         grpc::protobuf::MessageLite* msg, std::false_type) {
+  Status result = PassedMessage::Serialize(buffer);
+  if (!result.ok()) return result;
+  return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
+}
+
+// Moves the passed message out if it is of the receiving type.
+template <class T>
+Status TakePassedMessage(PassedMessage* passed, ByteBuffer* buffer,
+                         grpc::protobuf::MessageLite* msg, std::true_type) {
+  // The type is the identity of the sender's message type, so only a sender
+  // of exactly T passes a message this takes.
+  if (passed->type() != &PassedProtoType<T>::kType) {
+    return TakePassedMessage<T>(passed, buffer, msg, std::false_type());
+  }
+  *static_cast<T*>(msg) = std::move(*static_cast<T*>(passed->message()));
+  buffer->Clear();
+  return grpc::Status::OK;
+}
+
+}  // namespace internal
+
 // this is needed so the following class does not conflict with protobuf
 // serializers that utilize internal-only tools.
 #ifdef GRPC_OPEN_SOURCE_PROTO
@@ -108,10 +183,58 @@ class SerializationTraits<
     return GenericSerialize<ProtoBufferWriter, T>(msg, bb, own_buffer);
   }
 
+  // Makes \a bb hold a copy of \a msg itself, for an in-process peer, and
+  // returns true; or returns false if \a msg would serialize to more than
+  // \a max_size bytes.
+  template <class M = T>
+  static typename std::enable_if<internal::IsPassableMessage<M>::value,
+                                 bool>::type
+  Pass(const T& msg, size_t max_size, ByteBuffer* bb) {
+    if (msg.ByteSizeLong() > max_size) return false;
+    internal::PassedMessage::Pass(new T(msg),
+                                  &internal::PassedProtoType<T>::kType, bb);
+    return true;
+  }
+
+  // Moves the message \a buffer holds into \a msg and returns true if it
+  // was passed as a T, for receivers that otherwise deserialize through a
+  // base class of T.
+  template <class M = T>
+  static typename std::enable_if<internal::IsPassableMessage<M>::value,
+                                 bool>::type
+  TakePassed(ByteBuffer* buffer, T* msg) {
+    internal::PassedMessage* passed =
+        internal::PassedMessage::FromByteBuffer(buffer);
+    if (passed == nullptr ||
+        passed->type() != &internal::PassedProtoType<T>::kType) {
+      return false;
+    }
+    *msg = std::move(*static_cast<T*>(passed->message()));
+    buffer->Clear();
+    return true;
+  }
+
   static Status Deserialize(ByteBuffer* buffer,
                             grpc::protobuf::MessageLite* msg) {
+    if (buffer != nullptr) {
+      internal::PassedMessage* passed =
+          internal::PassedMessage::FromByteBuffer(buffer);
+      if (passed != nullptr) {
+        return internal::TakePassedMessage<T>(
+            passed, buffer, msg, internal::IsPassableMessage<T>());
+      }
+    }
     return GenericDeserialize<ProtoBufferReader, T>(buffer, msg);
   }
+
+  // Used by Service::EnableArenaMessageAllocation(): creates messages on
+  // protobuf arenas if the response is a protobuf message too.
+  template <class ResponseT>
+  static std::unique_ptr<MessageAllocator<T, ResponseT>>
+  CreateArenaMessageAllocator() {
+    return internal::CreateArenaMessageAllocator<T, ResponseT>(
+        std::is_base_of<grpc::protobuf::MessageLite, ResponseT>());
+  }
 };
 #endif
 
@@ -19,6 +19,10 @@
 #ifndef GRPCPP_IMPL_RPC_SERVICE_METHOD_H
 #define GRPCPP_IMPL_RPC_SERVICE_METHOD_H
 
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
 #include <climits>
 #include <functional>
 #include <map>
@@ -78,6 +82,11 @@ class MethodHandler {
     GPR_ASSERT(req == nullptr);
     return nullptr;
   }
+
+  /// Called through Service::EnableArenaMessageAllocation().  Handlers that
+  /// take a MessageAllocator and do not have one yet use the arena allocator
+  /// for their message types, if there is one.
+  virtual void EnableArenaMessageAllocation() {}
 };
 
 /// Server side rpc method class
@@ -124,10 +133,31 @@ class RpcServiceMethod : public RpcMethod {
     api_type_ = type;
   }
 
+  /// Runs the callback handler inline, on the thread that delivered the
+  /// request, instead of handing it to another thread.  Runs longer than
+  /// \a budget are counted and logged.
+  void SetRunInline(std::chrono::microseconds budget) {
+    run_inline_ = true;
+    inline_budget_ = budget;
+  }
+  bool run_inline() const { return run_inline_; }
+  std::chrono::microseconds inline_budget() const { return inline_budget_; }
+  /// Counts a run of the inline handler over its budget.  Returns the number
+  /// counted so far.
+  uint64_t CountInlineOverrun() {
+    return inline_overruns_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+  uint64_t inline_overruns() const {
+    return inline_overruns_.load(std::memory_order_relaxed);
+  }
+
  private:
   void* server_tag_;
   ApiType api_type_;
   std::unique_ptr<MethodHandler> handler_;
+  bool run_inline_ = false;
+  std::chrono::microseconds inline_budget_{0};
+  std::atomic<uint64_t> inline_overruns_{0};
 
   const char* TypeToString(RpcServiceMethod::ApiType type) {
     switch (type) {
@@ -43,6 +43,13 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
     allocator_ = allocator;
   }
 
+  void EnableArenaMessageAllocation() final {
+    if (allocator_ != nullptr) return;
+    arena_allocator_ = ArenaMessageAllocatorFactory<RequestType,
+                                                    ResponseType>::Create();
+    allocator_ = arena_allocator_.get();
+  }
+
   void RunHandler(const HandlerParameter& param) final {
     // Arena allocate a controller structure (that includes request/response)
     grpc_call_ref(param.call->call());
@@ -107,6 +114,8 @@ class CallbackUnaryHandler : public grpc::internal::MethodHandler {
                                     const RequestType*, ResponseType*)>
       get_reactor_;
   MessageAllocator<RequestType, ResponseType>* allocator_ = nullptr;
+  std::unique_ptr<MessageAllocator<RequestType, ResponseType>>
+      arena_allocator_;
 
   class ServerCallbackUnaryImpl : public ServerCallbackUnary {
    public:
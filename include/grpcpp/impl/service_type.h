@@ -19,6 +19,12 @@
 #ifndef GRPCPP_IMPL_SERVICE_TYPE_H
 #define GRPCPP_IMPL_SERVICE_TYPE_H
 
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+#include <string>
+
 #include <grpc/support/log.h>
 #include <grpcpp/impl/codegen/core_codegen_interface.h>
 #include <grpcpp/impl/rpc_service_method.h>
@@ -99,6 +105,43 @@ class Service {
     return false;
   }
 
+  /// EXPERIMENTAL
+  /// Runs the handler of the callback method \a method_name (e.g. "Echo")
+  /// inline, on the thread that delivered the request, instead of handing it
+  /// to another thread.  This saves a thread hop per RPC, but the handler
+  /// then holds up the transport: it must never block.  A handler that runs
+  /// for longer than \a budget is logged as an error.  Must be called before
+  /// the server is built.  Returns false if the service has no callback
+  /// method of that name.
+  bool SetMethodRunInline(const std::string& method_name,
+                          std::chrono::microseconds budget) {
+    internal::RpcServiceMethod* method = FindCallbackMethod(method_name);
+    if (method == nullptr) return false;
+    method->SetRunInline(budget);
+    return true;
+  }
+
+  /// EXPERIMENTAL
+  /// Returns how many times the handler of the callback method \a method_name
+  /// ran inline for longer than the budget given to SetMethodRunInline(), or
+  /// 0 if the service has no callback method of that name.
+  uint64_t MethodInlineOverruns(const std::string& method_name) {
+    internal::RpcServiceMethod* method = FindCallbackMethod(method_name);
+    return method == nullptr ? 0 : method->inline_overruns();
+  }
+
+  /// Gives each callback unary method of this service with protobuf messages
+  /// and no MessageAllocator an ArenaMessageAllocator, so that its requests
+  /// and responses are created on arenas reused across RPCs.  Must be called
+  /// before the server is built.
+  void EnableArenaMessageAllocation() {
+    for (const auto& method : methods_) {
+      if (method && method->handler() != nullptr) {
+        method->handler()->EnableArenaMessageAllocation();
+      }
+    }
+  }
+
  protected:
   template <class Message>
   void RequestAsyncUnary(int index, grpc::ServerContext* context,
@@ -227,6 +270,27 @@ class Service {
  private:
   friend class Server;
   friend class ServerInterface;
+
+  // Returns the callback method named \a method_name (e.g. "Echo"), or
+  // nullptr.
+  internal::RpcServiceMethod* FindCallbackMethod(
+      const std::string& method_name) {
+    for (const auto& method : methods_) {
+      if (method == nullptr ||
+          (method->api_type() !=
+               internal::RpcServiceMethod::ApiType::CALL_BACK &&
+           method->api_type() !=
+               internal::RpcServiceMethod::ApiType::RAW_CALL_BACK)) {
+        continue;
+      }
+      const char* slash = strrchr(method->name(), '/');
+      if (method_name == (slash != nullptr ? slash + 1 : method->name())) {
+        return method.get();
+      }
+    }
+    return nullptr;
+  }
+
   ServerInterface* server_;
   std::vector<std::unique_ptr<internal::RpcServiceMethod>> methods_;
 };
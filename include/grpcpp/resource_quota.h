@@ -36,6 +36,14 @@ class ResourceQuota final : private grpc::internal::GrpcLibrary {
   /// \param name - a unique name for this ResourceQuota.
   explicit ResourceQuota(const std::string& name);
   ResourceQuota();
+  /// EXPERIMENTAL: Create a quota for one tenant of \a parent. It draws from
+  /// \a parent's memory, with the first \a guaranteed_bytes set aside for it
+  /// and the rest shared with \a parent's other tenants in proportion to
+  /// \a weight, which must be positive. It shares \a parent's threads.
+  /// Connections on a listening port given the tenant through
+  /// ServerBuilder::experimental().AddListeningPort() are accounted to it.
+  ResourceQuota(const ResourceQuota& parent, const std::string& name,
+                size_t guaranteed_bytes, size_t weight);
   ~ResourceQuota() override;
 
   /// Resize this \a ResourceQuota to a new size. If \a new_size is smaller
@@ -44,6 +44,7 @@ struct grpc_server;
 
 namespace grpc {
 class AsyncGenericService;
+class HandlerPool;
 class ServerContext;
 class ServerInitializer;
 
@@ -172,6 +173,14 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
   ///
   /// \param sync_cq_timeout_msec The timeout to use when calling AsyncNext() on
   /// server completion queues passed via sync_server_cqs param.
+  ///
+  /// \param sync_handler_threads If not 0, sync handlers run on a pool of
+  /// this many threads (-1 for one per core) shared by all the server
+  /// completion queues, and min_pollers threads per queue only poll
+  ///
+  /// \param sync_max_pending_handlers The number of requests that may wait
+  /// for a thread of that pool before new ones fail with RESOURCE_EXHAUSTED
+  /// (-1 for no limit)
   Server(ChannelArguments* args,
          std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
              sync_server_cqs,
@@ -183,7 +192,8 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
          std::vector<
              std::unique_ptr<experimental::ServerInterceptorFactoryInterface>>
              interceptor_creators = std::vector<std::unique_ptr<
-                 experimental::ServerInterceptorFactoryInterface>>());
+                 experimental::ServerInterceptorFactoryInterface>>(),
+         int sync_handler_threads = 0, int sync_max_pending_handlers = -1);
 
   /// Start the server.
   ///
@@ -285,6 +295,10 @@ class Server : public ServerInterface, private internal::GrpcLibrary {
   std::shared_ptr<std::vector<std::unique_ptr<ServerCompletionQueue>>>
       sync_server_cqs_;
 
+  /// Runs the sync handlers, if the \a ThreadManager instances do not.
+  /// Outlives them.
+  std::unique_ptr<HandlerPool> sync_handler_pool_;
+
   /// List of \a ThreadManager instances (one for each cq in
   /// the \a sync_server_cqs)
   std::vector<std::unique_ptr<SyncRequestThreadManager>> sync_req_mgrs_;
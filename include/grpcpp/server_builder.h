@@ -226,10 +226,19 @@ class ServerBuilder {
 
   /// Options for synchronous servers.
   enum SyncServerOption {
-    NUM_CQS,         ///< Number of completion queues.
-    MIN_POLLERS,     ///< Minimum number of polling threads.
-    MAX_POLLERS,     ///< Maximum number of polling threads.
-    CQ_TIMEOUT_MSEC  ///< Completion queue timeout in milliseconds.
+    NUM_CQS,          ///< Number of completion queues.
+    MIN_POLLERS,      ///< Minimum number of polling threads.
+    MAX_POLLERS,      ///< Maximum number of polling threads.
+    CQ_TIMEOUT_MSEC,  ///< Completion queue timeout in milliseconds.
+    /// Number of threads running handlers, shared by all completion queues,
+    /// or -1 for one per core.  With this set, MIN_POLLERS threads per
+    /// completion queue only poll and the thread count stays fixed.  0 (the
+    /// default) runs handlers on the polling threads.
+    HANDLER_THREADS,
+    /// Number of requests that may wait for a handler thread before new ones
+    /// fail with RESOURCE_EXHAUSTED, or -1 (the default) for no limit.  Only
+    /// used with HANDLER_THREADS.
+    MAX_PENDING_HANDLERS
   };
 
   /// Only useful if this is a Synchronous server.
@@ -283,6 +292,21 @@ class ServerBuilder {
         std::shared_ptr<experimental::AuthorizationPolicyProviderInterface>
             provider);
 
+    /// Calls Service::EnableArenaMessageAllocation() on every service
+    /// registered with the builder.
+    void EnableArenaMessageAllocation() {
+      builder_->arena_message_allocation_ = true;
+    }
+
+    /// Like ServerBuilder::AddListeningPort(), but the connections on this
+    /// port are accounted to \a tenant_quota rather than to the server's
+    /// quota. \a tenant_quota should be a tenant of the quota passed to
+    /// SetResourceQuota().
+    void AddListeningPort(const std::string& addr_uri,
+                          std::shared_ptr<ServerCredentials> creds,
+                          const grpc::ResourceQuota& tenant_quota,
+                          int* selected_port = nullptr);
+
    private:
     ServerBuilder* builder_;
   };
@@ -310,6 +334,9 @@ class ServerBuilder {
     std::string addr;
     std::shared_ptr<ServerCredentials> creds;
     int* selected_port;
+    // The quota that the port's connections are accounted to, if not the
+    // server's. Owned by the builder.
+    grpc_resource_quota* resource_quota = nullptr;
   };
 
   /// Experimental, to be deprecated
@@ -359,7 +386,12 @@ class ServerBuilder {
 
   struct SyncServerSettings {
     SyncServerSettings()
-        : num_cqs(1), min_pollers(1), max_pollers(2), cq_timeout_msec(10000) {}
+        : num_cqs(1),
+          min_pollers(1),
+          max_pollers(2),
+          cq_timeout_msec(10000),
+          handler_threads(0),
+          max_pending_handlers(-1) {}
 
     /// Number of server completion queues to create to listen to incoming RPCs.
     int num_cqs;
@@ -374,6 +406,12 @@ class ServerBuilder {
 
     /// The timeout for server completion queue's AsyncNext call.
     int cq_timeout_msec;
+
+    /// Number of threads running handlers, if not the polling threads.
+    int handler_threads;
+
+    /// Number of requests that may wait for a handler thread.
+    int max_pending_handlers;
   };
 
   int max_receive_message_size_;
@@ -393,6 +431,7 @@ class ServerBuilder {
   grpc::AsyncGenericService* generic_service_{nullptr};
   std::unique_ptr<ContextAllocator> context_allocator_;
   grpc::CallbackGenericService* callback_generic_service_{nullptr};
+  bool arena_message_allocation_ = false;
 
   struct {
     bool is_set;
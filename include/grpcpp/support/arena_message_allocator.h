@@ -0,0 +1,177 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPCPP_SUPPORT_ARENA_MESSAGE_ALLOCATOR_H
+#define GRPCPP_SUPPORT_ARENA_MESSAGE_ALLOCATOR_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <grpcpp/impl/codegen/config_protobuf.h>
+#include <grpcpp/impl/sync.h>
+#include <grpcpp/support/message_allocator.h>
+
+#ifndef GRPC_CUSTOM_ARENA
+#include <google/protobuf/arena.h>
+#define GRPC_CUSTOM_ARENA ::google::protobuf::Arena
+#define GRPC_CUSTOM_ARENAOPTIONS ::google::protobuf::ArenaOptions
+#endif
+
+namespace grpc {
+
+namespace protobuf {
+
+typedef GRPC_CUSTOM_ARENA Arena;
+typedef GRPC_CUSTOM_ARENAOPTIONS ArenaOptions;
+
+}  // namespace protobuf
+
+// A MessageAllocator that creates the request and response of each RPC on a
+// protobuf arena, so that their fields are not heap allocated one by one.
+// Arenas are reset and reused across RPCs.  Each starts with a single block,
+// sized from a running estimate of the space the messages of the method
+// use, so that most RPCs allocate nothing else.
+//
+// Service::EnableArenaMessageAllocation() gives one to each callback unary
+// method of a service that has no other allocator;
+// ServerBuilder::experimental().EnableArenaMessageAllocation() does so for
+// every service of the server.
+template <typename RequestT, typename ResponseT>
+class ArenaMessageAllocator : public MessageAllocator<RequestT, ResponseT> {
+ public:
+  ArenaMessageAllocator() = default;
+  ~ArenaMessageAllocator() override {
+    internal::MutexLock lock(&mu_);
+    for (Holder* holder : free_holders_) delete holder;
+  }
+
+  ArenaMessageAllocator(const ArenaMessageAllocator&) = delete;
+  ArenaMessageAllocator& operator=(const ArenaMessageAllocator&) = delete;
+
+  MessageHolder<RequestT, ResponseT>* AllocateMessages() override {
+    Holder* holder = nullptr;
+    {
+      internal::MutexLock lock(&mu_);
+      if (!free_holders_.empty()) {
+        holder = free_holders_.back();
+        free_holders_.pop_back();
+      }
+    }
+    if (holder == nullptr) holder = new Holder(this, BlockSize());
+    holder->CreateMessages();
+    return holder;
+  }
+
+ private:
+  static constexpr size_t kMinBlockSize = 1024;
+  // Idle arenas kept for reuse.
+  static constexpr size_t kMaxFreeHolders = 64;
+
+  class Holder : public MessageHolder<RequestT, ResponseT> {
+   public:
+    Holder(ArenaMessageAllocator* allocator, size_t block_size)
+        : allocator_(allocator),
+          block_size_(block_size),
+          block_(new char[block_size]),
+          arena_(Options(block_.get(), block_size)) {}
+
+    void CreateMessages() {
+      this->set_request(protobuf::Arena::CreateMessage<RequestT>(&arena_));
+      this->set_response(protobuf::Arena::CreateMessage<ResponseT>(&arena_));
+    }
+
+    void Release() override { allocator_->Recycle(this); }
+
+    size_t block_size() const { return block_size_; }
+    protobuf::Arena* arena() { return &arena_; }
+
+   private:
+    static protobuf::ArenaOptions Options(char* block, size_t block_size) {
+      protobuf::ArenaOptions options;
+      options.initial_block = block;
+      options.initial_block_size = block_size;
+      return options;
+    }
+
+    ArenaMessageAllocator* const allocator_;
+    const size_t block_size_;
+    std::unique_ptr<char[]> block_;
+    protobuf::Arena arena_;
+  };
+
+  // Leaves some room over the estimate, so that RPCs a bit larger than usual
+  // still fit.
+  size_t BlockSize() const {
+    const size_t estimate =
+        estimated_space_used_.load(std::memory_order_relaxed);
+    const size_t block_size = estimate + estimate / 4;
+    return block_size < kMinBlockSize ? kMinBlockSize : block_size;
+  }
+
+  void Recycle(Holder* holder) {
+    // A moving average of the space used per RPC, starting from the first.
+    // Concurrent updates may lose a sample, which does not matter for an
+    // estimate.
+    const size_t used = static_cast<size_t>(holder->arena()->SpaceUsed());
+    size_t estimate = estimated_space_used_.load(std::memory_order_relaxed);
+    estimate = estimate == 0 ? used : estimate - estimate / 8 + used / 8;
+    estimated_space_used_.store(estimate, std::memory_order_relaxed);
+    holder->arena()->Reset();
+    // An arena whose block is now too small for the method's messages is
+    // dropped, so that a new one is sized from the estimate.
+    if (holder->block_size() >= estimate) {
+      internal::MutexLock lock(&mu_);
+      if (free_holders_.size() < kMaxFreeHolders) {
+        free_holders_.push_back(holder);
+        return;
+      }
+    }
+    delete holder;
+  }
+
+  std::atomic<size_t> estimated_space_used_{0};
+  internal::Mutex mu_;
+  std::vector<Holder*> free_holders_ ABSL_GUARDED_BY(mu_);
+};
+
+namespace internal {
+
+// Called by the SerializationTraits of protobuf requests (see proto_utils.h)
+// with whether the response is a protobuf message as well.
+template <typename RequestT, typename ResponseT>
+std::unique_ptr<MessageAllocator<RequestT, ResponseT>>
+CreateArenaMessageAllocator(std::true_type /*response_is_protobuf*/) {
+  return std::unique_ptr<MessageAllocator<RequestT, ResponseT>>(
+      new ArenaMessageAllocator<RequestT, ResponseT>());
+}
+
+template <typename RequestT, typename ResponseT>
+std::unique_ptr<MessageAllocator<RequestT, ResponseT>>
+CreateArenaMessageAllocator(std::false_type /*response_is_protobuf*/) {
+  return nullptr;
+}
+
+}  // namespace internal
+
+}  // namespace grpc
+
+#endif  // GRPCPP_SUPPORT_ARENA_MESSAGE_ALLOCATOR_H
@@ -19,6 +19,8 @@
 #ifndef GRPCPP_SUPPORT_BYTE_BUFFER_H
 #define GRPCPP_SUPPORT_BYTE_BUFFER_H
 
+#include <stdint.h>
+
 #include <vector>
 
 #include <grpc/byte_buffer.h>
@@ -42,7 +44,9 @@ class CallbackUnaryHandler;
 template <class RequestType, class ResponseType>
 class CallbackServerStreamingHandler;
 template <class RequestType>
-void* UnaryDeserializeHelper(grpc_byte_buffer*, grpc::Status*, RequestType*);
+void* UnaryDeserializeHelper(
+    grpc_byte_buffer*, grpc::Status*, RequestType*,
+    bool (*take_passed)(ByteBuffer*, RequestType*) = nullptr);
 template <class ServiceType, class RequestType, class ResponseType>
 class ServerStreamingHandler;
 template <grpc::StatusCode code>
@@ -55,6 +59,7 @@ class ExternalConnectionAcceptorImpl;
 template <class R>
 class DeserializeFuncType;
 class GrpcByteBufferPeer;
+class PassedMessage;
 
 }  // namespace internal
 /// A sequence of bytes.
@@ -167,8 +172,9 @@ class ByteBuffer final {
   friend class internal::CallOpRecvMessage;
   friend class internal::CallOpGenericRecvMessage;
   template <class RequestType>
-  friend void* internal::UnaryDeserializeHelper(grpc_byte_buffer*,
-                                                grpc::Status*, RequestType*);
+  friend void* internal::UnaryDeserializeHelper(
+      grpc_byte_buffer*, grpc::Status*, RequestType*,
+      bool (*take_passed)(ByteBuffer*, RequestType*));
   template <class ServiceType, class RequestType, class ResponseType>
   friend class internal::ServerStreamingHandler;
   template <class RequestType, class ResponseType>
@@ -183,6 +189,7 @@ class ByteBuffer final {
   friend class ProtoBufferWriter;
   friend class internal::GrpcByteBufferPeer;
   friend class internal::ExternalConnectionAcceptorImpl;
+  friend class internal::PassedMessage;
 
   grpc_byte_buffer* buffer_;
 
@@ -215,12 +222,72 @@ class ByteBuffer final {
   ByteBufferPointer bbuf_ptr() const { return ByteBufferPointer(this); }
 };
 
+namespace internal {
+
+/// A message handed to an in-process peer as an object rather than as bytes
+/// (see GRPC_ARG_INPROC_PASS_MESSAGES). The byte buffer made by Pass() holds
+/// only a handle to the message, from which the receiving side gets the
+/// message back with FromByteBuffer().
+class PassedMessage final {
+ public:
+  /// What the receiving side needs to handle a message of some type.
+  struct Type {
+    /// Serializes \a message, for receivers that want bytes.
+    Status (*serialize)(const void* message, ByteBuffer* buffer);
+    void (*destroy)(void* message);
+  };
+
+  /// Makes \a buffer hold \a message, of type \a type, and takes ownership
+  /// of the message.
+  static void Pass(void* message, const Type* type, ByteBuffer* buffer);
+
+  /// Returns the message \a buffer holds, or nullptr if it holds bytes.
+  static PassedMessage* FromByteBuffer(ByteBuffer* buffer) {
+    grpc_byte_buffer* bb = buffer->c_buffer();
+    // Cheap checks first: this runs on every message received.
+    if (bb == nullptr || bb->type != GRPC_BB_RAW ||
+        bb->data.raw.compression != GRPC_COMPRESS_NONE ||
+        bb->data.raw.slice_buffer.count != 1 ||
+        bb->data.raw.slice_buffer.length != sizeof(Handle)) {
+      return nullptr;
+    }
+    return FromHandle(bb->data.raw.slice_buffer.slices[0]);
+  }
+
+  /// Replaces a message held by \a buffer with its serialization.
+  static Status Serialize(ByteBuffer* buffer);
+
+  const Type* type() const { return type_; }
+  /// The receiving side may move from the message.
+  void* message() const { return message_; }
+
+ private:
+  // What the byte buffer carries: a per-process key, so that bytes from
+  // another process are never taken for a handle, and this object's address.
+  struct Handle {
+    uint64_t key;
+    uint64_t passed_message;
+  };
+
+  PassedMessage(void* message, const Type* type);
+  ~PassedMessage();
+
+  static PassedMessage* FromHandle(const grpc_slice& slice);
+
+  Handle handle_;
+  void* const message_;
+  const Type* const type_;
+};
+
+}  // namespace internal
+
 template <>
 class SerializationTraits<ByteBuffer, void> {
  public:
   static Status Deserialize(ByteBuffer* byte_buffer, ByteBuffer* dest) {
     dest->set_buffer(byte_buffer->buffer_);
-    return Status::OK;
+    // Receivers of bytes get them even if the sender passed a message.
+    return internal::PassedMessage::Serialize(dest);
   }
   static Status Serialize(const ByteBuffer& source, ByteBuffer* buffer,
                           bool* own_buffer) {
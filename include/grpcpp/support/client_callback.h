@@ -57,8 +57,11 @@ void CallbackUnaryCall(grpc::ChannelInterface* channel,
                 "Invalid input message specification");
   static_assert(std::is_base_of<BaseOutputMessage, OutputMessage>::value,
                 "Invalid output message specification");
+  // The request is passed to an in-process peer as its actual type.
   CallbackUnaryCallImpl<BaseInputMessage, BaseOutputMessage> x(
-      channel, method, context, request, result, on_completion);
+      channel, method, context, request, result, on_completion,
+      grpc::internal::CallOpSendMessage::PasserFor<InputMessage,
+                                                   BaseInputMessage>());
 }
 
 template <class InputMessage, class OutputMessage>
@@ -68,7 +71,9 @@ class CallbackUnaryCallImpl {
                         const grpc::internal::RpcMethod& method,
                         grpc::ClientContext* context,
                         const InputMessage* request, OutputMessage* result,
-                        std::function<void(grpc::Status)> on_completion) {
+                        std::function<void(grpc::Status)> on_completion,
+                        grpc::internal::CallOpSendMessage::Passer passer =
+                            nullptr) {
     grpc::CompletionQueue* cq = channel->CallbackCQ();
     GPR_ASSERT(cq != nullptr);
     grpc::internal::Call call(channel->CreateCall(method, context, cq));
@@ -98,6 +103,7 @@ class CallbackUnaryCallImpl {
       tag->force_run(s);
       return;
     }
+    if (passer != nullptr) ops->PassMessageWith(passer);
     ops->SendInitialMetadata(&context->send_initial_metadata_,
                              context->initial_metadata_flags());
     ops->RecvInitialMetadata(context);
@@ -19,6 +19,10 @@
 #ifndef GRPCPP_SUPPORT_MESSAGE_ALLOCATOR_H
 #define GRPCPP_SUPPORT_MESSAGE_ALLOCATOR_H
 
+#include <memory>
+
+#include <grpcpp/impl/serialization_traits.h>
+
 namespace grpc {
 
 // NOTE: This is an API for advanced users who need custom allocators.
@@ -66,6 +70,35 @@ class MessageAllocator {
   virtual MessageHolder<RequestT, ResponseT>* AllocateMessages() = 0;
 };
 
+namespace internal {
+
+// Creates the allocator that Service::EnableArenaMessageAllocation() gives to
+// callback unary methods with these message types, or returns nullptr if
+// there is none for them.  Serialization traits that can create messages on
+// an arena provide a static CreateArenaMessageAllocator<ResponseT>() (the
+// protobuf ones do, see proto_utils.h).  The traits of the request type are
+// complete wherever a handler is instantiated, since the handler deserializes
+// requests with them, so every translation unit picks the same one.
+template <typename RequestT, typename ResponseT, typename = void>
+struct ArenaMessageAllocatorFactory {
+  static std::unique_ptr<MessageAllocator<RequestT, ResponseT>> Create() {
+    return nullptr;
+  }
+};
+
+template <typename RequestT, typename ResponseT>
+struct ArenaMessageAllocatorFactory<
+    RequestT, ResponseT,
+    decltype(void(SerializationTraits<RequestT>::template
+                      CreateArenaMessageAllocator<ResponseT>()))> {
+  static std::unique_ptr<MessageAllocator<RequestT, ResponseT>> Create() {
+    return SerializationTraits<RequestT>::template CreateArenaMessageAllocator<
+        ResponseT>();
+  }
+};
+
+}  // namespace internal
+
 }  // namespace grpc
 
 #endif  // GRPCPP_SUPPORT_MESSAGE_ALLOCATOR_H
@@ -76,13 +76,45 @@ void UnaryRunHandlerHelper(const MethodHandler::HandlerParameter& param,
   param.call->cq()->Pluck(&ops);
 }
 
-/// A helper function with reduced templating to do deserializing.
+/// Takes a request that an in-process client passed as a RequestType (see
+/// PassedMessage), for handlers that deserialize through a base class.
+template <class RequestType, class BaseRequestType>
+bool TakePassedRequest(ByteBuffer* buffer, BaseRequestType* request) {
+  return SerializationTraits<RequestType>::TakePassed(
+      buffer, static_cast<RequestType*>(request));
+}
+
+template <class RequestType, class = void>
+struct CanTakePassedRequest : std::false_type {};
+template <class RequestType>
+struct CanTakePassedRequest<
+    RequestType, decltype(void(SerializationTraits<RequestType>::TakePassed(
+                     std::declval<ByteBuffer*>(),
+                     std::declval<RequestType*>())))> : std::true_type {};
+
+template <class RequestType, class BaseRequestType>
+bool (*PassedRequestTaker(std::true_type))(ByteBuffer*, BaseRequestType*) {
+  return TakePassedRequest<RequestType, BaseRequestType>;
+}
+template <class RequestType, class BaseRequestType>
+bool (*PassedRequestTaker(std::false_type))(ByteBuffer*, BaseRequestType*) {
+  return nullptr;
+}
+
+/// A helper function with reduced templating to do deserializing. If set,
+/// \a take_passed takes a request passed as the handler's actual type.
 
 template <class RequestType>
 void* UnaryDeserializeHelper(grpc_byte_buffer* req, grpc::Status* status,
-                             RequestType* request) {
+                             RequestType* request,
+                             bool (*take_passed)(ByteBuffer*, RequestType*)) {
   grpc::ByteBuffer buf;
   buf.set_buffer(req);
+  if (take_passed != nullptr && take_passed(&buf, request)) {
+    *status = grpc::Status::OK;
+    buf.Release();
+    return request;
+  }
   *status = grpc::SerializationTraits<RequestType>::Deserialize(
       &buf, static_cast<RequestType*>(request));
   buf.Release();
@@ -124,8 +156,10 @@ class RpcMethodHandler : public grpc::internal::MethodHandler {
                     grpc::Status* status, void** /*handler_data*/) final {
     auto* request =
         new (grpc_call_arena_alloc(call, sizeof(RequestType))) RequestType;
-    return UnaryDeserializeHelper(req, status,
-                                  static_cast<BaseRequestType*>(request));
+    return UnaryDeserializeHelper(
+        req, status, static_cast<BaseRequestType*>(request),
+        PassedRequestTaker<RequestType, BaseRequestType>(
+            CanTakePassedRequest<RequestType>()));
   }
 
  private:
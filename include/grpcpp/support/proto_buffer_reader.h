@@ -32,6 +32,10 @@
 #include <grpcpp/support/byte_buffer.h>
 #include <grpcpp/support/status.h>
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+#include "absl/strings/cord.h"
+#endif
+
 /// This header provides an object that reads bytes directly from a
 /// grpc::ByteBuffer, via the ZeroCopyInputStream interface
 
@@ -123,6 +127,35 @@ class ProtoBufferReader : public grpc::protobuf::io::ZeroCopyInputStream {
   /// Returns the total number of bytes read since this object was created.
   int64_t ByteCount() const override { return byte_count_ - backup_count_; }
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  /// The proto library calls this to read \a count bytes into an absl::Cord
+  /// field.  Rather than copying them, the cord takes a ref on each slice it
+  /// shares, so the message keeps the received bytes alive after the byte
+  /// buffer is gone.  Pieces too small to be worth a chunk of their own, and
+  /// inlined slices, are copied.
+  bool ReadCord(absl::Cord* cord, int count) override {
+    const void* data;
+    int size;
+    while (count > 0) {
+      if (!Next(&data, &size)) return false;
+      if (size > count) {
+        BackUp(size - count);
+        size = count;
+      }
+      absl::string_view piece(static_cast<const char*>(data), size);
+      if (slice_->refcount == nullptr || size < kMinSharedCordBytes) {
+        cord->Append(piece);
+      } else {
+        grpc_slice ref = grpc_slice_ref(*slice_);
+        cord->Append(absl::MakeCordFromExternal(
+            piece, [ref]() { grpc_slice_unref(ref); }));
+      }
+      count -= size;
+    }
+    return true;
+  }
+#endif
+
   // These protected members are needed to support internal optimizations.
   // they expose internal bits of grpc core that are NOT stable. If you have
   // a use case needs to use one of these functions, please send an email to
@@ -136,6 +169,11 @@ class ProtoBufferReader : public grpc::protobuf::io::ZeroCopyInputStream {
   grpc_slice** mutable_slice_ptr() { return &slice_; }
 
  private:
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  /// Smaller pieces are copied into a cord rather than shared with it.
+  static constexpr int kMinSharedCordBytes = 512;
+#endif
+
   int64_t byte_count_;              ///< total bytes read since object creation
   int64_t backup_count_;            ///< how far backed up in the stream we are
   grpc_byte_buffer_reader reader_;  ///< internal object to read \a grpc_slice
@@ -22,6 +22,7 @@
 #include <stddef.h>
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <map>
@@ -40,6 +41,7 @@
 #include <grpc/event_engine/event_engine.h>
 #include <grpc/impl/connectivity_state.h>
 #include <grpc/support/log.h>
+#include <grpc/support/time.h>
 
 #include "src/core/ext/filters/client_channel/lb_policy/child_policy_handler.h"
 #include "src/core/lib/address_utils/sockaddr_utils.h"
@@ -87,7 +89,12 @@ class OutlierDetectionLbConfig : public LoadBalancingPolicy::Config {
 
   bool CountingEnabled() const {
     return outlier_detection_config_.success_rate_ejection.has_value() ||
-           outlier_detection_config_.failure_percentage_ejection.has_value();
+           outlier_detection_config_.failure_percentage_ejection.has_value() ||
+           LatencyTrackingEnabled();
+  }
+
+  bool LatencyTrackingEnabled() const {
+    return outlier_detection_config_.latency_ejection.has_value();
   }
 
   const OutlierDetectionConfig& outlier_detection_config() const {
@@ -103,6 +110,68 @@ class OutlierDetectionLbConfig : public LoadBalancingPolicy::Config {
   RefCountedPtr<LoadBalancingPolicy::Config> child_policy_;
 };
 
+// Approximate distribution of call latencies over one interval.
+// Samples are counted in log-linear buckets, with 4 sub-buckets per power
+// of two, so a reported quantile is within 25% of the true value.  This
+// keeps recording down to a single atomic increment and makes it cheap to
+// merge the distributions of several endpoints.
+class LatencyHistogram {
+ public:
+  // Buckets cover latencies up to about two hours; anything longer is
+  // counted in the last bucket.
+  static constexpr size_t kNumBuckets = 128;
+  using Counts = std::array<uint64_t, kNumBuckets>;
+
+  void Record(uint64_t micros) {
+    buckets_[BucketFor(micros)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void Reset() {
+    for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  }
+
+  // Adds the counts from this histogram to *counts.
+  void AddTo(Counts* counts) const {
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      (*counts)[i] += buckets_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  // Returns the latency in microseconds below which the given fraction of
+  // the samples in counts fall, or nullopt if counts is empty.
+  static absl::optional<uint64_t> Quantile(const Counts& counts,
+                                           double quantile) {
+    uint64_t total = 0;
+    for (uint64_t count : counts) total += count;
+    if (total == 0) return absl::nullopt;
+    const uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(std::ceil(quantile * total)));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < kNumBuckets; ++i) {
+      seen += counts[i];
+      if (seen >= rank) return BucketLowerBound(i + 1);
+    }
+    return BucketLowerBound(kNumBuckets);
+  }
+
+ private:
+  static size_t BucketFor(uint64_t micros) {
+    if (micros < 4) return micros;
+    size_t msb = 0;
+    for (uint64_t v = micros; v > 1; v >>= 1) ++msb;
+    const size_t bucket = 4 * (msb - 1) + ((micros >> (msb - 2)) & 3);
+    return std::min(bucket, kNumBuckets - 1);
+  }
+
+  static uint64_t BucketLowerBound(size_t bucket) {
+    if (bucket < 4) return bucket;
+    const size_t msb = bucket / 4 + 1;
+    return static_cast<uint64_t>(4 + bucket % 4) << (msb - 2);
+  }
+
+  std::atomic<uint64_t> buckets_[kNumBuckets] = {};
+};
+
 // xDS Cluster Impl LB policy.
 class OutlierDetectionLb : public LoadBalancingPolicy {
  public:
@@ -217,11 +286,13 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     struct Bucket {
       std::atomic<uint64_t> successes;
       std::atomic<uint64_t> failures;
+      LatencyHistogram latencies;
     };
 
     void RotateBucket() {
       backup_bucket_->successes = 0;
       backup_bucket_->failures = 0;
+      backup_bucket_->latencies.Reset();
       current_bucket_.swap(backup_bucket_);
       active_bucket_.store(current_bucket_.get());
     }
@@ -251,6 +322,15 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
 
     void AddFailureCount() { active_bucket_.load()->failures.fetch_add(1); }
 
+    void AddLatency(uint64_t micros) {
+      active_bucket_.load()->latencies.Record(micros);
+    }
+
+    // Latencies recorded during the last completed interval.
+    const LatencyHistogram& latencies() const {
+      return backup_bucket_->latencies;
+    }
+
     absl::optional<Timestamp> ejection_time() const { return ejection_time_; }
 
     void Eject(const Timestamp& time) {
@@ -309,7 +389,8 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
   class Picker : public SubchannelPicker {
    public:
     Picker(OutlierDetectionLb* outlier_detection_lb,
-           RefCountedPtr<SubchannelPicker> picker, bool counting_enabled);
+           RefCountedPtr<SubchannelPicker> picker, bool counting_enabled,
+           bool latency_tracking_enabled);
 
     PickResult Pick(PickArgs args) override;
 
@@ -317,6 +398,7 @@ class OutlierDetectionLb : public LoadBalancingPolicy {
     class SubchannelCallTracker;
     RefCountedPtr<SubchannelPicker> picker_;
     bool counting_enabled_;
+    bool latency_tracking_enabled_;
   };
 
   class Helper : public ChannelControlHelper {
@@ -432,17 +514,23 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
   SubchannelCallTracker(
       std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
           original_subchannel_call_tracker,
-      RefCountedPtr<SubchannelState> subchannel_state)
+      RefCountedPtr<SubchannelState> subchannel_state,
+      bool latency_tracking_enabled)
       : original_subchannel_call_tracker_(
             std::move(original_subchannel_call_tracker)),
-        subchannel_state_(std::move(subchannel_state)) {}
+        subchannel_state_(std::move(subchannel_state)),
+        latency_tracking_enabled_(latency_tracking_enabled) {}
 
   ~SubchannelCallTracker() override {
     subchannel_state_.reset(DEBUG_LOCATION, "SubchannelCallTracker");
   }
 
   void Start() override {
-    // This tracker does not care about started calls only finished calls.
+    // This tracker only cares about started calls when it needs to
+    // measure their latency.
+    if (latency_tracking_enabled_) {
+      start_time_ = gpr_now(GPR_CLOCK_MONOTONIC);
+    }
     // Delegate if needed.
     if (original_subchannel_call_tracker_ != nullptr) {
       original_subchannel_call_tracker_->Start();
@@ -462,6 +550,12 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
       } else {
         subchannel_state_->AddFailureCount();
       }
+      if (latency_tracking_enabled_) {
+        double elapsed_micros = gpr_timespec_to_micros(
+            gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start_time_));
+        subchannel_state_->AddLatency(
+            static_cast<uint64_t>(std::max(0.0, elapsed_micros)));
+      }
     }
   }
 
@@ -469,6 +563,8 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
   std::unique_ptr<LoadBalancingPolicy::SubchannelCallTrackerInterface>
       original_subchannel_call_tracker_;
   RefCountedPtr<SubchannelState> subchannel_state_;
+  const bool latency_tracking_enabled_;
+  gpr_timespec start_time_;
 };
 
 //
@@ -477,14 +573,18 @@ class OutlierDetectionLb::Picker::SubchannelCallTracker
 
 OutlierDetectionLb::Picker::Picker(OutlierDetectionLb* outlier_detection_lb,
                                    RefCountedPtr<SubchannelPicker> picker,
-                                   bool counting_enabled)
-    : picker_(std::move(picker)), counting_enabled_(counting_enabled) {
+                                   bool counting_enabled,
+                                   bool latency_tracking_enabled)
+    : picker_(std::move(picker)),
+      counting_enabled_(counting_enabled),
+      latency_tracking_enabled_(latency_tracking_enabled) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
     gpr_log(GPR_INFO,
             "[outlier_detection_lb %p] constructed new picker %p and counting "
-            "is %s",
+            "is %s, latency tracking is %s",
             outlier_detection_lb, this,
-            (counting_enabled ? "enabled" : "disabled"));
+            (counting_enabled ? "enabled" : "disabled"),
+            (latency_tracking_enabled ? "enabled" : "disabled"));
   }
 }
 
@@ -502,12 +602,13 @@ LoadBalancingPolicy::PickResult OutlierDetectionLb::Picker::Pick(
     auto* subchannel_wrapper =
         static_cast<SubchannelWrapper*>(complete_pick->subchannel.get());
     // Inject subchannel call tracker to record call completion as long as
-    // not both success_rate_ejection and failure_percentage_ejection are unset.
+    // at least one of the ejection algorithms is configured.
     if (counting_enabled_) {
       complete_pick->subchannel_call_tracker =
           std::make_unique<SubchannelCallTracker>(
               std::move(complete_pick->subchannel_call_tracker),
-              subchannel_wrapper->subchannel_state());
+              subchannel_wrapper->subchannel_state(),
+              latency_tracking_enabled_);
     }
     complete_pick->subchannel = subchannel_wrapper->wrapped_subchannel();
   }
@@ -668,7 +769,8 @@ absl::Status OutlierDetectionLb::UpdateLocked(UpdateArgs args) {
 void OutlierDetectionLb::MaybeUpdatePickerLocked() {
   if (picker_ != nullptr) {
     auto outlier_detection_picker =
-        MakeRefCounted<Picker>(this, picker_, config_->CountingEnabled());
+        MakeRefCounted<Picker>(this, picker_, config_->CountingEnabled(),
+                               config_->LatencyTrackingEnabled());
     if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
       gpr_log(GPR_INFO,
               "[outlier_detection_lb %p] updating connectivity: state=%s "
@@ -807,6 +909,8 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked() {
   }
   std::map<SubchannelState*, double> success_rate_ejection_candidates;
   std::map<SubchannelState*, double> failure_percentage_ejection_candidates;
+  std::map<SubchannelState*, uint64_t> latency_ejection_candidates;
+  LatencyHistogram::Counts cluster_latencies{};
   size_t ejected_host_count = 0;
   double success_rate_sum = 0;
   auto time_now = Timestamp::Now();
@@ -840,15 +944,29 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked() {
         failure_percentage_ejection_candidates[subchannel_state] = success_rate;
       }
     }
+    if (config.latency_ejection.has_value()) {
+      if (request_volume >= config.latency_ejection->request_volume) {
+        LatencyHistogram::Counts latencies{};
+        subchannel_state->latencies().AddTo(&latencies);
+        auto latency = LatencyHistogram::Quantile(
+            latencies, config.latency_ejection->percentile / 100.0);
+        if (latency.has_value()) {
+          latency_ejection_candidates[subchannel_state] = *latency;
+          subchannel_state->latencies().AddTo(&cluster_latencies);
+        }
+      }
+    }
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
     gpr_log(GPR_INFO,
             "[outlier_detection_lb %p] found %" PRIuPTR
-            " success rate candidates and %" PRIuPTR
-            " failure percentage candidates; ejected_host_count=%" PRIuPTR
+            " success rate candidates, %" PRIuPTR
+            " failure percentage candidates and %" PRIuPTR
+            " latency candidates; ejected_host_count=%" PRIuPTR
             "; success_rate_sum=%.3f",
             parent_.get(), success_rate_ejection_candidates.size(),
-            failure_percentage_ejection_candidates.size(), ejected_host_count,
+            failure_percentage_ejection_candidates.size(),
+            latency_ejection_candidates.size(), ejected_host_count,
             success_rate_sum);
   }
   // success rate algorithm
@@ -957,6 +1075,59 @@ void OutlierDetectionLb::EjectionTimer::OnTimerLocked() {
       }
     }
   }
+  // latency algorithm
+  if (!latency_ejection_candidates.empty() &&
+      latency_ejection_candidates.size() >=
+          config.latency_ejection->minimum_hosts) {
+    // calculate ejection threshold: (cluster median latency *
+    // (latency_ejection.median_factor / 1000))
+    const uint64_t median =
+        LatencyHistogram::Quantile(cluster_latencies, 0.5).value_or(0);
+    const double ejection_threshold =
+        median * (static_cast<double>(config.latency_ejection->median_factor) /
+                  1000);
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+      gpr_log(GPR_INFO,
+              "[outlier_detection_lb %p] running latency algorithm: "
+              "median=%" PRIu64 "us, ejection_threshold=%.3fus",
+              parent_.get(), median, ejection_threshold);
+    }
+    for (auto& candidate : latency_ejection_candidates) {
+      if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+        gpr_log(GPR_INFO,
+                "[outlier_detection_lb %p] checking candidate %p: "
+                "latency=%" PRIu64 "us",
+                parent_.get(), candidate.first, candidate.second);
+      }
+      // Extra check to make sure one of the other algorithms didn't already
+      // eject this backend.
+      if (candidate.first->ejection_time().has_value()) continue;
+      if (candidate.second > ejection_threshold) {
+        uint32_t random_key = absl::Uniform(bit_gen_, 1, 100);
+        double current_percent =
+            100.0 * ejected_host_count / parent_->subchannel_state_map_.size();
+        if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+          gpr_log(GPR_INFO,
+                  "[outlier_detection_lb %p] random_key=%d "
+                  "ejected_host_count=%" PRIuPTR " current_percent=%.3f",
+                  parent_.get(), random_key, ejected_host_count,
+                  current_percent);
+        }
+        if (random_key < config.latency_ejection->enforcement_percentage &&
+            (ejected_host_count == 0 ||
+             (current_percent < config.max_ejection_percent))) {
+          // Eject and record the timestamp for use when ejecting addresses in
+          // this iteration.
+          if (GRPC_TRACE_FLAG_ENABLED(grpc_outlier_detection_lb_trace)) {
+            gpr_log(GPR_INFO, "[outlier_detection_lb %p] ejecting candidate",
+                    parent_.get());
+          }
+          candidate.first->Eject(time_now);
+          ++ejected_host_count;
+        }
+      }
+    }
+  }
   // For each address in the map:
   //   If the address is not ejected and the multiplier is greater than 0,
   //   decrease the multiplier by 1. If the address is ejected, and the
@@ -1086,6 +1257,36 @@ void OutlierDetectionConfig::FailurePercentageEjection::JsonPostLoad(
   }
 }
 
+const JsonLoaderInterface* OutlierDetectionConfig::LatencyEjection::JsonLoader(
+    const JsonArgs&) {
+  static const auto* loader =
+      JsonObjectLoader<LatencyEjection>()
+          .OptionalField("percentile", &LatencyEjection::percentile)
+          .OptionalField("medianFactor", &LatencyEjection::median_factor)
+          .OptionalField("enforcementPercentage",
+                         &LatencyEjection::enforcement_percentage)
+          .OptionalField("minimumHosts", &LatencyEjection::minimum_hosts)
+          .OptionalField("requestVolume", &LatencyEjection::request_volume)
+          .Finish();
+  return loader;
+}
+
+void OutlierDetectionConfig::LatencyEjection::JsonPostLoad(
+    const Json&, const JsonArgs&, ValidationErrors* errors) {
+  if (enforcement_percentage > 100) {
+    ValidationErrors::ScopedField field(errors, ".enforcement_percentage");
+    errors->AddError("value must be <= 100");
+  }
+  if (percentile == 0 || percentile > 100) {
+    ValidationErrors::ScopedField field(errors, ".percentile");
+    errors->AddError("value must be in the range [1, 100]");
+  }
+  if (median_factor < 1000) {
+    ValidationErrors::ScopedField field(errors, ".median_factor");
+    errors->AddError("value must be >= 1000");
+  }
+}
+
 const JsonLoaderInterface* OutlierDetectionConfig::JsonLoader(const JsonArgs&) {
   static const auto* loader =
       JsonObjectLoader<OutlierDetectionConfig>()
@@ -1100,6 +1301,8 @@ const JsonLoaderInterface* OutlierDetectionConfig::JsonLoader(const JsonArgs&) {
                          &OutlierDetectionConfig::success_rate_ejection)
           .OptionalField("failurePercentageEjection",
                          &OutlierDetectionConfig::failure_percentage_ejection)
+          .OptionalField("latencyEjection",
+                         &OutlierDetectionConfig::latency_ejection)
           .Finish();
   return loader;
 }
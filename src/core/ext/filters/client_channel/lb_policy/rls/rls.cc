@@ -27,7 +27,9 @@
 #include <string.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -276,10 +278,20 @@ class RlsLb : public LoadBalancingPolicy {
 
     const std::string& target() const { return target_; }
 
-    PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+    // May be called without holding RlsLb::mu_.
+    PickResult Pick(PickArgs args) ABSL_LOCKS_EXCLUDED(&picker_mu_) {
+      MutexLock lock(&picker_mu_);
       return picker_->Pick(args);
     }
 
+    // Returns the child's current picker.  Used by RlsLb::Picker, which
+    // keeps the pickers of all children so that cache hits can pick
+    // without taking picker_mu_.
+    RefCountedPtr<SubchannelPicker> picker() ABSL_LOCKS_EXCLUDED(&picker_mu_) {
+      MutexLock lock(&picker_mu_);
+      return picker_;
+    }
+
     // Updates for the child policy are handled in two phases:
     // 1. In StartUpdate(), we parse and validate the new child policy
     //    config and store the parsed config.
@@ -313,9 +325,8 @@ class RlsLb : public LoadBalancingPolicy {
     // reports TRANSIENT_FAILURE, the function will always return
     // TRANSIENT_FAILURE state instead of the actual state of the child policy
     // until the child policy reports another READY state.
-    grpc_connectivity_state connectivity_state() const
-        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-      return connectivity_state_;
+    grpc_connectivity_state connectivity_state() const {
+      return connectivity_state_.load(std::memory_order_relaxed);
     }
 
    private:
@@ -352,16 +363,26 @@ class RlsLb : public LoadBalancingPolicy {
     OrphanablePtr<ChildPolicyHandler> child_policy_;
     RefCountedPtr<LoadBalancingPolicy::Config> pending_config_;
 
-    grpc_connectivity_state connectivity_state_ ABSL_GUARDED_BY(&RlsLb::mu_) =
-        GRPC_CHANNEL_IDLE;
+    // Written while holding RlsLb::mu_, but read by the picker without it.
+    std::atomic<grpc_connectivity_state> connectivity_state_{
+        GRPC_CHANNEL_IDLE};
+    // picker_ is replaced from the WorkSerializer while the picker reads
+    // it, so it is guarded by picker_mu_ rather than RlsLb::mu_.  Picks
+    // themselves are serialized by the channel, which never calls the RLS
+    // picker concurrently.
+    Mutex picker_mu_;
     RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker_
-        ABSL_GUARDED_BY(&RlsLb::mu_);
+        ABSL_GUARDED_BY(&picker_mu_);
   };
 
   // A picker that uses the cache and the request map in the LB policy
   // (synchronized via a mutex) to determine how to route requests.
   class Picker : public LoadBalancingPolicy::SubchannelPicker {
    public:
+    // The pickers of the child policies, by target.
+    using ChildPickerMap =
+        std::map<std::string, RefCountedPtr<SubchannelPicker>, std::less<>>;
+
     explicit Picker(RefCountedPtr<RlsLb> lb_policy);
     ~Picker() override;
 
@@ -371,10 +392,27 @@ class RlsLb : public LoadBalancingPolicy {
     RefCountedPtr<RlsLb> lb_policy_;
     RefCountedPtr<RlsLbConfig> config_;
     RefCountedPtr<ChildPolicyWrapper> default_child_policy_;
+    // Taken when the picker is created.  A child that reports a new
+    // picker causes a new RLS picker to be created, so these are never
+    // older than the RLS picker itself.
+    ChildPickerMap child_pickers_;
   };
 
-  // An LRU cache with adjustable size.
+  // A cache with adjustable size.
+  //
+  // Entries are split across shards, each with its own mutex, so that
+  // the picker can serve hits on entries with fresh data while holding
+  // only the shard mutex rather than RlsLb::mu_ (see PickIfFresh()).
+  // Adding or removing entries requires holding both RlsLb::mu_ and the
+  // shard mutex, so either one is sufficient for lookups.
+  //
+  // Eviction uses the CLOCK approximation of LRU: using an entry only
+  // sets a flag on it, and the eviction sweep gives flagged entries a
+  // second chance instead of reordering a list on every hit.
   class Cache {
+   private:
+    struct Shard;
+
    public:
     using Iterator = std::list<RequestKey>::iterator;
 
@@ -401,14 +439,16 @@ class RlsLb : public LoadBalancingPolicy {
         return backoff_expiration_time_;
       }
       Timestamp data_expiration_time() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+          ABSL_LOCKS_EXCLUDED(&shard_->mu) {
+        MutexLock lock(&shard_->mu);
         return data_expiration_time_;
       }
-      const std::string& header_data() const
-          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      std::string header_data() const ABSL_LOCKS_EXCLUDED(&shard_->mu) {
+        MutexLock lock(&shard_->mu);
         return header_data_;
       }
-      Timestamp stale_time() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+      Timestamp stale_time() const ABSL_LOCKS_EXCLUDED(&shard_->mu) {
+        MutexLock lock(&shard_->mu);
         return stale_time_;
       }
       Timestamp min_expiration_time() const
@@ -425,7 +465,17 @@ class RlsLb : public LoadBalancingPolicy {
       size_t Size() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
       // Pick subchannel for request based on the entry's state.
-      PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      PickResult Pick(PickArgs args) ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_)
+          ABSL_LOCKS_EXCLUDED(&shard_->mu);
+
+      // Called by Cache::PickIfFresh() while holding the shard mutex, but
+      // not RlsLb::mu_.  If the entry has data that is neither stale nor
+      // expired, adds the header data to the request and returns the
+      // picker of the target to delegate to.  Otherwise, or if that
+      // target is newer than child_pickers, returns null.
+      SubchannelPicker* FreshChildPicker(
+          Timestamp now, PickArgs args,
+          const Picker::ChildPickerMap& child_pickers);
 
       // If the cache entry is in backoff state, resets the backoff and, if
       // applicable, its backoff timer. The method does not update the LB
@@ -446,8 +496,15 @@ class RlsLb : public LoadBalancingPolicy {
           ResponseInfo response, std::unique_ptr<BackOff> backoff_state)
           ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
-      // Moves entry to the end of the LRU list.
-      void MarkUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+      // Marks the entry as recently used, so that the next eviction sweep
+      // will skip it.  May be called without holding RlsLb::mu_.
+      void MarkUsed() { used_.store(true, std::memory_order_relaxed); }
+
+      // Returns true if the entry was used since the last call, and
+      // clears the flag.
+      bool TestAndClearUsed() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
+        return used_.exchange(false, std::memory_order_relaxed);
+      }
 
      private:
       class BackoffTimer : public InternallyRefCounted<BackoffTimer> {
@@ -469,8 +526,10 @@ class RlsLb : public LoadBalancingPolicy {
       };
 
       RefCountedPtr<RlsLb> lb_policy_;
+      Shard* const shard_;
 
       bool is_shutdown_ ABSL_GUARDED_BY(&RlsLb::mu_) = false;
+      std::atomic<bool> used_{false};
 
       // Backoff states
       absl::Status status_ ABSL_GUARDED_BY(&RlsLb::mu_);
@@ -481,13 +540,26 @@ class RlsLb : public LoadBalancingPolicy {
           Timestamp::InfPast();
       OrphanablePtr<BackoffTimer> backoff_timer_;
 
+      // Returns the target to delegate picks to: the first one that is
+      // not in TRANSIENT_FAILURE, or else the last one.
+      ChildPolicyWrapper* SelectChildLocked()
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&shard_->mu);
+
+      // Adds header_data_ to the request's metadata.
+      void AddHeaderDataLocked(PickArgs args)
+          ABSL_EXCLUSIVE_LOCKS_REQUIRED(&shard_->mu);
+
       // RLS response states
+      // These are read by PickIfFresh() while holding only shard_->mu.
+      // They are only written while also holding RlsLb::mu_, so that
+      // child_policy_wrappers_ does not change while RlsLb::mu_ is held.
       std::vector<RefCountedPtr<ChildPolicyWrapper>> child_policy_wrappers_
-          ABSL_GUARDED_BY(&RlsLb::mu_);
-      std::string header_data_ ABSL_GUARDED_BY(&RlsLb::mu_);
-      Timestamp data_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_) =
+          ABSL_GUARDED_BY(&shard_->mu);
+      std::string header_data_ ABSL_GUARDED_BY(&shard_->mu);
+      Timestamp data_expiration_time_ ABSL_GUARDED_BY(&shard_->mu) =
+          Timestamp::InfPast();
+      Timestamp stale_time_ ABSL_GUARDED_BY(&shard_->mu) =
           Timestamp::InfPast();
-      Timestamp stale_time_ ABSL_GUARDED_BY(&RlsLb::mu_) = Timestamp::InfPast();
 
       Timestamp min_expiration_time_ ABSL_GUARDED_BY(&RlsLb::mu_);
       Cache::Iterator lru_iterator_ ABSL_GUARDED_BY(&RlsLb::mu_);
@@ -496,19 +568,28 @@ class RlsLb : public LoadBalancingPolicy {
     explicit Cache(RlsLb* lb_policy);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
-    // not found, nullptr is returned. Otherwise, the entry is considered
-    // recently used and its order in the LRU list of the cache is updated.
+    // not found, nullptr is returned. Otherwise, the entry is marked as
+    // recently used.
     Entry* Find(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
     // Finds an entry from the cache that corresponds to a key. If an entry is
     // not found, an entry is created, inserted in the cache, and returned to
     // the caller. Otherwise, the entry found is returned to the caller. The
-    // entry returned to the user is considered recently used and its order in
-    // the LRU list of the cache is updated.
+    // entry returned to the user is marked as recently used.
     Entry* FindOrInsert(const RequestKey& key)
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
+    // Called by the picker without holding RlsLb::mu_.  If there is an
+    // entry for key whose data is neither stale nor expired, marks the
+    // entry as used and returns the result of picking from it, using
+    // child_pickers.  Otherwise, returns nullopt, and the caller needs to
+    // take the locked path, which may need to start an RLS request.
+    absl::optional<PickResult> PickIfFresh(
+        const RequestKey& key, Timestamp now, PickArgs args,
+        const Picker::ChildPickerMap& child_pickers)
+        ABSL_LOCKS_EXCLUDED(&RlsLb::mu_);
+
     // Resizes the cache. If the new cache size is greater than the current size
     // of the cache, do nothing. Otherwise, evict the oldest entries that
     // exceed the new size limit of the cache.
@@ -521,6 +602,27 @@ class RlsLb : public LoadBalancingPolicy {
     void Shutdown() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
 
    private:
+    using Map = std::unordered_map<RequestKey, OrphanablePtr<Entry>,
+                                   absl::Hash<RequestKey>>;
+
+    static constexpr size_t kNumShards = 16;
+
+    struct Shard {
+      Mutex mu;
+      // Not annotated, since either mu or RlsLb::mu_ is sufficient for
+      // reading, but both are needed for writing.
+      Map map;
+    };
+
+    Shard& ShardForKey(const RequestKey& key) {
+      return shards_[absl::Hash<RequestKey>()(key) % kNumShards];
+    }
+
+    // Removes the entry at it from shard.  The entry is orphaned after
+    // the shard mutex has been released.
+    void RemoveEntry(Shard* shard, Map::iterator it)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_);
+
     static void OnCleanupTimer(void* arg, grpc_error_handle error);
 
     // Returns the entry size for a given key.
@@ -536,9 +638,10 @@ class RlsLb : public LoadBalancingPolicy {
     size_t size_limit_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
     size_t size_ ABSL_GUARDED_BY(&RlsLb::mu_) = 0;
 
+    // All keys in the cache, in the order in which the CLOCK sweep visits
+    // them.
     std::list<RequestKey> lru_list_ ABSL_GUARDED_BY(&RlsLb::mu_);
-    std::unordered_map<RequestKey, OrphanablePtr<Entry>, absl::Hash<RequestKey>>
-        map_ ABSL_GUARDED_BY(&RlsLb::mu_);
+    Shard shards_[kNumShards];
     grpc_timer cleanup_timer_;
     grpc_closure timer_callback_;
   };
@@ -699,7 +802,10 @@ class RlsLb : public LoadBalancingPolicy {
   Mutex mu_;
   bool is_shutdown_ ABSL_GUARDED_BY(mu_) = false;
   bool update_in_progress_ = false;
-  Cache cache_ ABSL_GUARDED_BY(mu_);
+  // Not annotated, since the picker accesses parts of the cache that are
+  // synchronized by the cache's shard mutexes.  The cache's methods are
+  // annotated instead.
+  Cache cache_;
   // Maps an RLS request key to an RlsRequest object that represents a pending
   // RLS request.
   std::unordered_map<RequestKey, OrphanablePtr<RlsRequest>,
@@ -746,6 +852,7 @@ void RlsLb::ChildPolicyWrapper::Orphan() {
                                      lb_policy_->interested_parties());
     child_policy_.reset();
   }
+  MutexLock lock(&picker_mu_);
   picker_.reset();
 }
 
@@ -811,8 +918,11 @@ void RlsLb::ChildPolicyWrapper::StartUpdate() {
               config.status().ToString().c_str());
     }
     pending_config_.reset();
-    picker_ = MakeRefCounted<TransientFailurePicker>(
-        absl::UnavailableError(config.status().message()));
+    {
+      MutexLock lock(&picker_mu_);
+      picker_ = MakeRefCounted<TransientFailurePicker>(
+          absl::UnavailableError(config.status().message()));
+    }
     child_policy_.reset();
   } else {
     pending_config_ = std::move(*config);
@@ -888,13 +998,14 @@ void RlsLb::ChildPolicyWrapper::ChildPolicyHelper::UpdateState(
   {
     MutexLock lock(&wrapper_->lb_policy_->mu_);
     if (wrapper_->is_shutdown_) return;
-    if (wrapper_->connectivity_state_ == GRPC_CHANNEL_TRANSIENT_FAILURE &&
+    if (wrapper_->connectivity_state() == GRPC_CHANNEL_TRANSIENT_FAILURE &&
         state != GRPC_CHANNEL_READY) {
       return;
     }
-    wrapper_->connectivity_state_ = state;
+    wrapper_->connectivity_state_.store(state, std::memory_order_relaxed);
     GPR_DEBUG_ASSERT(picker != nullptr);
     if (picker != nullptr) {
+      MutexLock picker_lock(&wrapper_->picker_mu_);
       wrapper_->picker_ = std::move(picker);
     }
   }
@@ -1003,6 +1114,10 @@ RlsLb::Picker::Picker(RefCountedPtr<RlsLb> lb_policy)
     default_child_policy_ =
         lb_policy_->default_child_policy_->Ref(DEBUG_LOCATION, "Picker");
   }
+  for (const auto& p : lb_policy_->child_policy_map_) {
+    auto picker = p.second->picker();
+    if (picker != nullptr) child_pickers_.emplace(p.first, std::move(picker));
+  }
 }
 
 RlsLb::Picker::~Picker() {
@@ -1028,6 +1143,11 @@ LoadBalancingPolicy::PickResult RlsLb::Picker::Pick(PickArgs args) {
             lb_policy_.get(), this, key.ToString().c_str());
   }
   Timestamp now = Timestamp::Now();
+  // Fast path: if the cache has fresh data for this key, we don't need
+  // to start an RLS request, so there's no need to acquire the lock.
+  absl::optional<PickResult> fresh_result =
+      lb_policy_->cache_.PickIfFresh(key, now, args, child_pickers_);
+  if (fresh_result.has_value()) return std::move(*fresh_result);
   MutexLock lock(&lb_policy_->mu_);
   if (lb_policy_->is_shutdown_) {
     return PickResult::Fail(
@@ -1176,6 +1296,7 @@ RlsLb::Cache::Entry::Entry(RefCountedPtr<RlsLb> lb_policy,
     : InternallyRefCounted<Entry>(
           GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace) ? "CacheEntry" : nullptr),
       lb_policy_(std::move(lb_policy)),
+      shard_(&lb_policy_->cache_.ShardForKey(key)),
       backoff_state_(MakeCacheEntryBackoff()),
       min_expiration_time_(Timestamp::Now() + kMinExpirationTime),
       lru_iterator_(lb_policy_->cache_.lru_list_.insert(
@@ -1194,7 +1315,14 @@ void RlsLb::Cache::Entry::Orphan() {
     backoff_timer_.reset();
     lb_policy_->UpdatePickerAsync();
   }
-  child_policy_wrappers_.clear();
+  // The targets are swapped out under the shard mutex, since pickers may
+  // still be reading them, and destroyed without holding it.
+  std::vector<RefCountedPtr<ChildPolicyWrapper>> child_policy_wrappers;
+  {
+    MutexLock lock(&shard_->mu);
+    child_policy_wrappers_.swap(child_policy_wrappers);
+  }
+  child_policy_wrappers.clear();
   Unref(DEBUG_LOCATION, "Orphan");
 }
 
@@ -1204,7 +1332,7 @@ size_t RlsLb::Cache::Entry::Size() const {
   return lb_policy_->cache_.EntrySizeForKey(*lru_iterator_);
 }
 
-LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
+RlsLb::ChildPolicyWrapper* RlsLb::Cache::Entry::SelectChildLocked() {
   size_t i = 0;
   ChildPolicyWrapper* child_policy_wrapper = nullptr;
   // Skip targets before the last one that are in state TRANSIENT_FAILURE.
@@ -1215,11 +1343,10 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
         i < child_policy_wrappers_.size() - 1) {
       if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
         gpr_log(GPR_INFO,
-                "[rlslb %p] cache entry=%p %s: target %s (%" PRIuPTR
+                "[rlslb %p] cache entry=%p: target %s (%" PRIuPTR
                 " of %" PRIuPTR ") in state TRANSIENT_FAILURE; skipping",
-                lb_policy_.get(), this, lru_iterator_->ToString().c_str(),
-                child_policy_wrapper->target().c_str(), i,
-                child_policy_wrappers_.size());
+                lb_policy_.get(), this, child_policy_wrapper->target().c_str(),
+                i, child_policy_wrappers_.size());
       }
       continue;
     }
@@ -1229,14 +1356,16 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
   // the list, so delegate.
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO,
-            "[rlslb %p] cache entry=%p %s: target %s (%" PRIuPTR " of %" PRIuPTR
+            "[rlslb %p] cache entry=%p: target %s (%" PRIuPTR " of %" PRIuPTR
             ") in state %s; delegating",
-            lb_policy_.get(), this, lru_iterator_->ToString().c_str(),
-            child_policy_wrapper->target().c_str(), i,
+            lb_policy_.get(), this, child_policy_wrapper->target().c_str(), i,
             child_policy_wrappers_.size(),
             ConnectivityStateName(child_policy_wrapper->connectivity_state()));
   }
-  // Add header data.
+  return child_policy_wrapper;
+}
+
+void RlsLb::Cache::Entry::AddHeaderDataLocked(PickArgs args) {
   // Note that even if the target we're using is in TRANSIENT_FAILURE,
   // the pick might still succeed (e.g., if the child is ring_hash), so
   // we need to pass the right header info down in all cases.
@@ -1246,9 +1375,32 @@ LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
     strcpy(copied_header_data, header_data_.c_str());
     args.initial_metadata->Add(kRlsHeaderKey, copied_header_data);
   }
+}
+
+LoadBalancingPolicy::PickResult RlsLb::Cache::Entry::Pick(PickArgs args) {
+  ChildPolicyWrapper* child_policy_wrapper;
+  {
+    MutexLock lock(&shard_->mu);
+    child_policy_wrapper = SelectChildLocked();
+    AddHeaderDataLocked(args);
+  }
+  // child_policy_wrappers_ can't change while we hold RlsLb::mu_, so
+  // child_policy_wrapper is still alive.
   return child_policy_wrapper->Pick(args);
 }
 
+LoadBalancingPolicy::SubchannelPicker* RlsLb::Cache::Entry::FreshChildPicker(
+    Timestamp now, PickArgs args, const Picker::ChildPickerMap& child_pickers) {
+  // The caller found this entry in shard_->map while holding shard_->mu.
+  shard_->mu.AssertHeld();
+  if (stale_time_ < now || data_expiration_time_ < now) return nullptr;
+  ChildPolicyWrapper* child_policy_wrapper = SelectChildLocked();
+  auto it = child_pickers.find(child_policy_wrapper->target());
+  if (it == child_pickers.end()) return nullptr;
+  AddHeaderDataLocked(args);
+  return it->second.get();
+}
+
 void RlsLb::Cache::Entry::ResetBackoff() {
   backoff_time_ = Timestamp::InfPast();
   backoff_timer_.reset();
@@ -1256,7 +1408,7 @@ void RlsLb::Cache::Entry::ResetBackoff() {
 
 bool RlsLb::Cache::Entry::ShouldRemove() const {
   Timestamp now = Timestamp::Now();
-  return data_expiration_time_ < now && backoff_expiration_time_ < now;
+  return data_expiration_time() < now && backoff_expiration_time_ < now;
 }
 
 bool RlsLb::Cache::Entry::CanEvict() const {
@@ -1264,17 +1416,9 @@ bool RlsLb::Cache::Entry::CanEvict() const {
   return min_expiration_time_ < now;
 }
 
-void RlsLb::Cache::Entry::MarkUsed() {
-  auto& lru_list = lb_policy_->cache_.lru_list_;
-  auto new_it = lru_list.insert(lru_list.end(), *lru_iterator_);
-  lru_list.erase(lru_iterator_);
-  lru_iterator_ = new_it;
-}
-
 std::vector<RlsLb::ChildPolicyWrapper*>
 RlsLb::Cache::Entry::OnRlsResponseLocked(
     ResponseInfo response, std::unique_ptr<BackOff> backoff_state) {
-  // Move the entry to the end of the LRU list.
   MarkUsed();
   // If the request failed, store the failed status and update the
   // backoff state.
@@ -1294,62 +1438,77 @@ RlsLb::Cache::Entry::OnRlsResponseLocked(
     return {};
   }
   // Request succeeded, so store the result.
-  header_data_ = std::move(response.header_data);
   Timestamp now = Timestamp::Now();
-  data_expiration_time_ = now + lb_policy_->config_->max_age();
-  stale_time_ = now + lb_policy_->config_->stale_age();
   status_ = absl::OkStatus();
   backoff_state_.reset();
   backoff_time_ = Timestamp::InfPast();
   backoff_expiration_time_ = Timestamp::InfPast();
-  // Check if we need to update this list of targets.
-  bool targets_changed = [&]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(&RlsLb::mu_) {
-    if (child_policy_wrappers_.size() != response.targets.size()) return true;
-    for (size_t i = 0; i < response.targets.size(); ++i) {
-      if (child_policy_wrappers_[i]->target() != response.targets[i]) {
-        return true;
+  // Check if we need to update this list of targets.  The old targets
+  // stay alive until child_policy_wrappers_ is replaced below, which can
+  // only happen while holding RlsLb::mu_.
+  bool targets_changed = false;
+  std::set<absl::string_view> old_targets;
+  {
+    MutexLock lock(&shard_->mu);
+    if (child_policy_wrappers_.size() != response.targets.size()) {
+      targets_changed = true;
+    } else {
+      for (size_t i = 0; i < response.targets.size(); ++i) {
+        if (child_policy_wrappers_[i]->target() != response.targets[i]) {
+          targets_changed = true;
+          break;
+        }
+      }
+    }
+    if (targets_changed) {
+      for (RefCountedPtr<ChildPolicyWrapper>& child_policy_wrapper :
+           child_policy_wrappers_) {
+        old_targets.emplace(child_policy_wrapper->target());
       }
     }
-    return false;
-  }();
-  if (!targets_changed) {
-    // Targets didn't change, so we're not updating the list of child
-    // policies.  Return a new picker so that any queued requests can be
-    // re-processed.
-    lb_policy_->UpdatePickerAsync();
-    return {};
-  }
-  // Target list changed, so update it.
-  std::set<absl::string_view> old_targets;
-  for (RefCountedPtr<ChildPolicyWrapper>& child_policy_wrapper :
-       child_policy_wrappers_) {
-    old_targets.emplace(child_policy_wrapper->target());
   }
-  bool update_picker = false;
+  // If targets didn't change, we're not updating the list of child
+  // policies, but we still return a new picker so that any queued
+  // requests can be re-processed.
+  bool update_picker = !targets_changed;
   std::vector<ChildPolicyWrapper*> child_policies_to_finish_update;
   std::vector<RefCountedPtr<ChildPolicyWrapper>> new_child_policy_wrappers;
-  new_child_policy_wrappers.reserve(response.targets.size());
-  for (std::string& target : response.targets) {
-    auto it = lb_policy_->child_policy_map_.find(target);
-    if (it == lb_policy_->child_policy_map_.end()) {
-      auto new_child = MakeRefCounted<ChildPolicyWrapper>(
-          lb_policy_->Ref(DEBUG_LOCATION, "ChildPolicyWrapper"), target);
-      new_child->StartUpdate();
-      child_policies_to_finish_update.push_back(new_child.get());
-      new_child_policy_wrappers.emplace_back(std::move(new_child));
-    } else {
-      new_child_policy_wrappers.emplace_back(
-          it->second->Ref(DEBUG_LOCATION, "CacheEntry"));
-      // If the target already existed but was not previously used for
-      // this key, then we'll need to update the picker, since we
-      // didn't actually create a new child policy, which would have
-      // triggered an RLS picker update when it returned its first picker.
-      if (old_targets.find(target) == old_targets.end()) {
-        update_picker = true;
+  if (targets_changed) {
+    // Target list changed, so update it.
+    new_child_policy_wrappers.reserve(response.targets.size());
+    for (std::string& target : response.targets) {
+      auto it = lb_policy_->child_policy_map_.find(target);
+      if (it == lb_policy_->child_policy_map_.end()) {
+        auto new_child = MakeRefCounted<ChildPolicyWrapper>(
+            lb_policy_->Ref(DEBUG_LOCATION, "ChildPolicyWrapper"), target);
+        new_child->StartUpdate();
+        child_policies_to_finish_update.push_back(new_child.get());
+        new_child_policy_wrappers.emplace_back(std::move(new_child));
+      } else {
+        new_child_policy_wrappers.emplace_back(
+            it->second->Ref(DEBUG_LOCATION, "CacheEntry"));
+        // If the target already existed but was not previously used for
+        // this key, then we'll need to update the picker, since we
+        // didn't actually create a new child policy, which would have
+        // triggered an RLS picker update when it returned its first picker.
+        if (old_targets.find(target) == old_targets.end()) {
+          update_picker = true;
+        }
       }
     }
   }
-  child_policy_wrappers_ = std::move(new_child_policy_wrappers);
+  {
+    // Publish the new data to PickIfFresh() all at once.
+    MutexLock lock(&shard_->mu);
+    header_data_ = std::move(response.header_data);
+    data_expiration_time_ = now + lb_policy_->config_->max_age();
+    stale_time_ = now + lb_policy_->config_->stale_age();
+    if (targets_changed) {
+      child_policy_wrappers_.swap(new_child_policy_wrappers);
+    }
+  }
+  // Any previous targets are now in new_child_policy_wrappers, which is
+  // destroyed without holding the shard mutex.
   if (update_picker) {
     lb_policy_->UpdatePickerAsync();
   }
@@ -1369,21 +1528,26 @@ RlsLb::Cache::Cache(RlsLb* lb_policy) : lb_policy_(lb_policy) {
 }
 
 RlsLb::Cache::Entry* RlsLb::Cache::Find(const RequestKey& key) {
-  auto it = map_.find(key);
-  if (it == map_.end()) return nullptr;
+  Shard& shard = ShardForKey(key);
+  auto it = shard.map.find(key);
+  if (it == shard.map.end()) return nullptr;
   it->second->MarkUsed();
   return it->second.get();
 }
 
 RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
-  auto it = map_.find(key);
+  Shard& shard = ShardForKey(key);
+  auto it = shard.map.find(key);
   // If not found, create new entry.
-  if (it == map_.end()) {
+  if (it == shard.map.end()) {
     size_t entry_size = EntrySizeForKey(key);
     MaybeShrinkSize(size_limit_ - std::min(size_limit_, entry_size));
     Entry* entry =
         new Entry(lb_policy_->Ref(DEBUG_LOCATION, "CacheEntry"), key);
-    map_.emplace(key, OrphanablePtr<Entry>(entry));
+    {
+      MutexLock lock(&shard.mu);
+      shard.map.emplace(key, OrphanablePtr<Entry>(entry));
+    }
     size_ += entry_size;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] key=%s: cache entry added, entry=%p",
@@ -1400,6 +1564,38 @@ RlsLb::Cache::Entry* RlsLb::Cache::FindOrInsert(const RequestKey& key) {
   return it->second.get();
 }
 
+absl::optional<LoadBalancingPolicy::PickResult> RlsLb::Cache::PickIfFresh(
+    const RequestKey& key, Timestamp now, PickArgs args,
+    const Picker::ChildPickerMap& child_pickers) {
+  SubchannelPicker* child_picker;
+  {
+    Shard& shard = ShardForKey(key);
+    MutexLock lock(&shard.mu);
+    auto it = shard.map.find(key);
+    if (it == shard.map.end()) return absl::nullopt;
+    Entry* entry = it->second.get();
+    child_picker = entry->FreshChildPicker(now, args, child_pickers);
+    if (child_picker == nullptr) return absl::nullopt;
+    entry->MarkUsed();
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
+      gpr_log(GPR_INFO, "[rlslb %p] key=%s: using fresh cache entry %p",
+              lb_policy_, key.ToString().c_str(), entry);
+    }
+  }
+  // child_pickers holds a ref to child_picker.
+  return child_picker->Pick(args);
+}
+
+void RlsLb::Cache::RemoveEntry(Shard* shard, Map::iterator it) {
+  OrphanablePtr<Entry> entry;
+  {
+    MutexLock lock(&shard->mu);
+    entry = std::move(it->second);
+    shard->map.erase(it);
+  }
+  // The entry is orphaned here, after the shard mutex has been released.
+}
+
 void RlsLb::Cache::Resize(size_t bytes) {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO, "[rlslb %p] resizing cache to %" PRIuPTR " bytes",
@@ -1410,14 +1606,22 @@ void RlsLb::Cache::Resize(size_t bytes) {
 }
 
 void RlsLb::Cache::ResetAllBackoff() {
-  for (auto& p : map_) {
-    p.second->ResetBackoff();
+  for (Shard& shard : shards_) {
+    for (auto& p : shard.map) {
+      p.second->ResetBackoff();
+    }
   }
   lb_policy_->UpdatePickerAsync();
 }
 
 void RlsLb::Cache::Shutdown() {
-  map_.clear();
+  for (Shard& shard : shards_) {
+    Map map;
+    {
+      MutexLock lock(&shard.mu);
+      map.swap(shard.map);
+    }
+  }
   lru_list_.clear();
   grpc_timer_cancel(&cleanup_timer_);
 }
@@ -1434,13 +1638,15 @@ void RlsLb::Cache::OnCleanupTimer(void* arg, grpc_error_handle error) {
         if (error == absl::CancelledError()) return;
         MutexLock lock(&lb_policy->mu_);
         if (lb_policy->is_shutdown_) return;
-        for (auto it = cache->map_.begin(); it != cache->map_.end();) {
-          if (GPR_UNLIKELY(it->second->ShouldRemove() &&
-                           it->second->CanEvict())) {
-            cache->size_ -= it->second->Size();
-            it = cache->map_.erase(it);
-          } else {
-            ++it;
+        for (Shard& shard : cache->shards_) {
+          for (auto it = shard.map.begin(); it != shard.map.end();) {
+            if (GPR_UNLIKELY(it->second->ShouldRemove() &&
+                             it->second->CanEvict())) {
+              cache->size_ -= it->second->Size();
+              cache->RemoveEntry(&shard, it++);
+            } else {
+              ++it;
+            }
           }
         }
         Timestamp now = Timestamp::Now();
@@ -1458,18 +1664,31 @@ size_t RlsLb::Cache::EntrySizeForKey(const RequestKey& key) {
 }
 
 void RlsLb::Cache::MaybeShrinkSize(size_t bytes) {
+  // The sweep starts at the front of lru_list_.  Entries that have been
+  // used since the sweep last reached them are moved to the back instead
+  // of being evicted.  Each entry gets at most one second chance per call,
+  // so this terminates even if every entry is in use.
+  size_t second_chances = lru_list_.size();
   while (size_ > bytes) {
     auto lru_it = lru_list_.begin();
     if (GPR_UNLIKELY(lru_it == lru_list_.end())) break;
-    auto map_it = map_.find(*lru_it);
-    GPR_ASSERT(map_it != map_.end());
+    Shard& shard = ShardForKey(*lru_it);
+    auto map_it = shard.map.find(*lru_it);
+    GPR_ASSERT(map_it != shard.map.end());
+    if (second_chances > 0 && map_it->second->TestAndClearUsed()) {
+      --second_chances;
+      // splice() keeps lru_it, and therefore the entry's lru_iterator_,
+      // valid.
+      lru_list_.splice(lru_list_.end(), lru_list_, lru_it);
+      continue;
+    }
     if (!map_it->second->CanEvict()) break;
     if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
       gpr_log(GPR_INFO, "[rlslb %p] LRU eviction: removing entry %p %s",
               lb_policy_, map_it->second.get(), lru_it->ToString().c_str());
     }
     size_ -= map_it->second->Size();
-    map_.erase(map_it);
+    RemoveEntry(&shard, map_it);
   }
   if (GRPC_TRACE_FLAG_ENABLED(grpc_lb_rls_trace)) {
     gpr_log(GPR_INFO,
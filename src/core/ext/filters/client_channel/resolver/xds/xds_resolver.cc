@@ -339,6 +339,7 @@ class XdsResolver : public Resolver {
 
     RefCountedPtr<XdsResolver> resolver_;
     RouteTable route_table_;
+    std::unique_ptr<XdsRouting::RouteIndex> route_index_;
     std::map<absl::string_view, RefCountedPtr<ClusterState>> clusters_;
     std::vector<const grpc_channel_filter*> filters_;
   };
@@ -512,6 +513,8 @@ XdsResolver::XdsConfigSelector::XdsConfigSelector(
       if (!status->ok()) return;
     }
   }
+  route_index_ = std::make_unique<XdsRouting::RouteIndex>(
+      RouteListIterator(&route_table_));
   // Populate filter list.
   const auto& http_filter_registry =
       static_cast<const GrpcXdsBootstrap&>(resolver_->xds_client_->bootstrap())
@@ -657,8 +660,8 @@ absl::optional<uint64_t> HeaderHashHelper(
 absl::StatusOr<ConfigSelector::CallConfig>
 XdsResolver::XdsConfigSelector::GetCallConfig(GetCallConfigArgs args) {
   auto route_index = XdsRouting::GetRouteForRequest(
-      RouteListIterator(&route_table_), StringViewFromSlice(*args.path),
-      args.initial_metadata);
+      RouteListIterator(&route_table_), *route_index_,
+      StringViewFromSlice(*args.path), args.initial_metadata);
   if (!route_index.has_value()) {
     return absl::UnavailableError(
         "No matching route found in xDS route config");
@@ -18,10 +18,13 @@
 
 #include <inttypes.h>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
 
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
 #include "absl/meta/type_traits.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_cat.h"
@@ -29,6 +32,9 @@
 #include "absl/types/optional.h"
 
 #include <grpc/compression.h>
+#include <grpc/event_engine/event_engine.h>
+#include <grpc/event_engine/memory_allocator.h>
+#include <grpc/event_engine/memory_request.h>
 #include <grpc/impl/codegen/grpc_types.h>
 #include <grpc/impl/compression_types.h>
 #include <grpc/support/log.h>
@@ -40,12 +46,18 @@
 #include "src/core/lib/channel/promise_based_filter.h"
 #include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/compression/stream_compress.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/event_engine/default_event_engine.h"  // IWYU pragma: keep
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/promise/activity.h"
 #include "src/core/lib/promise/context.h"
 #include "src/core/lib/promise/detail/promise_like.h"
 #include "src/core/lib/promise/latch.h"
 #include "src/core/lib/promise/map_pipe.h"
 #include "src/core/lib/promise/pipe.h"
+#include "src/core/lib/promise/poll.h"
 #include "src/core/lib/promise/promise.h"
 #include "src/core/lib/promise/seq.h"
 #include "src/core/lib/promise/try_concurrently.h"
@@ -58,6 +70,100 @@
 
 namespace grpc_core {
 
+namespace {
+
+using ::grpc_event_engine::experimental::EventEngine;
+using ::grpc_event_engine::experimental::MemoryAllocator;
+using ::grpc_event_engine::experimental::MemoryRequest;
+
+// Compressing a message this big takes a few milliseconds.
+constexpr int kDefaultOffloadThreshold = 256 * 1024;
+
+// Promise for the result of compressing or decompressing one message, which
+// is either available right away or computed on the EventEngine.
+template <typename R>
+class MaybeOffloaded {
+ public:
+  // The work was done inline.
+  explicit MaybeOffloaded(R result) : result_(std::move(result)) {}
+  // Runs fn on event_engine, charging memory_bytes to the call's allocator
+  // until it has finished.
+  MaybeOffloaded(EventEngine* event_engine, size_t memory_bytes,
+                 absl::AnyInvocable<R()> fn)
+      : job_(std::make_shared<Job>(std::move(fn), memory_bytes)) {
+    event_engine->Run([job = job_]() { job->Run(); });
+  }
+  ~MaybeOffloaded() {
+    if (job_ != nullptr) job_->Abandon();
+  }
+
+  MaybeOffloaded(const MaybeOffloaded&) = delete;
+  MaybeOffloaded& operator=(const MaybeOffloaded&) = delete;
+  MaybeOffloaded(MaybeOffloaded&& other) noexcept = default;
+  MaybeOffloaded& operator=(MaybeOffloaded&& other) = delete;
+
+  Poll<R> operator()() {
+    if (job_ == nullptr) return std::move(*result_);
+    auto result = job_->TakeResult();
+    if (!result.has_value()) return Pending{};
+    job_.reset();
+    return std::move(*result);
+  }
+
+ private:
+  class Job {
+   public:
+    Job(absl::AnyInvocable<R()> fn, size_t memory_bytes)
+        : fn_(std::move(fn)),
+          // The job holds the call (and so its arena) alive until it is done.
+          waker_(Activity::current()->MakeOwningWaker()),
+          reservation_(GetContext<Arena>()->memory_allocator()->MakeReservation(
+              MemoryRequest(std::min(memory_bytes,
+                                     MemoryRequest::max_allowed_size())))) {}
+
+    void Run() {
+      ApplicationCallbackExecCtx callback_exec_ctx;
+      ExecCtx exec_ctx;
+      absl::optional<R> result(fn_());
+      fn_ = nullptr;
+      {
+        MutexLock lock(&mu_);
+        if (!abandoned_) result_.swap(result);
+      }
+      // Anything owned by the call must be gone before the waker lets it go.
+      result.reset();
+      reservation_ = MemoryAllocator::Reservation();
+      auto waker = std::move(waker_);
+      waker.Wakeup();
+    }
+
+    absl::optional<R> TakeResult() {
+      MutexLock lock(&mu_);
+      return std::exchange(result_, absl::nullopt);
+    }
+
+    void Abandon() {
+      absl::optional<R> result;
+      MutexLock lock(&mu_);
+      abandoned_ = true;
+      result_.swap(result);
+    }
+
+   private:
+    absl::AnyInvocable<R()> fn_;
+    Waker waker_;
+    MemoryAllocator::Reservation reservation_;
+    Mutex mu_;
+    absl::optional<R> result_ ABSL_GUARDED_BY(mu_);
+    bool abandoned_ ABSL_GUARDED_BY(mu_) = false;
+  };
+
+  absl::optional<R> result_;
+  std::shared_ptr<Job> job_;
+};
+
+}  // namespace
+
 const grpc_channel_filter ClientCompressionFilter::kFilter =
     MakePromiseBasedFilter<ClientCompressionFilter, FilterEndpoint::kClient,
                            kFilterExaminesServerInitialMetadata |
@@ -88,11 +194,15 @@ CompressionFilter::CompressionFilter(const ChannelArgs& args)
               GRPC_COMPRESS_NONE)),
       enabled_compression_algorithms_(
           CompressionAlgorithmSet::FromChannelArgs(args)),
+      dictionary_(args.GetObjectRef<CompressionDictionary>()),
       enable_compression_(
           args.GetBool(GRPC_ARG_ENABLE_PER_MESSAGE_COMPRESSION).value_or(true)),
       enable_decompression_(
           args.GetBool(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION)
-              .value_or(true)) {
+              .value_or(true)),
+      offload_threshold_(std::max(
+          0, args.GetInt(GRPC_ARG_COMPRESSION_OFFLOAD_THRESHOLD)
+                 .value_or(kDefaultOffloadThreshold))) {
   // Make sure the default is enabled.
   if (!enabled_compression_algorithms_.IsSet(default_compression_algorithm_)) {
     const char* name;
@@ -108,7 +218,8 @@ CompressionFilter::CompressionFilter(const ChannelArgs& args)
 }
 
 MessageHandle CompressionFilter::CompressMessage(
-    MessageHandle message, grpc_compression_algorithm algorithm) const {
+    MessageHandle message, grpc_compression_algorithm algorithm,
+    DeflateStreamCompressor* stream) const {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
     gpr_log(GPR_ERROR, "CompressMessage: len=%" PRIdPTR " alg=%d flags=%d",
             message->payload()->Length(), algorithm, message->flags());
@@ -121,11 +232,15 @@ MessageHandle CompressionFilter::CompressMessage(
       (flags & (GRPC_WRITE_NO_COMPRESS | GRPC_WRITE_INTERNAL_COMPRESS))) {
     return message;
   }
-  // Try to compress the payload.
+  // Try to compress the payload.  A stream compressor keeps every message,
+  // even one that grows, since the peer needs it to follow the history.
   SliceBuffer tmp;
   SliceBuffer* payload = message->payload();
-  bool did_compress = grpc_msg_compress(algorithm, payload->c_slice_buffer(),
-                                        tmp.c_slice_buffer());
+  bool did_compress =
+      stream != nullptr
+          ? stream->Compress(payload->c_slice_buffer(), tmp.c_slice_buffer())
+          : grpc_msg_compress(algorithm, payload->c_slice_buffer(),
+                              tmp.c_slice_buffer(), dictionary_.get());
   // If we achieved compression send it as compressed, otherwise send it as (to
   // avoid spending cycles on the receiver decompressing).
   if (did_compress) {
@@ -156,9 +271,23 @@ MessageHandle CompressionFilter::CompressMessage(
   return message;
 }
 
+bool CompressionFilter::PeerAcceptsDictionary(
+    const absl::optional<CompressionAlgorithmSet>& accepted) const {
+  return dictionary_ != nullptr && accepted.has_value() &&
+         accepted->HasDictionary(dictionary_->id());
+}
+
+bool CompressionFilter::ShouldOffload(
+    const Message& message, grpc_compression_algorithm algorithm) const {
+  return offload_threshold_ != 0 && algorithm != GRPC_COMPRESS_NONE &&
+         message.payload()->Length() >= offload_threshold_ &&
+         HasContext<EventEngine>();
+}
+
 absl::StatusOr<MessageHandle> CompressionFilter::DecompressMessage(
     MessageHandle message, grpc_compression_algorithm algorithm,
-    absl::optional<uint32_t> max_recv_message_length) const {
+    absl::optional<uint32_t> max_recv_message_length,
+    DeflateStreamDecompressor* stream) const {
   if (GRPC_TRACE_FLAG_ENABLED(grpc_compression_trace)) {
     gpr_log(GPR_ERROR, "DecompressMessage: len=%" PRIdPTR " max=%d alg=%d",
             message->payload()->Length(), max_recv_message_length.value_or(-1),
@@ -180,8 +309,14 @@ absl::StatusOr<MessageHandle> CompressionFilter::DecompressMessage(
   }
   // Try to decompress the payload.
   SliceBuffer decompressed_slices;
-  if (grpc_msg_decompress(algorithm, message->payload()->c_slice_buffer(),
-                          decompressed_slices.c_slice_buffer()) == 0) {
+  const bool did_decompress =
+      stream != nullptr
+          ? stream->Decompress(message->payload()->c_slice_buffer(),
+                               decompressed_slices.c_slice_buffer())
+          : grpc_msg_decompress(
+                algorithm, message->payload()->c_slice_buffer(),
+                decompressed_slices.c_slice_buffer(), dictionary_.get()) != 0;
+  if (!did_decompress) {
     return absl::InternalError(
         absl::StrCat("Unexpected error decompressing data for algorithm ",
                      CompressionAlgorithmAsString(algorithm)));
@@ -215,11 +350,31 @@ class CompressionFilter::DecompressLoop {
          *limits->max_recv_size() < *max_recv_message_length)) {
       max_recv_message_length = *limits->max_recv_size();
     }
+    // A streaming peer compresses all of its messages with one context, so
+    // we decompress them with one too.
+    DeflateStreamDecompressor* stream = nullptr;
+    if (algorithm == GRPC_COMPRESS_DEFLATE_STREAM) {
+      stream = GetContext<Arena>()->ManagedNew<DeflateStreamDecompressor>();
+    }
     // Interject decompression into the message loop.
-    return mapper_.TakeAndRun([algorithm, max_recv_message_length,
+    return mapper_.TakeAndRun([algorithm, max_recv_message_length, stream,
                                filter = filter_](MessageHandle message) {
-      return filter->DecompressMessage(std::move(message), algorithm,
-                                       max_recv_message_length);
+      using Result = absl::StatusOr<MessageHandle>;
+      if (!filter->enable_decompression_ ||
+          (message->flags() & GRPC_WRITE_INTERNAL_COMPRESS) == 0 ||
+          !filter->ShouldOffload(*message, algorithm)) {
+        return MaybeOffloaded<Result>(filter->DecompressMessage(
+            std::move(message), algorithm, max_recv_message_length, stream));
+      }
+      // The output is at least as big as the input.
+      const size_t memory_bytes = message->payload()->Length();
+      return MaybeOffloaded<Result>(
+          GetContext<EventEngine>(), memory_bytes,
+          [filter, message = std::move(message), algorithm,
+           max_recv_message_length, stream]() mutable {
+            return filter->DecompressMessage(std::move(message), algorithm,
+                                             max_recv_message_length, stream);
+          });
     });
   }
 
@@ -236,12 +391,36 @@ class CompressionFilter::CompressLoop {
             *call_args.outgoing_messages)) {}
 
   // Once we're ready to send initial metadata we can construct the compression
-  // loop.
+  // loop.  peer_accepts_deflate_stream and peer_accepts_dictionary say
+  // whether the peer is known to support GRPC_COMPRESS_DEFLATE_STREAM and
+  // GRPC_COMPRESS_DEFLATE_DICTIONARY with our dictionary; if not,
+  // GRPC_COMPRESS_DEFLATE is used in their place.
   // Returns a promise that resolves to MessageHandle.
-  auto TakeAndRun(grpc_metadata_batch& outgoing_metadata) {
-    const auto algorithm =
-        outgoing_metadata.Take(GrpcInternalEncodingRequest())
-            .value_or(filter_->default_compression_algorithm());
+  auto TakeAndRun(grpc_metadata_batch& outgoing_metadata,
+                  bool peer_accepts_deflate_stream,
+                  bool peer_accepts_dictionary) {
+    auto algorithm = outgoing_metadata.Take(GrpcInternalEncodingRequest())
+                         .value_or(filter_->default_compression_algorithm());
+    if (algorithm == GRPC_COMPRESS_DEFLATE_DICTIONARY
+            ? filter_->dictionary_ == nullptr
+            : !IsCompressionAlgorithmSupported(algorithm)) {
+      gpr_log(GPR_ERROR,
+              "compression algorithm %d not supported: switching to none",
+              algorithm);
+      algorithm = GRPC_COMPRESS_NONE;
+    }
+    DeflateStreamCompressor* stream = nullptr;
+    if (algorithm == GRPC_COMPRESS_DEFLATE_STREAM) {
+      if (peer_accepts_deflate_stream) {
+        stream = GetContext<Arena>()->ManagedNew<DeflateStreamCompressor>();
+      } else {
+        algorithm = GRPC_COMPRESS_DEFLATE;
+      }
+    }
+    if (algorithm == GRPC_COMPRESS_DEFLATE_DICTIONARY &&
+        !peer_accepts_dictionary) {
+      algorithm = GRPC_COMPRESS_DEFLATE;
+    }
     // Convey supported compression algorithms.
     outgoing_metadata.Set(GrpcAcceptEncodingMetadata(),
                           filter_->enabled_compression_algorithms());
@@ -249,8 +428,23 @@ class CompressionFilter::CompressLoop {
       outgoing_metadata.Set(GrpcEncodingMetadata(), algorithm);
     }
     // Interject compression into the message loop.
-    return mapper_.TakeAndRun([filter = filter_, algorithm](MessageHandle m) {
-      return filter->CompressMessage(std::move(m), algorithm);
+    return mapper_.TakeAndRun([filter = filter_, algorithm,
+                               stream](MessageHandle m) {
+      const uint32_t skip =
+          GRPC_WRITE_NO_COMPRESS | GRPC_WRITE_INTERNAL_COMPRESS;
+      if (!filter->enable_compression_ || (m->flags() & skip) != 0 ||
+          !filter->ShouldOffload(*m, algorithm)) {
+        return MaybeOffloaded<MessageHandle>(
+            filter->CompressMessage(std::move(m), algorithm, stream));
+      }
+      // The output is no bigger than the input, unless it is sent
+      // uncompressed.
+      const size_t memory_bytes = m->payload()->Length();
+      return MaybeOffloaded<MessageHandle>(
+          GetContext<EventEngine>(), memory_bytes,
+          [filter, m = std::move(m), algorithm, stream]() mutable {
+            return filter->CompressMessage(std::move(m), algorithm, stream);
+          });
     });
   }
 
@@ -261,9 +455,14 @@ class CompressionFilter::CompressLoop {
 
 ArenaPromise<ServerMetadataHandle> ClientCompressionFilter::MakeCallPromise(
     CallArgs call_args, NextPromiseFactory next_promise_factory) {
-  auto compress_loop = CompressLoop(this, call_args)
-                           .TakeAndRun(*call_args.client_initial_metadata);
+  auto compress_loop =
+      CompressLoop(this, call_args)
+          .TakeAndRun(
+              *call_args.client_initial_metadata,
+              server_accepts_->deflate_stream.load(std::memory_order_relaxed),
+              server_accepts_->dictionary.load(std::memory_order_relaxed));
   DecompressLoop decompress_loop(this, call_args);
+  auto* server_accepts = server_accepts_.get();
   auto* server_initial_metadata = call_args.server_initial_metadata;
   // Concurrently:
   // - call the next filter
@@ -271,12 +470,27 @@ ArenaPromise<ServerMetadataHandle> ClientCompressionFilter::MakeCallPromise(
   // - compress outgoing messages
   return TryConcurrently(next_promise_factory(std::move(call_args)))
       .NecessaryPull(Seq(server_initial_metadata->Wait(),
-                         [decompress_loop = std::move(decompress_loop)](
+                         [this, decompress_loop = std::move(decompress_loop),
+                          server_accepts](
                              ServerMetadata** server_initial_metadata) mutable
                          -> ArenaPromise<absl::Status> {
                            if (*server_initial_metadata == nullptr) {
                              return ImmediateOkStatus();
                            }
+                           // Remember for later calls on this connection
+                           // whether its server can take deflate-stream
+                           // and our dictionary.
+                           auto accepted =
+                               (*server_initial_metadata)
+                                   ->get(GrpcAcceptEncodingMetadata());
+                           server_accepts->deflate_stream.store(
+                               accepted.has_value() &&
+                                   accepted->IsSet(
+                                       GRPC_COMPRESS_DEFLATE_STREAM),
+                               std::memory_order_relaxed);
+                           server_accepts->dictionary.store(
+                               PeerAcceptsDictionary(accepted),
+                               std::memory_order_relaxed);
                            return decompress_loop.TakeAndRun(
                                (*server_initial_metadata)
                                    ->get(GrpcEncodingMetadata())
@@ -288,6 +502,12 @@ ArenaPromise<ServerMetadataHandle> ClientCompressionFilter::MakeCallPromise(
 ArenaPromise<ServerMetadataHandle> ServerCompressionFilter::MakeCallPromise(
     CallArgs call_args, NextPromiseFactory next_promise_factory) {
   CompressLoop compress_loop(this, call_args);
+  auto client_accepted = call_args.client_initial_metadata->get(
+      GrpcAcceptEncodingMetadata());
+  const bool client_accepts_deflate_stream =
+      client_accepted.has_value() &&
+      client_accepted->IsSet(GRPC_COMPRESS_DEFLATE_STREAM);
+  const bool client_accepts_dictionary = PeerAcceptsDictionary(client_accepted);
   auto decompress_loop = DecompressLoop(this, call_args)
                              .TakeAndRun(call_args.client_initial_metadata
                                              ->get(GrpcEncodingMetadata())
@@ -303,10 +523,13 @@ ArenaPromise<ServerMetadataHandle> ServerCompressionFilter::MakeCallPromise(
   return TryConcurrently(next_promise_factory(std::move(call_args)))
       .Pull(std::move(decompress_loop))
       .Push(Seq(read_latch->Wait(),
-                [write_latch, compress_loop = std::move(compress_loop)](
-                    ServerMetadata** md) mutable {
+                [write_latch, compress_loop = std::move(compress_loop),
+                 client_accepts_deflate_stream,
+                 client_accepts_dictionary](ServerMetadata** md) mutable {
                   // Find the compression algorithm.
-                  auto loop = compress_loop.TakeAndRun(**md);
+                  auto loop = compress_loop.TakeAndRun(
+                      **md, client_accepts_deflate_stream,
+                      client_accepts_dictionary);
                   write_latch->Set(*md);
                   return loop;
                 }));
@@ -24,6 +24,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <atomic>
+#include <memory>
+
 #include "absl/status/statusor.h"
 #include "absl/types/optional.h"
 
@@ -32,7 +35,10 @@
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_fwd.h"
 #include "src/core/lib/channel/promise_based_filter.h"
+#include "src/core/lib/compression/compression_dictionary.h"
 #include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/stream_compress.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/transport/transport.h"
 
@@ -58,7 +64,21 @@ namespace grpc_core {
  * If compression is actually performed, the MessageHandle's flag is modified to
  * incorporate GRPC_WRITE_INTERNAL_COMPRESS. Otherwise, and regardless of the
  * aforementioned 'grpc-encoding' metadata value, data will pass through
- * uncompressed. */
+ * uncompressed.
+ *
+ * GRPC_COMPRESS_DEFLATE_STREAM keeps one compression context per call and
+ * direction (see stream_compress.h). It is only used with peers that list
+ * it in 'grpc-accept-encoding'; others get GRPC_COMPRESS_DEFLATE instead.
+ *
+ * GRPC_COMPRESS_DEFLATE_DICTIONARY uses the CompressionDictionary in the
+ * channel args, and is unavailable without one. Like deflate-stream, it is
+ * only used with peers that list the same dictionary in
+ * 'grpc-accept-encoding', and others get GRPC_COMPRESS_DEFLATE.
+ *
+ * Messages of at least GRPC_ARG_COMPRESSION_OFFLOAD_THRESHOLD bytes are
+ * compressed and decompressed on the EventEngine, and the call resumes once
+ * that is done.  The buffers involved are reserved from the call's memory
+ * allocator while the work is in flight. */
 
 class CompressionFilter : public ChannelFilter {
  protected:
@@ -75,14 +95,27 @@ class CompressionFilter : public ChannelFilter {
     return enabled_compression_algorithms_;
   }
 
+  // Whether a peer that sent accepted can take messages compressed with
+  // this filter's dictionary.
+  bool PeerAcceptsDictionary(
+      const absl::optional<CompressionAlgorithmSet>& accepted) const;
+
  private:
-  // Compress one message synchronously.
+  // Compress one message synchronously.  stream is the call's compression
+  // context for GRPC_COMPRESS_DEFLATE_STREAM, and null otherwise.
   MessageHandle CompressMessage(MessageHandle message,
-                                grpc_compression_algorithm algorithm) const;
-  // Decompress one message synchronously.
+                                grpc_compression_algorithm algorithm,
+                                DeflateStreamCompressor* stream) const;
+  // Decompress one message synchronously.  stream is as for
+  // CompressMessage().
   absl::StatusOr<MessageHandle> DecompressMessage(
       MessageHandle message, grpc_compression_algorithm algorithm,
-      absl::optional<uint32_t> max_recv_message_length) const;
+      absl::optional<uint32_t> max_recv_message_length,
+      DeflateStreamDecompressor* stream) const;
+  // Whether compressing or decompressing message with algorithm is enough
+  // work to move off the current thread.
+  bool ShouldOffload(const Message& message,
+                     grpc_compression_algorithm algorithm) const;
 
   // Max receive message length, if set.
   absl::optional<uint32_t> max_recv_size_;
@@ -91,10 +124,15 @@ class CompressionFilter : public ChannelFilter {
   grpc_compression_algorithm default_compression_algorithm_;
   // Enabled compression algorithms.
   CompressionAlgorithmSet enabled_compression_algorithms_;
+  // For GRPC_COMPRESS_DEFLATE_DICTIONARY, if set.
+  RefCountedPtr<CompressionDictionary> dictionary_;
   // Is compression enabled?
   bool enable_compression_;
   // Is decompression enabled?
   bool enable_decompression_;
+  // Messages of at least this size are processed on the EventEngine; 0
+  // disables offloading.
+  size_t offload_threshold_;
 };
 
 class ClientCompressionFilter final : public CompressionFilter {
@@ -110,6 +148,20 @@ class ClientCompressionFilter final : public CompressionFilter {
 
  private:
   using CompressionFilter::CompressionFilter;
+
+  // Whether the last server response on this filter's connection listed
+  // deflate-stream and our dictionary in grpc-accept-encoding.  Calls only
+  // find out once the server responds, which is too late for their own
+  // messages, so they rely on this.  The filter runs on subchannel and
+  // direct channel stacks, which are built per connection, so this only
+  // ever describes one server: calls to other backends go through their own
+  // filter instances and learn separately.
+  struct ServerAccepts {
+    std::atomic<bool> deflate_stream{false};
+    std::atomic<bool> dictionary{false};
+  };
+  std::unique_ptr<ServerAccepts> server_accepts_ =
+      std::make_unique<ServerAccepts>();
 };
 
 class ServerCompressionFilter final : public CompressionFilter {
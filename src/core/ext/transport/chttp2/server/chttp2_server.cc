@@ -697,10 +697,19 @@ grpc_error_handle Chttp2ServerListener::Create(
       if (!string_address.ok()) {
         return GRPC_ERROR_CREATE(string_address.status().ToString());
       }
+      // Report the usage of a tenant's quota that this port's args carry.
+      MemoryQuotaRefPtr tenant_quota;
+      ResourceQuota* resource_quota = args.GetObject<ResourceQuota>();
+      if (resource_quota != nullptr &&
+          resource_quota !=
+              server->channel_args().GetObject<ResourceQuota>()) {
+        tenant_quota = resource_quota->memory_quota();
+      }
       listener->channelz_listen_socket_ =
           MakeRefCounted<channelz::ListenSocketNode>(
               *string_address,
-              absl::StrCat("chttp2 listener ", *string_address));
+              absl::StrCat("chttp2 listener ", *string_address),
+              std::move(tenant_quota));
     }
     // Register with the server only upon success
     server->AddListener(OrphanablePtr<Server::ListenerInterface>(listener));
@@ -1004,7 +1013,7 @@ int grpc_server_add_http2_port(grpc_server* server, const char* addr,
   grpc_core::RefCountedPtr<grpc_server_security_connector> sc;
   int port_num = 0;
   grpc_core::Server* core_server = grpc_core::Server::FromC(server);
-  grpc_core::ChannelArgs args = core_server->channel_args();
+  grpc_core::ChannelArgs args = core_server->ChannelArgsForPort(addr);
   GRPC_API_TRACE("grpc_server_add_http2_port(server=%p, addr=%s, creds=%p)", 3,
                  (server, addr, creds));
   // Create security context.
@@ -109,6 +109,8 @@
 
 #define DEFAULT_MAX_PENDING_INDUCED_FRAMES 10000
 
+#define INITIAL_STREAM_MAP_CAPACITY 8
+
 static int g_default_client_keepalive_time_ms =
     DEFAULT_CLIENT_KEEPALIVE_TIME_MS;
 static int g_default_client_keepalive_timeout_ms =
@@ -157,10 +159,11 @@ static void connectivity_state_set(grpc_chttp2_transport* t,
                                    const absl::Status& status,
                                    const char* reason);
 
-static void benign_reclaimer_locked(void* arg, grpc_error_handle error);
+static void compaction_reclaimer_locked(void* arg, grpc_error_handle error);
+static void idle_reclaimer_locked(void* arg, grpc_error_handle error);
 static void destructive_reclaimer_locked(void* arg, grpc_error_handle error);
 
-static void post_benign_reclaimer(grpc_chttp2_transport* t);
+static void post_idle_reclaimers(grpc_chttp2_transport* t);
 static void post_destructive_reclaimer(grpc_chttp2_transport* t);
 
 static void close_transport_locked(grpc_chttp2_transport* t,
@@ -493,7 +496,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   //   large enough that the exponential growth should happen nicely when it's
   //   needed.
   //   TODO(ctiller): tune this
-  grpc_chttp2_stream_map_init(&stream_map, 8);
+  grpc_chttp2_stream_map_init(&stream_map, INITIAL_STREAM_MAP_CAPACITY);
 
   grpc_slice_buffer_init(&read_buffer);
   grpc_slice_buffer_init(&outbuf);
@@ -544,7 +547,7 @@ grpc_chttp2_transport::grpc_chttp2_transport(
   }
 
   grpc_chttp2_initiate_write(this, GRPC_CHTTP2_INITIATE_WRITE_INITIAL_WRITE);
-  post_benign_reclaimer(this);
+  post_idle_reclaimers(this);
   if (grpc_core::test_only_init_callback != nullptr) {
     grpc_core::test_only_init_callback();
   }
@@ -1317,19 +1320,11 @@ static void perform_stream_op_locked(void* stream_op,
                                         absl::OkStatus(),
                                         "fetching_send_message_finished");
     } else {
-      uint8_t* frame_hdr = grpc_slice_buffer_tiny_add(
-          &s->flow_controlled_buffer, GRPC_HEADER_SIZE_IN_BYTES);
-      frame_hdr[0] = (flags & GRPC_WRITE_INTERNAL_COMPRESS) != 0;
       size_t len = op_payload->send_message.send_message->Length();
-      frame_hdr[1] = static_cast<uint8_t>(len >> 24);
-      frame_hdr[2] = static_cast<uint8_t>(len >> 16);
-      frame_hdr[3] = static_cast<uint8_t>(len >> 8);
-      frame_hdr[4] = static_cast<uint8_t>(len);
-
       s->next_message_end_offset =
           s->flow_controlled_bytes_written +
           static_cast<int64_t>(s->flow_controlled_buffer.length) +
-          static_cast<int64_t>(len);
+          GRPC_HEADER_SIZE_IN_BYTES + static_cast<int64_t>(len);
       if (flags & GRPC_WRITE_BUFFER_HINT) {
         s->next_message_end_offset -= t->write_buffer_size;
         s->write_buffering = true;
@@ -1337,11 +1332,29 @@ static void perform_stream_op_locked(void* stream_op,
         s->write_buffering = false;
       }
 
-      grpc_slice* const slices =
+      grpc_slice* slice =
           op_payload->send_message.send_message->c_slice_buffer()->slices;
       grpc_slice* const end =
-          slices + op_payload->send_message.send_message->Count();
-      for (grpc_slice* slice = slices; slice != end; slice++) {
+          slice + op_payload->send_message.send_message->Count();
+      uint8_t* frame_hdr;
+      if (slice != end &&
+          grpc_slice_headroom(*slice) >= GRPC_HEADER_SIZE_IN_BYTES) {
+        // The serializer left room for the header before the message: write
+        // it there rather than in a slice of its own.
+        grpc_slice first = grpc_core::CSliceRef(*slice++);
+        frame_hdr =
+            grpc_slice_extend_into_headroom(&first, GRPC_HEADER_SIZE_IN_BYTES);
+        grpc_slice_buffer_add(&s->flow_controlled_buffer, first);
+      } else {
+        frame_hdr = grpc_slice_buffer_tiny_add(&s->flow_controlled_buffer,
+                                               GRPC_HEADER_SIZE_IN_BYTES);
+      }
+      frame_hdr[0] = (flags & GRPC_WRITE_INTERNAL_COMPRESS) != 0;
+      frame_hdr[1] = static_cast<uint8_t>(len >> 24);
+      frame_hdr[2] = static_cast<uint8_t>(len >> 16);
+      frame_hdr[3] = static_cast<uint8_t>(len >> 8);
+      frame_hdr[4] = static_cast<uint8_t>(len);
+      for (; slice != end; slice++) {
         grpc_slice_buffer_add(&s->flow_controlled_buffer,
                               grpc_core::CSliceRef(*slice));
       }
@@ -1914,7 +1927,7 @@ static void remove_stream(grpc_chttp2_transport* t, uint32_t id,
   }
 
   if (grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
-    post_benign_reclaimer(t);
+    post_idle_reclaimers(t);
     if (t->sent_goaway_state == GRPC_CHTTP2_FINAL_GOAWAY_SENT) {
       close_transport_locked(
           t, GRPC_ERROR_CREATE_REFERENCING(
@@ -2788,21 +2801,42 @@ static void set_pollset_set(grpc_transport* gt, grpc_stream* /*gs*/,
 // RESOURCE QUOTAS
 //
 
-static void post_benign_reclaimer(grpc_chttp2_transport* t) {
-  if (!t->benign_reclaimer_registered) {
-    t->benign_reclaimer_registered = true;
-    GRPC_CHTTP2_REF_TRANSPORT(t, "benign_reclaimer");
+// Idle transports are compacted in the benign pass, and asked to go away in
+// the idle pass: the reclamation loop runs every benign reclaimer before any
+// idle one, so all idle transports are shrunk before the first is closed.
+static void post_idle_reclaimers(grpc_chttp2_transport* t) {
+  if (!t->compaction_reclaimer_registered) {
+    t->compaction_reclaimer_registered = true;
+    GRPC_CHTTP2_REF_TRANSPORT(t, "compaction_reclaimer");
     t->memory_owner.PostReclaimer(
         grpc_core::ReclamationPass::kBenign,
         [t](absl::optional<grpc_core::ReclamationSweep> sweep) {
           if (sweep.has_value()) {
-            GRPC_CLOSURE_INIT(&t->benign_reclaimer_locked,
-                              benign_reclaimer_locked, t,
+            GRPC_CLOSURE_INIT(&t->compaction_reclaimer_locked,
+                              compaction_reclaimer_locked, t,
                               grpc_schedule_on_exec_ctx);
             t->active_reclamation = std::move(*sweep);
-            t->combiner->Run(&t->benign_reclaimer_locked, absl::OkStatus());
+            t->combiner->Run(&t->compaction_reclaimer_locked,
+                             absl::OkStatus());
           } else {
-            GRPC_CHTTP2_UNREF_TRANSPORT(t, "benign_reclaimer");
+            GRPC_CHTTP2_UNREF_TRANSPORT(t, "compaction_reclaimer");
+          }
+        });
+  }
+  if (!t->idle_reclaimer_registered) {
+    t->idle_reclaimer_registered = true;
+    GRPC_CHTTP2_REF_TRANSPORT(t, "idle_reclaimer");
+    t->memory_owner.PostReclaimer(
+        grpc_core::ReclamationPass::kIdle,
+        [t](absl::optional<grpc_core::ReclamationSweep> sweep) {
+          if (sweep.has_value()) {
+            GRPC_CLOSURE_INIT(&t->idle_reclaimer_locked,
+                              idle_reclaimer_locked, t,
+                              grpc_schedule_on_exec_ctx);
+            t->active_reclamation = std::move(*sweep);
+            t->combiner->Run(&t->idle_reclaimer_locked, absl::OkStatus());
+          } else {
+            GRPC_CHTTP2_UNREF_TRANSPORT(t, "idle_reclaimer");
           }
         });
   }
@@ -2829,7 +2863,43 @@ static void post_destructive_reclaimer(grpc_chttp2_transport* t) {
   }
 }
 
-static void benign_reclaimer_locked(void* arg, grpc_error_handle error) {
+// Give back the slice array of an empty buffer that has outgrown its inline
+// storage.
+static void shrink_slice_buffer(grpc_slice_buffer* sb) {
+  if (sb->count == 0 && sb->base_slices != sb->inlined) {
+    grpc_slice_buffer_destroy(sb);
+    grpc_slice_buffer_init(sb);
+  }
+}
+
+void grpc_chttp2_compact_idle_transport_locked(grpc_chttp2_transport* t) {
+  t->hpack_parser.hpack_table()->ShrinkToFit();
+  t->hpack_compressor.ReleaseValueIndexes();
+  grpc_chttp2_stream_map_shrink(&t->stream_map, INITIAL_STREAM_MAP_CAPACITY);
+  // outbuf belongs to the endpoint while a write is in flight.
+  if (t->write_state == GRPC_CHTTP2_WRITE_STATE_IDLE) {
+    shrink_slice_buffer(&t->outbuf);
+  }
+  shrink_slice_buffer(&t->qbuf);
+}
+
+static void compaction_reclaimer_locked(void* arg, grpc_error_handle error) {
+  grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
+  if (error.ok() && grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
+    if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+      gpr_log(GPR_INFO, "HTTP2: %s - compact idle transport to free memory",
+              t->peer_string.c_str());
+    }
+    grpc_chttp2_compact_idle_transport_locked(t);
+  }
+  t->compaction_reclaimer_registered = false;
+  if (error != absl::CancelledError()) {
+    t->active_reclamation.Finish();
+  }
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "compaction_reclaimer");
+}
+
+static void idle_reclaimer_locked(void* arg, grpc_error_handle error) {
   grpc_chttp2_transport* t = static_cast<grpc_chttp2_transport*>(arg);
   if (error.ok() && grpc_chttp2_stream_map_size(&t->stream_map) == 0) {
     // Channel with no active streams: send a goaway to try and make it
@@ -2845,16 +2915,16 @@ static void benign_reclaimer_locked(void* arg, grpc_error_handle error) {
                 /*immediate_disconnect_hint=*/true);
   } else if (error.ok() && GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
     gpr_log(GPR_INFO,
-            "HTTP2: %s - skip benign reclamation, there are still %" PRIdPTR
+            "HTTP2: %s - skip idle reclamation, there are still %" PRIdPTR
             " streams",
             t->peer_string.c_str(),
             grpc_chttp2_stream_map_size(&t->stream_map));
   }
-  t->benign_reclaimer_registered = false;
+  t->idle_reclaimer_registered = false;
   if (error != absl::CancelledError()) {
     t->active_reclamation.Finish();
   }
-  GRPC_CHTTP2_UNREF_TRANSPORT(t, "benign_reclaimer");
+  GRPC_CHTTP2_UNREF_TRANSPORT(t, "idle_reclaimer");
 }
 
 static void destructive_reclaimer_locked(void* arg, grpc_error_handle error) {
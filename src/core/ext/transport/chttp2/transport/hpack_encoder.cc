@@ -595,6 +595,12 @@ void HPackCompressor::SetMaxUsableSize(uint32_t max_table_size) {
   SetMaxTableSize(std::min(table_.max_size(), max_table_size));
 }
 
+void HPackCompressor::ReleaseValueIndexes() {
+  path_index_.Clear();
+  authority_index_.Clear();
+  std::vector<PreviousTimeout>().swap(previous_timeouts_);
+}
+
 void HPackCompressor::SetMaxTableSize(uint32_t max_table_size) {
   if (table_.SetMaxSize(std::min(max_usable_size_, max_table_size))) {
     advertise_table_size_change_ = true;
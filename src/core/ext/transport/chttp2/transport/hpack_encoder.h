@@ -59,6 +59,11 @@ class HPackCompressor {
   void SetMaxTableSize(uint32_t max_table_size);
   void SetMaxUsableSize(uint32_t max_table_size);
 
+  // Forget the :path, :authority and grpc-timeout values remembered from
+  // earlier headers.  Their entries stay in the table, but repeating one of
+  // them sends a new literal instead of an index.
+  void ReleaseValueIndexes();
+
   uint32_t test_only_table_size() const {
     return table_.test_only_table_size();
   }
@@ -171,6 +176,7 @@ class HPackCompressor {
   class SliceIndex {
    public:
     void EmitTo(absl::string_view key, const Slice& value, Encoder* encoder);
+    void Clear() { std::vector<ValueIndex>().swap(values_); }
 
    private:
     struct ValueIndex {
@@ -68,6 +68,15 @@ auto HPackTable::MementoRingBuffer::Lookup(uint32_t index) const
 
 void HPackTable::MementoRingBuffer::Rebuild(uint32_t max_entries) {
   if (max_entries == max_entries_) return;
+  Repack();
+}
+
+void HPackTable::MementoRingBuffer::ShrinkToFit() {
+  if (entries_.capacity() == num_entries_) return;
+  Repack();
+}
+
+void HPackTable::MementoRingBuffer::Repack() {
   std::vector<Memento> entries;
   entries.reserve(num_entries_);
   for (size_t i = 0; i < num_entries_; i++) {
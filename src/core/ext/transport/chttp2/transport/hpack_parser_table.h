@@ -68,6 +68,10 @@ class HPackTable {
   // Current entry count in the table.
   uint32_t num_entries() const { return entries_.num_entries(); }
 
+  // Release storage not used by the current entries.  Entries themselves
+  // are part of the state shared with the peer, and are kept.
+  void ShrinkToFit() { entries_.ShrinkToFit(); }
+
  private:
   struct StaticMementos {
     StaticMementos();
@@ -79,6 +83,10 @@ class HPackTable {
     // Rebuild this buffer with a new max_entries_ size.
     void Rebuild(uint32_t max_entries);
 
+    // Drop capacity that is not holding an entry; it is grown back on demand
+    // by Put().
+    void ShrinkToFit();
+
     // Put a new memento.
     // REQUIRES: num_entries < max_entries
     void Put(Memento m);
@@ -94,6 +102,9 @@ class HPackTable {
     uint32_t num_entries() const { return num_entries_; }
 
    private:
+    // Move the entries to a new vector of exactly num_entries_ elements.
+    void Repack();
+
     // The index of the first entry in the buffer. May be greater than
     // max_entries_, in which case a wraparound has occurred.
     uint32_t first_entry_ = 0;
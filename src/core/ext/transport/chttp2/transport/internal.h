@@ -412,12 +412,16 @@ struct grpc_chttp2_transport
   grpc_closure_list run_after_write = GRPC_CLOSURE_LIST_INIT;
 
   /* buffer pool state */
-  /** have we scheduled a benign cleanup? */
-  bool benign_reclaimer_registered = false;
+  /** have we scheduled a compaction of the idle transport? */
+  bool compaction_reclaimer_registered = false;
+  /** have we scheduled closing the idle transport? */
+  bool idle_reclaimer_registered = false;
   /** have we scheduled a destructive cleanup? */
   bool destructive_reclaimer_registered = false;
-  /** benign cleanup closure */
-  grpc_closure benign_reclaimer_locked;
+  /** compaction closure */
+  grpc_closure compaction_reclaimer_locked;
+  /** idle cleanup closure */
+  grpc_closure idle_reclaimer_locked;
   /** destructive cleanup closure */
   grpc_closure destructive_reclaimer_locked;
 
@@ -803,4 +807,8 @@ void schedule_bdp_ping_locked(grpc_chttp2_transport* t);
 
 uint32_t grpc_chttp2_min_read_progress_size(grpc_chttp2_transport* t);
 
+/** Release memory an idle transport holds on to: spare HPACK table and stream
+    map capacity, remembered HPACK values and grown slice buffer arrays */
+void grpc_chttp2_compact_idle_transport_locked(grpc_chttp2_transport* t);
+
 #endif /* GRPC_CORE_EXT_TRANSPORT_CHTTP2_TRANSPORT_INTERNAL_H */
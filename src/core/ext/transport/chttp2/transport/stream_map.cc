@@ -22,6 +22,8 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
@@ -56,6 +58,22 @@ static size_t compact(uint32_t* keys, void** values, size_t count) {
   return out;
 }
 
+void grpc_chttp2_stream_map_shrink(grpc_chttp2_stream_map* map,
+                                   size_t min_capacity) {
+  GPR_DEBUG_ASSERT(min_capacity > 1);
+  if (map->free != 0) {
+    map->count = compact(map->keys, map->values, map->count);
+    map->free = 0;
+  }
+  size_t capacity = std::max(map->count, min_capacity);
+  if (capacity >= map->capacity) return;
+  map->capacity = capacity;
+  map->keys = static_cast<uint32_t*>(
+      gpr_realloc(map->keys, capacity * sizeof(uint32_t)));
+  map->values =
+      static_cast<void**>(gpr_realloc(map->values, capacity * sizeof(void*)));
+}
+
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
                                 void* value) {
   size_t count = map->count;
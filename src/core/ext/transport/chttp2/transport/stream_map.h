@@ -41,6 +41,11 @@ void grpc_chttp2_stream_map_init(grpc_chttp2_stream_map* map,
                                  size_t initial_capacity);
 void grpc_chttp2_stream_map_destroy(grpc_chttp2_stream_map* map);
 
+/* Release array space that the current entries do not need, keeping room for
+   at least min_capacity entries */
+void grpc_chttp2_stream_map_shrink(grpc_chttp2_stream_map* map,
+                                   size_t min_capacity);
+
 /* Add a new key: given http2 semantics, new keys must always be greater than
    existing keys - this is asserted */
 void grpc_chttp2_stream_map_add(grpc_chttp2_stream_map* map, uint32_t key,
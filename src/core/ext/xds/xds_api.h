@@ -68,15 +68,21 @@ class XdsApi {
 
     // Called to parse each individual resource in the ADS response.
     // Note that resource_name is non-empty only when the resource was
-    // wrapped in a Resource wrapper proto.
+    // wrapped in a Resource wrapper proto, and resource_version is
+    // non-empty only in delta responses.
     virtual void ParseResource(upb_Arena* arena, size_t idx,
                                absl::string_view type_url,
                                absl::string_view resource_name,
+                               absl::string_view resource_version,
                                absl::string_view serialized_resource) = 0;
 
     // Called when a resource is wrapped in a Resource wrapper proto but
     // we fail to deserialize the wrapper proto.
     virtual void ResourceWrapperParsingFailed(size_t idx) = 0;
+
+    // Called for each entry in the removed_resources field of a delta
+    // response.
+    virtual void ProcessRemovedResource(absl::string_view resource_name) = 0;
   };
 
   struct ClusterLoadReport {
@@ -124,6 +130,9 @@ class XdsApi {
     std::string failed_details;
     // Timestamp of the last failed update attempt.
     Timestamp failed_update_time;
+    // True if the resource was loaded from the persistent resource cache
+    // and has not yet been confirmed by the xDS server.
+    bool from_cache = false;
   };
   using ResourceMetadataMap =
       std::map<std::string /*resource_name*/, const ResourceMetadata*>;
@@ -162,6 +171,24 @@ class XdsApi {
   absl::Status ParseAdsResponse(absl::string_view encoded_response,
                                 AdsResponseParserInterface* parser);
 
+  // Creates a delta ADS request.  Unlike state-of-the-world requests,
+  // which list every subscribed resource, this lists only the changes
+  // since the previous request for this type on the stream.
+  // initial_resource_versions is used on the first request for a type on
+  // a new stream, to tell the server which resources we already have.
+  std::string CreateDeltaAdsRequest(
+      absl::string_view type_url, absl::string_view nonce,
+      const std::vector<std::string>& resource_names_subscribe,
+      const std::vector<std::string>& resource_names_unsubscribe,
+      const std::map<std::string, std::string>& initial_resource_versions,
+      absl::Status status, bool populate_node);
+
+  // Same as ParseAdsResponse(), but for a DeltaDiscoveryResponse.
+  // AdsResponseFields::version is set to the response's
+  // system_version_info, which is informational only.
+  absl::Status ParseDeltaAdsResponse(absl::string_view encoded_response,
+                                     AdsResponseParserInterface* parser);
+
   // Creates an initial LRS request.
   std::string CreateLrsInitialRequest();
 
@@ -47,6 +47,9 @@ class XdsBootstrap {
 
     virtual const std::string& server_uri() const = 0;
     virtual bool IgnoreResourceDeletion() const = 0;
+    // Returns true if the incremental (delta) variant of the ADS
+    // protocol should be used with this server.
+    virtual bool UseDeltaProtocol() const = 0;
 
     virtual bool Equals(const XdsServer& other) const = 0;
 
@@ -81,6 +84,10 @@ class XdsBootstrap {
   // If the server exists in the bootstrap config, returns a pointer to
   // the XdsServer instance in the config.  Otherwise, returns null.
   virtual const XdsServer* FindXdsServer(const XdsServer& server) const = 0;
+
+  // Returns the directory in which validated resources should be
+  // persisted across restarts, or an empty string if they should not be.
+  virtual const std::string& resource_cache_dir() const = 0;
 };
 
 }  // namespace grpc_core
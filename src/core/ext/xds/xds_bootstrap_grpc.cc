@@ -96,6 +96,8 @@ namespace {
 constexpr absl::string_view kServerFeatureIgnoreResourceDeletion =
     "ignore_resource_deletion";
 
+constexpr absl::string_view kServerFeatureDeltaXds = "delta_xds";
+
 }  // namespace
 
 bool GrpcXdsBootstrap::GrpcXdsServer::IgnoreResourceDeletion() const {
@@ -103,6 +105,11 @@ bool GrpcXdsBootstrap::GrpcXdsServer::IgnoreResourceDeletion() const {
              kServerFeatureIgnoreResourceDeletion)) != server_features_.end();
 }
 
+bool GrpcXdsBootstrap::GrpcXdsServer::UseDeltaProtocol() const {
+  return server_features_.find(std::string(kServerFeatureDeltaXds)) !=
+         server_features_.end();
+}
+
 bool GrpcXdsBootstrap::GrpcXdsServer::Equals(const XdsServer& other) const {
   const auto& o = static_cast<const GrpcXdsServer&>(other);
   return (server_uri_ == o.server_uri_ &&
@@ -161,7 +168,8 @@ void GrpcXdsBootstrap::GrpcXdsServer::JsonPostLoad(const Json& json,
         for (const Json& feature_json : array) {
           if (feature_json.type() == Json::Type::STRING &&
               (feature_json.string_value() ==
-               kServerFeatureIgnoreResourceDeletion)) {
+                   kServerFeatureIgnoreResourceDeletion ||
+               feature_json.string_value() == kServerFeatureDeltaXds)) {
             server_features_.insert(feature_json.string_value());
           }
         }
@@ -239,6 +247,8 @@ const JsonLoaderInterface* GrpcXdsBootstrap::JsonLoader(const JsonArgs&) {
           .OptionalField(
               "server_listener_resource_name_template",
               &GrpcXdsBootstrap::server_listener_resource_name_template_)
+          .OptionalField("resource_cache_dir",
+                         &GrpcXdsBootstrap::resource_cache_dir_)
           .OptionalField("authorities", &GrpcXdsBootstrap::authorities_,
                          "federation")
           .OptionalField("client_default_listener_resource_name_template",
@@ -304,6 +314,10 @@ std::string GrpcXdsBootstrap::ToString() const {
         absl::StrFormat("server_listener_resource_name_template=\"%s\",\n",
                         server_listener_resource_name_template_));
   }
+  if (!resource_cache_dir_.empty()) {
+    parts.push_back(
+        absl::StrFormat("resource_cache_dir=\"%s\",\n", resource_cache_dir_));
+  }
   parts.push_back("authorities={\n");
   for (const auto& entry : authorities_) {
     parts.push_back(absl::StrFormat("  %s={\n", entry.first));
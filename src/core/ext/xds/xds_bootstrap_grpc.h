@@ -79,6 +79,8 @@ class GrpcXdsBootstrap : public XdsBootstrap {
 
     bool IgnoreResourceDeletion() const override;
 
+    bool UseDeltaProtocol() const override;
+
     bool Equals(const XdsServer& other) const override;
 
     const std::string& channel_creds_type() const {
@@ -140,6 +142,9 @@ class GrpcXdsBootstrap : public XdsBootstrap {
   }
   const Authority* LookupAuthority(const std::string& name) const override;
   const XdsServer* FindXdsServer(const XdsServer& server) const override;
+  const std::string& resource_cache_dir() const override {
+    return resource_cache_dir_;
+  }
 
   const std::string& client_default_listener_resource_name_template() const {
     return client_default_listener_resource_name_template_;
@@ -172,6 +177,7 @@ class GrpcXdsBootstrap : public XdsBootstrap {
   absl::optional<GrpcNode> node_;
   std::string client_default_listener_resource_name_template_;
   std::string server_listener_resource_name_template_;
+  std::string resource_cache_dir_;
   std::map<std::string, GrpcAuthority> authorities_;
   CertificateProviderStore::PluginDefinitionMap certificate_providers_;
   XdsHttpFilterRegistry http_filter_registry_;
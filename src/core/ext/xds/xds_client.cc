@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -59,6 +60,13 @@ using ::grpc_event_engine::experimental::EventEngine;
 TraceFlag grpc_xds_client_trace(false, "xds_client");
 TraceFlag grpc_xds_client_refcount_trace(false, "xds_client_refcount");
 
+namespace {
+
+// Minimum time between writes of the persistent resource cache.
+constexpr Duration kResourceCacheSaveInterval = Duration::Seconds(1);
+
+}  // namespace
+
 //
 // Internal class declarations
 //
@@ -148,16 +156,29 @@ class XdsClient::ChannelState::AdsCallState
 
     void ParseResource(upb_Arena* arena, size_t idx, absl::string_view type_url,
                        absl::string_view resource_name,
+                       absl::string_view resource_version,
                        absl::string_view serialized_resource) override
         ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
     void ResourceWrapperParsingFailed(size_t idx) override;
 
+    void ProcessRemovedResource(absl::string_view resource_name) override
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     Result TakeResult() { return std::move(result_); }
 
    private:
     XdsClient* xds_client() const { return ads_call_state_->xds_client(); }
 
+    // Cancels the resource-does-not-exist timer for the resource, if any.
+    void MarkResourceSeen(const XdsResourceName& name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
+    // Returns the cache entry for the resource, or null if we do not
+    // have a subscription for it.
+    ResourceState* FindResourceState(const XdsResourceName& name)
+        ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
     AdsCallState* ads_call_state_;
     const Timestamp update_time_ = Timestamp::Now();
     Result result_;
@@ -304,11 +325,23 @@ class XdsClient::ChannelState::AdsCallState
     std::map<std::string /*authority*/,
              std::map<XdsResourceKey, OrphanablePtr<ResourceTimer>>>
         subscribed_resources;
+
+    // Delta protocol only: the resource names that the server currently
+    // knows we are subscribed to, and whether we have sent a request for
+    // this type on this stream yet.
+    std::set<std::string> subscribed_names_sent;
+    bool sent_initial_request = false;
   };
 
   void SendMessageLocked(const XdsResourceType* type)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
 
+  // Creates a delta ADS request carrying only the subscription changes
+  // since the last request for the type.
+  std::string CreateDeltaRequestLocked(const XdsResourceType* type,
+                                       ResourceTypeState* state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(&XdsClient::mu_);
+
   void OnRequestSent(bool ok);
   void OnRecvMessage(absl::string_view payload);
   void OnStatusReceived(absl::Status status);
@@ -323,6 +356,9 @@ class XdsClient::ChannelState::AdsCallState
   // The owning RetryableCall<>.
   RefCountedPtr<RetryableCall<AdsCallState>> parent_;
 
+  // True if this call uses the incremental (delta) variant of the protocol.
+  const bool delta_;
+
   OrphanablePtr<XdsTransportFactory::XdsTransport::StreamingCall> call_;
 
   bool sent_initial_message_ = false;
@@ -733,9 +769,39 @@ void UpdateResourceMetadataNacked(const std::string& version,
 
 }  // namespace
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    MarkResourceSeen(const XdsResourceName& name) {
+  auto timer_it = ads_call_state_->state_map_.find(result_.type);
+  if (timer_it == ads_call_state_->state_map_.end()) return;
+  auto it = timer_it->second.subscribed_resources.find(name.authority);
+  if (it == timer_it->second.subscribed_resources.end()) return;
+  auto res_it = it->second.find(name.key);
+  if (res_it != it->second.end()) res_it->second->MarkSeen();
+}
+
+XdsClient::ResourceState*
+XdsClient::ChannelState::AdsCallState::AdsResponseParser::FindResourceState(
+    const XdsResourceName& name) {
+  // Lookup the authority in the cache.
+  auto authority_it = xds_client()->authority_state_map_.find(name.authority);
+  if (authority_it == xds_client()->authority_state_map_.end()) {
+    return nullptr;
+  }
+  // Found authority, so look up type.
+  AuthorityState& authority_state = authority_it->second;
+  auto type_it = authority_state.resource_map.find(result_.type);
+  if (type_it == authority_state.resource_map.end()) return nullptr;
+  auto& type_map = type_it->second;
+  // Found type, so look up resource key.
+  auto it = type_map.find(name.key);
+  if (it == type_map.end()) return nullptr;
+  return &it->second;
+}
+
 void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     upb_Arena* arena, size_t idx, absl::string_view type_url,
-    absl::string_view resource_name, absl::string_view serialized_resource) {
+    absl::string_view resource_name, absl::string_view resource_version,
+    absl::string_view serialized_resource) {
   std::string error_prefix = absl::StrCat(
       "resource index ", idx, ": ",
       resource_name.empty() ? "" : absl::StrCat(resource_name, ": "));
@@ -782,36 +848,17 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
     return;
   }
   // Cancel resource-does-not-exist timer, if needed.
-  auto timer_it = ads_call_state_->state_map_.find(result_.type);
-  if (timer_it != ads_call_state_->state_map_.end()) {
-    auto it = timer_it->second.subscribed_resources.find(
-        parsed_resource_name->authority);
-    if (it != timer_it->second.subscribed_resources.end()) {
-      auto res_it = it->second.find(parsed_resource_name->key);
-      if (res_it != it->second.end()) {
-        res_it->second->MarkSeen();
-      }
-    }
-  }
-  // Lookup the authority in the cache.
-  auto authority_it =
-      xds_client()->authority_state_map_.find(parsed_resource_name->authority);
-  if (authority_it == xds_client()->authority_state_map_.end()) {
+  MarkResourceSeen(*parsed_resource_name);
+  ResourceState* resource_state_ptr = FindResourceState(*parsed_resource_name);
+  if (resource_state_ptr == nullptr) {
     return;  // Skip resource -- we don't have a subscription for it.
   }
-  // Found authority, so look up type.
-  AuthorityState& authority_state = authority_it->second;
-  auto type_it = authority_state.resource_map.find(result_.type);
-  if (type_it == authority_state.resource_map.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  auto& type_map = type_it->second;
-  // Found type, so look up resource key.
-  auto it = type_map.find(parsed_resource_name->key);
-  if (it == type_map.end()) {
-    return;  // Skip resource -- we don't have a subscription for it.
-  }
-  ResourceState& resource_state = it->second;
+  ResourceState& resource_state = *resource_state_ptr;
+  // Delta responses carry a version per resource; SotW responses carry
+  // one version for the whole response.
+  std::string version = resource_version.empty()
+                            ? result_.version
+                            : std::string(resource_version);
   // If needed, record that we've seen this resource.
   if (result_.type->AllResourcesRequiredInSotW()) {
     result_.resources_seen[parsed_resource_name->authority].insert(
@@ -835,7 +882,7 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
         resource_state.watchers,
         absl::UnavailableError(
             absl::StrCat("invalid resource: ", decode_status.ToString())));
-    UpdateResourceMetadataNacked(result_.version, decode_status.ToString(),
+    UpdateResourceMetadataNacked(version, decode_status.ToString(),
                                  update_time_, &resource_state.meta);
     return;
   }
@@ -851,12 +898,26 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::ParseResource(
               xds_client(), result_.type_url.c_str(),
               std::string(resource_name).c_str());
     }
+    if (resource_state.meta.from_cache) {
+      // The server has confirmed the resource we loaded from the
+      // persistent cache.
+      resource_state.meta = CreateResourceMetadataAcked(
+          std::string(serialized_resource), version, update_time_);
+    } else if (!resource_version.empty()) {
+      // Keep the per-resource version current, since it is what we send
+      // back to a delta server when the stream is re-established.
+      resource_state.meta.version = version;
+    }
+    xds_client()->UpdateCachedResourceLocked(
+        result_.type, *parsed_resource_name, resource_state.meta);
     return;
   }
   // Update the resource state.
   resource_state.resource = std::move(*decode_result.resource);
   resource_state.meta = CreateResourceMetadataAcked(
-      std::string(serialized_resource), result_.version, update_time_);
+      std::string(serialized_resource), std::move(version), update_time_);
+  xds_client()->UpdateCachedResourceLocked(result_.type, *parsed_resource_name,
+                                           resource_state.meta);
   // Notify watchers.
   auto& watchers_list = resource_state.watchers;
   auto* value =
@@ -878,6 +939,41 @@ void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
       "resource index ", idx, ": Can't decode Resource proto wrapper"));
 }
 
+void XdsClient::ChannelState::AdsCallState::AdsResponseParser::
+    ProcessRemovedResource(absl::string_view resource_name) {
+  auto parsed_resource_name =
+      xds_client()->ParseXdsResourceName(resource_name, result_.type);
+  if (!parsed_resource_name.ok()) {
+    result_.errors.emplace_back(
+        absl::StrCat("removed resource ", resource_name,
+                     ": Cannot parse xDS resource name"));
+    return;
+  }
+  // The server has told us about this resource, so there is no need to
+  // wait for the does-not-exist timer.
+  MarkResourceSeen(*parsed_resource_name);
+  ResourceState* resource_state = FindResourceState(*parsed_resource_name);
+  if (resource_state == nullptr) return;
+  if (resource_state->resource != nullptr &&
+      ads_call_state_->chand()->server_.IgnoreResourceDeletion()) {
+    if (!resource_state->ignored_deletion) {
+      gpr_log(GPR_ERROR,
+              "[xds_client %p] xds server %s: ignoring deletion for resource "
+              "type %s name %s",
+              xds_client(),
+              ads_call_state_->chand()->server_.server_uri().c_str(),
+              result_.type_url.c_str(), std::string(resource_name).c_str());
+      resource_state->ignored_deletion = true;
+    }
+    return;
+  }
+  resource_state->resource.reset();
+  resource_state->meta.client_status =
+      XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+  xds_client()->RemoveCachedResourceLocked(result_.type, *parsed_resource_name);
+  xds_client()->NotifyWatchersOnResourceDoesNotExist(resource_state->watchers);
+}
+
 //
 // XdsClient::ChannelState::AdsCallState
 //
@@ -888,12 +984,15 @@ XdsClient::ChannelState::AdsCallState::AdsCallState(
           GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_refcount_trace)
               ? "AdsCallState"
               : nullptr),
-      parent_(std::move(parent)) {
+      parent_(std::move(parent)),
+      delta_(chand()->server_.UseDeltaProtocol()) {
   GPR_ASSERT(xds_client() != nullptr);
   // Init the ADS call.
   const char* method =
-      "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
-      "StreamAggregatedResources";
+      delta_ ? "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+               "DeltaAggregatedResources"
+             : "/envoy.service.discovery.v3.AggregatedDiscoveryService/"
+               "StreamAggregatedResources";
   call_ = chand()->transport_->CreateStreamingCall(
       method, std::make_unique<StreamEventHandler>(
                   // Passing the initial ref here.  This ref will go away when
@@ -945,9 +1044,12 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
     return;
   }
   auto& state = state_map_[type];
-  std::string serialized_message = xds_client()->api_.CreateAdsRequest(
-      type->type_url(), chand()->resource_type_version_map_[type], state.nonce,
-      ResourceNamesForRequest(type), state.status, !sent_initial_message_);
+  std::string serialized_message =
+      delta_ ? CreateDeltaRequestLocked(type, &state)
+             : xds_client()->api_.CreateAdsRequest(
+                   type->type_url(), chand()->resource_type_version_map_[type],
+                   state.nonce, ResourceNamesForRequest(type), state.status,
+                   !sent_initial_message_);
   sent_initial_message_ = true;
   if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
     gpr_log(GPR_INFO,
@@ -959,10 +1061,60 @@ void XdsClient::ChannelState::AdsCallState::SendMessageLocked(
             state.nonce.c_str(), state.status.ToString().c_str());
   }
   state.status = absl::OkStatus();
+  // A delta request acknowledges exactly one response, so the nonce must
+  // not be repeated in later requests that only change subscriptions.
+  if (delta_) state.nonce.clear();
   call_->SendMessage(std::move(serialized_message));
   send_message_pending_ = type;
 }
 
+std::string XdsClient::ChannelState::AdsCallState::CreateDeltaRequestLocked(
+    const XdsResourceType* type, ResourceTypeState* state) {
+  std::vector<std::string> resource_names = ResourceNamesForRequest(type);
+  std::set<std::string> current_names(resource_names.begin(),
+                                      resource_names.end());
+  std::vector<std::string> subscribe;
+  std::set_difference(current_names.begin(), current_names.end(),
+                      state->subscribed_names_sent.begin(),
+                      state->subscribed_names_sent.end(),
+                      std::back_inserter(subscribe));
+  std::vector<std::string> unsubscribe;
+  std::set_difference(state->subscribed_names_sent.begin(),
+                      state->subscribed_names_sent.end(),
+                      current_names.begin(), current_names.end(),
+                      std::back_inserter(unsubscribe));
+  // On the first request for this type on a new stream, tell the server
+  // which versions we already have cached, so that it does not need to
+  // resend them.
+  std::map<std::string, std::string> initial_resource_versions;
+  if (!state->sent_initial_request) {
+    for (const auto& a : state->subscribed_resources) {
+      const std::string& authority = a.first;
+      auto authority_it = xds_client()->authority_state_map_.find(authority);
+      if (authority_it == xds_client()->authority_state_map_.end()) continue;
+      auto type_it = authority_it->second.resource_map.find(type);
+      if (type_it == authority_it->second.resource_map.end()) continue;
+      for (const auto& r : a.second) {
+        const XdsResourceKey& resource_key = r.first;
+        auto it = type_it->second.find(resource_key);
+        if (it == type_it->second.end() || it->second.resource == nullptr ||
+            it->second.meta.version.empty()) {
+          continue;
+        }
+        initial_resource_versions.emplace(
+            XdsClient::ConstructFullXdsResourceName(
+                authority, type->type_url(), resource_key),
+            it->second.meta.version);
+      }
+    }
+  }
+  state->sent_initial_request = true;
+  state->subscribed_names_sent = std::move(current_names);
+  return xds_client()->api_.CreateDeltaAdsRequest(
+      type->type_url(), state->nonce, subscribe, unsubscribe,
+      initial_resource_versions, state->status, !sent_initial_message_);
+}
+
 void XdsClient::ChannelState::AdsCallState::SubscribeLocked(
     const XdsResourceType* type, const XdsResourceName& name, bool delay_send) {
   auto& state = state_map_[type].subscribed_resources[name.authority][name.key];
@@ -1030,7 +1182,9 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
     if (!IsCurrentCallOnChannel()) return;
     // Parse and validate the response.
     AdsResponseParser parser(this);
-    absl::Status status = xds_client()->api_.ParseAdsResponse(payload, &parser);
+    absl::Status status =
+        delta_ ? xds_client()->api_.ParseDeltaAdsResponse(payload, &parser)
+               : xds_client()->api_.ParseAdsResponse(payload, &parser);
     if (!status.ok()) {
       // Ignore unparsable response.
       gpr_log(GPR_ERROR,
@@ -1058,8 +1212,9 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
                 result.type_url.c_str(), result.version.c_str(),
                 state.nonce.c_str(), state.status.ToString().c_str());
       }
-      // Delete resources not seen in update if needed.
-      if (result.type->AllResourcesRequiredInSotW()) {
+      // Delete resources not seen in update if needed.  Delta responses
+      // list removed resources explicitly, so this does not apply to them.
+      if (!delta_ && result.type->AllResourcesRequiredInSotW()) {
         for (auto& a : xds_client()->authority_state_map_) {
           const std::string& authority = a.first;
           AuthorityState& authority_state = a.second;
@@ -1100,6 +1255,8 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
                 resource_state.resource.reset();
                 resource_state.meta.client_status =
                     XdsApi::ResourceMetadata::DOES_NOT_EXIST;
+                xds_client()->RemoveCachedResourceLocked(
+                    result.type, {authority, resource_key});
                 xds_client()->NotifyWatchersOnResourceDoesNotExist(
                     resource_state.watchers);
               }
@@ -1121,6 +1278,7 @@ void XdsClient::ChannelState::AdsCallState::OnRecvMessage(
       // Send ACK or NACK.
       SendMessageLocked(result.type);
     }
+    xds_client()->MaybeScheduleResourceCacheSaveLocked();
   }
   xds_client()->work_serializer_.DrainQueue();
 }
@@ -1483,6 +1641,21 @@ XdsClient::XdsClient(
     gpr_log(GPR_INFO, "[xds_client %p] xDS node ID: %s", this,
             bootstrap_->node()->id().c_str());
   }
+  if (!bootstrap_->resource_cache_dir().empty()) {
+    resource_cache_ = std::make_unique<XdsResourceCache>(*bootstrap_);
+    auto entries = resource_cache_->Load();
+    if (!entries.ok()) {
+      gpr_log(GPR_ERROR, "[xds_client %p] ignoring xDS resource cache: %s",
+              this, entries.status().ToString().c_str());
+    } else {
+      gpr_log(GPR_INFO,
+              "[xds_client %p] loaded %" PRIuPTR
+              " resources from xDS resource cache %s",
+              this, entries->size(), resource_cache_->path().c_str());
+      MutexLock lock(&mu_);
+      cached_resources_ = std::move(*entries);
+    }
+  }
 }
 
 XdsClient::~XdsClient() {
@@ -1522,6 +1695,110 @@ RefCountedPtr<XdsClient::ChannelState> XdsClient::GetOrCreateChannelStateLocked(
   return channel_state;
 }
 
+void XdsClient::MaybeLoadResourceFromCacheLocked(
+    const XdsResourceType* type, const XdsResourceName& name,
+    const XdsBootstrap::XdsServer& xds_server, ResourceState* resource_state) {
+  if (resource_cache_ == nullptr) return;
+  auto it = cached_resources_.find(std::make_pair(
+      std::string(type->type_url()),
+      ConstructFullXdsResourceName(name.authority, type->type_url(),
+                                   name.key)));
+  if (it == cached_resources_.end()) return;
+  upb::Arena arena;
+  XdsResourceType::DecodeContext context = {
+      this, xds_server, &grpc_xds_client_trace, symtab_.ptr(), arena.ptr()};
+  XdsResourceType::DecodeResult decode_result =
+      type->Decode(context, it->second.serialized_resource);
+  if (!decode_result.resource.ok()) {
+    // This can happen if validation rules changed since the entry was
+    // written.  Drop the entry and wait for the server instead.
+    gpr_log(GPR_ERROR,
+            "[xds_client %p] discarding invalid cached resource {type=%s "
+            "name=%s}: %s",
+            this, it->first.first.c_str(), it->first.second.c_str(),
+            decode_result.resource.status().ToString().c_str());
+    cached_resources_.erase(it);
+    ++cached_resources_generation_;
+    return;
+  }
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_xds_client_trace)) {
+    gpr_log(GPR_INFO,
+            "[xds_client %p] using cached resource {type=%s name=%s} "
+            "version %s",
+            this, it->first.first.c_str(), it->first.second.c_str(),
+            it->second.version.c_str());
+  }
+  resource_state->resource = std::move(*decode_result.resource);
+  resource_state->meta.serialized_proto = it->second.serialized_resource;
+  resource_state->meta.version = it->second.version;
+  resource_state->meta.from_cache = true;
+}
+
+void XdsClient::UpdateCachedResourceLocked(
+    const XdsResourceType* type, const XdsResourceName& name,
+    const XdsApi::ResourceMetadata& meta) {
+  if (resource_cache_ == nullptr) return;
+  XdsResourceCache::Entry& entry = cached_resources_[std::make_pair(
+      std::string(type->type_url()),
+      ConstructFullXdsResourceName(name.authority, type->type_url(),
+                                   name.key))];
+  if (entry.version == meta.version &&
+      entry.serialized_resource == meta.serialized_proto) {
+    return;
+  }
+  entry.version = meta.version;
+  entry.serialized_resource = meta.serialized_proto;
+  ++cached_resources_generation_;
+}
+
+void XdsClient::RemoveCachedResourceLocked(const XdsResourceType* type,
+                                           const XdsResourceName& name) {
+  if (resource_cache_ == nullptr) return;
+  if (cached_resources_.erase(std::make_pair(
+          std::string(type->type_url()),
+          ConstructFullXdsResourceName(name.authority, type->type_url(),
+                                       name.key))) > 0) {
+    ++cached_resources_generation_;
+  }
+}
+
+void XdsClient::MaybeScheduleResourceCacheSaveLocked() {
+  if (resource_cache_ == nullptr || resource_cache_save_pending_) return;
+  if (cached_resources_generation_ == cached_resources_saved_generation_) {
+    return;
+  }
+  resource_cache_save_pending_ = true;
+  const Duration delay = std::max(
+      Duration::Zero(), resource_cache_last_save_time_ +
+                            kResourceCacheSaveInterval - Timestamp::Now());
+  engine_->RunAfter(delay, [self = WeakRef(DEBUG_LOCATION, "SaveCache")]() {
+    ApplicationCallbackExecCtx callback_exec_ctx;
+    ExecCtx exec_ctx;
+    self->SaveResourceCache();
+  });
+}
+
+void XdsClient::SaveResourceCache() {
+  XdsResourceCache::EntryMap entries;
+  uint64_t generation;
+  {
+    MutexLock lock(&mu_);
+    resource_cache_save_pending_ = false;
+    resource_cache_last_save_time_ = Timestamp::Now();
+    if (cached_resources_generation_ == cached_resources_saved_generation_) {
+      return;
+    }
+    entries = cached_resources_;
+    generation = cached_resources_generation_;
+    cached_resources_saved_generation_ = generation;
+  }
+  absl::Status status = resource_cache_->Save(entries, generation);
+  if (!status.ok()) {
+    gpr_log(GPR_ERROR, "[xds_client %p] failed to write xDS resource cache: %s",
+            this, status.ToString().c_str());
+  }
+}
+
 void XdsClient::WatchResource(const XdsResourceType* type,
                               absl::string_view name,
                               RefCountedPtr<ResourceWatcherInterface> watcher) {
@@ -1568,6 +1845,14 @@ void XdsClient::WatchResource(const XdsResourceType* type,
     ResourceState& resource_state =
         authority_state.resource_map[type][resource_name->key];
     resource_state.watchers[w] = watcher;
+    // On the first watch for a resource, start from the persistent cache,
+    // if we have it there.
+    if (resource_state.resource == nullptr &&
+        resource_state.meta.client_status ==
+            XdsApi::ResourceMetadata::REQUESTED) {
+      MaybeLoadResourceFromCacheLocked(type, *resource_name, *xds_server,
+                                       &resource_state);
+    }
     // If we already have a cached value for the resource, notify the new
     // watcher immediately.
     if (resource_state.resource != nullptr) {
@@ -37,6 +37,7 @@
 #include "src/core/ext/xds/xds_api.h"
 #include "src/core/ext/xds/xds_bootstrap.h"
 #include "src/core/ext/xds/xds_client_stats.h"
+#include "src/core/ext/xds/xds_resource_cache.h"
 #include "src/core/ext/xds/xds_resource_type.h"
 #include "src/core/ext/xds/xds_transport.h"
 #include "src/core/lib/debug/trace.h"
@@ -304,6 +305,31 @@ class XdsClient : public DualRefCounted<XdsClient> {
       const XdsBootstrap::XdsServer& server, const char* reason)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Populates resource_state from the persistent resource cache, if the
+  // cache is enabled and has a valid entry for the resource.
+  void MaybeLoadResourceFromCacheLocked(
+      const XdsResourceType* type, const XdsResourceName& name,
+      const XdsBootstrap::XdsServer& xds_server, ResourceState* resource_state)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Records a newly accepted resource in, or removes a deleted resource
+  // from, the in-memory copy of the persistent resource cache.
+  void UpdateCachedResourceLocked(const XdsResourceType* type,
+                                  const XdsResourceName& name,
+                                  const XdsApi::ResourceMetadata& meta)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void RemoveCachedResourceLocked(const XdsResourceType* type,
+                                  const XdsResourceName& name)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // If the in-memory copy of the persistent resource cache has changed,
+  // schedules a write of it on the EventEngine.  Writes happen at most
+  // once per kResourceCacheSaveInterval; changes made while a write is
+  // pending are picked up by that write.
+  void MaybeScheduleResourceCacheSaveLocked()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Writes the persistent resource cache.  The file I/O is done without
+  // holding mu_.
+  void SaveResourceCache() ABSL_LOCKS_EXCLUDED(mu_);
+
   std::unique_ptr<XdsBootstrap> bootstrap_;
   OrphanablePtr<XdsTransportFactory> transport_factory_;
   const Duration request_timeout_;
@@ -327,6 +353,18 @@ class XdsClient : public DualRefCounted<XdsClient> {
   std::map<std::string /*authority*/, AuthorityState> authority_state_map_
       ABSL_GUARDED_BY(mu_);
 
+  // Persistent resource cache, or null if not configured in the bootstrap.
+  std::unique_ptr<XdsResourceCache> resource_cache_;
+  // In-memory copy of the cache contents.  The generation is bumped on
+  // every change, and saved_generation_ is the last generation handed to
+  // resource_cache_ for writing.
+  XdsResourceCache::EntryMap cached_resources_ ABSL_GUARDED_BY(mu_);
+  uint64_t cached_resources_generation_ ABSL_GUARDED_BY(mu_) = 0;
+  uint64_t cached_resources_saved_generation_ ABSL_GUARDED_BY(mu_) = 0;
+  bool resource_cache_save_pending_ ABSL_GUARDED_BY(mu_) = false;
+  Timestamp resource_cache_last_save_time_ ABSL_GUARDED_BY(mu_) =
+      Timestamp::InfPast();
+
   // Key is owned by the bootstrap config.
   std::map<const XdsBootstrap::XdsServer*, LoadReportServer>
       xds_load_report_server_map_ ABSL_GUARDED_BY(mu_);
@@ -0,0 +1,266 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/ext/xds/xds_resource_cache.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef GPR_POSIX_TMPFILE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/strip.h"
+
+#include "src/core/lib/gprpp/load_file.h"
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+namespace {
+
+constexpr absl::string_view kMagic = "GRPCXDSC";
+constexpr uint32_t kFormatVersion = 1;
+constexpr absl::string_view kFileName = "xds_resource_cache";
+
+void AppendUint32(uint32_t value, std::string* out) {
+  for (int i = 0; i < 4; ++i) {
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+  }
+}
+
+void AppendString(absl::string_view value, std::string* out) {
+  AppendUint32(static_cast<uint32_t>(value.size()), out);
+  out->append(value.data(), value.size());
+}
+
+bool ConsumeUint32(absl::string_view* in, uint32_t* value) {
+  if (in->size() < 4) return false;
+  *value = 0;
+  for (int i = 0; i < 4; ++i) {
+    *value |= static_cast<uint32_t>(static_cast<uint8_t>((*in)[i])) << (8 * i);
+  }
+  in->remove_prefix(4);
+  return true;
+}
+
+bool ConsumeString(absl::string_view* in, std::string* value) {
+  uint32_t size;
+  if (!ConsumeUint32(in, &size) || in->size() < size) return false;
+  value->assign(in->data(), size);
+  in->remove_prefix(size);
+  return true;
+}
+
+// Names the file after a hash of the node ID and server.  This is FNV-1a,
+// since unlike absl::Hash it must be the same in every process.
+std::string CacheFileName(absl::string_view node_id,
+                          absl::string_view server_uri) {
+  uint64_t hash = 0xcbf29ce484222325u;
+  auto add = [&hash](absl::string_view value) {
+    for (char c : value) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 0x100000001b3u;
+    }
+  };
+  add(node_id);
+  add(absl::string_view("\0", 1));
+  add(server_uri);
+  return absl::StrCat(kFileName, "_", absl::Hex(hash, absl::kZeroPad16));
+}
+
+#ifdef GPR_POSIX_TMPFILE
+
+bool WriteAll(int fd, absl::string_view contents) {
+  while (!contents.empty()) {
+    ssize_t n = write(fd, contents.data(), contents.size());
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+    contents.remove_prefix(n);
+  }
+  return true;
+}
+
+#endif  // GPR_POSIX_TMPFILE
+
+}  // namespace
+
+XdsResourceCache::XdsResourceCache(absl::string_view directory,
+                                   absl::string_view node_id,
+                                   absl::string_view server_uri)
+    : path_(absl::StrCat(absl::StripSuffix(directory, "/"), "/",
+                         CacheFileName(node_id, server_uri))) {}
+
+XdsResourceCache::XdsResourceCache(const XdsBootstrap& bootstrap)
+    : XdsResourceCache(
+          bootstrap.resource_cache_dir(),
+          bootstrap.node() == nullptr ? "" : bootstrap.node()->id(),
+          bootstrap.server().server_uri()) {}
+
+std::string XdsResourceCache::Serialize(const EntryMap& entries) {
+  std::string out(kMagic);
+  AppendUint32(kFormatVersion, &out);
+  AppendUint32(static_cast<uint32_t>(entries.size()), &out);
+  for (const auto& p : entries) {
+    AppendString(p.first.first, &out);
+    AppendString(p.first.second, &out);
+    AppendString(p.second.version, &out);
+    AppendString(p.second.serialized_resource, &out);
+  }
+  return out;
+}
+
+absl::StatusOr<XdsResourceCache::EntryMap> XdsResourceCache::Parse(
+    absl::string_view contents) {
+  if (!absl::ConsumePrefix(&contents, kMagic)) {
+    return absl::InvalidArgumentError("not an xDS resource cache file");
+  }
+  uint32_t format_version;
+  uint32_t num_records;
+  if (!ConsumeUint32(&contents, &format_version) ||
+      !ConsumeUint32(&contents, &num_records)) {
+    return absl::InvalidArgumentError("truncated header");
+  }
+  if (format_version != kFormatVersion) {
+    return absl::InvalidArgumentError(
+        absl::StrCat("unsupported format version ", format_version));
+  }
+  EntryMap entries;
+  for (uint32_t i = 0; i < num_records; ++i) {
+    std::string type_url;
+    std::string name;
+    Entry entry;
+    if (!ConsumeString(&contents, &type_url) ||
+        !ConsumeString(&contents, &name) ||
+        !ConsumeString(&contents, &entry.version) ||
+        !ConsumeString(&contents, &entry.serialized_resource)) {
+      return absl::InvalidArgumentError(absl::StrCat("truncated record ", i));
+    }
+    entries.emplace(std::make_pair(std::move(type_url), std::move(name)),
+                    std::move(entry));
+  }
+  if (!contents.empty()) {
+    return absl::InvalidArgumentError("trailing data after last record");
+  }
+  return entries;
+}
+
+absl::StatusOr<XdsResourceCache::EntryMap> XdsResourceCache::Load() const {
+  absl::StatusOr<EntryMap> entries;
+#ifdef GPR_POSIX_TMPFILE
+  // A missing file just means that nothing has been cached yet.
+  int fd = open(path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (errno == ENOENT) return EntryMap();
+    return absl::InternalError(absl::StrCat("Failed to open ", path_, ": ",
+                                            strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    absl::Status status = absl::InternalError(
+        absl::StrCat("Failed to stat ", path_, ": ", strerror(errno)));
+    close(fd);
+    return status;
+  }
+  // The file is only ever replaced by rename(), never changed in place, so
+  // the mapping cannot be truncated while it is being parsed.  An empty file
+  // cannot be mapped, but does not parse either.
+  const size_t size = static_cast<size_t>(st.st_size);
+  void* data = size == 0 ? nullptr
+                         : mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    return absl::InternalError(
+        absl::StrCat("Failed to map ", path_, ": ", strerror(errno)));
+  }
+  entries = Parse(absl::string_view(static_cast<const char*>(data), size));
+  if (data != nullptr) munmap(data, size);
+#else
+  FILE* file = fopen(path_.c_str(), "rb");
+  if (file == nullptr) {
+    if (errno == ENOENT) return EntryMap();
+    return absl::InternalError(absl::StrCat("Failed to open ", path_, ": ",
+                                            strerror(errno)));
+  }
+  fclose(file);
+  auto contents = LoadFile(path_, /*add_null_terminator=*/false);
+  if (!contents.ok()) return contents.status();
+  entries = Parse(contents->as_string_view());
+#endif  // GPR_POSIX_TMPFILE
+  if (!entries.ok()) {
+    return absl::InvalidArgumentError(absl::StrCat(
+        "Failed to parse ", path_, ": ", entries.status().message()));
+  }
+  return entries;
+}
+
+absl::Status XdsResourceCache::Save(const EntryMap& entries,
+                                    uint64_t generation) {
+  std::string contents = Serialize(entries);
+  MutexLock lock(&mu_);
+  if (generation <= last_saved_generation_) return absl::OkStatus();
+#ifdef GPR_POSIX_TMPFILE
+  // A unique name, so that processes sharing the cache never write to the
+  // same temporary file.
+  std::string tmp_path = absl::StrCat(path_, ".XXXXXX");
+  int fd = mkstemp(&tmp_path[0]);
+  if (fd < 0) {
+    return absl::InternalError(absl::StrCat("Failed to create ", tmp_path,
+                                            ": ", strerror(errno)));
+  }
+  // The data must be on disk before the rename is, or a crash could leave
+  // an empty cache file behind.
+  bool ok = WriteAll(fd, contents) && fsync(fd) == 0;
+  ok &= close(fd) == 0;
+#else
+  const std::string tmp_path = absl::StrCat(path_, ".tmp");
+  FILE* file = fopen(tmp_path.c_str(), "wb");
+  if (file == nullptr) {
+    return absl::InternalError(absl::StrCat("Failed to open ", tmp_path, ": ",
+                                            strerror(errno)));
+  }
+  bool ok = fwrite(contents.data(), 1, contents.size(), file) ==
+            contents.size();
+  ok &= fclose(file) == 0;
+#endif  // GPR_POSIX_TMPFILE
+  if (!ok) {
+    remove(tmp_path.c_str());
+    return absl::InternalError(absl::StrCat("Failed to write ", tmp_path));
+  }
+#ifdef GPR_WINDOWS
+  // rename() does not replace an existing file on Windows.
+  remove(path_.c_str());
+#endif
+  if (rename(tmp_path.c_str(), path_.c_str()) != 0) {
+    absl::Status status = absl::InternalError(absl::StrCat(
+        "Failed to rename ", tmp_path, " to ", path_, ": ", strerror(errno)));
+    remove(tmp_path.c_str());
+    return status;
+  }
+  last_saved_generation_ = generation;
+  return absl::OkStatus();
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,96 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_EXT_XDS_XDS_RESOURCE_CACHE_H
+#define GRPC_CORE_EXT_XDS_XDS_RESOURCE_CACHE_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/lib/gprpp/sync.h"
+
+namespace grpc_core {
+
+// Persists validated xDS resources to a file, so that a restarted client
+// can use its last-known-good config before the xDS server responds.
+//
+// The file is a fixed header followed by length-prefixed records, laid
+// out so that it can be read in place (e.g., via mmap):
+//
+//   magic "GRPCXDSC" | uint32 format version | uint32 num_records
+//   per record: uint32 length + bytes, for each of type_url, resource
+//               name, version, and serialized resource
+//
+// All integers are little-endian.  Writes go to a uniquely named temporary
+// file that is flushed to disk before it is renamed over the cache file, so
+// readers never see a partial file, even after a crash.
+class XdsResourceCache {
+ public:
+  struct Entry {
+    std::string version;
+    std::string serialized_resource;
+  };
+
+  // Keyed by type URL (without the "type.googleapis.com/" prefix) and
+  // full resource name.
+  using EntryMap =
+      std::map<std::pair<std::string /*type_url*/, std::string /*name*/>,
+               Entry>;
+
+  // Uses a file in the specified directory named for the node ID and the
+  // xDS server, so that clients that share the directory but not their
+  // identity or server do not load each other's resources.
+  XdsResourceCache(absl::string_view directory, absl::string_view node_id,
+                   absl::string_view server_uri);
+  // Uses the directory, node and server in the bootstrap config.
+  explicit XdsResourceCache(const XdsBootstrap& bootstrap);
+
+  const std::string& path() const { return path_; }
+
+  // Reads the cache file, which is mapped into memory where possible.
+  // Returns an empty map if the file does not exist yet.
+  absl::StatusOr<EntryMap> Load() const;
+
+  // Writes the cache file.  generation must increase with every change
+  // to the entries; a save whose generation is not newer than the last
+  // one written is skipped, so that concurrent saves cannot replace a
+  // newer snapshot with an older one.
+  absl::Status Save(const EntryMap& entries, uint64_t generation);
+
+  // Exposed for testing.
+  static std::string Serialize(const EntryMap& entries);
+  static absl::StatusOr<EntryMap> Parse(absl::string_view contents);
+
+ private:
+  const std::string path_;
+  Mutex mu_;
+  uint64_t last_saved_generation_ ABSL_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_EXT_XDS_XDS_RESOURCE_CACHE_H
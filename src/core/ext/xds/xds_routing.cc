@@ -20,17 +20,19 @@
 
 #include "src/core/ext/xds/xds_routing.h"
 
+#include <inttypes.h>
 #include <stdint.h>
 #include <stdlib.h>
 
 #include <algorithm>
-#include <cctype>
 #include <utility>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
+#include "re2/re2.h"
 
 #include <grpc/support/log.h>
 
@@ -50,35 +52,22 @@ enum MatchType {
 };
 
 // Returns true if match succeeds.
-bool DomainMatch(MatchType match_type, absl::string_view domain_pattern_in,
-                 absl::string_view expected_host_name_in) {
-  // Normalize the args to lower-case. Domain matching is case-insensitive.
-  std::string domain_pattern = std::string(domain_pattern_in);
-  std::string expected_host_name = std::string(expected_host_name_in);
-  std::transform(domain_pattern.begin(), domain_pattern.end(),
-                 domain_pattern.begin(),
-                 [](unsigned char c) { return std::tolower(c); });
-  std::transform(expected_host_name.begin(), expected_host_name.end(),
-                 expected_host_name.begin(),
-                 [](unsigned char c) { return std::tolower(c); });
+// Domain matching is case-insensitive.
+bool DomainMatch(MatchType match_type, absl::string_view domain_pattern,
+                 absl::string_view expected_host_name) {
   if (match_type == EXACT_MATCH) {
-    return domain_pattern == expected_host_name;
+    return absl::EqualsIgnoreCase(domain_pattern, expected_host_name);
   } else if (match_type == SUFFIX_MATCH) {
     // Asterisk must match at least one char.
     if (expected_host_name.size() < domain_pattern.size()) return false;
-    absl::string_view pattern_suffix(domain_pattern.c_str() + 1);
-    absl::string_view host_suffix(expected_host_name.c_str() +
-                                  expected_host_name.size() -
-                                  pattern_suffix.size());
-    return pattern_suffix == host_suffix;
+    return absl::EndsWithIgnoreCase(expected_host_name,
+                                    domain_pattern.substr(1));
   } else if (match_type == PREFIX_MATCH) {
     // Asterisk must match at least one char.
     if (expected_host_name.size() < domain_pattern.size()) return false;
-    absl::string_view pattern_prefix(domain_pattern.c_str(),
-                                     domain_pattern.size() - 1);
-    absl::string_view host_prefix(expected_host_name.c_str(),
-                                  pattern_prefix.size());
-    return pattern_prefix == host_prefix;
+    return absl::StartsWithIgnoreCase(
+        expected_host_name,
+        domain_pattern.substr(0, domain_pattern.size() - 1));
   } else {
     return match_type == UNIVERSE_MATCH;
   }
@@ -175,6 +164,157 @@ absl::optional<size_t> XdsRouting::GetRouteForRequest(
   return absl::nullopt;
 }
 
+absl::optional<size_t> XdsRouting::GetRouteForRequest(
+    const RouteListIterator& route_list_iterator, const RouteIndex& route_index,
+    absl::string_view path, grpc_metadata_batch* initial_metadata) {
+  RouteIndex::Candidates candidates;
+  route_index.FindRoutesForPath(route_list_iterator, path, &candidates);
+  // Candidates are in route order, so the first one that also matches
+  // headers and fraction is the same route a linear scan would select.
+  for (size_t i : candidates) {
+    const XdsRouteConfigResource::Route::Matchers& matchers =
+        route_list_iterator.GetMatchersForRoute(i);
+    if (HeadersMatch(matchers.header_matchers, initial_metadata) &&
+        (!matchers.fraction_per_million.has_value() ||
+         UnderFraction(*matchers.fraction_per_million))) {
+      return i;
+    }
+  }
+  return absl::nullopt;
+}
+
+//
+// XdsRouting::RouteIndex
+//
+
+XdsRouting::RouteIndex::RouteIndex(
+    const RouteListIterator& route_list_iterator) {
+  std::vector<const std::string*> regex_patterns;
+  for (size_t i = 0; i < route_list_iterator.Size(); ++i) {
+    const StringMatcher& path_matcher =
+        route_list_iterator.GetMatchersForRoute(i).path_matcher;
+    switch (path_matcher.type()) {
+      case StringMatcher::Type::kExact:
+        if (path_matcher.case_sensitive()) {
+          exact_paths_[path_matcher.string_matcher()].push_back(i);
+        } else {
+          exact_paths_ignore_case_[absl::AsciiStrToLower(
+                                       path_matcher.string_matcher())]
+              .push_back(i);
+          has_ignore_case_matchers_ = true;
+        }
+        break;
+      case StringMatcher::Type::kPrefix:
+        if (path_matcher.case_sensitive()) {
+          AddPrefix(&prefixes_, path_matcher.string_matcher(), i);
+        } else {
+          AddPrefix(&prefixes_ignore_case_,
+                    absl::AsciiStrToLower(path_matcher.string_matcher()), i);
+          has_ignore_case_matchers_ = true;
+        }
+        break;
+      case StringMatcher::Type::kSafeRegex:
+        regex_patterns.push_back(&path_matcher.regex_matcher()->pattern());
+        regex_routes_.push_back(i);
+        break;
+      default:
+        unindexed_routes_.push_back(i);
+    }
+  }
+  if (regex_patterns.empty()) return;
+  // StringMatcher uses RE2::FullMatch() with default options, so anchor
+  // both ends and use the same options here.
+  regex_set_ = std::make_unique<RE2::Set>(RE2::Options(), RE2::ANCHOR_BOTH);
+  bool ok = true;
+  for (const std::string* pattern : regex_patterns) {
+    if (regex_set_->Add(*pattern, nullptr) < 0) {
+      ok = false;
+      break;
+    }
+  }
+  if (!ok || !regex_set_->Compile()) {
+    // Should not happen, since each pattern has already compiled on its
+    // own, but if the combined set is too large, check each regex in turn.
+    gpr_log(GPR_ERROR,
+            "failed to build RE2::Set for %" PRIuPTR
+            " route regexes; matching them individually",
+            regex_patterns.size());
+    regex_set_.reset();
+    unindexed_routes_.insert(unindexed_routes_.end(), regex_routes_.begin(),
+                             regex_routes_.end());
+    regex_routes_.clear();
+  }
+}
+
+void XdsRouting::RouteIndex::AddPrefix(PrefixTrieNode* root,
+                                       absl::string_view prefix,
+                                       size_t index) {
+  PrefixTrieNode* node = root;
+  for (char c : prefix) {
+    auto& child = node->children[c];
+    if (child == nullptr) child = std::make_unique<PrefixTrieNode>();
+    node = child.get();
+  }
+  node->routes.push_back(index);
+}
+
+void XdsRouting::RouteIndex::FindPrefixMatches(const PrefixTrieNode& root,
+                                               absl::string_view path,
+                                               Candidates* candidates) {
+  const PrefixTrieNode* node = &root;
+  while (true) {
+    candidates->insert(candidates->end(), node->routes.begin(),
+                       node->routes.end());
+    if (path.empty()) return;
+    auto it = node->children.find(path.front());
+    if (it == node->children.end()) return;
+    node = it->second.get();
+    path.remove_prefix(1);
+  }
+}
+
+void XdsRouting::RouteIndex::FindRoutesForPath(
+    const RouteListIterator& route_list_iterator, absl::string_view path,
+    Candidates* candidates) const {
+  auto it = exact_paths_.find(path);
+  if (it != exact_paths_.end()) {
+    candidates->insert(candidates->end(), it->second.begin(),
+                       it->second.end());
+  }
+  FindPrefixMatches(prefixes_, path, candidates);
+  if (has_ignore_case_matchers_) {
+    std::string lower_path = absl::AsciiStrToLower(path);
+    it = exact_paths_ignore_case_.find(lower_path);
+    if (it != exact_paths_ignore_case_.end()) {
+      candidates->insert(candidates->end(), it->second.begin(),
+                         it->second.end());
+    }
+    FindPrefixMatches(prefixes_ignore_case_, lower_path, candidates);
+  }
+  if (regex_set_ != nullptr) {
+    std::vector<int> matches;
+    RE2::Set::ErrorInfo error_info;
+    if (regex_set_->Match(re2::StringPiece(path.data(), path.size()),
+                          &matches, &error_info)) {
+      for (int match : matches) candidates->push_back(regex_routes_[match]);
+    } else if (error_info.kind != RE2::Set::kNoError) {
+      // The DFA ran out of memory; fall back to checking each regex.
+      for (size_t i : regex_routes_) {
+        if (route_list_iterator.GetMatchersForRoute(i).path_matcher.Match(
+                path)) {
+          candidates->push_back(i);
+        }
+      }
+    }
+  }
+  for (size_t i : unindexed_routes_) {
+    if (route_list_iterator.GetMatchersForRoute(i).path_matcher.Match(path)) {
+      candidates->push_back(i);
+    }
+  }
+  std::sort(candidates->begin(), candidates->end());
+}
+
 bool XdsRouting::IsValidDomainPattern(absl::string_view domain_pattern) {
   return DomainPatternMatchType(domain_pattern) != INVALID_MATCH;
 }
@@ -24,12 +24,16 @@
 #include <stddef.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/inlined_vector.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "re2/set.h"
 
 #include "src/core/ext/xds/xds_http_filters.h"
 #include "src/core/ext/xds/xds_listener.h"
@@ -61,16 +65,83 @@ class XdsRouting {
         size_t index) const = 0;
   };
 
+  // An index over the path matchers of a route list, built once when the
+  // route config is updated.  Exact paths are looked up in a hash map,
+  // prefixes in a trie, and all regexes are matched in a single pass with
+  // an RE2::Set, so that the cost of finding the routes whose path
+  // matches no longer grows with the number of routes.
+  // The index refers to routes by their position in the iterator it was
+  // built from, so it must be rebuilt whenever the route list changes.
+  class RouteIndex {
+   public:
+    explicit RouteIndex(const RouteListIterator& route_list_iterator);
+
+    RouteIndex(const RouteIndex&) = delete;
+    RouteIndex& operator=(const RouteIndex&) = delete;
+
+    using Candidates = absl::InlinedVector<size_t, 8>;
+
+    // Adds to \a candidates the index of each route whose path matcher
+    // matches \a path.  The result is in ascending order.
+    // \a route_list_iterator must be equivalent to the one the index was
+    // built from.
+    void FindRoutesForPath(const RouteListIterator& route_list_iterator,
+                           absl::string_view path,
+                           Candidates* candidates) const;
+
+   private:
+    struct PrefixTrieNode {
+      // Routes whose prefix ends at this node, in ascending order.
+      std::vector<size_t> routes;
+      absl::flat_hash_map<char, std::unique_ptr<PrefixTrieNode>> children;
+    };
+
+    using ExactPathMap = absl::flat_hash_map<std::string, std::vector<size_t>>;
+
+    static void AddPrefix(PrefixTrieNode* root, absl::string_view prefix,
+                          size_t index);
+    static void FindPrefixMatches(const PrefixTrieNode& root,
+                                  absl::string_view path,
+                                  Candidates* candidates);
+
+    ExactPathMap exact_paths_;
+    // Keys are lower-cased.
+    ExactPathMap exact_paths_ignore_case_;
+    PrefixTrieNode prefixes_;
+    // Prefixes are lower-cased.
+    PrefixTrieNode prefixes_ignore_case_;
+    bool has_ignore_case_matchers_ = false;
+    // All regexes, anchored at both ends to match StringMatcher's
+    // semantics.  Null if there are no regexes.
+    std::unique_ptr<RE2::Set> regex_set_;
+    // Maps from regex_set_ index to route index.
+    std::vector<size_t> regex_routes_;
+    // Routes whose path matcher cannot be indexed.  Their matchers are
+    // evaluated directly on every lookup.
+    std::vector<size_t> unindexed_routes_;
+  };
+
   // Returns the index of the selected virtual host in the list.
   static absl::optional<size_t> FindVirtualHostForDomain(
       const VirtualHostListIterator& vhost_iterator, absl::string_view domain);
 
   // Returns the index in route_list_iterator to use for a request with
   // the specified path and metadata, or nullopt if no route matches.
+  // This checks every route in turn; callers that look up routes for
+  // many requests should build a RouteIndex and use the overload below.
   static absl::optional<size_t> GetRouteForRequest(
       const RouteListIterator& route_list_iterator, absl::string_view path,
       grpc_metadata_batch* initial_metadata);
 
+  // Same as above, but uses \a route_index to skip routes whose path
+  // does not match.  The result is always the same as that of the
+  // overload above.  \a route_index must have been built from
+  // \a route_list_iterator.
+  static absl::optional<size_t> GetRouteForRequest(
+      const RouteListIterator& route_list_iterator,
+      const RouteIndex& route_index, absl::string_view path,
+      grpc_metadata_batch* initial_metadata);
+
   // Returns true if \a domain_pattern is a valid domain pattern, false
   // otherwise.
   static bool IsValidDomainPattern(absl::string_view domain_pattern);
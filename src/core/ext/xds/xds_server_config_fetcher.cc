@@ -347,6 +347,7 @@ class XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
 
     std::vector<std::string> domains;
     std::vector<Route> routes;
+    std::unique_ptr<XdsRouting::RouteIndex> route_index;
   };
 
   class VirtualHostListIterator : public XdsRouting::VirtualHostListIterator {
@@ -1183,6 +1184,8 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
             ServiceConfigImpl::Create(result->args, json.c_str()).value();
       }
     }
+    virtual_host.route_index = std::make_unique<XdsRouting::RouteIndex>(
+        VirtualHost::RouteListIterator(&virtual_host.routes));
   }
   return config_selector;
 }
@@ -1210,7 +1213,8 @@ XdsServerConfigFetcher::ListenerWatcher::FilterChainMatchManager::
   }
   auto& virtual_host = virtual_hosts_[vhost_index.value()];
   auto route_index = XdsRouting::GetRouteForRequest(
-      VirtualHost::RouteListIterator(&virtual_host.routes), path, metadata);
+      VirtualHost::RouteListIterator(&virtual_host.routes),
+      *virtual_host.route_index, path, metadata);
   if (route_index.has_value()) {
     auto& route = virtual_host.routes[route_index.value()];
     // Found the matching route
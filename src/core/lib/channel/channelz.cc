@@ -562,9 +562,11 @@ Json SocketNode::RenderJson() {
 // ListenSocketNode
 //
 
-ListenSocketNode::ListenSocketNode(std::string local_addr, std::string name)
+ListenSocketNode::ListenSocketNode(std::string local_addr, std::string name,
+                                   MemoryQuotaRefPtr tenant_quota)
     : BaseNode(EntityType::kSocket, std::move(name)),
-      local_addr_(std::move(local_addr)) {}
+      local_addr_(std::move(local_addr)),
+      tenant_quota_(std::move(tenant_quota)) {}
 
 Json ListenSocketNode::RenderJson() {
   Json::Object object = {
@@ -575,6 +577,23 @@ Json ListenSocketNode::RenderJson() {
        }},
   };
   PopulateSocketAddressJson(&object, "local", local_addr_.c_str());
+  if (tenant_quota_ != nullptr) {
+    BasicMemoryQuota::ChildUsage usage = tenant_quota_->GetUsage();
+    auto option = [](std::string name, std::string value) {
+      return Json::Object{{"name", std::move(name)},
+                          {"value", std::move(value)}};
+    };
+    object["data"] = Json::Object{
+        {"option",
+         Json::Array{
+             option("grpc.tenant", usage.name),
+             option("grpc.tenant_used_bytes", std::to_string(usage.used_bytes)),
+             option("grpc.tenant_guaranteed_bytes",
+                    std::to_string(usage.guaranteed_bytes)),
+             option("grpc.tenant_weight", std::to_string(usage.weight)),
+         }},
+    };
+  }
   return object;
 }
 
@@ -26,6 +26,7 @@
 #include <atomic>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -45,6 +46,7 @@
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
 
 // Channel arg key for channelz node.
 #define GRPC_ARG_CHANNELZ_CHANNEL_NODE "grpc.internal.channelz_channel_node"
@@ -359,13 +361,18 @@ class SocketNode : public BaseNode {
 // Handles channelz bookkeeping for listen sockets
 class ListenSocketNode : public BaseNode {
  public:
-  ListenSocketNode(std::string local_addr, std::string name);
+  // If the port's connections are accounted to a tenant's quota, rather than
+  // the server's, tenant_quota is that quota and its usage is reported as
+  // socket options.
+  ListenSocketNode(std::string local_addr, std::string name,
+                   MemoryQuotaRefPtr tenant_quota = nullptr);
   ~ListenSocketNode() override {}
 
   Json RenderJson() override;
 
  private:
   std::string local_addr_;
+  MemoryQuotaRefPtr tenant_quota_;
 };
 
 }  // namespace channelz
@@ -45,6 +45,7 @@
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/context.h"
 #include "src/core/lib/debug/trace.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/gpr/alloc.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/match.h"
@@ -815,7 +816,8 @@ class ClientConnectedCallPromise {
   }
 
   static ArenaPromise<ServerMetadataHandle> Make(grpc_transport* transport,
-                                                 CallArgs call_args) {
+                                                 CallArgs call_args,
+                                                 NextPromiseFactory) {
     return ClientConnectedCallPromise(transport, std::move(call_args));
   }
 
@@ -825,8 +827,585 @@ class ClientConnectedCallPromise {
   OrphanablePtr<ClientStream> impl_;
 };
 
+class ServerStream final : public Orphanable {
+ public:
+  ServerStream(grpc_transport* transport,
+               NextPromiseFactory next_promise_factory)
+      : transport_(transport),
+        stream_(nullptr, StreamDeleter(this)),
+        next_promise_factory_(std::move(next_promise_factory)) {
+    call_context_->IncrementRefCount("server_stream");
+    GRPC_STREAM_REF_INIT(
+        &stream_refcount_, 1,
+        [](void* p, grpc_error_handle) {
+          static_cast<ServerStream*>(p)->BeginDestroy();
+        },
+        this, "server_stream");
+    // The transport expects the stream it announced to be initialized before
+    // its accept_stream callback returns.
+    stream_.reset(static_cast<grpc_stream*>(
+        GetContext<Arena>()->Alloc(transport_->vtable->sizeof_stream)));
+    grpc_transport_init_stream(transport_, stream_.get(), &stream_refcount_,
+                               server_call_context_->server_stream_data(),
+                               GetContext<Arena>());
+    MutexLock lock(&mu_);
+    memset(&recv_metadata_, 0, sizeof(recv_metadata_));
+    recv_metadata_.recv_initial_metadata = true;
+    recv_metadata_.recv_trailing_metadata = true;
+    recv_metadata_.payload = &batch_payload_;
+    recv_metadata_.on_complete = &recv_metadata_batch_done_;
+    client_initial_metadata_ =
+        GetContext<Arena>()->MakePooled<ClientMetadata>(GetContext<Arena>());
+    batch_payload_.recv_initial_metadata.recv_initial_metadata =
+        client_initial_metadata_.get();
+    batch_payload_.recv_initial_metadata.recv_initial_metadata_ready =
+        &recv_initial_metadata_ready_;
+    batch_payload_.recv_initial_metadata.trailing_metadata_available =
+        nullptr;
+    batch_payload_.recv_initial_metadata.peer_string =
+        call_context_->peer_string_atm_ptr();
+    client_trailing_metadata_ =
+        GetContext<Arena>()->MakePooled<ClientMetadata>(GetContext<Arena>());
+    batch_payload_.recv_trailing_metadata.recv_trailing_metadata =
+        client_trailing_metadata_.get();
+    batch_payload_.recv_trailing_metadata.collect_stats =
+        &call_context_->call_stats()->transport_stream_stats;
+    batch_payload_.recv_trailing_metadata.recv_trailing_metadata_ready =
+        &recv_trailing_metadata_ready_;
+    push_recv_metadata_ = true;
+    IncrementRefCount("recv_metadata_batch_done");
+    IncrementRefCount("initial_metadata_ready");
+    IncrementRefCount("trailing_metadata_ready");
+    initial_metadata_waker_ = Activity::current()->MakeOwningWaker();
+    trailing_metadata_waker_ = Activity::current()->MakeOwningWaker();
+    SchedulePush();
+  }
+
+  void Orphan() override {
+    bool finished;
+    {
+      MutexLock lock(&mu_);
+      if (grpc_call_trace.enabled()) {
+        gpr_log(GPR_INFO, "%sDropServerStream: finished=%d",
+                Activity::current()->DebugTag().c_str(), finished_);
+      }
+      finished = finished_;
+      // The rest of the call stack goes with us.
+      promise_ = ArenaPromise<ServerMetadataHandle>();
+    }
+    // If we hadn't already observed the stream to be finished, we need to
+    // cancel it at the transport.
+    if (!finished) {
+      IncrementRefCount("shutdown server stream");
+      auto* cancel_op =
+          GetContext<Arena>()->New<grpc_transport_stream_op_batch>();
+      cancel_op->cancel_stream = true;
+      cancel_op->payload = &batch_payload_;
+      auto* stream = stream_.get();
+      cancel_op->on_complete = NewClosure(
+          [this](grpc_error_handle) { Unref("shutdown server stream"); });
+      batch_payload_.cancel_stream.cancel_error = absl::CancelledError();
+      grpc_transport_perform_stream_op(transport_, stream, cancel_op);
+    }
+    Unref("orphan server stream");
+  }
+
+  void IncrementRefCount(const char* reason) {
+#ifndef NDEBUG
+    grpc_stream_ref(&stream_refcount_, reason);
+#else
+    (void)reason;
+    grpc_stream_ref(&stream_refcount_);
+#endif
+  }
+
+  void Unref(const char* reason) {
+#ifndef NDEBUG
+    grpc_stream_unref(&stream_refcount_, reason);
+#else
+    (void)reason;
+    grpc_stream_unref(&stream_refcount_);
+#endif
+  }
+
+  void BeginDestroy() {
+    if (stream_ != nullptr) {
+      stream_.reset();
+    } else {
+      StreamDestroyed();
+    }
+  }
+
+  Poll<ServerMetadataHandle> PollOnce() {
+    MutexLock lock(&mu_);
+    GPR_ASSERT(!finished_);
+
+    if (grpc_call_trace.enabled()) {
+      gpr_log(GPR_INFO,
+              "%sPollServerStream: initial_metadata=%d trailers=%d "
+              "recv_trailing_metadata=%d",
+              Activity::current()->DebugTag().c_str(),
+              static_cast<int>(client_initial_metadata_state_),
+              static_cast<int>(trailing_metadata_state_),
+              recv_trailing_metadata_ready_seen_);
+    }
+
+    auto push_recv_message = [this]() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+      recv_message_state_ = PendingReceiveMessage{};
+      auto& pending_recv_message =
+          absl::get<PendingReceiveMessage>(recv_message_state_);
+      memset(&recv_message_, 0, sizeof(recv_message_));
+      recv_message_.payload = &batch_payload_;
+      recv_message_.on_complete = nullptr;
+      recv_message_.recv_message = true;
+      batch_payload_.recv_message.recv_message = &pending_recv_message.payload;
+      batch_payload_.recv_message.flags = &pending_recv_message.flags;
+      batch_payload_.recv_message.call_failed_before_recv_message = nullptr;
+      batch_payload_.recv_message.recv_message_ready =
+          &recv_message_batch_done_;
+      IncrementRefCount("recv_message");
+      recv_message_waker_ = Activity::current()->MakeOwningWaker();
+      push_recv_message_ = true;
+      SchedulePush();
+    };
+
+    // A stream that failed at the transport takes the call with it.
+    if (recv_trailing_metadata_ready_seen_ &&
+        !recv_trailing_metadata_error_.ok()) {
+      return Cancelled();
+    }
+
+    switch (client_initial_metadata_state_) {
+      case ClientInitialMetadataState::kNotReceived:
+        return Pending{};
+      case ClientInitialMetadataState::kReceivedButNotSet: {
+        client_initial_metadata_state_ = ClientInitialMetadataState::kSet;
+        if (!recv_initial_metadata_error_.ok()) return Cancelled();
+        // Start the rest of the call stack, whose top hands the call to the
+        // application.
+        client_to_server_messages_ =
+            server_call_context_->client_to_server_messages();
+        server_to_client_messages_ =
+            server_call_context_->server_to_client_messages();
+        promise_ = next_promise_factory_(CallArgs{
+            std::move(client_initial_metadata_),
+            &server_initial_metadata_,
+            server_to_client_messages_,
+            client_to_server_messages_,
+        });
+        push_recv_message();
+      } break;
+      case ClientInitialMetadataState::kSet:
+        break;
+    }
+
+    if (promise_.has_value()) {
+      auto r = promise_();
+      if (auto* md = absl::get_if<ServerMetadataHandle>(&r)) {
+        server_trailing_metadata_ = std::move(*md);
+        promise_ = ArenaPromise<ServerMetadataHandle>();
+      }
+    }
+
+    if (!sent_initial_metadata_ &&
+        trailing_metadata_state_ == TrailingMetadataState::kNotSent) {
+      auto r = server_initial_metadata_.Wait()();
+      if (ServerMetadata*** md = absl::get_if<ServerMetadata**>(&r)) {
+        memset(&send_initial_metadata_, 0, sizeof(send_initial_metadata_));
+        send_initial_metadata_.send_initial_metadata = true;
+        send_initial_metadata_.payload = &batch_payload_;
+        send_initial_metadata_.on_complete =
+            &send_initial_metadata_batch_done_;
+        batch_payload_.send_initial_metadata.send_initial_metadata = **md;
+        batch_payload_.send_initial_metadata.peer_string = nullptr;
+        sent_initial_metadata_ = true;
+        IncrementRefCount("send_initial_metadata");
+        push_send_initial_metadata_ = true;
+        SchedulePush();
+      }
+    }
+
+    // Messages follow initial metadata; the end of them is our cue that the
+    // trailing metadata is on its way.
+    if (sent_initial_metadata_) {
+      if (absl::holds_alternative<Idle>(send_message_state_)) {
+        message_to_send_.reset();
+        send_message_state_ = server_to_client_messages_->Next();
+      }
+      if (auto* next = absl::get_if<PipeReceiver<MessageHandle>::NextType>(
+              &send_message_state_)) {
+        auto r = (*next)();
+        if (auto* p = absl::get_if<NextResult<MessageHandle>>(&r)) {
+          if (p->has_value()) {
+            message_to_send_ = std::move(**p);
+            send_message_state_ = SendMessageToTransport{};
+            memset(&send_message_, 0, sizeof(send_message_));
+            send_message_.send_message = true;
+            send_message_.payload = &batch_payload_;
+            send_message_.on_complete = &send_message_batch_done_;
+            batch_payload_.send_message.send_message =
+                message_to_send_->payload();
+            batch_payload_.send_message.flags = message_to_send_->flags();
+            IncrementRefCount("send_message");
+            send_message_waker_ = Activity::current()->MakeOwningWaker();
+            push_send_message_ = true;
+            SchedulePush();
+          } else {
+            send_message_state_ = Closed{};
+            server_call_context_->ServerToClientMessagesDrained();
+          }
+        }
+      }
+    }
+
+    if (server_trailing_metadata_ != nullptr &&
+        trailing_metadata_state_ == TrailingMetadataState::kNotSent &&
+        !absl::holds_alternative<SendMessageToTransport>(
+            send_message_state_)) {
+      memset(&send_trailing_metadata_, 0, sizeof(send_trailing_metadata_));
+      send_trailing_metadata_.send_trailing_metadata = true;
+      send_trailing_metadata_.payload = &batch_payload_;
+      send_trailing_metadata_.on_complete = &send_trailing_metadata_batch_done_;
+      batch_payload_.send_trailing_metadata.send_trailing_metadata =
+          server_trailing_metadata_.get();
+      batch_payload_.send_trailing_metadata.sent = &trailing_metadata_sent_;
+      trailing_metadata_state_ = TrailingMetadataState::kSending;
+      IncrementRefCount("send_trailing_metadata");
+      send_trailing_metadata_waker_ = Activity::current()->MakeOwningWaker();
+      push_send_trailing_metadata_ = true;
+      SchedulePush();
+    }
+
+    if (auto* pending =
+            absl::get_if<PendingReceiveMessage>(&recv_message_state_)) {
+      if (pending->received) {
+        if (pending->payload.has_value()) {
+          recv_message_state_ = client_to_server_messages_->Push(
+              GetContext<Arena>()->MakePooled<Message>(
+                  std::move(*pending->payload), pending->flags));
+        } else {
+          recv_message_state_ = Closed{};
+          std::exchange(client_to_server_messages_, nullptr)->Close();
+        }
+      }
+    }
+    if (auto* push = absl::get_if<PipeSender<MessageHandle>::PushType>(
+            &recv_message_state_)) {
+      auto r = (*push)();
+      if (bool* result = absl::get_if<bool>(&r)) {
+        if (*result) {
+          push_recv_message();
+        } else {
+          recv_message_state_ = Closed{};
+        }
+      }
+    }
+
+    if (trailing_metadata_state_ == TrailingMetadataState::kSent &&
+        recv_trailing_metadata_ready_seen_) {
+      if (!trailing_metadata_sent_) return Cancelled();
+      if (grpc_call_trace.enabled()) {
+        gpr_log(GPR_INFO, "%sPollServerStream: finished request, returning %s",
+                Activity::current()->DebugTag().c_str(),
+                server_trailing_metadata_->DebugString().c_str());
+      }
+      finished_ = true;
+      return std::move(server_trailing_metadata_);
+    }
+    return Pending{};
+  }
+
+  void RecvInitialMetadataReady(grpc_error_handle error) {
+    {
+      MutexLock lock(&mu_);
+      recv_initial_metadata_error_ = error;
+      client_initial_metadata_state_ =
+          ClientInitialMetadataState::kReceivedButNotSet;
+      initial_metadata_waker_.Wakeup();
+    }
+    Unref("initial_metadata_ready");
+  }
+
+  void RecvTrailingMetadataReady(grpc_error_handle error) {
+    {
+      MutexLock lock(&mu_);
+      // chttp2 reports a client that cancelled or reset the stream as a
+      // successful batch with a synthesized non-OK status.
+      if (error.ok()) {
+        absl::optional<grpc_status_code> status =
+            client_trailing_metadata_->get(GrpcStatusMetadata());
+        if (status.has_value() && *status != GRPC_STATUS_OK) {
+          error = grpc_error_set_int(GRPC_ERROR_CREATE("Cancelled by client"),
+                                     StatusIntProperty::kRpcStatus,
+                                     static_cast<intptr_t>(*status));
+        }
+      }
+      recv_trailing_metadata_error_ = error;
+      recv_trailing_metadata_ready_seen_ = true;
+      trailing_metadata_waker_.Wakeup();
+    }
+    Unref("trailing_metadata_ready");
+  }
+
+  void RecvMetadataBatchDone(grpc_error_handle) {
+    Unref("recv_metadata_batch_done");
+  }
+
+  void SendInitialMetadataBatchDone(grpc_error_handle) {
+    Unref("send_initial_metadata");
+  }
+
+  void SendMessageBatchDone(grpc_error_handle error) {
+    {
+      MutexLock lock(&mu_);
+      // On error the transport closes the stream, which ends the call: no
+      // need to send anything else.
+      send_message_state_ = error.ok() ? SendMessageState(Idle{}) : Closed{};
+      send_message_waker_.Wakeup();
+    }
+    Unref("send_message");
+  }
+
+  void SendTrailingMetadataBatchDone(grpc_error_handle) {
+    {
+      MutexLock lock(&mu_);
+      trailing_metadata_state_ = TrailingMetadataState::kSent;
+      send_trailing_metadata_waker_.Wakeup();
+    }
+    Unref("send_trailing_metadata");
+  }
+
+  void RecvMessageBatchDone(grpc_error_handle error) {
+    {
+      MutexLock lock(&mu_);
+      auto* pending = absl::get_if<PendingReceiveMessage>(&recv_message_state_);
+      GPR_ASSERT(pending != nullptr);
+      GPR_ASSERT(pending->received == false);
+      // A failed read ends the stream of messages.
+      if (!error.ok()) pending->payload.reset();
+      pending->received = true;
+      recv_message_waker_.Wakeup();
+    }
+    Unref("recv_message");
+  }
+
+  // Called from outside the activity to push work down to the transport.
+  void Push() {
+    auto do_push = [this](grpc_transport_stream_op_batch* batch) {
+      if (stream_ != nullptr) {
+        grpc_transport_perform_stream_op(transport_, stream_.get(), batch);
+      } else {
+        grpc_transport_stream_op_batch_finish_with_failure_from_transport(
+            batch, absl::CancelledError());
+      }
+    };
+    bool push_recv_metadata;
+    bool push_send_initial_metadata;
+    bool push_send_message;
+    bool push_send_trailing_metadata;
+    bool push_recv_message;
+    {
+      MutexLock lock(&mu_);
+      push_recv_metadata = std::exchange(push_recv_metadata_, false);
+      push_send_initial_metadata =
+          std::exchange(push_send_initial_metadata_, false);
+      push_send_message = std::exchange(push_send_message_, false);
+      push_send_trailing_metadata =
+          std::exchange(push_send_trailing_metadata_, false);
+      push_recv_message = std::exchange(push_recv_message_, false);
+      scheduled_push_ = false;
+    }
+    if (push_recv_metadata) do_push(&recv_metadata_);
+    if (push_send_initial_metadata) do_push(&send_initial_metadata_);
+    if (push_send_message) do_push(&send_message_);
+    if (push_send_trailing_metadata) do_push(&send_trailing_metadata_);
+    if (push_recv_message) do_push(&recv_message_);
+    Unref("push");
+  }
+
+  void StreamDestroyed() {
+    call_context_->RunInContext([this] {
+      auto* cc = call_context_;
+      this->~ServerStream();
+      cc->Unref("server_stream");
+    });
+  }
+
+ private:
+  struct Idle {};
+  struct Closed {};
+  struct SendMessageToTransport {};
+  using SendMessageState =
+      absl::variant<Idle, Closed, PipeReceiver<MessageHandle>::NextType,
+                    SendMessageToTransport>;
+
+  enum class ClientInitialMetadataState : uint8_t {
+    // Initial metadata has not been received from the client.
+    kNotReceived,
+    // Initial metadata has been received from the client via the transport,
+    // but the call stack above has not been started with it.
+    kReceivedButNotSet,
+    // The call stack above has been started.
+    kSet,
+  };
+
+  enum class TrailingMetadataState : uint8_t {
+    kNotSent,
+    kSending,
+    kSent,
+  };
+
+  class StreamDeleter {
+   public:
+    explicit StreamDeleter(ServerStream* impl) : impl_(impl) {}
+    void operator()(grpc_stream* stream) const {
+      if (stream == nullptr) return;
+      grpc_transport_destroy_stream(impl_->transport_, stream,
+                                    &impl_->stream_destroyed_);
+    }
+
+   private:
+    ServerStream* impl_;
+  };
+  using StreamPtr = std::unique_ptr<grpc_stream, StreamDeleter>;
+
+  void SchedulePush() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (std::exchange(scheduled_push_, true)) return;
+    IncrementRefCount("push");
+    ExecCtx::Run(DEBUG_LOCATION, &push_, absl::OkStatus());
+  }
+
+  // The result for a stream that ended without our trailing metadata
+  // reaching the client.
+  ServerMetadataHandle Cancelled() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    finished_ = true;
+    auto md = ServerMetadataFromStatus(absl::CancelledError());
+    md->Set(GrpcStatusFromWire(), true);
+    return md;
+  }
+
+  Mutex mu_;
+  bool push_recv_metadata_ ABSL_GUARDED_BY(mu_) = false;
+  bool push_send_initial_metadata_ ABSL_GUARDED_BY(mu_) = false;
+  bool push_send_message_ ABSL_GUARDED_BY(mu_) = false;
+  bool push_send_trailing_metadata_ ABSL_GUARDED_BY(mu_) = false;
+  bool push_recv_message_ ABSL_GUARDED_BY(mu_) = false;
+  bool scheduled_push_ ABSL_GUARDED_BY(mu_) = false;
+  ClientInitialMetadataState client_initial_metadata_state_
+      ABSL_GUARDED_BY(mu_) = ClientInitialMetadataState::kNotReceived;
+  grpc_error_handle recv_initial_metadata_error_ ABSL_GUARDED_BY(mu_);
+  bool recv_trailing_metadata_ready_seen_ ABSL_GUARDED_BY(mu_) = false;
+  grpc_error_handle recv_trailing_metadata_error_ ABSL_GUARDED_BY(mu_);
+  bool sent_initial_metadata_ ABSL_GUARDED_BY(mu_) = false;
+  TrailingMetadataState trailing_metadata_state_ ABSL_GUARDED_BY(mu_) =
+      TrailingMetadataState::kNotSent;
+  // Set by the transport if the trailing metadata made it to the wire.
+  bool trailing_metadata_sent_ = false;
+  bool finished_ ABSL_GUARDED_BY(mu_) = false;
+  CallContext* const call_context_{GetContext<CallContext>()};
+  ServerCallContext* const server_call_context_{
+      call_context_->server_call_context()};
+  Waker initial_metadata_waker_ ABSL_GUARDED_BY(mu_);
+  Waker trailing_metadata_waker_ ABSL_GUARDED_BY(mu_);
+  Waker send_message_waker_ ABSL_GUARDED_BY(mu_);
+  Waker send_trailing_metadata_waker_ ABSL_GUARDED_BY(mu_);
+  Waker recv_message_waker_ ABSL_GUARDED_BY(mu_);
+  grpc_transport* const transport_;
+  grpc_stream_refcount stream_refcount_;
+  StreamPtr stream_;
+  NextPromiseFactory next_promise_factory_;
+  // The rest of the call stack, once client initial metadata is in.
+  ArenaPromise<ServerMetadataHandle> promise_ ABSL_GUARDED_BY(mu_);
+  Latch<ServerMetadata*> server_initial_metadata_ ABSL_GUARDED_BY(mu_);
+  PipeReceiver<MessageHandle>* server_to_client_messages_
+      ABSL_GUARDED_BY(mu_) = nullptr;
+  PipeSender<MessageHandle>* client_to_server_messages_ ABSL_GUARDED_BY(mu_) =
+      nullptr;
+  MessageHandle message_to_send_ ABSL_GUARDED_BY(mu_);
+  SendMessageState send_message_state_ ABSL_GUARDED_BY(mu_);
+  struct PendingReceiveMessage {
+    absl::optional<SliceBuffer> payload;
+    uint32_t flags;
+    bool received = false;
+  };
+  absl::variant<Idle, PendingReceiveMessage, Closed,
+                PipeSender<MessageHandle>::PushType>
+      recv_message_state_ ABSL_GUARDED_BY(mu_);
+  grpc_closure recv_initial_metadata_ready_ =
+      MakeMemberClosure<ServerStream, &ServerStream::RecvInitialMetadataReady>(
+          this, DEBUG_LOCATION);
+  grpc_closure recv_trailing_metadata_ready_ =
+      MakeMemberClosure<ServerStream, &ServerStream::RecvTrailingMetadataReady>(
+          this, DEBUG_LOCATION);
+  grpc_closure push_ = MakeMemberClosure<ServerStream, &ServerStream::Push>(
+      this, DEBUG_LOCATION);
+  ClientMetadataHandle client_initial_metadata_;
+  ClientMetadataHandle client_trailing_metadata_;
+  ServerMetadataHandle server_trailing_metadata_;
+  grpc_transport_stream_op_batch recv_metadata_;
+  grpc_closure recv_metadata_batch_done_ =
+      MakeMemberClosure<ServerStream, &ServerStream::RecvMetadataBatchDone>(
+          this, DEBUG_LOCATION);
+  grpc_transport_stream_op_batch send_initial_metadata_;
+  grpc_closure send_initial_metadata_batch_done_ =
+      MakeMemberClosure<ServerStream,
+                        &ServerStream::SendInitialMetadataBatchDone>(
+          this, DEBUG_LOCATION);
+  grpc_transport_stream_op_batch send_message_;
+  grpc_closure send_message_batch_done_ =
+      MakeMemberClosure<ServerStream, &ServerStream::SendMessageBatchDone>(
+          this, DEBUG_LOCATION);
+  grpc_transport_stream_op_batch send_trailing_metadata_;
+  grpc_closure send_trailing_metadata_batch_done_ =
+      MakeMemberClosure<ServerStream,
+                        &ServerStream::SendTrailingMetadataBatchDone>(
+          this, DEBUG_LOCATION);
+  grpc_closure recv_message_batch_done_ =
+      MakeMemberClosure<ServerStream, &ServerStream::RecvMessageBatchDone>(
+          this, DEBUG_LOCATION);
+  grpc_transport_stream_op_batch recv_message_;
+  grpc_transport_stream_op_batch_payload batch_payload_{
+      GetContext<grpc_call_context_element>()};
+  grpc_closure stream_destroyed_ =
+      MakeMemberClosure<ServerStream, &ServerStream::StreamDestroyed>(
+          this, DEBUG_LOCATION);
+};
+
+class ServerConnectedCallPromise {
+ public:
+  ServerConnectedCallPromise(grpc_transport* transport,
+                             NextPromiseFactory next_promise_factory)
+      : impl_(GetContext<Arena>()->New<ServerStream>(
+            transport, std::move(next_promise_factory))) {}
+
+  ServerConnectedCallPromise(const ServerConnectedCallPromise&) = delete;
+  ServerConnectedCallPromise& operator=(const ServerConnectedCallPromise&) =
+      delete;
+  ServerConnectedCallPromise(ServerConnectedCallPromise&& other) noexcept
+      : impl_(std::exchange(other.impl_, nullptr)) {}
+  ServerConnectedCallPromise& operator=(
+      ServerConnectedCallPromise&& other) noexcept {
+    impl_ = std::move(other.impl_);
+    return *this;
+  }
+
+  // The call args are empty: the server call stack is built from the bottom
+  // up, and the transport supplies them.
+  static ArenaPromise<ServerMetadataHandle> Make(
+      grpc_transport* transport, CallArgs,
+      NextPromiseFactory next_promise_factory) {
+    return ServerConnectedCallPromise(transport,
+                                      std::move(next_promise_factory));
+  }
+
+  Poll<ServerMetadataHandle> operator()() { return impl_->PollOnce(); }
+
+ private:
+  OrphanablePtr<ServerStream> impl_;
+};
+
 template <ArenaPromise<ServerMetadataHandle> (*make_call_promise)(
-    grpc_transport*, CallArgs)>
+    grpc_transport*, CallArgs, NextPromiseFactory)>
 grpc_channel_filter MakeConnectedFilter() {
   // Create a vtable that contains both the legacy call methods (for filter
   // stack based calls) and the new promise based method for creating promise
@@ -839,10 +1418,11 @@ grpc_channel_filter MakeConnectedFilter() {
         make_call_promise == nullptr
             ? nullptr
             : +[](grpc_channel_element* elem, CallArgs call_args,
-                 NextPromiseFactory) {
+                 NextPromiseFactory next) {
                 grpc_transport* transport =
                     static_cast<channel_data*>(elem->channel_data)->transport;
-                return make_call_promise(transport, std::move(call_args));
+                return make_call_promise(transport, std::move(call_args),
+                                         std::move(next));
               },
       connected_channel_start_transport_op,
       sizeof(call_data),
@@ -868,7 +1448,7 @@ grpc_channel_filter MakeConnectedFilter() {
 }
 
 ArenaPromise<ServerMetadataHandle> MakeTransportCallPromise(
-    grpc_transport* transport, CallArgs call_args) {
+    grpc_transport* transport, CallArgs call_args, NextPromiseFactory) {
   return transport->vtable->make_call_promise(transport, std::move(call_args));
 }
 
@@ -878,6 +1458,9 @@ const grpc_channel_filter kPromiseBasedTransportFilter =
 const grpc_channel_filter kClientEmulatedFilter =
     MakeConnectedFilter<ClientConnectedCallPromise::Make>();
 
+const grpc_channel_filter kServerEmulatedFilter =
+    MakeConnectedFilter<ServerConnectedCallPromise::Make>();
+
 const grpc_channel_filter kNoPromiseFilter = MakeConnectedFilter<nullptr>();
 
 }  // namespace
@@ -901,8 +1484,12 @@ bool grpc_add_connected_filter(grpc_core::ChannelStackBuilder* builder) {
     // on the client and so we have an implementation that we can use to convert
     // to batches.
     builder->AppendFilter(&grpc_core::kClientEmulatedFilter);
+  } else if (grpc_core::IsPromiseBasedServerCallEnabled()) {
+    // Option 3: the transport does not support promise based calls, we're on
+    // the server, and the server emulation of them has been asked for.
+    builder->AppendFilter(&grpc_core::kServerEmulatedFilter);
   } else {
-    // Option 3: the transport does not support promise based calls, and we're
+    // Option 4: the transport does not support promise based calls, and we're
     // on the server so we can't construct promise based calls just yet.
     builder->AppendFilter(&grpc_core::kNoPromiseFilter);
   }
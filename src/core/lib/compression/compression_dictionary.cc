@@ -0,0 +1,156 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/compression/compression_dictionary.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include <zconf.h>
+#include <zlib.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/compression/compression_internal.h"
+
+namespace grpc_core {
+
+namespace {
+
+void* ZAlloc(void* /*opaque*/, unsigned int items, unsigned int size) {
+  return gpr_malloc(items * size);
+}
+
+void ZFree(void* /*opaque*/, void* address) { gpr_free(address); }
+
+void DestroyDeflater(z_stream* zs) {
+  deflateEnd(zs);
+  delete zs;
+}
+
+void DestroyInflater(z_stream* zs) {
+  inflateEnd(zs);
+  delete zs;
+}
+
+}  // namespace
+
+//
+// CompressionDictionary
+//
+
+absl::StatusOr<RefCountedPtr<CompressionDictionary>>
+CompressionDictionary::Create(grpc_compression_algorithm algorithm,
+                              std::string data) {
+  if (data.empty()) {
+    return absl::InvalidArgumentError("compression dictionary is empty");
+  }
+  switch (algorithm) {
+    case GRPC_COMPRESS_DEFLATE_DICTIONARY: {
+      // This is the DICTID that zlib writes into the stream header.
+      const uint32_t id = static_cast<uint32_t>(
+          adler32(adler32(0, nullptr, 0),
+                  reinterpret_cast<const Bytef*>(data.data()),
+                  static_cast<uInt>(data.size())));
+      return RefCountedPtr<CompressionDictionary>(
+          new CompressionDictionary(algorithm, std::move(data), id));
+    }
+    default:
+      return absl::InvalidArgumentError(
+          absl::StrCat("algorithm ", algorithm, " does not use a dictionary"));
+  }
+}
+
+CompressionDictionary::CompressionDictionary(
+    grpc_compression_algorithm algorithm, std::string data, uint32_t id)
+    : algorithm_(algorithm),
+      data_(std::move(data)),
+      id_(id),
+      name_(DeflateDictionaryToken(id)) {}
+
+CompressionDictionary::~CompressionDictionary() {
+  for (z_stream* zs : deflaters_.TakeAll()) DestroyDeflater(zs);
+  for (z_stream* zs : inflaters_.TakeAll()) DestroyInflater(zs);
+}
+
+z_stream* CompressionDictionary::AcquireDeflater() {
+  z_stream* zs = deflaters_.Take();
+  if (zs != nullptr) return zs;
+  zs = new z_stream;
+  memset(zs, 0, sizeof(*zs));
+  zs->zalloc = ZAlloc;
+  zs->zfree = ZFree;
+  GPR_ASSERT(deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15, 8,
+                          Z_DEFAULT_STRATEGY) == Z_OK);
+  GPR_ASSERT(deflateSetDictionary(zs,
+                                  reinterpret_cast<const Bytef*>(data_.data()),
+                                  static_cast<uInt>(data_.size())) == Z_OK);
+  return zs;
+}
+
+void CompressionDictionary::ReleaseDeflater(z_stream* zs) {
+  // Resetting drops the dictionary, so load it again right away: that is
+  // much cheaper than a new deflateInit2() and keeps Acquire fast.
+  if (deflateReset(zs) != Z_OK ||
+      deflateSetDictionary(zs, reinterpret_cast<const Bytef*>(data_.data()),
+                           static_cast<uInt>(data_.size())) != Z_OK ||
+      !deflaters_.Put(zs)) {
+    DestroyDeflater(zs);
+  }
+}
+
+z_stream* CompressionDictionary::AcquireInflater() {
+  z_stream* zs = inflaters_.Take();
+  if (zs != nullptr) return zs;
+  zs = new z_stream;
+  memset(zs, 0, sizeof(*zs));
+  zs->zalloc = ZAlloc;
+  zs->zfree = ZFree;
+  zs->opaque = this;
+  GPR_ASSERT(inflateInit2(zs, 15) == Z_OK);
+  return zs;
+}
+
+void CompressionDictionary::ReleaseInflater(z_stream* zs) {
+  if (inflateReset(zs) != Z_OK || !inflaters_.Put(zs)) DestroyInflater(zs);
+}
+
+int CompressionDictionary::InflateWithDictionary(z_stream* zs, int flush) {
+  int r = inflate(zs, flush);
+  if (r == Z_NEED_DICT) {
+    auto* dictionary = static_cast<const CompressionDictionary*>(zs->opaque);
+    // zlib puts the DICTID into adler when it needs a dictionary.
+    if (zs->adler != dictionary->id_) {
+      gpr_log(GPR_INFO, "zlib: message needs dictionary %08x, but ours is %08x",
+              static_cast<uint32_t>(zs->adler), dictionary->id_);
+      return Z_DATA_ERROR;
+    }
+    r = inflateSetDictionary(
+        zs, reinterpret_cast<const Bytef*>(dictionary->data_.data()),
+        static_cast<uInt>(dictionary->data_.size()));
+    if (r != Z_OK) return r;
+    r = inflate(zs, flush);
+  }
+  return r;
+}
+
+}  // namespace grpc_core
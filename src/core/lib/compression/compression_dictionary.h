@@ -0,0 +1,140 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_COMPRESSION_COMPRESSION_DICTIONARY_H
+#define GRPC_CORE_LIB_COMPRESSION_COMPRESSION_DICTIONARY_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/impl/compression_types.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/gprpp/ref_counted.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/gprpp/sync.h"
+
+struct z_stream_s;
+
+namespace grpc_core {
+
+// A preset dictionary for small-message compression.
+//
+// Messages of a few hundred bytes barely compress on their own, because
+// the compressor starts every message with an empty history.  Seeding it
+// with a dictionary of typical content fixes that, as long as both peers
+// use the same dictionary.  Dictionaries are therefore identified by an ID
+// that peers advertise in grpc-accept-encoding ("deflate-dict-<id>"), so
+// that a dictionary encoding is only used with peers that have the same
+// one.  The ID is also carried in each compressed message (the zlib
+// DICTID), so a mismatch is detected rather than producing garbage.
+//
+// A dictionary belongs to the channels and servers whose channel args hold
+// it (see ChannelArgName()); there is no process-wide one.  Setting up a
+// compressor with a dictionary is expensive, so contexts are initialized
+// once and recycled between messages of all of those channels.
+class CompressionDictionary : public RefCounted<CompressionDictionary> {
+ public:
+  // algorithm must be GRPC_COMPRESS_DEFLATE_DICTIONARY.
+  static absl::StatusOr<RefCountedPtr<CompressionDictionary>> Create(
+      grpc_compression_algorithm algorithm, std::string data);
+
+  ~CompressionDictionary() override;
+
+  CompressionDictionary(const CompressionDictionary&) = delete;
+  CompressionDictionary& operator=(const CompressionDictionary&) = delete;
+
+  static absl::string_view ChannelArgName() {
+    return "grpc.internal.compression_dictionary";
+  }
+  static int ChannelArgsCompare(const CompressionDictionary* a,
+                                const CompressionDictionary* b) {
+    return QsortCompare(a, b);
+  }
+
+  grpc_compression_algorithm algorithm() const { return algorithm_; }
+  uint32_t id() const { return id_; }
+  // The token that advertises this dictionary in grpc-accept-encoding.
+  const std::string& name() const { return name_; }
+
+  // Contexts ready to process a new message with this dictionary.  They
+  // must be handed back with the matching Release method, whether or not
+  // the message was processed successfully.
+  z_stream_s* AcquireDeflater();
+  void ReleaseDeflater(z_stream_s* zs);
+  // The inflater supplies the dictionary itself when the stream asks for
+  // it; see InflateWithDictionary().
+  z_stream_s* AcquireInflater();
+  void ReleaseInflater(z_stream_s* zs);
+
+  // Drop-in replacement for inflate() on streams returned by
+  // AcquireInflater(): loads the dictionary when the stream needs it, after
+  // checking that the stream was compressed with this dictionary.
+  static int InflateWithDictionary(z_stream_s* zs, int flush);
+
+ private:
+  // Idle contexts of one kind.  Only a bounded number is kept, so that a
+  // burst of concurrent calls does not pin memory forever.
+  template <typename T>
+  class Pool {
+   public:
+    T* Take() {
+      MutexLock lock(&mu_);
+      if (idle_.empty()) return nullptr;
+      T* context = idle_.back();
+      idle_.pop_back();
+      return context;
+    }
+    // Returns false if the pool is full; the caller must then free context.
+    bool Put(T* context) {
+      MutexLock lock(&mu_);
+      if (idle_.size() >= kMaxIdleContexts) return false;
+      idle_.push_back(context);
+      return true;
+    }
+    std::vector<T*> TakeAll() {
+      MutexLock lock(&mu_);
+      return std::move(idle_);
+    }
+
+   private:
+    static constexpr size_t kMaxIdleContexts = 16;
+    Mutex mu_;
+    std::vector<T*> idle_ ABSL_GUARDED_BY(mu_);
+  };
+
+  CompressionDictionary(grpc_compression_algorithm algorithm,
+                        std::string data, uint32_t id);
+
+  const grpc_compression_algorithm algorithm_;
+  const std::string data_;
+  const uint32_t id_;
+  const std::string name_;
+  Pool<z_stream_s> deflaters_;
+  Pool<z_stream_s> inflaters_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_COMPRESSION_COMPRESSION_DICTIONARY_H
@@ -26,12 +26,16 @@
 
 #include "absl/container/inlined_vector.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
 #include "absl/types/variant.h"
 
 #include <grpc/support/log.h>
 
 #include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/compression/compression_dictionary.h"
 #include "src/core/lib/debug/trace.h"
 #include "src/core/lib/surface/api_trace.h"
 
@@ -45,6 +49,11 @@ const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm) {
       return "deflate";
     case GRPC_COMPRESS_GZIP:
       return "gzip";
+    case GRPC_COMPRESS_DEFLATE_DICTIONARY:
+      // The dictionary itself is identified by each message.
+      return "deflate-dict";
+    case GRPC_COMPRESS_DEFLATE_STREAM:
+      return "deflate-stream";
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
     default:
       return nullptr;
@@ -52,6 +61,11 @@ const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm) {
 }
 
 namespace {
+// The dictionary algorithm is advertised with the ID of its dictionary, so
+// it is left out of the precomputed lists.
+constexpr uint32_t kDictionaryBit = 1u << GRPC_COMPRESS_DEFLATE_DICTIONARY;
+constexpr absl::string_view kDeflateDictionaryTokenPrefix = "deflate-dict-";
+
 class CommaSeparatedLists {
  public:
   CommaSeparatedLists() : lists_{}, text_buffer_{} {
@@ -61,6 +75,10 @@ class CommaSeparatedLists {
       *text_buffer++ = c;
     };
     for (size_t list = 0; list < kNumLists; ++list) {
+      if ((list & kDictionaryBit) != 0) {
+        lists_[list] = lists_[list & ~kDictionaryBit];
+        continue;
+      }
       char* start = text_buffer;
       for (size_t algorithm = 0; algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT;
            ++algorithm) {
@@ -85,12 +103,27 @@ class CommaSeparatedLists {
  private:
   static constexpr size_t kNumLists = 1 << GRPC_COMPRESS_ALGORITHMS_COUNT;
   // Experimentally determined (tweak things until it runs).
-  static constexpr size_t kTextBufferSize = 86;
+  static constexpr size_t kTextBufferSize = 298;
   absl::string_view lists_[kNumLists];
   char text_buffer_[kTextBufferSize];
 };
 
 const CommaSeparatedLists kCommaSeparatedLists;
+
+// Parses a token made by DeflateDictionaryToken().
+absl::optional<uint32_t> ParseDeflateDictionaryToken(absl::string_view token) {
+  if (!absl::ConsumePrefix(&token, kDeflateDictionaryTokenPrefix) ||
+      token.size() != 8) {
+    return absl::nullopt;
+  }
+  uint32_t id = 0;
+  for (char c : token) {
+    if (!absl::ascii_isxdigit(c)) return absl::nullopt;
+    id = id << 4 | (absl::ascii_isdigit(c) ? c - '0'
+                                           : absl::ascii_tolower(c) - 'a' + 10);
+  }
+  return id;
+}
 }  // namespace
 
 absl::optional<grpc_compression_algorithm> ParseCompressionAlgorithm(
@@ -101,11 +134,35 @@ absl::optional<grpc_compression_algorithm> ParseCompressionAlgorithm(
     return GRPC_COMPRESS_DEFLATE;
   } else if (algorithm == "gzip") {
     return GRPC_COMPRESS_GZIP;
+  } else if (algorithm == "deflate-dict") {
+    return GRPC_COMPRESS_DEFLATE_DICTIONARY;
+  } else if (algorithm == "deflate-stream") {
+    return GRPC_COMPRESS_DEFLATE_STREAM;
   } else {
     return absl::nullopt;
   }
 }
 
+std::string DeflateDictionaryToken(uint32_t id) {
+  return absl::StrFormat("%s%08x", kDeflateDictionaryTokenPrefix, id);
+}
+
+bool IsCompressionAlgorithmSupported(grpc_compression_algorithm algorithm) {
+  switch (algorithm) {
+    case GRPC_COMPRESS_NONE:
+    case GRPC_COMPRESS_DEFLATE:
+    case GRPC_COMPRESS_GZIP:
+      return true;
+    case GRPC_COMPRESS_DEFLATE_DICTIONARY:
+      return false;
+    case GRPC_COMPRESS_DEFLATE_STREAM:
+      return true;
+    case GRPC_COMPRESS_ALGORITHMS_COUNT:
+    default:
+      return false;
+  }
+}
+
 grpc_compression_algorithm
 CompressionAlgorithmSet::CompressionAlgorithmForLevel(
     grpc_compression_level level) const {
@@ -126,12 +183,15 @@ CompressionAlgorithmSet::CompressionAlgorithmForLevel(
   /* Establish a "ranking" or compression algorithms in increasing order of
    * compression.
    * This is simplistic and we will probably want to introduce other dimensions
-   * in the future (cpu/memory cost, etc). */
+   * in the future (cpu/memory cost, etc). Algorithms that this process cannot
+   * compress with are skipped even if the peer accepts them. deflate-dict
+   * needs the channel's dictionary and deflate-stream keeps a context for the
+   * whole call, so they are only used when asked for by name. */
   absl::InlinedVector<grpc_compression_algorithm,
                       GRPC_COMPRESS_ALGORITHMS_COUNT>
       algos;
   for (auto algo : {GRPC_COMPRESS_GZIP, GRPC_COMPRESS_DEFLATE}) {
-    if (set_.is_set(algo)) {
+    if (set_.is_set(algo) && IsCompressionAlgorithmSupported(algo)) {
       algos.push_back(algo);
     }
   }
@@ -166,12 +226,33 @@ CompressionAlgorithmSet CompressionAlgorithmSet::FromUint32(uint32_t value) {
 
 CompressionAlgorithmSet CompressionAlgorithmSet::FromChannelArgs(
     const ChannelArgs& args) {
-  CompressionAlgorithmSet set;
   static const uint32_t kEverything =
       (1u << GRPC_COMPRESS_ALGORITHMS_COUNT) - 1;
-  return CompressionAlgorithmSet::FromUint32(
+  const uint32_t enabled =
       args.GetInt(GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET)
-          .value_or(kEverything));
+          .value_or(kEverything);
+  CompressionAlgorithmSet set = Supported(args);
+  for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    if ((enabled & (1u << i)) == 0) set.set_.clear(i);
+  }
+  return set;
+}
+
+CompressionAlgorithmSet CompressionAlgorithmSet::Supported() {
+  CompressionAlgorithmSet set;
+  for (size_t i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    auto algorithm = static_cast<grpc_compression_algorithm>(i);
+    if (IsCompressionAlgorithmSupported(algorithm)) set.Set(algorithm);
+  }
+  return set;
+}
+
+CompressionAlgorithmSet CompressionAlgorithmSet::Supported(
+    const ChannelArgs& args) {
+  CompressionAlgorithmSet set = Supported();
+  auto* dictionary = args.GetObject<CompressionDictionary>();
+  if (dictionary != nullptr) set.SetDictionary(dictionary->id());
+  return set;
 }
 
 CompressionAlgorithmSet::CompressionAlgorithmSet() = default;
@@ -200,21 +281,44 @@ void CompressionAlgorithmSet::Set(grpc_compression_algorithm algorithm) {
   }
 }
 
-absl::string_view CompressionAlgorithmSet::ToString() const {
-  return kCommaSeparatedLists[ToLegacyBitmask()];
+void CompressionAlgorithmSet::SetDictionary(uint32_t id) {
+  set_.set(GRPC_COMPRESS_DEFLATE_DICTIONARY);
+  dictionary_id_ = id;
+}
+
+bool CompressionAlgorithmSet::HasDictionary(uint32_t id) const {
+  return set_.is_set(GRPC_COMPRESS_DEFLATE_DICTIONARY) && dictionary_id_ == id;
+}
+
+std::string CompressionAlgorithmSet::ToString() const {
+  const uint32_t list = ToLegacyBitmask();
+  std::string text(kCommaSeparatedLists[list]);
+  if ((list & kDictionaryBit) != 0) {
+    absl::StrAppend(&text, text.empty() ? "" : ", ",
+                    DeflateDictionaryToken(dictionary_id_));
+  }
+  return text;
 }
 
 Slice CompressionAlgorithmSet::ToSlice() const {
-  return Slice::FromStaticString(ToString());
+  const uint32_t list = ToLegacyBitmask();
+  if ((list & kDictionaryBit) != 0) return Slice::FromCopiedString(ToString());
+  return Slice::FromStaticString(kCommaSeparatedLists[list]);
 }
 
 CompressionAlgorithmSet CompressionAlgorithmSet::FromString(
     absl::string_view str) {
   CompressionAlgorithmSet set{GRPC_COMPRESS_NONE};
   for (auto algorithm : absl::StrSplit(str, ',')) {
-    auto parsed =
-        ParseCompressionAlgorithm(absl::StripAsciiWhitespace(algorithm));
-    if (parsed.has_value()) {
+    algorithm = absl::StripAsciiWhitespace(algorithm);
+    // A dictionary is only accepted along with its ID.
+    auto dictionary_id = ParseDeflateDictionaryToken(algorithm);
+    if (dictionary_id.has_value()) {
+      set.SetDictionary(*dictionary_id);
+      continue;
+    }
+    auto parsed = ParseCompressionAlgorithm(algorithm);
+    if (parsed.has_value() && *parsed != GRPC_COMPRESS_DEFLATE_DICTIONARY) {
       set.Set(*parsed);
     }
   }
@@ -24,6 +24,7 @@
 #include <stdint.h>
 
 #include <initializer_list>
+#include <string>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -47,6 +48,13 @@ const char* CompressionAlgorithmAsString(grpc_compression_algorithm algorithm);
 // if not found.
 absl::optional<grpc_compression_algorithm>
 DefaultCompressionAlgorithmFromChannelArgs(const ChannelArgs& args);
+// Return true if this process can compress and decompress with algorithm.
+// Dictionary algorithms are never supported process-wide: they need the
+// dictionary from a channel's args.
+bool IsCompressionAlgorithmSupported(grpc_compression_algorithm algorithm);
+// The grpc-accept-encoding token for GRPC_COMPRESS_DEFLATE_DICTIONARY with
+// the dictionary identified by id, e.g. "deflate-dict-1a2b3c4d".
+std::string DeflateDictionaryToken(uint32_t id);
 
 // A set of grpc_compression_algorithm values.
 class CompressionAlgorithmSet {
@@ -54,8 +62,14 @@ class CompressionAlgorithmSet {
   // Construct from a uint32_t bitmask - bit 0 => algorithm 0, bit 1 =>
   // algorithm 1, etc.
   static CompressionAlgorithmSet FromUint32(uint32_t value);
-  // Locate in channel args and construct from the found value.
+  // Locate in channel args and construct from the found value.  Algorithms
+  // that a channel with args does not support are never included.
   static CompressionAlgorithmSet FromChannelArgs(const ChannelArgs& args);
+  // The set of algorithms that this process supports.
+  static CompressionAlgorithmSet Supported();
+  // The set of algorithms that a channel with args supports: Supported(),
+  // plus the dictionary algorithm if args hold a dictionary.
+  static CompressionAlgorithmSet Supported(const ChannelArgs& args);
   // Parse a string of comma-separated compression algorithms.
   static CompressionAlgorithmSet FromString(absl::string_view str);
   // Construct an empty set.
@@ -72,20 +86,29 @@ class CompressionAlgorithmSet {
   bool IsSet(grpc_compression_algorithm algorithm) const;
   // Add algorithm to this set.
   void Set(grpc_compression_algorithm algorithm);
+  // Add GRPC_COMPRESS_DEFLATE_DICTIONARY with the dictionary identified by
+  // id.
+  void SetDictionary(uint32_t id);
+  // Return true if this set contains GRPC_COMPRESS_DEFLATE_DICTIONARY with
+  // the dictionary identified by id.
+  bool HasDictionary(uint32_t id) const;
 
   // Return a comma separated string of the algorithms in this set.
-  absl::string_view ToString() const;
+  std::string ToString() const;
   Slice ToSlice() const;
 
   // Return a bitmask of the algorithms in this set.
   uint32_t ToLegacyBitmask() const;
 
   bool operator==(const CompressionAlgorithmSet& other) const {
-    return set_ == other.set_;
+    return set_ == other.set_ && dictionary_id_ == other.dictionary_id_;
   }
 
  private:
   BitSet<GRPC_COMPRESS_ALGORITHMS_COUNT> set_;
+  // Identifies the dictionary of GRPC_COMPRESS_DEFLATE_DICTIONARY, if that
+  // is in set_.
+  uint32_t dictionary_id_ = 0;
 };
 
 }  // namespace grpc_core
@@ -29,6 +29,8 @@
 #include <grpc/support/alloc.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/compression/compression_dictionary.h"
+#include "src/core/lib/compression/stream_compress.h"
 #include "src/core/lib/slice/slice.h"
 
 #define OUTPUT_BLOCK_SIZE 1024
@@ -93,20 +95,29 @@ static void* zalloc_gpr(void* /*opaque*/, unsigned int items,
 
 static void zfree_gpr(void* /*opaque*/, void* address) { gpr_free(address); }
 
+/* With a dictionary, the z_stream comes ready-made from the dictionary's
+   pool and goes back there afterwards. */
 static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                         int gzip) {
-  z_stream zs;
+                         int gzip,
+                         grpc_core::CompressionDictionary* dictionary) {
+  z_stream zs_storage;
+  z_stream* zs;
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | (gzip ? 16 : 0),
-                   8, Z_DEFAULT_STRATEGY);
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, deflate) && output->length < input->length;
+  if (dictionary != nullptr) {
+    zs = dictionary->AcquireDeflater();
+  } else {
+    zs = &zs_storage;
+    memset(zs, 0, sizeof(*zs));
+    zs->zalloc = zalloc_gpr;
+    zs->zfree = zfree_gpr;
+    r = deflateInit2(zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                     15 | (gzip ? 16 : 0), 8, Z_DEFAULT_STRATEGY);
+    GPR_ASSERT(r == Z_OK);
+  }
+  r = zlib_body(zs, input, output, deflate) && output->length < input->length;
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_core::CSliceUnref(output->slices[i]);
@@ -114,23 +125,37 @@ static int zlib_compress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  deflateEnd(&zs);
+  if (dictionary != nullptr) {
+    dictionary->ReleaseDeflater(zs);
+  } else {
+    deflateEnd(zs);
+  }
   return r;
 }
 
 static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
-                           int gzip) {
-  z_stream zs;
+                           int gzip,
+                           grpc_core::CompressionDictionary* dictionary) {
+  z_stream zs_storage;
+  z_stream* zs;
   int r;
   size_t i;
   size_t count_before = output->count;
   size_t length_before = output->length;
-  memset(&zs, 0, sizeof(zs));
-  zs.zalloc = zalloc_gpr;
-  zs.zfree = zfree_gpr;
-  r = inflateInit2(&zs, 15 | (gzip ? 16 : 0));
-  GPR_ASSERT(r == Z_OK);
-  r = zlib_body(&zs, input, output, inflate);
+  if (dictionary != nullptr) {
+    zs = dictionary->AcquireInflater();
+  } else {
+    zs = &zs_storage;
+    memset(zs, 0, sizeof(*zs));
+    zs->zalloc = zalloc_gpr;
+    zs->zfree = zfree_gpr;
+    r = inflateInit2(zs, 15 | (gzip ? 16 : 0));
+    GPR_ASSERT(r == Z_OK);
+  }
+  r = zlib_body(zs, input, output,
+                dictionary != nullptr
+                    ? grpc_core::CompressionDictionary::InflateWithDictionary
+                    : inflate);
   if (!r) {
     for (i = count_before; i < output->count; i++) {
       grpc_core::CSliceUnref(output->slices[i]);
@@ -138,10 +163,39 @@ static int zlib_decompress(grpc_slice_buffer* input, grpc_slice_buffer* output,
     output->count = count_before;
     output->length = length_before;
   }
-  inflateEnd(&zs);
+  if (dictionary != nullptr) {
+    dictionary->ReleaseInflater(zs);
+  } else {
+    inflateEnd(zs);
+  }
   return r;
 }
 
+/* On its own, a deflate-stream message is compressed as the first message of
+   a new stream.  Callers that keep the stream going use
+   grpc_core::DeflateStreamCompressor directly. */
+static int deflate_stream_compress(grpc_slice_buffer* input,
+                                   grpc_slice_buffer* output) {
+  grpc_core::DeflateStreamCompressor compressor;
+  size_t i;
+  size_t count_before = output->count;
+  size_t length_before = output->length;
+  if (!compressor.Compress(input, output)) return 0;
+  if (output->length - length_before < input->length) return 1;
+  for (i = count_before; i < output->count; i++) {
+    grpc_core::CSliceUnref(output->slices[i]);
+  }
+  output->count = count_before;
+  output->length = length_before;
+  return 0;
+}
+
+static int deflate_stream_decompress(grpc_slice_buffer* input,
+                                     grpc_slice_buffer* output) {
+  grpc_core::DeflateStreamDecompressor decompressor;
+  return decompressor.Decompress(input, output);
+}
+
 static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
   size_t i;
   for (i = 0; i < input->count; i++) {
@@ -151,16 +205,26 @@ static int copy(grpc_slice_buffer* input, grpc_slice_buffer* output) {
 }
 
 static int compress_inner(grpc_compression_algorithm algorithm,
-                          grpc_slice_buffer* input, grpc_slice_buffer* output) {
+                          grpc_slice_buffer* input, grpc_slice_buffer* output,
+                          grpc_core::CompressionDictionary* dictionary) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       /* the fallback path always needs to be send uncompressed: we simply
          rely on that here */
       return 0;
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_compress(input, output, 0);
+      return zlib_compress(input, output, 0, nullptr);
     case GRPC_COMPRESS_GZIP:
-      return zlib_compress(input, output, 1);
+      return zlib_compress(input, output, 1, nullptr);
+    case GRPC_COMPRESS_DEFLATE_DICTIONARY:
+      if (dictionary == nullptr) {
+        gpr_log(GPR_ERROR, "compression algorithm %d needs a dictionary",
+                algorithm);
+        return 0;
+      }
+      return zlib_compress(input, output, 0, dictionary);
+    case GRPC_COMPRESS_DEFLATE_STREAM:
+      return deflate_stream_compress(input, output);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
@@ -169,8 +233,9 @@ static int compress_inner(grpc_compression_algorithm algorithm,
 }
 
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
-                      grpc_slice_buffer* input, grpc_slice_buffer* output) {
-  if (!compress_inner(algorithm, input, output)) {
+                      grpc_slice_buffer* input, grpc_slice_buffer* output,
+                      grpc_core::CompressionDictionary* dictionary) {
+  if (!compress_inner(algorithm, input, output, dictionary)) {
     copy(input, output);
     return 0;
   }
@@ -178,14 +243,24 @@ int grpc_msg_compress(grpc_compression_algorithm algorithm,
 }
 
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
-                        grpc_slice_buffer* input, grpc_slice_buffer* output) {
+                        grpc_slice_buffer* input, grpc_slice_buffer* output,
+                        grpc_core::CompressionDictionary* dictionary) {
   switch (algorithm) {
     case GRPC_COMPRESS_NONE:
       return copy(input, output);
     case GRPC_COMPRESS_DEFLATE:
-      return zlib_decompress(input, output, 0);
+      return zlib_decompress(input, output, 0, nullptr);
     case GRPC_COMPRESS_GZIP:
-      return zlib_decompress(input, output, 1);
+      return zlib_decompress(input, output, 1, nullptr);
+    case GRPC_COMPRESS_DEFLATE_DICTIONARY:
+      if (dictionary == nullptr) {
+        gpr_log(GPR_ERROR, "compression algorithm %d needs a dictionary",
+                algorithm);
+        return 0;
+      }
+      return zlib_decompress(input, output, 0, dictionary);
+    case GRPC_COMPRESS_DEFLATE_STREAM:
+      return deflate_stream_decompress(input, output);
     case GRPC_COMPRESS_ALGORITHMS_COUNT:
       break;
   }
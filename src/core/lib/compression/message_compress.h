@@ -24,16 +24,25 @@
 #include <grpc/impl/compression_types.h>
 #include <grpc/slice.h>
 
+namespace grpc_core {
+class CompressionDictionary;
+}  // namespace grpc_core
+
 /* compress 'input' to 'output' using 'algorithm'.
+   GRPC_COMPRESS_DEFLATE_DICTIONARY needs 'dictionary'; other algorithms
+   ignore it.
    On success, appends compressed slices to output and returns 1.
    On failure, appends uncompressed slices to output and returns 0. */
 int grpc_msg_compress(grpc_compression_algorithm algorithm,
-                      grpc_slice_buffer* input, grpc_slice_buffer* output);
+                      grpc_slice_buffer* input, grpc_slice_buffer* output,
+                      grpc_core::CompressionDictionary* dictionary = nullptr);
 
-/* decompress 'input' to 'output' using 'algorithm'.
+/* decompress 'input' to 'output' using 'algorithm', and 'dictionary' as for
+   grpc_msg_compress().
    On success, appends slices to output and returns 1.
    On failure, output is unchanged, and returns 0. */
 int grpc_msg_decompress(grpc_compression_algorithm algorithm,
-                        grpc_slice_buffer* input, grpc_slice_buffer* output);
+                        grpc_slice_buffer* input, grpc_slice_buffer* output,
+                        grpc_core::CompressionDictionary* dictionary = nullptr);
 
 #endif /* GRPC_CORE_LIB_COMPRESSION_MESSAGE_COMPRESS_H */
@@ -0,0 +1,212 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/compression/stream_compress.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <zconf.h>
+#include <zlib.h>
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/alloc.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/slice/slice.h"
+
+namespace grpc_core {
+
+namespace {
+
+// The context lives as long as the call, so it uses a smaller window than
+// per-message DEFLATE: about 100 KiB instead of 256 KiB per call.  That
+// still spans several of the small messages this mode is meant for.  Raw
+// DEFLATE does not record the window size, so the decompressor always uses
+// the largest one, which lets the compressor's choice change freely.
+constexpr int kCompressWindowBits = 13;
+constexpr int kCompressMemLevel = 7;
+constexpr int kDecompressWindowBits = 15;
+
+constexpr size_t kMinBlockSize = 1024;
+constexpr size_t kMaxBlockSize = 64 * 1024;
+
+void* ZAlloc(void* /*opaque*/, unsigned int items, unsigned int size) {
+  return gpr_malloc(items * size);
+}
+
+void ZFree(void* /*opaque*/, void* address) { gpr_free(address); }
+
+z_stream* NewZStream() {
+  z_stream* zs = new z_stream;
+  memset(zs, 0, sizeof(*zs));
+  zs->zalloc = ZAlloc;
+  zs->zfree = ZFree;
+  return zs;
+}
+
+// Feeds input through flate, appending the output to output in blocks of
+// block_size bytes.  With flush_at_end, flate is finally called with
+// Z_SYNC_FLUSH until all pending output has been written.  zs->data_type is
+// left as set by the last call that made progress.  On failure, output is
+// restored to its previous state.
+bool RunFlate(z_stream* zs, grpc_slice_buffer* input,
+              grpc_slice_buffer* output, int (*flate)(z_stream*, int),
+              bool flush_at_end, size_t block_size) {
+  const size_t count_before = output->count;
+  const size_t length_before = output->length;
+  grpc_slice block = grpc_slice_malloc_large(block_size);
+  zs->next_out = GRPC_SLICE_START_PTR(block);
+  zs->avail_out = static_cast<uInt>(block_size);
+  bool ok = true;
+  // One extra round with no input to flush.
+  const size_t rounds = input->count + (flush_at_end ? 1 : 0);
+  for (size_t i = 0; ok && i < rounds; ++i) {
+    const bool last = flush_at_end && i == input->count;
+    if (last) {
+      zs->next_in = nullptr;
+      zs->avail_in = 0;
+    } else {
+      GPR_ASSERT(GRPC_SLICE_LENGTH(input->slices[i]) <= ~uInt{0});
+      zs->next_in = GRPC_SLICE_START_PTR(input->slices[i]);
+      zs->avail_in = static_cast<uInt>(GRPC_SLICE_LENGTH(input->slices[i]));
+    }
+    do {
+      if (zs->avail_out == 0) {
+        grpc_slice_buffer_add_indexed(output, block);
+        block = grpc_slice_malloc_large(block_size);
+        zs->next_out = GRPC_SLICE_START_PTR(block);
+        zs->avail_out = static_cast<uInt>(block_size);
+      }
+      const uInt avail_in_before = zs->avail_in;
+      const int data_type_before = zs->data_type;
+      const int r = flate(zs, last ? Z_SYNC_FLUSH : Z_NO_FLUSH);
+      // A call that made no progress still marks the inflate state as being
+      // past a block boundary; report the state of the last one that did.
+      if (r == Z_BUF_ERROR) zs->data_type = data_type_before;
+      // Z_BUF_ERROR just means that there was nothing left to do, unless
+      // input is stuck.  Z_STREAM_END is an error too: the compressor never
+      // finishes the stream.
+      if ((r != Z_OK && r != Z_BUF_ERROR) ||
+          (r == Z_BUF_ERROR && zs->avail_in != 0 &&
+           zs->avail_in == avail_in_before && zs->avail_out != 0)) {
+        gpr_log(GPR_INFO, "deflate-stream: zlib error (%d)", r);
+        ok = false;
+        break;
+      }
+      // A full block may mean that more output is pending.
+    } while (zs->avail_in != 0 || zs->avail_out == 0);
+  }
+  if (!ok) {
+    CSliceUnref(block);
+    for (size_t i = count_before; i < output->count; ++i) {
+      CSliceUnref(output->slices[i]);
+    }
+    output->count = count_before;
+    output->length = length_before;
+    return false;
+  }
+  GPR_ASSERT(block.refcount);
+  block.data.refcounted.length -= zs->avail_out;
+  if (GRPC_SLICE_LENGTH(block) > 0) {
+    grpc_slice_buffer_add_indexed(output, block);
+  } else {
+    CSliceUnref(block);
+  }
+  return true;
+}
+
+}  // namespace
+
+//
+// DeflateStreamCompressor
+//
+
+DeflateStreamCompressor::DeflateStreamCompressor() : zs_(NewZStream()) {
+  GPR_ASSERT(deflateInit2(zs_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                          -kCompressWindowBits, kCompressMemLevel,
+                          Z_DEFAULT_STRATEGY) == Z_OK);
+}
+
+DeflateStreamCompressor::~DeflateStreamCompressor() {
+  deflateEnd(zs_);
+  delete zs_;
+}
+
+bool DeflateStreamCompressor::Compress(grpc_slice_buffer* input,
+                                       grpc_slice_buffer* output) {
+  if (failed_) return false;
+  // Every message ends in a flush, so nothing is pending from the previous
+  // one and this bounds the whole output.
+  const size_t bound =
+      deflateBound(zs_, static_cast<uLong>(input->length)) + 6;
+  if (!RunFlate(zs_, input, output, deflate, /*flush_at_end=*/true,
+                std::min(bound, kMaxBlockSize))) {
+    failed_ = true;
+  }
+  return !failed_;
+}
+
+//
+// DeflateStreamDecompressor
+//
+
+DeflateStreamDecompressor::DeflateStreamDecompressor() : zs_(NewZStream()) {
+  GPR_ASSERT(inflateInit2(zs_, -kDecompressWindowBits) == Z_OK);
+}
+
+DeflateStreamDecompressor::~DeflateStreamDecompressor() {
+  inflateEnd(zs_);
+  delete zs_;
+}
+
+bool DeflateStreamDecompressor::Decompress(grpc_slice_buffer* input,
+                                           grpc_slice_buffer* output) {
+  if (failed_) return false;
+  // zlib skips the flush of an empty message that follows another flush,
+  // leaving nothing to decompress.
+  if (input->length == 0) return true;
+  const size_t block_size =
+      std::max(kMinBlockSize, std::min(4 * input->length, kMaxBlockSize));
+  const size_t count_before = output->count;
+  const size_t length_before = output->length;
+  if (!RunFlate(zs_, input, output, inflate, /*flush_at_end=*/false,
+                block_size)) {
+    failed_ = true;
+    return false;
+  }
+  // A complete message ends right after the empty stored block of its
+  // flush: inflate is then at a block boundary (128), with no bits left
+  // over and outside of a final block.  Anything else means that the
+  // message was truncated.
+  if (zs_->data_type != 128) {
+    gpr_log(GPR_INFO, "deflate-stream: incomplete message");
+    for (size_t i = count_before; i < output->count; ++i) {
+      CSliceUnref(output->slices[i]);
+    }
+    output->count = count_before;
+    output->length = length_before;
+    failed_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace grpc_core
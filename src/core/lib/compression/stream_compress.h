@@ -0,0 +1,81 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef GRPC_CORE_LIB_COMPRESSION_STREAM_COMPRESS_H
+#define GRPC_CORE_LIB_COMPRESSION_STREAM_COMPRESS_H
+
+#include <grpc/support/port_platform.h>
+
+#include <grpc/slice.h>
+
+struct z_stream_s;
+
+namespace grpc_core {
+
+// GRPC_COMPRESS_DEFLATE_STREAM ("deflate-stream") compresses all messages
+// sent in one direction of a call as a single raw DEFLATE stream (RFC 1951).
+// Each message is terminated with a sync flush, i.e. the empty stored block
+// 00 00 ff ff, so that it can be decompressed as soon as it arrives.  The
+// history window carries over from one message to the next, so a stream of
+// similar messages compresses far better than the messages do on their own,
+// and the compression context is set up once per call instead of once per
+// message.
+//
+// Because of the shared history, every message that goes through the
+// compressor must go through the peer's decompressor, in the same order.
+// Messages that are sent uncompressed must bypass both.
+
+class DeflateStreamCompressor {
+ public:
+  DeflateStreamCompressor();
+  ~DeflateStreamCompressor();
+
+  DeflateStreamCompressor(const DeflateStreamCompressor&) = delete;
+  DeflateStreamCompressor& operator=(const DeflateStreamCompressor&) = delete;
+
+  // Appends the next message of the stream to output and returns true.  On
+  // failure, output is unchanged, false is returned, and so is every later
+  // call: the peer can no longer follow the stream.
+  bool Compress(grpc_slice_buffer* input, grpc_slice_buffer* output);
+
+ private:
+  z_stream_s* zs_;
+  bool failed_ = false;
+};
+
+class DeflateStreamDecompressor {
+ public:
+  DeflateStreamDecompressor();
+  ~DeflateStreamDecompressor();
+
+  DeflateStreamDecompressor(const DeflateStreamDecompressor&) = delete;
+  DeflateStreamDecompressor& operator=(const DeflateStreamDecompressor&) =
+      delete;
+
+  // Appends the next message of the stream to output and returns true.
+  // input must be exactly one message as produced by the peer's
+  // DeflateStreamCompressor.  On failure, output is unchanged and false is
+  // returned, as for every later call.
+  bool Decompress(grpc_slice_buffer* input, grpc_slice_buffer* output);
+
+ private:
+  z_stream_s* zs_;
+  bool failed_ = false;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_COMPRESSION_STREAM_COMPRESS_H
@@ -75,9 +75,12 @@ const absl::string_view
     GlobalStats::counter_name[static_cast<int>(Counter::COUNT)] = {
         "client_calls_created",
         "server_calls_created",
+        "arena_allocations",
         "client_channels_created",
         "client_subchannels_created",
         "server_channels_created",
+        "server_pending_calls_shed",
+        "server_pending_calls_expired",
         "syscall_write",
         "syscall_read",
         "tcp_read_alloc_8k",
@@ -95,9 +98,15 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
     Counter::COUNT)] = {
     "Number of client side calls created by this process",
     "Number of server side calls created by this process",
+    "Number of heap allocations made for arenas, for their initial blocks and "
+    "for later zones",
     "Number of client channels created",
     "Number of client subchannels created",
     "Number of server channels created",
+    "Number of server calls rejected with RESOURCE_EXHAUSTED because the "
+    "pending call queue was full or overloaded, or too slow for their deadline",
+    "Number of server calls failed with DEADLINE_EXCEEDED because their "
+    "deadline passed before the application requested them",
     "Number of write syscalls (or equivalent - eg sendmsg) made by this "
     "process",
     "Number of read syscalls (or equivalent - eg recvmsg) made by this process",
@@ -119,13 +128,20 @@ const absl::string_view GlobalStats::counter_doc[static_cast<int>(
 };
 const absl::string_view
     GlobalStats::histogram_name[static_cast<int>(Histogram::COUNT)] = {
-        "call_initial_size",       "tcp_write_size", "tcp_write_iov_size",
-        "tcp_read_size",           "tcp_read_offer", "tcp_read_offer_iov_size",
+        "call_initial_size",
+        "server_pending_call_queue_time",
+        "tcp_write_size",
+        "tcp_write_iov_size",
+        "tcp_read_size",
+        "tcp_read_offer",
+        "tcp_read_offer_iov_size",
         "http2_send_message_size",
 };
 const absl::string_view
     GlobalStats::histogram_doc[static_cast<int>(Histogram::COUNT)] = {
         "Initial size of the grpc_call arena created at call start",
+        "Time in milliseconds server calls waited in the pending call queue "
+        "for the application to request them",
         "Number of bytes offered to each syscall_write",
         "Number of byte segments offered to each syscall_write",
         "Number of bytes received by each syscall_read",
@@ -214,9 +230,12 @@ int Histogram_80_10::BucketFor(int value) {
 GlobalStats::GlobalStats()
     : client_calls_created{0},
       server_calls_created{0},
+      arena_allocations{0},
       client_channels_created{0},
       client_subchannels_created{0},
       server_channels_created{0},
+      server_pending_calls_shed{0},
+      server_pending_calls_expired{0},
       syscall_write{0},
       syscall_read{0},
       tcp_read_alloc_8k{0},
@@ -236,6 +255,9 @@ HistogramView GlobalStats::histogram(Histogram which) const {
     case Histogram::kCallInitialSize:
       return HistogramView{&Histogram_32768_24::BucketFor, kStatsTable0, 24,
                            call_initial_size.buckets()};
+    case Histogram::kServerPendingCallQueueTime:
+      return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
+                           server_pending_call_queue_time.buckets()};
     case Histogram::kTcpWriteSize:
       return HistogramView{&Histogram_16777216_20::BucketFor, kStatsTable2, 20,
                            tcp_write_size.buckets()};
@@ -263,12 +285,18 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
         data.client_calls_created.load(std::memory_order_relaxed);
     result->server_calls_created +=
         data.server_calls_created.load(std::memory_order_relaxed);
+    result->arena_allocations +=
+        data.arena_allocations.load(std::memory_order_relaxed);
     result->client_channels_created +=
         data.client_channels_created.load(std::memory_order_relaxed);
     result->client_subchannels_created +=
         data.client_subchannels_created.load(std::memory_order_relaxed);
     result->server_channels_created +=
         data.server_channels_created.load(std::memory_order_relaxed);
+    result->server_pending_calls_shed +=
+        data.server_pending_calls_shed.load(std::memory_order_relaxed);
+    result->server_pending_calls_expired +=
+        data.server_pending_calls_expired.load(std::memory_order_relaxed);
     result->syscall_write += data.syscall_write.load(std::memory_order_relaxed);
     result->syscall_read += data.syscall_read.load(std::memory_order_relaxed);
     result->tcp_read_alloc_8k +=
@@ -292,6 +320,8 @@ std::unique_ptr<GlobalStats> GlobalStatsCollector::Collect() const {
     result->cq_callback_creates +=
         data.cq_callback_creates.load(std::memory_order_relaxed);
     data.call_initial_size.Collect(&result->call_initial_size);
+    data.server_pending_call_queue_time.Collect(
+        &result->server_pending_call_queue_time);
     data.tcp_write_size.Collect(&result->tcp_write_size);
     data.tcp_write_iov_size.Collect(&result->tcp_write_iov_size);
     data.tcp_read_size.Collect(&result->tcp_read_size);
@@ -307,12 +337,17 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
       client_calls_created - other.client_calls_created;
   result->server_calls_created =
       server_calls_created - other.server_calls_created;
+  result->arena_allocations = arena_allocations - other.arena_allocations;
   result->client_channels_created =
       client_channels_created - other.client_channels_created;
   result->client_subchannels_created =
       client_subchannels_created - other.client_subchannels_created;
   result->server_channels_created =
       server_channels_created - other.server_channels_created;
+  result->server_pending_calls_shed =
+      server_pending_calls_shed - other.server_pending_calls_shed;
+  result->server_pending_calls_expired =
+      server_pending_calls_expired - other.server_pending_calls_expired;
   result->syscall_write = syscall_write - other.syscall_write;
   result->syscall_read = syscall_read - other.syscall_read;
   result->tcp_read_alloc_8k = tcp_read_alloc_8k - other.tcp_read_alloc_8k;
@@ -328,6 +363,8 @@ std::unique_ptr<GlobalStats> GlobalStats::Diff(const GlobalStats& other) const {
   result->cq_next_creates = cq_next_creates - other.cq_next_creates;
   result->cq_callback_creates = cq_callback_creates - other.cq_callback_creates;
   result->call_initial_size = call_initial_size - other.call_initial_size;
+  result->server_pending_call_queue_time =
+      server_pending_call_queue_time - other.server_pending_call_queue_time;
   result->tcp_write_size = tcp_write_size - other.tcp_write_size;
   result->tcp_write_iov_size = tcp_write_iov_size - other.tcp_write_iov_size;
   result->tcp_read_size = tcp_read_size - other.tcp_read_size;
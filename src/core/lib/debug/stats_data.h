@@ -107,9 +107,12 @@ struct GlobalStats {
   enum class Counter {
     kClientCallsCreated,
     kServerCallsCreated,
+    kArenaAllocations,
     kClientChannelsCreated,
     kClientSubchannelsCreated,
     kServerChannelsCreated,
+    kServerPendingCallsShed,
+    kServerPendingCallsExpired,
     kSyscallWrite,
     kSyscallRead,
     kTcpReadAlloc8k,
@@ -126,6 +129,7 @@ struct GlobalStats {
   };
   enum class Histogram {
     kCallInitialSize,
+    kServerPendingCallQueueTime,
     kTcpWriteSize,
     kTcpWriteIovSize,
     kTcpReadSize,
@@ -145,9 +149,12 @@ struct GlobalStats {
     struct {
       uint64_t client_calls_created;
       uint64_t server_calls_created;
+      uint64_t arena_allocations;
       uint64_t client_channels_created;
       uint64_t client_subchannels_created;
       uint64_t server_channels_created;
+      uint64_t server_pending_calls_shed;
+      uint64_t server_pending_calls_expired;
       uint64_t syscall_write;
       uint64_t syscall_read;
       uint64_t tcp_read_alloc_8k;
@@ -164,6 +171,7 @@ struct GlobalStats {
     uint64_t counters[static_cast<int>(Counter::COUNT)];
   };
   Histogram_32768_24 call_initial_size;
+  Histogram_16777216_20 server_pending_call_queue_time;
   Histogram_16777216_20 tcp_write_size;
   Histogram_80_10 tcp_write_iov_size;
   Histogram_16777216_20 tcp_read_size;
@@ -184,6 +192,9 @@ class GlobalStatsCollector {
     data_.this_cpu().server_calls_created.fetch_add(1,
                                                     std::memory_order_relaxed);
   }
+  void IncrementArenaAllocations() {
+    data_.this_cpu().arena_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
   void IncrementClientChannelsCreated() {
     data_.this_cpu().client_channels_created.fetch_add(
         1, std::memory_order_relaxed);
@@ -196,6 +207,14 @@ class GlobalStatsCollector {
     data_.this_cpu().server_channels_created.fetch_add(
         1, std::memory_order_relaxed);
   }
+  void IncrementServerPendingCallsShed() {
+    data_.this_cpu().server_pending_calls_shed.fetch_add(
+        1, std::memory_order_relaxed);
+  }
+  void IncrementServerPendingCallsExpired() {
+    data_.this_cpu().server_pending_calls_expired.fetch_add(
+        1, std::memory_order_relaxed);
+  }
   void IncrementSyscallWrite() {
     data_.this_cpu().syscall_write.fetch_add(1, std::memory_order_relaxed);
   }
@@ -239,6 +258,9 @@ class GlobalStatsCollector {
   void IncrementCallInitialSize(int value) {
     data_.this_cpu().call_initial_size.Increment(value);
   }
+  void IncrementServerPendingCallQueueTime(int value) {
+    data_.this_cpu().server_pending_call_queue_time.Increment(value);
+  }
   void IncrementTcpWriteSize(int value) {
     data_.this_cpu().tcp_write_size.Increment(value);
   }
@@ -262,9 +284,12 @@ class GlobalStatsCollector {
   struct Data {
     std::atomic<uint64_t> client_calls_created{0};
     std::atomic<uint64_t> server_calls_created{0};
+    std::atomic<uint64_t> arena_allocations{0};
     std::atomic<uint64_t> client_channels_created{0};
     std::atomic<uint64_t> client_subchannels_created{0};
     std::atomic<uint64_t> server_channels_created{0};
+    std::atomic<uint64_t> server_pending_calls_shed{0};
+    std::atomic<uint64_t> server_pending_calls_expired{0};
     std::atomic<uint64_t> syscall_write{0};
     std::atomic<uint64_t> syscall_read{0};
     std::atomic<uint64_t> tcp_read_alloc_8k{0};
@@ -278,6 +303,7 @@ class GlobalStatsCollector {
     std::atomic<uint64_t> cq_next_creates{0};
     std::atomic<uint64_t> cq_callback_creates{0};
     HistogramCollector_32768_24 call_initial_size;
+    HistogramCollector_16777216_20 server_pending_call_queue_time;
     HistogramCollector_16777216_20 tcp_write_size;
     HistogramCollector_80_10 tcp_write_iov_size;
     HistogramCollector_16777216_20 tcp_read_size;
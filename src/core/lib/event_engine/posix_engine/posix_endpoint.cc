@@ -48,6 +48,7 @@
 #include "src/core/lib/gprpp/strerror.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/resource_quota/slab_allocator.h"
 #include "src/core/lib/slice/slice.h"
 
 #ifdef GRPC_POSIX_SOCKET_TCP
@@ -488,6 +489,14 @@ void PosixEndpointImpl::UpdateRcvLowat() {
   }
 }
 
+Slice PosixEndpointImpl::MakeReadChunk(size_t size) {
+  if (grpc_core::IsTcpReadSlabsEnabled()) {
+    return Slice(
+        grpc_core::SlabAllocator::ForReads(size)->MakeSlice(&memory_owner_));
+  }
+  return Slice(memory_owner_.MakeSlice(size));
+}
+
 void PosixEndpointImpl::MaybeMakeReadSlices() {
   if (grpc_core::IsTcpReadChunksEnabled()) {
     static const int kBigAlloc = 64 * 1024;
@@ -508,14 +517,12 @@ void PosixEndpointImpl::MaybeMakeReadSlices() {
           (low_memory_pressure ? kSmallAlloc * 3 / 2 : kBigAlloc)) {
         while (extra_wanted > 0) {
           extra_wanted -= kBigAlloc;
-          incoming_buffer_->AppendIndexed(
-              Slice(memory_owner_.MakeSlice(kBigAlloc)));
+          incoming_buffer_->AppendIndexed(MakeReadChunk(kBigAlloc));
         }
       } else {
         while (extra_wanted > 0) {
           extra_wanted -= kSmallAlloc;
-          incoming_buffer_->AppendIndexed(
-              Slice(memory_owner_.MakeSlice(kSmallAlloc)));
+          incoming_buffer_->AppendIndexed(MakeReadChunk(kSmallAlloc));
         }
       }
       MaybePostReclaimer();
@@ -53,6 +53,14 @@ const char* const description_posix_event_engine_enable_polling =
     "If set, enables polling on the default posix event engine.";
 const char* const description_free_large_allocator =
     "If set, return all free bytes from a \042big\042 allocator";
+const char* const description_tcp_read_slabs =
+    "Take the 8kb and 64kb chunks for TCP reads from per-CPU slab allocators "
+    "instead of allocating each one from malloc.";
+const char* const description_tcp_read_slab_hugepages =
+    "Ask for transparent hugepages to back the slabs used by tcp_read_slabs.";
+const char* const description_promise_based_server_call =
+    "If set, use the new gRPC promise based call code on the server when it's "
+    "appropriate (ie when all filters in a stack are promise based)";
 #ifdef NDEBUG
 const bool kDefaultForDebugOnly = false;
 #else
@@ -80,6 +88,10 @@ const ExperimentMetadata g_experiment_metadata[] = {
     {"posix_event_engine_enable_polling",
      description_posix_event_engine_enable_polling, true},
     {"free_large_allocator", description_free_large_allocator, false},
+    {"tcp_read_slabs", description_tcp_read_slabs, false},
+    {"tcp_read_slab_hugepages", description_tcp_read_slab_hugepages, false},
+    {"promise_based_server_call", description_promise_based_server_call,
+     false},
 };
 
 }  // namespace grpc_core
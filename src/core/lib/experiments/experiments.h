@@ -46,6 +46,13 @@ inline bool IsPosixEventEngineEnablePollingEnabled() {
   return IsExperimentEnabled(11);
 }
 inline bool IsFreeLargeAllocatorEnabled() { return IsExperimentEnabled(12); }
+inline bool IsTcpReadSlabsEnabled() { return IsExperimentEnabled(13); }
+inline bool IsTcpReadSlabHugepagesEnabled() {
+  return IsExperimentEnabled(14);
+}
+inline bool IsPromiseBasedServerCallEnabled() {
+  return IsExperimentEnabled(15);
+}
 
 struct ExperimentMetadata {
   const char* name;
@@ -53,7 +60,7 @@ struct ExperimentMetadata {
   bool default_value;
 };
 
-constexpr const size_t kNumExperiments = 13;
+constexpr const size_t kNumExperiments = 16;
 extern const ExperimentMetadata g_experiment_metadata[kNumExperiments];
 
 }  // namespace grpc_core
@@ -434,6 +434,8 @@ bool Executor::IsThreadedDefault() {
   return Executor::IsThreaded(ExecutorType::DEFAULT);
 }
 
+bool Executor::IsExecutorThread() { return g_this_thread_state != nullptr; }
+
 void Executor::SetThreadingAll(bool enable) {
   EXECUTOR_TRACE("Executor::SetThreadingAll(%d) called", enable);
   for (size_t i = 0; i < static_cast<size_t>(ExecutorType::NUM_EXECUTORS);
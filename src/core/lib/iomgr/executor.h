@@ -103,6 +103,9 @@ class Executor {
   // Return if the DEFAULT executor is threaded
   static bool IsThreadedDefault();
 
+  // Return if the calling thread is a thread of any executor
+  static bool IsExecutorThread();
+
  private:
   static size_t RunClosures(const char* executor_name, grpc_closure_list list);
   static void ThreadMain(void* arg);
@@ -65,6 +65,7 @@
 #include "src/core/lib/iomgr/tcp_posix.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/slab_allocator.h"
 #include "src/core/lib/resource_quota/trace.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/slice/slice_string_helpers.h"
@@ -1041,6 +1042,15 @@ static bool tcp_do_read(grpc_tcp* tcp, grpc_error_handle* error)
   return true;
 }
 
+// A read chunk of exactly size bytes.
+static grpc_slice make_read_chunk(grpc_tcp* tcp, size_t size) {
+  if (grpc_core::IsTcpReadSlabsEnabled()) {
+    return grpc_core::SlabAllocator::ForReads(size)->MakeSlice(
+        &tcp->memory_owner);
+  }
+  return tcp->memory_owner.MakeSlice(size);
+}
+
 static void maybe_make_read_slices(grpc_tcp* tcp)
     ABSL_EXCLUSIVE_LOCKS_REQUIRED(tcp->read_mu) {
   if (grpc_core::IsTcpReadChunksEnabled()) {
@@ -1064,14 +1074,14 @@ static void maybe_make_read_slices(grpc_tcp* tcp)
         while (extra_wanted > 0) {
           extra_wanted -= kBigAlloc;
           grpc_slice_buffer_add_indexed(tcp->incoming_buffer,
-                                        tcp->memory_owner.MakeSlice(kBigAlloc));
+                                        make_read_chunk(tcp, kBigAlloc));
           grpc_core::global_stats().IncrementTcpReadAlloc64k();
         }
       } else {
         while (extra_wanted > 0) {
           extra_wanted -= kSmallAlloc;
-          grpc_slice_buffer_add_indexed(
-              tcp->incoming_buffer, tcp->memory_owner.MakeSlice(kSmallAlloc));
+          grpc_slice_buffer_add_indexed(tcp->incoming_buffer,
+                                        make_read_chunk(tcp, kSmallAlloc));
           grpc_core::global_stats().IncrementTcpReadAlloc8k();
         }
       }
@@ -102,3 +102,17 @@ extern "C" void grpc_resource_quota_set_max_threads(
       ->thread_quota()
       ->SetMax(new_max_threads);
 }
+
+extern "C" grpc_resource_quota* grpc_resource_quota_create_tenant(
+    grpc_resource_quota* parent, const char* name, size_t guaranteed_bytes,
+    size_t weight) {
+  static std::atomic<uintptr_t> anonymous_counter{0};
+  std::string tenant_name =
+      name == nullptr
+          ? absl::StrCat("anonymous-tenant-", anonymous_counter.fetch_add(1))
+          : name;
+  return grpc_core::ResourceQuota::FromC(parent)
+      ->CreateTenant(std::move(tenant_name), guaranteed_bytes, weight)
+      .release()
+      ->c_ptr();
+}
@@ -20,26 +20,261 @@
 
 #include "src/core/lib/resource_quota/arena.h"
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <new>
+#include <utility>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/types/optional.h"
 
 #include <grpc/support/alloc.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gpr/alloc.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 
 namespace {
 
-void* ArenaStorage(size_t initial_size) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
-  initial_size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
-  size_t alloc_size = base_size + initial_size;
+constexpr size_t kBaseSize =
+    GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(grpc_core::Arena));
+
+// Arena blocks (the arena itself followed by its initial zone) of up to
+// 64 KiB are rounded up to the next size class, so that arenas of similar
+// sizes can share them.  There are four size classes per power of two, which
+// bounds the rounding to a quarter of the block.  Each thread keeps a few
+// freed blocks of each size for the next arenas it creates: calls are mostly
+// created and destroyed on the same few threads, so in a steady state most
+// arenas need no malloc or free.
+constexpr size_t kMinCachedBlockSizeLog2 = 10;
+constexpr size_t kMaxCachedBlockSizeLog2 = 16;
+constexpr size_t kSizeClassesPerDoublingLog2 = 2;
+constexpr size_t kSizeClassesPerDoubling = size_t{1}
+                                           << kSizeClassesPerDoublingLog2;
+constexpr size_t kNumSizeClasses =
+    (kMaxCachedBlockSizeLog2 - kMinCachedBlockSizeLog2) *
+        kSizeClassesPerDoubling +
+    1;
+constexpr size_t kMaxCachedBlocksPerClass = 4;
+constexpr size_t kMaxCachedBytesPerThread = 256 * 1024;
+
+size_t SizeClassBytes(size_t size_class) {
+  return (kSizeClassesPerDoubling + size_class % kSizeClassesPerDoubling)
+         << (kMinCachedBlockSizeLog2 - kSizeClassesPerDoublingLog2 +
+             size_class / kSizeClassesPerDoubling);
+}
+
+// Returns the size class of a block of at least size bytes, or
+// kNumSizeClasses if blocks of that size are not cached.
+size_t SizeClassFor(size_t size) {
+  if (size > size_t{1} << kMaxCachedBlockSizeLog2) return kNumSizeClasses;
+  // Find the power of two first, then the step within it.
+  size_t size_class = 0;
+  while (SizeClassBytes(size_class + kSizeClassesPerDoubling) < size) {
+    size_class += kSizeClassesPerDoubling;
+  }
+  while (SizeClassBytes(size_class) < size) ++size_class;
+  return size_class;
+}
+
+// Cached blocks are charged to the default resource quota.  Each thread
+// reserves quota in chunks of kQuotaChunkSize, so that most arenas are cached
+// and reused without touching the shared memory owner.
+constexpr size_t kQuotaChunkSize = 64 * 1024;
+
+class ThreadArenaCache;
+
+// Owns the quota reservations of all thread caches, and frees the caches of
+// idle threads when the quota runs short.
+class ArenaCacheQuota {
+ public:
+  static ArenaCacheQuota* Get() {
+    static grpc_core::NoDestruct<ArenaCacheQuota> quota;
+    return quota.get();
+  }
+
+  ArenaCacheQuota()
+      : memory_owner_(grpc_core::ResourceQuota::Default()
+                          ->memory_quota()
+                          ->CreateMemoryOwner("arena_cache")) {}
+
+  void Register(ThreadArenaCache* cache);
+  void Unregister(ThreadArenaCache* cache);
+
+  void Reserve(size_t size) {
+    memory_owner_.Reserve(size);
+    // The reclaimer is posted again only once there is something new to
+    // reclaim, so that a quota that stays short moves on to other reclaimers.
+    if (!reclaimer_posted_.exchange(true, std::memory_order_relaxed)) {
+      memory_owner_.PostReclaimer(
+          grpc_core::ReclamationPass::kBenign,
+          [this](absl::optional<grpc_core::ReclamationSweep> sweep) {
+            if (!sweep.has_value()) return;
+            reclaimer_posted_.store(false, std::memory_order_relaxed);
+            Reclaim();
+          });
+    }
+  }
+
+  void Release(size_t size) { memory_owner_.Release(size); }
+
+ private:
+  void Reclaim();
+
+  grpc_core::MemoryOwner memory_owner_;
+  std::atomic<bool> reclaimer_posted_{false};
+  grpc_core::Mutex mu_;
+  ThreadArenaCache* caches_ ABSL_GUARDED_BY(mu_) = nullptr;
+};
+
+class ThreadArenaCache {
+ public:
+  ThreadArenaCache() { ArenaCacheQuota::Get()->Register(this); }
+  ~ThreadArenaCache() {
+    ArenaCacheQuota::Get()->Unregister(this);
+    Flush();
+  }
+
+  ThreadArenaCache(const ThreadArenaCache&) = delete;
+  ThreadArenaCache& operator=(const ThreadArenaCache&) = delete;
+
+  // Returns a cached block of the given size class, or nullptr.
+  void* Pop(size_t size_class) {
+    if (!TryLock()) return nullptr;
+    void* block = nullptr;
+    if (count_[size_class] != 0) {
+      cached_bytes_ -= SizeClassBytes(size_class);
+      block = blocks_[size_class][--count_[size_class]];
+      // Keep one spare chunk, so that a thread that alternates between
+      // creating and destroying arenas does not reserve and release quota
+      // each time.
+      if (reserved_bytes_ - cached_bytes_ >= 2 * kQuotaChunkSize) {
+        reserved_bytes_ -= kQuotaChunkSize;
+        ArenaCacheQuota::Get()->Release(kQuotaChunkSize);
+      }
+    }
+    Unlock();
+    return block;
+  }
+
+  // Takes ownership of block and returns true if there is room for it.
+  bool Push(size_t size_class, void* block) {
+    if (!TryLock()) return false;
+    const size_t size = SizeClassBytes(size_class);
+    if (count_[size_class] == kMaxCachedBlocksPerClass ||
+        cached_bytes_ + size > kMaxCachedBytesPerThread) {
+      Unlock();
+      return false;
+    }
+    if (cached_bytes_ + size > reserved_bytes_) {
+      reserved_bytes_ += kQuotaChunkSize;
+      ArenaCacheQuota::Get()->Reserve(kQuotaChunkSize);
+    }
+    cached_bytes_ += size;
+    blocks_[size_class][count_[size_class]++] = block;
+    Unlock();
+    return true;
+  }
+
+  // Called by the reclaimer: frees the cache unless its thread is using it
+  // right now, in which case it is not idle.
+  void FlushIfIdle() {
+    if (!TryLock()) return;
+    Flush();
+    Unlock();
+  }
+
+ private:
+  friend class ArenaCacheQuota;
+
+  // Both the owning thread and the reclaimer only ever try to take the
+  // cache, so neither waits for the other.
+  bool TryLock() { return !busy_.exchange(true, std::memory_order_acquire); }
+  void Unlock() { busy_.store(false, std::memory_order_release); }
+
+  void Flush() {
+    for (size_t i = 0; i < kNumSizeClasses; ++i) {
+      while (count_[i] != 0) gpr_free_aligned(blocks_[i][--count_[i]]);
+    }
+    cached_bytes_ = 0;
+    if (reserved_bytes_ != 0) {
+      ArenaCacheQuota::Get()->Release(reserved_bytes_);
+      reserved_bytes_ = 0;
+    }
+  }
+
+  std::atomic<bool> busy_{false};
+  size_t cached_bytes_ = 0;
+  size_t reserved_bytes_ = 0;
+  size_t count_[kNumSizeClasses] = {};
+  void* blocks_[kNumSizeClasses][kMaxCachedBlocksPerClass];
+  // Links in ArenaCacheQuota's list of caches.
+  ThreadArenaCache* prev_ = nullptr;
+  ThreadArenaCache* next_ = nullptr;
+};
+
+void ArenaCacheQuota::Register(ThreadArenaCache* cache) {
+  grpc_core::MutexLock lock(&mu_);
+  cache->next_ = caches_;
+  if (caches_ != nullptr) caches_->prev_ = cache;
+  caches_ = cache;
+}
+
+void ArenaCacheQuota::Unregister(ThreadArenaCache* cache) {
+  grpc_core::MutexLock lock(&mu_);
+  if (cache->prev_ != nullptr) {
+    cache->prev_->next_ = cache->next_;
+  } else {
+    caches_ = cache->next_;
+  }
+  if (cache->next_ != nullptr) cache->next_->prev_ = cache->prev_;
+}
+
+void ArenaCacheQuota::Reclaim() {
+  // Caches are unregistered under mu_, so none is destroyed while this runs.
+  grpc_core::MutexLock lock(&mu_);
+  for (ThreadArenaCache* cache = caches_; cache != nullptr;
+       cache = cache->next_) {
+    cache->FlushIfIdle();
+  }
+}
+
+thread_local ThreadArenaCache g_thread_arena_cache;
+
+// Returns storage for an arena with at least initial_size bytes in its
+// initial zone, along with the actual size of that zone.
+std::pair<void*, size_t> ArenaStorage(size_t initial_size) {
+  size_t alloc_size = kBaseSize + GPR_ROUND_UP_TO_ALIGNMENT_SIZE(initial_size);
+  const size_t size_class = SizeClassFor(alloc_size);
+  if (size_class < kNumSizeClasses) {
+    alloc_size = SizeClassBytes(size_class);
+    if (void* block = g_thread_arena_cache.Pop(size_class)) {
+      return std::make_pair(block, alloc_size - kBaseSize);
+    }
+  }
   static constexpr size_t alignment =
       (GPR_CACHELINE_SIZE > GPR_MAX_ALIGNMENT &&
        GPR_CACHELINE_SIZE % GPR_MAX_ALIGNMENT == 0)
           ? GPR_CACHELINE_SIZE
           : GPR_MAX_ALIGNMENT;
-  return gpr_malloc_aligned(alloc_size, alignment);
+  grpc_core::global_stats().IncrementArenaAllocations();
+  return std::make_pair(gpr_malloc_aligned(alloc_size, alignment),
+                        alloc_size - kBaseSize);
+}
+
+void FreeArenaStorage(void* storage, size_t initial_zone_size) {
+  const size_t size_class = SizeClassFor(kBaseSize + initial_zone_size);
+  if (size_class < kNumSizeClasses &&
+      g_thread_arena_cache.Push(size_class, storage)) {
+    return;
+  }
+  gpr_free_aligned(storage);
 }
 
 }  // namespace
@@ -57,17 +292,16 @@ Arena::~Arena() {
 }
 
 Arena* Arena::Create(size_t initial_size, MemoryAllocator* memory_allocator) {
-  return new (ArenaStorage(initial_size))
-      Arena(initial_size, 0, memory_allocator);
+  auto storage = ArenaStorage(initial_size);
+  return new (storage.first) Arena(storage.second, 0, memory_allocator);
 }
 
 std::pair<Arena*, void*> Arena::CreateWithAlloc(
     size_t initial_size, size_t alloc_size, MemoryAllocator* memory_allocator) {
-  static constexpr size_t base_size =
-      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Arena));
-  auto* new_arena = new (ArenaStorage(initial_size))
-      Arena(initial_size, alloc_size, memory_allocator);
-  void* first_alloc = reinterpret_cast<char*>(new_arena) + base_size;
+  auto storage = ArenaStorage(initial_size);
+  auto* new_arena =
+      new (storage.first) Arena(storage.second, alloc_size, memory_allocator);
+  void* first_alloc = reinterpret_cast<char*>(new_arena) + kBaseSize;
   return std::make_pair(new_arena, first_alloc);
 }
 
@@ -84,8 +318,9 @@ size_t Arena::Destroy() {
   }
   size_t size = total_used_.load(std::memory_order_relaxed);
   memory_allocator_->Release(total_allocated_.load(std::memory_order_relaxed));
+  const size_t initial_zone_size = initial_zone_size_;
   this->~Arena();
-  gpr_free_aligned(this);
+  FreeArenaStorage(this, initial_zone_size);
   return size;
 }
 
@@ -100,6 +335,7 @@ void* Arena::AllocZone(size_t size) {
   size_t alloc_size = zone_base_size + size;
   memory_allocator_->Reserve(alloc_size);
   total_allocated_.fetch_add(alloc_size, std::memory_order_relaxed);
+  global_stats().IncrementArenaAllocations();
   Zone* z = new (gpr_malloc_aligned(alloc_size, GPR_MAX_ALIGNMENT)) Zone();
   auto* prev = last_zone_.load(std::memory_order_relaxed);
   do {
@@ -135,4 +371,60 @@ void Arena::FreePooled(void* p, std::atomic<FreePoolNode*>* head) {
   }
 }
 
+namespace {
+
+template <size_t... kSizes>
+constexpr std::array<size_t, sizeof...(kSizes)> PoolSizeArray(
+    absl::integer_sequence<size_t, kSizes...>) {
+  return {{kSizes...}};
+}
+
+// Scopes take chunks of at least this size, so that small allocations share
+// them.
+constexpr size_t kMinScopeChunkSize = 4096;
+
+}  // namespace
+
+Arena::ReclaimableScope::~ReclaimableScope() {
+  while (managed_new_head_ != nullptr) {
+    Destruct(std::exchange(managed_new_head_, managed_new_head_->next));
+  }
+  while (chunk_ != nullptr) {
+    Chunk* chunk = std::exchange(chunk_, chunk_->prev);
+    FreePooled(chunk, &arena_->pools_[chunk->pool]);
+  }
+}
+
+void* Arena::ReclaimableScope::Alloc(size_t size) {
+  size = GPR_ROUND_UP_TO_ALIGNMENT_SIZE(size);
+  if ((chunk_ == nullptr || chunk_->used + size > chunk_->size) &&
+      !NewChunk(size)) {
+    return arena_->Alloc(size);
+  }
+  static constexpr size_t chunk_base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Chunk));
+  void* p = reinterpret_cast<char*>(chunk_) + chunk_base_size + chunk_->used;
+  chunk_->used += size;
+  return p;
+}
+
+bool Arena::ReclaimableScope::NewChunk(size_t size) {
+  static constexpr size_t chunk_base_size =
+      GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(Chunk));
+  static constexpr auto pool_sizes = PoolSizeArray(PoolSizes());
+  const size_t needed = std::max(chunk_base_size + size, kMinScopeChunkSize);
+  for (size_t pool = 0; pool < pool_sizes.size(); ++pool) {
+    if (pool_sizes[pool] < needed) continue;
+    auto* chunk = static_cast<Chunk*>(
+        arena_->AllocPooled(pool_sizes[pool], &arena_->pools_[pool]));
+    chunk->prev = chunk_;
+    chunk->pool = pool;
+    chunk->used = 0;
+    chunk->size = pool_sizes[pool] - chunk_base_size;
+    chunk_ = chunk;
+    return true;
+  }
+  return false;
+}
+
 }  // namespace grpc_core
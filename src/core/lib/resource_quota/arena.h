@@ -69,6 +69,13 @@ struct PoolIndexForSize<
     : public PoolIndexForSize<void, kIndex + 1, kObjectSize, kBucketSizes...> {
 };
 
+// Larger than every bucket: the index is one past the last pool.
+template <size_t kObjectSize, size_t kIndex>
+struct PoolIndexForSize<void, kIndex, kObjectSize> {
+  static constexpr size_t kPool = kIndex;
+  static constexpr size_t kSize = kObjectSize;
+};
+
 template <size_t kObjectSize, size_t... kBucketSizes>
 constexpr size_t PoolFromObjectSize(
     absl::integer_sequence<size_t, kBucketSizes...>) {
@@ -84,9 +91,13 @@ constexpr size_t AllocationSizeFromObjectSize(
 }  // namespace arena_detail
 
 class Arena {
-  using PoolSizes = absl::integer_sequence<size_t, 256, 512, 768>;
-
  public:
+  // Size classes for MakePooled: objects are pooled with others of their
+  // class, so that the memory of a released object can be reused by the next
+  // one.  Each class adds one pointer to every arena.
+  using PoolSizes = absl::integer_sequence<size_t, 256, 512, 768, 1024, 2048,
+                                           4096, 8192, 16384>;
+
   // Create an arena, with \a initial_size bytes in the first allocated buffer.
   static Arena* Create(size_t initial_size, MemoryAllocator* memory_allocator);
 
@@ -98,7 +109,13 @@ class Arena {
       MemoryAllocator* memory_allocator);
 
   // Destroy an arena, returning the total number of bytes allocated.
+  // Arenas of up to 64 KiB are rounded up to a power of two, and the memory
+  // of a destroyed one is kept by the destroying thread for the next arena
+  // that it creates.
   size_t Destroy();
+  // The allocator that the arena's memory is charged to.  Work on behalf of
+  // the call can use it to account for memory outside of the arena.
+  MemoryAllocator* memory_allocator() const { return memory_allocator_; }
   // Allocate \a size bytes from the arena.
   void* Alloc(size_t size) {
     static constexpr size_t base_size =
@@ -154,6 +171,10 @@ class Arena {
 
   template <typename T, typename... Args>
   PoolPtr<T> MakePooled(Args&&... args) {
+    static_assert(
+        arena_detail::PoolFromObjectSize<sizeof(T)>(PoolSizes()) <
+            PoolSizes::size(),
+        "Object too large to pool: add a size class to Arena::PoolSizes");
     return PoolPtr<T>(
         new (AllocPooled(
             arena_detail::AllocationSizeFromObjectSize<sizeof(T)>(PoolSizes()),
@@ -162,6 +183,8 @@ class Arena {
         PooledDeleter(this));
   }
 
+  class ReclaimableScope;
+
  private:
   struct Zone {
     Zone* prev;
@@ -233,6 +256,58 @@ class Arena {
   MemoryAllocator* const memory_allocator_;
 };
 
+// Allocations that are reclaimed when the scope ends rather than when the
+// arena is destroyed, for state that lives only as long as one message of
+// a streaming call.  The scope takes its memory from the arena's pools and
+// gives it back when it ends, so a call that uses one scope per message
+// needs no more arena than its largest messages do, however many messages
+// it exchanges.  Allocations larger than the largest pool size come from
+// the arena itself and are not reclaimed.  A scope must only be used by one
+// thread at a time, and must end before its arena is destroyed.
+class Arena::ReclaimableScope {
+ public:
+  explicit ReclaimableScope(Arena* arena) : arena_(arena) {}
+  ~ReclaimableScope();
+
+  ReclaimableScope(const ReclaimableScope&) = delete;
+  ReclaimableScope& operator=(const ReclaimableScope&) = delete;
+
+  // Allocate \a size bytes, until the end of the scope.
+  void* Alloc(size_t size);
+
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    T* t = static_cast<T*>(Alloc(sizeof(T)));
+    Construct(t, std::forward<Args>(args)...);
+    return t;
+  }
+
+  // Like New, but has the scope call p->~T() when it ends.
+  template <typename T, typename... Args>
+  T* ManagedNew(Args&&... args) {
+    auto* p = New<ManagedNewImpl<T>>(std::forward<Args>(args)...);
+    p->next = managed_new_head_;
+    managed_new_head_ = p;
+    return &p->t;
+  }
+
+ private:
+  struct Chunk {
+    Chunk* prev;
+    size_t pool;
+    size_t used;
+    size_t size;
+  };
+
+  // Makes chunk_ a new chunk with room for size bytes, or returns false if
+  // none of the pools is large enough.
+  bool NewChunk(size_t size);
+
+  Arena* const arena_;
+  Chunk* chunk_ = nullptr;
+  ManagedNewObject* managed_new_head_ = nullptr;
+};
+
 // Smart pointer for arenas when the final size is not required.
 struct ScopedArenaDeleter {
   void operator()(Arena* arena) { arena->Destroy(); }
@@ -295,6 +295,22 @@ void GrpcMemoryAllocatorImpl::Replenish() {
 // BasicMemoryQuota
 //
 
+BasicMemoryQuota::BasicMemoryQuota(std::string name,
+                                   std::shared_ptr<BasicMemoryQuota> parent,
+                                   size_t guaranteed_bytes, size_t weight)
+    : parent_(std::move(parent)),
+      guaranteed_bytes_(guaranteed_bytes),
+      weight_(weight),
+      name_(std::move(name)) {
+  GPR_ASSERT(weight_ > 0);
+  parent_->Take(/*allocator=*/nullptr, guaranteed_bytes_);
+}
+
+BasicMemoryQuota::~BasicMemoryQuota() {
+  // Allocators hold a reference to their quota, so none are left to use it.
+  if (parent_ != nullptr) parent_->Return(guaranteed_bytes_);
+}
+
 class BasicMemoryQuota::WaitForSweepPromise {
  public:
   WaitForSweepPromise(std::shared_ptr<BasicMemoryQuota> memory_quota,
@@ -319,6 +335,17 @@ class BasicMemoryQuota::WaitForSweepPromise {
 void BasicMemoryQuota::Start() {
   auto self = shared_from_this();
 
+  if (parent_ != nullptr) {
+    MutexLock lock(&parent_->children_mu_);
+    auto& children = parent_->children_;
+    children.erase(std::remove_if(children.begin(), children.end(),
+                                  [](const std::weak_ptr<BasicMemoryQuota>& c) {
+                                    return c.expired();
+                                  }),
+                   children.end());
+    children.push_back(self);
+  }
+
   // Reclamation loop:
   // basically, wait until we are in overcommit (free_bytes_ < 0), and then:
   // while (free_bytes_ < 0) reclaim_memory()
@@ -326,7 +353,8 @@ void BasicMemoryQuota::Start() {
   auto reclamation_loop = Loop(Seq(
       [self]() -> Poll<int> {
         // If there's free memory we no longer need to reclaim memory!
-        if (self->free_bytes_.load(std::memory_order_acquire) > 0) {
+        if (self->free_bytes_.load(std::memory_order_acquire) > 0 &&
+            !self->ReclamationRequestedByParent()) {
           return Pending{};
         }
         return 0;
@@ -384,25 +412,43 @@ void BasicMemoryQuota::Stop() { reclaimer_activity_.reset(); }
 
 void BasicMemoryQuota::SetSize(size_t new_size) {
   size_t old_size = quota_size_.exchange(new_size, std::memory_order_relaxed);
+  // Resizing changes what is free, not what is used, so this bypasses Take
+  // and Return.
   if (old_size < new_size) {
     // We're growing the quota.
-    Return(new_size - old_size);
-  } else {
+    free_bytes_.fetch_add(new_size - old_size, std::memory_order_relaxed);
+  } else if (old_size > new_size) {
     // We're shrinking the quota.
-    Take(/*allocator=*/nullptr, old_size - new_size);
+    TakeFreeBytes(old_size - new_size);
   }
 }
 
-void BasicMemoryQuota::Take(GrpcMemoryAllocatorImpl* allocator, size_t amount) {
-  // If there's a request for nothing, then do nothing!
-  if (amount == 0) return;
+void BasicMemoryQuota::TakeFreeBytes(size_t amount) {
   GPR_DEBUG_ASSERT(amount <= std::numeric_limits<intptr_t>::max());
   // Grab memory from the quota.
   auto prior = free_bytes_.fetch_sub(amount, std::memory_order_acq_rel);
   // If we push into overcommit, awake the reclaimer.
   if (prior >= 0 && prior < static_cast<intptr_t>(amount)) {
     if (reclaimer_activity_ != nullptr) reclaimer_activity_->ForceWakeup();
+    RequestChildReclamation();
+  }
+}
+
+void BasicMemoryQuota::Take(GrpcMemoryAllocatorImpl* allocator, size_t amount) {
+  // If there's a request for nothing, then do nothing!
+  if (amount == 0) return;
+  const size_t prior_used =
+      used_bytes_.fetch_add(amount, std::memory_order_relaxed);
+  if (parent_ != nullptr) {
+    // Only what is used beyond the guarantee comes out of the parent's shared
+    // memory.
+    const size_t new_used = prior_used + amount;
+    if (new_used > guaranteed_bytes_) {
+      parent_->Take(/*allocator=*/nullptr,
+                    new_used - std::max(prior_used, guaranteed_bytes_));
+    }
   }
+  TakeFreeBytes(amount);
 
   if (IsFreeLargeAllocatorEnabled()) {
     if (allocator == nullptr) return;
@@ -447,7 +493,75 @@ void BasicMemoryQuota::FinishReclamation(uint64_t token, Waker waker) {
 }
 
 void BasicMemoryQuota::Return(size_t amount) {
+  if (amount == 0) return;
   free_bytes_.fetch_add(amount, std::memory_order_relaxed);
+  const size_t prior_used =
+      used_bytes_.fetch_sub(amount, std::memory_order_relaxed);
+  if (parent_ != nullptr && prior_used > guaranteed_bytes_) {
+    parent_->Return(prior_used -
+                    std::max(prior_used - amount, guaranteed_bytes_));
+  }
+}
+
+void BasicMemoryQuota::RequestChildReclamation() {
+  std::shared_ptr<BasicMemoryQuota> chosen;
+  double chosen_excess = 0;
+  {
+    MutexLock lock(&children_mu_);
+    for (const auto& weak_child : children_) {
+      auto child = weak_child.lock();
+      if (child == nullptr) continue;
+      const size_t used = child->used_bytes_.load(std::memory_order_relaxed);
+      // Children within their guarantee are never asked to give memory back.
+      if (used <= child->guaranteed_bytes_) continue;
+      const double excess =
+          static_cast<double>(used - child->guaranteed_bytes_) / child->weight_;
+      if (excess > chosen_excess) {
+        chosen = std::move(child);
+        chosen_excess = excess;
+      }
+    }
+  }
+  if (chosen == nullptr) return;
+  if (GRPC_TRACE_FLAG_ENABLED(grpc_resource_quota_trace)) {
+    gpr_log(GPR_INFO, "RQ: %s asks child %s to reclaim memory", name_.c_str(),
+            chosen->name_.c_str());
+  }
+  chosen->reclamation_requested_.store(true, std::memory_order_relaxed);
+  if (chosen->reclaimer_activity_ != nullptr) {
+    chosen->reclaimer_activity_->ForceWakeup();
+  }
+}
+
+bool BasicMemoryQuota::ReclamationRequestedByParent() {
+  if (!reclamation_requested_.load(std::memory_order_relaxed)) return false;
+  if (parent_->free_bytes_.load(std::memory_order_acquire) > 0) {
+    reclamation_requested_.store(false, std::memory_order_relaxed);
+    return false;
+  }
+  if (used_bytes_.load(std::memory_order_relaxed) <= guaranteed_bytes_) {
+    // This quota has given back all it can: pass the request on.
+    reclamation_requested_.store(false, std::memory_order_relaxed);
+    parent_->RequestChildReclamation();
+    return false;
+  }
+  return true;
+}
+
+BasicMemoryQuota::ChildUsage BasicMemoryQuota::GetUsage() const {
+  return {name_, used_bytes_.load(std::memory_order_relaxed),
+          guaranteed_bytes_, weight_};
+}
+
+std::vector<BasicMemoryQuota::ChildUsage> BasicMemoryQuota::GetChildUsage() {
+  std::vector<ChildUsage> usage;
+  MutexLock lock(&children_mu_);
+  for (const auto& weak_child : children_) {
+    auto child = weak_child.lock();
+    if (child == nullptr) continue;
+    usage.push_back(child->GetUsage());
+  }
+  return usage;
 }
 
 void BasicMemoryQuota::AddNewAllocator(GrpcMemoryAllocatorImpl* allocator) {
@@ -568,6 +682,19 @@ BasicMemoryQuota::PressureInfo BasicMemoryQuota::GetPressureInfo() {
         std::min(pressure_info.instantaneous_pressure, 1.0);
   }
   pressure_info.max_recommended_allocation_size = quota_size / 16;
+  if (parent_ != nullptr) {
+    // A child is also constrained by what is left in its parent.
+    const PressureInfo parent_info = parent_->GetPressureInfo();
+    pressure_info.instantaneous_pressure =
+        std::max(pressure_info.instantaneous_pressure,
+                 parent_info.instantaneous_pressure);
+    pressure_info.pressure_control_value =
+        std::max(pressure_info.pressure_control_value,
+                 parent_info.pressure_control_value);
+    pressure_info.max_recommended_allocation_size =
+        std::min(pressure_info.max_recommended_allocation_size,
+                 parent_info.max_recommended_allocation_size);
+  }
   return pressure_info;
 }
 
@@ -695,6 +822,14 @@ MemoryAllocator MemoryQuota::CreateMemoryAllocator(absl::string_view name) {
   return MemoryAllocator(std::move(impl));
 }
 
+std::shared_ptr<MemoryQuota> MemoryQuota::CreateChild(std::string name,
+                                                      size_t guaranteed_bytes,
+                                                      size_t weight) {
+  return std::shared_ptr<MemoryQuota>(
+      new MemoryQuota(std::make_shared<BasicMemoryQuota>(
+          std::move(name), memory_quota_, guaranteed_bytes, weight)));
+}
+
 MemoryOwner MemoryQuota::CreateMemoryOwner(absl::string_view name) {
   auto impl = std::make_shared<GrpcMemoryAllocatorImpl>(
       memory_quota_, absl::StrCat(memory_quota_->name(), "/owner/", name));
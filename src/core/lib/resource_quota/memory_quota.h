@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/container/flat_hash_set.h"
@@ -52,6 +53,7 @@ namespace grpc_core {
 class BasicMemoryQuota;
 class MemoryQuota;
 class GrpcMemoryAllocatorImpl;
+class SlabAllocator;
 
 using grpc_event_engine::experimental::MemoryRequest;
 
@@ -295,7 +297,25 @@ class BasicMemoryQuota final
     size_t max_recommended_allocation_size = 0;
   };
 
+  // Usage of one child quota, see GetChildUsage().
+  struct ChildUsage {
+    std::string name;
+    // Bytes taken by the child's allocators.
+    size_t used_bytes;
+    size_t guaranteed_bytes;
+    size_t weight;
+  };
+
   explicit BasicMemoryQuota(std::string name) : name_(std::move(name)) {}
+  // A child quota, that draws from parent as well as from its own size.  The
+  // first guaranteed_bytes that the child uses are set aside in the parent
+  // for as long as the child exists; anything beyond that is shared with the
+  // parent's other users.  When the parent runs out of memory, it asks the
+  // child that is furthest over its guarantee, relative to its weight, to
+  // reclaim memory, so that other children keep their connections.
+  BasicMemoryQuota(std::string name, std::shared_ptr<BasicMemoryQuota> parent,
+                   size_t guaranteed_bytes, size_t weight);
+  ~BasicMemoryQuota();
 
   // Start the reclamation activity.
   void Start();
@@ -329,6 +349,11 @@ class BasicMemoryQuota final
   // The name of this quota
   absl::string_view name() const { return name_; }
 
+  // Usage of this quota, as reported to its parent.
+  ChildUsage GetUsage() const;
+  // Usage of the live children of this quota.
+  std::vector<ChildUsage> GetChildUsage();
+
  private:
   friend class ReclamationSweep;
   class WaitForSweepPromise;
@@ -355,6 +380,14 @@ class BasicMemoryQuota final
   void MaybeMoveAllocatorBigToSmall(GrpcMemoryAllocatorImpl* allocator);
   // Move allocator from small bucket to big bucket.
   void MaybeMoveAllocatorSmallToBig(GrpcMemoryAllocatorImpl* allocator);
+  // Remove amount from free_bytes_, waking the reclaimer if that enters
+  // overcommit.
+  void TakeFreeBytes(size_t amount);
+  // Ask the child that is furthest over its fair share to reclaim memory.
+  void RequestChildReclamation();
+  // Has the parent asked this quota to reclaim memory, and does it still need
+  // to?
+  bool ReclamationRequestedByParent();
 
   // The amount of memory that's free in this quota.
   // We use intptr_t as a reasonable proxy for ssize_t that's portable.
@@ -362,6 +395,20 @@ class BasicMemoryQuota final
   std::atomic<intptr_t> free_bytes_{kInitialSize};
   // The total number of bytes in this quota.
   std::atomic<size_t> quota_size_{kInitialSize};
+  // The number of bytes taken by allocators: unlike quota_size_ - free_bytes_,
+  // this is not changed by SetSize.
+  std::atomic<size_t> used_bytes_{0};
+
+  // The quota that this one draws from, or null.
+  const std::shared_ptr<BasicMemoryQuota> parent_;
+  const size_t guaranteed_bytes_ = 0;
+  const size_t weight_ = 1;
+  // Set by the parent to make this quota reclaim memory while the parent is
+  // in overcommit.
+  std::atomic<bool> reclamation_requested_{false};
+  Mutex children_mu_;
+  std::vector<std::weak_ptr<BasicMemoryQuota>> children_
+      ABSL_GUARDED_BY(children_mu_);
 
   // Reclaimer queues.
   ReclaimerQueue reclaimers_[kNumReclamationPasses];
@@ -536,6 +583,8 @@ class MemoryOwner final : public MemoryAllocator {
   bool is_valid() const { return impl() != nullptr; }
 
  private:
+  friend class SlabAllocator;
+
   const GrpcMemoryAllocatorImpl* impl() const {
     return static_cast<const GrpcMemoryAllocatorImpl*>(get_internal_impl_ptr());
   }
@@ -568,6 +617,22 @@ class MemoryQuota final
   // Resize the quota to new_size.
   void SetSize(size_t new_size) { memory_quota_->SetSize(new_size); }
 
+  // Create a quota that draws from this one, with an unlimited size of its
+  // own: see BasicMemoryQuota for guaranteed_bytes and weight.
+  std::shared_ptr<MemoryQuota> CreateChild(std::string name,
+                                           size_t guaranteed_bytes,
+                                           size_t weight);
+
+  // Usage of this quota, for one created by CreateChild().
+  BasicMemoryQuota::ChildUsage GetUsage() const {
+    return memory_quota_->GetUsage();
+  }
+
+  // Usage of each live child quota.
+  std::vector<BasicMemoryQuota::ChildUsage> GetChildUsage() {
+    return memory_quota_->GetChildUsage();
+  }
+
   // Return true if the instantaneous memory pressure is high.
   bool IsMemoryPressureHigh() const {
     static constexpr double kMemoryPressureHighThreshold = 1.0;
@@ -577,6 +642,12 @@ class MemoryQuota final
 
  private:
   friend class MemoryOwner;
+
+  explicit MemoryQuota(std::shared_ptr<BasicMemoryQuota> memory_quota)
+      : memory_quota_(std::move(memory_quota)) {
+    memory_quota_->Start();
+  }
+
   std::shared_ptr<BasicMemoryQuota> memory_quota_;
 };
 
@@ -22,6 +22,11 @@ ResourceQuota::ResourceQuota(std::string name)
     : memory_quota_(MakeMemoryQuota(std::move(name))),
       thread_quota_(MakeRefCounted<ThreadQuota>()) {}
 
+ResourceQuota::ResourceQuota(MemoryQuotaRefPtr memory_quota,
+                             RefCountedPtr<ThreadQuota> thread_quota)
+    : memory_quota_(std::move(memory_quota)),
+      thread_quota_(std::move(thread_quota)) {}
+
 ResourceQuota::~ResourceQuota() = default;
 
 ResourceQuotaRefPtr ResourceQuota::Default() {
@@ -30,4 +35,12 @@ ResourceQuotaRefPtr ResourceQuota::Default() {
   return default_resource_quota->Ref();
 }
 
+ResourceQuotaRefPtr ResourceQuota::CreateTenant(std::string name,
+                                                size_t guaranteed_bytes,
+                                                size_t weight) {
+  return ResourceQuotaRefPtr(new ResourceQuota(
+      memory_quota_->CreateChild(std::move(name), guaranteed_bytes, weight),
+      thread_quota_));
+}
+
 }  // namespace grpc_core
@@ -17,6 +17,8 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <stddef.h>
+
 #include <string>
 #include <utility>
 
@@ -55,12 +57,23 @@ class ResourceQuota : public RefCounted<ResourceQuota>,
   // The default global resource quota
   static ResourceQuotaRefPtr Default();
 
+  // Create a quota for one tenant of this one.  Its memory quota draws from
+  // this one's with guaranteed_bytes set aside for it and the rest shared by
+  // weight (see BasicMemoryQuota), and it shares this quota's threads.
+  // Connections whose channel args carry the tenant's quota, such as those
+  // of a listening port, are accounted to the tenant.
+  ResourceQuotaRefPtr CreateTenant(std::string name, size_t guaranteed_bytes,
+                                   size_t weight);
+
   static int ChannelArgsCompare(const ResourceQuota* a,
                                 const ResourceQuota* b) {
     return QsortCompare(a, b);
   }
 
  private:
+  ResourceQuota(MemoryQuotaRefPtr memory_quota,
+                RefCountedPtr<ThreadQuota> thread_quota);
+
   MemoryQuotaRefPtr memory_quota_;
   RefCountedPtr<ThreadQuota> thread_quota_;
 };
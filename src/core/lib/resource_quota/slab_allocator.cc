@@ -0,0 +1,284 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpc/support/port_platform.h>
+
+#include "src/core/lib/resource_quota/slab_allocator.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <new>
+#include <utility>
+
+#include "absl/types/optional.h"
+
+#include <grpc/support/alloc.h>
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+#ifdef GPR_LINUX
+#include <sys/mman.h>
+#endif
+
+#include "src/core/lib/experiments/experiments.h"
+#include "src/core/lib/gprpp/no_destruct.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice_refcount.h"
+
+namespace grpc_core {
+
+namespace {
+
+// Slab headers and blocks start on cache line boundaries.
+constexpr size_t kAlignment = 64;
+
+constexpr size_t RoundUp(size_t n) {
+  return (n + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+void* AllocSlabMemory(bool use_hugepages) {
+#ifdef GPR_WINDOWS
+  (void)use_hugepages;
+  return gpr_malloc_aligned(SlabAllocator::kSlabSize, SlabAllocator::kSlabSize);
+#else
+  void* p = nullptr;
+  GPR_ASSERT(posix_memalign(&p, SlabAllocator::kSlabSize,
+                            SlabAllocator::kSlabSize) == 0);
+#ifdef MADV_HUGEPAGE
+  // Slabs are aligned to the hugepage size, so this lets the kernel back each
+  // one with a single TLB entry.
+  if (use_hugepages) madvise(p, SlabAllocator::kSlabSize, MADV_HUGEPAGE);
+#else
+  (void)use_hugepages;
+#endif
+  return p;
+#endif
+}
+
+void FreeSlabMemory(void* p) {
+#ifdef GPR_WINDOWS
+  gpr_free_aligned(p);
+#else
+  free(p);
+#endif
+}
+
+}  // namespace
+
+struct SlabAllocator::Slab {
+  Slab* next;
+  // Number of blocks of this slab in the shared free list.
+  size_t free_blocks;
+};
+
+// Freed blocks are cached here for reuse on the same CPU.
+struct SlabAllocator::Magazine {
+  static constexpr size_t kCapacity = 16;
+
+  Mutex mu;
+  size_t count ABSL_GUARDED_BY(mu) = 0;
+  void* blocks[kCapacity] ABSL_GUARDED_BY(mu);
+};
+
+// Starts every block, followed by the slice's bytes.  Releases the block's
+// charge to its owner and gives the block back when the slice is destroyed.
+class SlabAllocator::BlockRefCount : public grpc_slice_refcount {
+ public:
+  BlockRefCount(SlabAllocator* slab_allocator,
+                std::shared_ptr<EventEngineMemoryAllocatorImpl> allocator)
+      : grpc_slice_refcount(Destroy),
+        slab_allocator_(slab_allocator),
+        allocator_(std::move(allocator)) {}
+
+ private:
+  static void Destroy(grpc_slice_refcount* p) {
+    auto* rc = static_cast<BlockRefCount*>(p);
+    SlabAllocator* slab_allocator = rc->slab_allocator_;
+    rc->allocator_->Release(slab_allocator->block_size_);
+    rc->~BlockRefCount();
+    slab_allocator->memory_owner_.Reserve(slab_allocator->block_size_);
+    slab_allocator->FreeBlock(rc);
+  }
+
+  SlabAllocator* const slab_allocator_;
+  std::shared_ptr<EventEngineMemoryAllocatorImpl> allocator_;
+};
+
+SlabAllocator::SlabAllocator(size_t block_size, bool use_hugepages,
+                             MemoryQuota* memory_quota)
+    : block_size_(block_size),
+      block_stride_(RoundUp(RoundUp(sizeof(BlockRefCount)) + block_size)),
+      blocks_per_slab_((kSlabSize - RoundUp(sizeof(Slab))) / block_stride_),
+      use_hugepages_(use_hugepages),
+      num_magazines_(gpr_cpu_num_cores()),
+      magazines_(new Magazine[num_magazines_]),
+      memory_owner_(memory_quota->CreateMemoryOwner("slab_allocator")) {
+  GPR_ASSERT(blocks_per_slab_ > 0);
+}
+
+SlabAllocator::~SlabAllocator() {
+  ReleaseEmptySlabs();
+  MutexLock lock(&mu_);
+  GPR_ASSERT(slabs_ == nullptr);
+}
+
+SlabAllocator* SlabAllocator::ForReads(size_t block_size) {
+  static NoDestruct<SlabAllocator> small_blocks(
+      8 * 1024, IsTcpReadSlabHugepagesEnabled(),
+      ResourceQuota::Default()->memory_quota().get());
+  static NoDestruct<SlabAllocator> big_blocks(
+      64 * 1024, IsTcpReadSlabHugepagesEnabled(),
+      ResourceQuota::Default()->memory_quota().get());
+  if (block_size == small_blocks->block_size()) return small_blocks.get();
+  GPR_ASSERT(block_size == big_blocks->block_size());
+  return big_blocks.get();
+}
+
+grpc_slice SlabAllocator::MakeSlice(MemoryOwner* owner) {
+  // The block's memory moves from the slab allocator's charge to owner's.
+  owner->Reserve(block_size_);
+  void* block = AllocBlock();
+  memory_owner_.Release(block_size_);
+  auto* rc =
+      new (block) BlockRefCount(this, owner->impl()->shared_from_this());
+  grpc_slice slice;
+  slice.refcount = rc;
+  slice.data.refcounted.bytes =
+      static_cast<uint8_t*>(block) + RoundUp(sizeof(BlockRefCount));
+  slice.data.refcounted.length = block_size_;
+  return slice;
+}
+
+size_t SlabAllocator::ReleaseEmptySlabs() {
+  size_t released = 0;
+  {
+    MutexLock lock(&mu_);
+    // Cached blocks would keep their slabs alive: put them back first.
+    for (size_t i = 0; i < num_magazines_; ++i) {
+      Magazine& magazine = magazines_[i];
+      MutexLock magazine_lock(&magazine.mu);
+      while (magazine.count > 0) {
+        FreeSharedBlock(magazine.blocks[--magazine.count]);
+      }
+    }
+    for (FreeNode** node = &free_list_; *node != nullptr;) {
+      if (SlabForBlock(*node)->free_blocks == blocks_per_slab_) {
+        *node = (*node)->next;
+      } else {
+        node = &(*node)->next;
+      }
+    }
+    for (Slab** slab = &slabs_; *slab != nullptr;) {
+      if ((*slab)->free_blocks == blocks_per_slab_) {
+        FreeSlabMemory(std::exchange(*slab, (*slab)->next));
+        ++released;
+      } else {
+        slab = &(*slab)->next;
+      }
+    }
+    slab_count_ -= released;
+  }
+  if (released > 0) memory_owner_.Release(released * kSlabSize);
+  return released;
+}
+
+void* SlabAllocator::AllocBlock() {
+  {
+    Magazine& magazine = CurrentMagazine();
+    MutexLock lock(&magazine.mu);
+    if (magazine.count > 0) return magazine.blocks[--magazine.count];
+  }
+  void* block;
+  {
+    MutexLock lock(&mu_);
+    block = AllocSharedBlock();
+  }
+  MaybeArmReclaimer();
+  return block;
+}
+
+void SlabAllocator::FreeBlock(void* block) {
+  // When the magazine is full, half of it goes back to the shared list, so
+  // that a CPU that only frees does not go there every time.
+  void* spill[Magazine::kCapacity / 2 + 1];
+  size_t num_spill = 0;
+  {
+    Magazine& magazine = CurrentMagazine();
+    MutexLock lock(&magazine.mu);
+    if (magazine.count < Magazine::kCapacity) {
+      magazine.blocks[magazine.count++] = block;
+      return;
+    }
+    spill[num_spill++] = block;
+    while (num_spill <= Magazine::kCapacity / 2) {
+      spill[num_spill++] = magazine.blocks[--magazine.count];
+    }
+  }
+  {
+    MutexLock lock(&mu_);
+    for (size_t i = 0; i < num_spill; ++i) FreeSharedBlock(spill[i]);
+  }
+  MaybeArmReclaimer();
+}
+
+void* SlabAllocator::AllocSharedBlock() {
+  if (free_list_ == nullptr) NewSlab();
+  FreeNode* node = free_list_;
+  free_list_ = node->next;
+  --SlabForBlock(node)->free_blocks;
+  return node;
+}
+
+void SlabAllocator::FreeSharedBlock(void* block) {
+  auto* node = static_cast<FreeNode*>(block);
+  node->next = free_list_;
+  free_list_ = node;
+  ++SlabForBlock(block)->free_blocks;
+}
+
+void SlabAllocator::NewSlab() {
+  memory_owner_.Reserve(kSlabSize);
+  char* memory = static_cast<char*>(AllocSlabMemory(use_hugepages_));
+  slabs_ = new (memory) Slab{slabs_, 0};
+  ++slab_count_;
+  char* first_block = memory + RoundUp(sizeof(Slab));
+  for (size_t i = blocks_per_slab_; i > 0; --i) {
+    FreeSharedBlock(first_block + (i - 1) * block_stride_);
+  }
+}
+
+SlabAllocator::Slab* SlabAllocator::SlabForBlock(void* block) const {
+  return reinterpret_cast<Slab*>(reinterpret_cast<uintptr_t>(block) &
+                                 ~uintptr_t{kSlabSize - 1});
+}
+
+SlabAllocator::Magazine& SlabAllocator::CurrentMagazine() {
+  return magazines_[gpr_cpu_current_cpu() % num_magazines_];
+}
+
+void SlabAllocator::MaybeArmReclaimer() {
+  if (reclaimer_armed_.exchange(true, std::memory_order_relaxed)) return;
+  memory_owner_.PostReclaimer(
+      ReclamationPass::kBenign,
+      [this](absl::optional<ReclamationSweep> sweep) {
+        // Rearmed by the next use of the shared free list rather than from
+        // here: a reclaimer posted during its own sweep would run again at
+        // once while the quota stays in overcommit.
+        reclaimer_armed_.store(false, std::memory_order_relaxed);
+        if (sweep.has_value()) ReleaseEmptySlabs();
+      });
+}
+
+}  // namespace grpc_core
@@ -0,0 +1,110 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef GRPC_CORE_LIB_RESOURCE_QUOTA_SLAB_ALLOCATOR_H
+#define GRPC_CORE_LIB_RESOURCE_QUOTA_SLAB_ALLOCATOR_H
+
+#include <grpc/support/port_platform.h>
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+
+#include "absl/base/thread_annotations.h"
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+
+namespace grpc_core {
+
+// Hands out slices of one fixed size, carved out of 2 MiB slabs, for buffers
+// that are allocated and freed at a high rate such as transport reads.
+// Freed blocks are kept in a magazine for the current CPU, so that most
+// allocations and frees only take an uncontended lock, and slabs can be
+// backed by transparent hugepages to save TLB entries.
+//
+// Each slice is charged to the MemoryOwner it was made for until it is
+// released, as with MemoryAllocator::MakeSlice.  Slab memory that is not in
+// a slice is charged to the slab allocator itself, and its benign reclaimer
+// gives empty slabs back to the system.
+class SlabAllocator {
+ public:
+  static constexpr size_t kSlabSize = 2 * 1024 * 1024;
+
+  // Blocks of block_size bytes, with their memory charged to memory_quota.
+  SlabAllocator(size_t block_size, bool use_hugepages,
+                MemoryQuota* memory_quota);
+  // All slices must have been released.
+  ~SlabAllocator();
+
+  SlabAllocator(const SlabAllocator&) = delete;
+  SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+  // The shared allocator for transport reads of block_size bytes, which
+  // must be 8 KiB or 64 KiB.
+  static SlabAllocator* ForReads(size_t block_size);
+
+  // A slice of block_size() bytes, charged to owner.
+  grpc_slice MakeSlice(MemoryOwner* owner);
+
+  size_t block_size() const { return block_size_; }
+  size_t slab_count() {
+    MutexLock lock(&mu_);
+    return slab_count_;
+  }
+
+  // Give slabs that have no block in use back to the system.  Returns the
+  // number of slabs released.
+  size_t ReleaseEmptySlabs();
+
+ private:
+  class BlockRefCount;
+  struct Slab;
+  struct FreeNode {
+    FreeNode* next;
+  };
+  struct Magazine;
+
+  void* AllocBlock();
+  void FreeBlock(void* block);
+  // Take a block from the shared free list, adding a slab if it is empty.
+  void* AllocSharedBlock() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void FreeSharedBlock(void* block) ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  void NewSlab() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  Slab* SlabForBlock(void* block) const;
+  Magazine& CurrentMagazine();
+  void MaybeArmReclaimer();
+
+  const size_t block_size_;
+  // Distance between blocks: block_size_ plus the slice refcount.
+  const size_t block_stride_;
+  const size_t blocks_per_slab_;
+  const bool use_hugepages_;
+  const size_t num_magazines_;
+  const std::unique_ptr<Magazine[]> magazines_;
+  Mutex mu_;
+  FreeNode* free_list_ ABSL_GUARDED_BY(mu_) = nullptr;
+  Slab* slabs_ ABSL_GUARDED_BY(mu_) = nullptr;
+  size_t slab_count_ ABSL_GUARDED_BY(mu_) = 0;
+  std::atomic<bool> reclaimer_armed_{false};
+  // Last, so that the reclaimer is cancelled before anything it uses goes.
+  MemoryOwner memory_owner_;
+};
+
+}  // namespace grpc_core
+
+#endif  // GRPC_CORE_LIB_RESOURCE_QUOTA_SLAB_ALLOCATOR_H
@@ -22,6 +22,7 @@
 
 #include <string.h>
 
+#include <atomic>
 #include <new>
 
 #include <grpc/slice.h>
@@ -220,16 +221,34 @@ grpc_slice grpc_slice_from_cpp_string(std::string str) {
   return slice;
 }
 
+static void destroy_malloced_slice(grpc_slice_refcount* p) {
+  delete[] reinterpret_cast<uint8_t*>(p);
+}
+
 grpc_slice grpc_slice_malloc_large(size_t length) {
   grpc_slice slice;
   uint8_t* memory = new uint8_t[sizeof(grpc_slice_refcount) + length];
-  slice.refcount = new (memory) grpc_slice_refcount(
-      [](grpc_slice_refcount* p) { delete[] reinterpret_cast<uint8_t*>(p); });
+  slice.refcount = new (memory) grpc_slice_refcount(destroy_malloced_slice);
   slice.data.refcounted.bytes = memory + sizeof(grpc_slice_refcount);
   slice.data.refcounted.length = length;
   return slice;
 }
 
+size_t grpc_slice_headroom(const grpc_slice& s) {
+  if (s.refcount == nullptr ||
+      s.refcount == grpc_slice_refcount::NoopRefcount() ||
+      s.refcount->destroyer_fn() != destroy_malloced_slice ||
+      !s.refcount->IsUnique()) {
+    return 0;
+  }
+  // Pairs with the unrefs of any other slices of the buffer, which may still
+  // have been reading the bytes before s.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const uint8_t* buffer_start = reinterpret_cast<const uint8_t*>(s.refcount) +
+                                sizeof(grpc_slice_refcount);
+  return static_cast<size_t>(s.data.refcounted.bytes - buffer_start);
+}
+
 grpc_slice grpc_slice_malloc(size_t length) {
   if (length <= GRPC_SLICE_INLINED_SIZE) {
     grpc_slice slice;
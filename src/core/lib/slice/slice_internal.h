@@ -67,6 +67,20 @@ grpc_slice grpc_slice_from_cpp_string(std::string str);
 // 0. All other slices will return the size of the allocated chars.
 size_t grpc_slice_memory_usage(grpc_slice s);
 
+// Returns the number of bytes directly before the start of \a s that can be
+// prepended to it in place: the unused start of a buffer from
+// grpc_slice_malloc, while \a s is the only reference to that buffer.
+size_t grpc_slice_headroom(const grpc_slice& s);
+
+// Moves the start of \a s back by \a n bytes, which must have been within its
+// headroom, and returns the new start.  The bytes' contents are undefined.
+inline uint8_t* grpc_slice_extend_into_headroom(grpc_slice* s, size_t n) {
+  GPR_DEBUG_ASSERT(s->refcount != nullptr);
+  s->data.refcounted.bytes -= n;
+  s->data.refcounted.length += n;
+  return s->data.refcounted.bytes;
+}
+
 namespace grpc_core {
 
 // Converts grpc_slice to absl::string_view.
@@ -171,9 +171,10 @@ class Call : public CppImplOf<Call, grpc_call> {
   };
 
   Call(Arena* arena, bool is_client, Timestamp send_deadline,
-       RefCountedPtr<Channel> channel)
+       RefCountedPtr<Channel> channel, CallSizeEstimator* call_size_estimator)
       : channel_(std::move(channel)),
         arena_(arena),
+        call_size_estimator_(call_size_estimator),
         send_deadline_(send_deadline),
         is_client_(is_client) {
     GPR_DEBUG_ASSERT(arena_ != nullptr);
@@ -205,6 +206,8 @@ class Call : public CppImplOf<Call, grpc_call> {
  private:
   RefCountedPtr<Channel> channel_;
   Arena* const arena_;
+  // Fed the final arena size; owned by channel_.
+  CallSizeEstimator* const call_size_estimator_;
   std::atomic<ParentCall*> parent_call_{nullptr};
   ChildCall* child_ = nullptr;
   Timestamp send_deadline_;
@@ -344,8 +347,15 @@ char* Call::GetPeer() {
 void Call::DeleteThis() {
   RefCountedPtr<Channel> channel = std::move(channel_);
   Arena* arena = arena_;
+  CallSizeEstimator* call_size_estimator = call_size_estimator_;
   this->~Call();
-  channel->UpdateCallSizeEstimate(arena->Destroy());
+  const size_t size = arena->Destroy();
+  call_size_estimator->Update(size);
+  // Keep the channel-wide estimate current too: calls whose method is not
+  // known up front use it, and new methods start from it.
+  if (call_size_estimator != channel->call_size_estimator()) {
+    channel->UpdateCallSizeEstimate(size);
+  }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -494,7 +504,7 @@ class FilterStackCall final : public Call {
 
   FilterStackCall(Arena* arena, const grpc_call_create_args& args)
       : Call(arena, args.server_transport_data == nullptr, args.send_deadline,
-             args.channel->Ref()),
+             args.channel->Ref(), args.call_size_estimator),
         cq_(args.cq),
         stream_op_payload_(context_) {}
 
@@ -635,8 +645,9 @@ grpc_error_handle FilterStackCall::Create(grpc_call_create_args* args,
   FilterStackCall* call;
   grpc_error_handle error;
   grpc_channel_stack* channel_stack = channel->channel_stack();
-  size_t initial_size = channel->CallSizeEstimate();
+  size_t initial_size = args->call_size_estimator->Estimate();
   global_stats().IncrementCallInitialSize(initial_size);
+  args->call_size_estimator->RecordInitialSize(initial_size);
   size_t call_alloc_size =
       GPR_ROUND_UP_TO_ALIGNMENT_SIZE(sizeof(FilterStackCall)) +
       channel_stack->call_stack_size;
@@ -1946,6 +1957,9 @@ class PromiseBasedCall : public Call, public Activity, public Wakeable {
   // for that functionality be invented)
   grpc_call_stack* call_stack() override { return nullptr; }
 
+  // The server half of the call, if this is a server call.
+  virtual ServerCallContext* server_call_context() { return nullptr; }
+
  protected:
   class ScopedContext
       : public ScopedActivity,
@@ -2007,6 +2021,8 @@ class PromiseBasedCall : public Call, public Activity, public Wakeable {
     kReceiveStatusOnClient,
     kSendMessage,
     kReceiveMessage,
+    kSendStatusFromServer,
+    kReceiveCloseOnServer,
   };
 
   static constexpr const char* PendingOpString(PendingOp reason) {
@@ -2021,6 +2037,10 @@ class PromiseBasedCall : public Call, public Activity, public Wakeable {
         return "SendMessage";
       case PendingOp::kReceiveMessage:
         return "ReceiveMessage";
+      case PendingOp::kSendStatusFromServer:
+        return "SendStatusFromServer";
+      case PendingOp::kReceiveCloseOnServer:
+        return "ReceiveCloseOnServer";
     }
     return "Unknown";
   }
@@ -2064,6 +2084,9 @@ class PromiseBasedCall : public Call, public Activity, public Wakeable {
 
   void CToMetadata(grpc_metadata* metadata, size_t count,
                    grpc_metadata_batch* batch);
+  // Publish some metadata out to the application.
+  static void PublishMetadataArray(grpc_metadata_array* array,
+                                   grpc_metadata_batch* md);
 
   std::string ActivityDebugTag() const override { return DebugTag(); }
 
@@ -2193,8 +2216,11 @@ grpc_error_handle MakePromiseBasedCall(grpc_call_create_args* args,
                                        grpc_call** out_call) {
   Channel* channel = args->channel.get();
 
-  auto alloc = Arena::CreateWithAlloc(channel->CallSizeEstimate(), sizeof(T),
-                                      channel->allocator());
+  size_t initial_size = args->call_size_estimator->Estimate();
+  global_stats().IncrementCallInitialSize(initial_size);
+  args->call_size_estimator->RecordInitialSize(initial_size);
+  auto alloc =
+      Arena::CreateWithAlloc(initial_size, sizeof(T), channel->allocator());
   PromiseBasedCall* call = new (alloc.second) T(alloc.first, args);
   *out_call = call->c_ptr();
   GPR_DEBUG_ASSERT(Call::FromC(*out_call) == call);
@@ -2204,7 +2230,7 @@ grpc_error_handle MakePromiseBasedCall(grpc_call_create_args* args,
 PromiseBasedCall::PromiseBasedCall(Arena* arena,
                                    const grpc_call_create_args& args)
     : Call(arena, args.server_transport_data == nullptr, args.send_deadline,
-           args.channel->Ref()),
+           args.channel->Ref(), args.call_size_estimator),
       cq_(args.cq) {
   if (args.cq != nullptr) {
     GPR_ASSERT(args.pollset_set_alternative == nullptr &&
@@ -2247,6 +2273,19 @@ void PromiseBasedCall::CToMetadata(grpc_metadata* metadata, size_t count,
   }
 }
 
+void PromiseBasedCall::PublishMetadataArray(grpc_metadata_array* array,
+                                            grpc_metadata_batch* md) {
+  const auto md_count = md->count();
+  if (md_count > array->capacity) {
+    array->capacity =
+        std::max(array->capacity + md->count(), array->capacity * 3 / 2);
+    array->metadata = static_cast<grpc_metadata*>(
+        gpr_realloc(array->metadata, sizeof(grpc_metadata) * array->capacity));
+  }
+  PublishToAppEncoder encoder(array);
+  md->Encode(&encoder);
+}
+
 void PromiseBasedCall::ContextSet(grpc_context_index elem, void* value,
                                   void (*destroy)(void*)) {
   if (context_[elem].destroy != nullptr) {
@@ -2365,6 +2404,10 @@ void CallContext::IncrementRefCount(const char* reason) {
 
 void CallContext::Unref(const char* reason) { call_->InternalUnref(reason); }
 
+ServerCallContext* CallContext::server_call_context() {
+  return call_->server_call_context();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // ClientPromiseBasedCall
 
@@ -2435,9 +2478,6 @@ class ClientPromiseBasedCall final : public PromiseBasedCall {
   // Start the underlying promise.
   void StartPromise(ClientMetadataHandle client_initial_metadata)
       ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
-  // Publish some metadata out to the application.
-  static void PublishMetadataArray(grpc_metadata_array* array,
-                                   ServerMetadata* md);
   // Publish status out to the application.
   void PublishStatus(
       grpc_op::grpc_op_data::grpc_op_recv_status_on_client op_args,
@@ -2843,20 +2883,495 @@ void ClientPromiseBasedCall::PublishStatus(
                        PendingOp::kReceiveStatusOnClient);
 }
 
-void ClientPromiseBasedCall::PublishMetadataArray(grpc_metadata_array* array,
-                                                  ServerMetadata* md) {
-  const auto md_count = md->count();
-  if (md_count > array->capacity) {
-    array->capacity =
-        std::max(array->capacity + md->count(), array->capacity * 3 / 2);
-    array->metadata = static_cast<grpc_metadata*>(
-        gpr_realloc(array->metadata, sizeof(grpc_metadata) * array->capacity));
+bool ClientPromiseBasedCall::Completed() {
+  MutexLock lock(mu());
+  return completed_;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ServerPromiseBasedCall
+
+class ServerPromiseBasedCall final : public PromiseBasedCall,
+                                     public ServerCallContext {
+ public:
+  ServerPromiseBasedCall(Arena* arena, grpc_call_create_args* args);
+
+  ~ServerPromiseBasedCall() override {
+    ScopedContext context(this);
+    promise_ = ArenaPromise<ServerMetadataHandle>();
+    client_initial_metadata_.reset();
+    send_initial_metadata_.reset();
+    send_trailing_metadata_.reset();
+    // Need to destroy the pipes under the ScopedContext above, so we move them
+    // out here and then allow the destructors to run at end of scope, but
+    // before context.
+    auto c2s = std::move(client_to_server_messages_);
+    auto s2c = std::move(server_to_client_messages_);
   }
-  PublishToAppEncoder encoder(array);
-  md->Encode(&encoder);
+
+  absl::string_view GetServerAuthority() const override;
+  void CancelWithError(grpc_error_handle error) override;
+  bool Completed() override;
+  void Orphan() override {
+    MutexLock lock(mu());
+    ScopedContext ctx(this);
+    if (!completed_) {
+      Finish(ServerMetadataFromStatus(absl::CancelledError()), true);
+    }
+  }
+  bool is_trailers_only() const override { abort(); }
+  bool failed_before_recv_message() const override {
+    MutexLock lock(mu());
+    return failed_before_recv_message_;
+  }
+  grpc_compression_algorithm compression_for_level(
+      grpc_compression_level level) override {
+    MutexLock lock(mu());
+    return encodings_accepted_by_peer_.CompressionAlgorithmForLevel(level);
+  }
+
+  grpc_call_error StartBatch(const grpc_op* ops, size_t nops, void* notify_tag,
+                             bool is_notify_tag_closure) override;
+
+  std::string DebugTag() const override {
+    return absl::StrFormat("SERVER_CALL[%p]: ", this);
+  }
+
+  ServerCallContext* server_call_context() override { return this; }
+
+  // ServerCallContext: only called from within the call's activity.
+  const void* server_stream_data() override { return server_transport_data_; }
+  grpc_call* c_call() override { return c_ptr(); }
+  PipeSender<MessageHandle>* client_to_server_messages() override {
+    return &client_to_server_messages_.sender;
+  }
+  PipeReceiver<MessageHandle>* server_to_client_messages() override {
+    return &server_to_client_messages_.receiver;
+  }
+  void ServerToClientMessagesDrained() override
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
+  ArenaPromise<ServerMetadataHandle> MakeTopOfServerCallPromise(
+      CallArgs call_args) override ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
+
+ private:
+  // Poll the underlying promise (and sundry objects) once.
+  void UpdateOnce() ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu()) override;
+  // Finish the call: result is what the call stack resolved to, and cancelled
+  // is set if the call ended without the application's status reaching the
+  // transport.
+  void Finish(ServerMetadataHandle result, bool cancelled)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
+  // Validate that a set of ops is valid for a server call.
+  grpc_call_error ValidateBatch(const grpc_op* ops, size_t nops) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
+  // Commit a valid batch of operations to be executed.
+  void CommitBatch(const grpc_op* ops, size_t nops,
+                   const Completion& completion)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
+  // Poll the innermost promise of the call stack: it resolves with the
+  // application's trailing metadata once everything sent before it has made
+  // its way down the stack.
+  Poll<ServerMetadataHandle> PollTopOfCall()
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(mu());
+
+  Server* const server_;
+  const void* const server_transport_data_;
+  ArenaPromise<ServerMetadataHandle> promise_ ABSL_GUARDED_BY(mu());
+  Pipe<MessageHandle> client_to_server_messages_ ABSL_GUARDED_BY(mu()){arena()};
+  Pipe<MessageHandle> server_to_client_messages_ ABSL_GUARDED_BY(mu()){arena()};
+  // Set from the call args that reach the top of the call stack.
+  ClientMetadataHandle client_initial_metadata_ ABSL_GUARDED_BY(mu());
+  Latch<ServerMetadata*>* server_initial_metadata_ ABSL_GUARDED_BY(mu()) =
+      nullptr;
+  ServerMetadataHandle send_initial_metadata_ ABSL_GUARDED_BY(mu());
+  ServerMetadataHandle send_trailing_metadata_ ABSL_GUARDED_BY(mu());
+  CompressionAlgorithmSet encodings_accepted_by_peer_ ABSL_GUARDED_BY(mu()){
+      GRPC_COMPRESS_NONE};
+  grpc_compression_algorithm incoming_compression_algorithm_
+      ABSL_GUARDED_BY(mu()) = GRPC_COMPRESS_NONE;
+  grpc_byte_buffer** recv_message_ ABSL_GUARDED_BY(mu()) = nullptr;
+  int* recv_close_cancelled_ ABSL_GUARDED_BY(mu()) = nullptr;
+  absl::optional<PipeSender<MessageHandle>::PushType> outstanding_send_
+      ABSL_GUARDED_BY(mu());
+  absl::optional<PipeReceiver<MessageHandle>::NextType> outstanding_recv_
+      ABSL_GUARDED_BY(mu());
+  Completion send_message_completion_ ABSL_GUARDED_BY(mu());
+  Completion recv_message_completion_ ABSL_GUARDED_BY(mu());
+  Completion send_status_from_server_completion_ ABSL_GUARDED_BY(mu());
+  Completion recv_close_on_server_completion_ ABSL_GUARDED_BY(mu());
+  // Set once the call args have reached the top of the call stack, from
+  // which point Server::CallData owns the ref the call was created with.
+  bool top_reached_ ABSL_GUARDED_BY(mu()) = false;
+  bool sent_initial_metadata_ ABSL_GUARDED_BY(mu()) = false;
+  bool sent_status_ ABSL_GUARDED_BY(mu()) = false;
+  bool server_to_client_messages_drained_ ABSL_GUARDED_BY(mu()) = false;
+  bool completed_ ABSL_GUARDED_BY(mu()) = false;
+  bool cancelled_ ABSL_GUARDED_BY(mu()) = false;
+  bool failed_before_recv_message_ ABSL_GUARDED_BY(mu()) = false;
+};
+
+ServerPromiseBasedCall::ServerPromiseBasedCall(Arena* arena,
+                                               grpc_call_create_args* args)
+    : PromiseBasedCall(arena, *args),
+      server_(args->server),
+      server_transport_data_(args->server_transport_data) {
+  global_stats().IncrementServerCallsCreated();
+  if (auto* channelz_node = server_->channelz_node()) {
+    channelz_node->RecordCallStarted();
+  }
+  MutexLock lock(mu());
+  ScopedContext activity_context(this);
+  // The connected filter at the bottom of the stack fills in the call args
+  // once client initial metadata arrives.
+  promise_ = channel()->channel_stack()->MakeServerCallPromise(
+      CallArgs{nullptr, nullptr, nullptr, nullptr});
+  Update();
 }
 
-bool ClientPromiseBasedCall::Completed() {
+ArenaPromise<ServerMetadataHandle>
+ServerPromiseBasedCall::MakeTopOfServerCallPromise(CallArgs call_args) {
+  GPR_ASSERT(!top_reached_);
+  top_reached_ = true;
+  client_initial_metadata_ = std::move(call_args.client_initial_metadata);
+  server_initial_metadata_ = call_args.server_initial_metadata;
+  incoming_compression_algorithm_ =
+      client_initial_metadata_->Take(GrpcEncodingMetadata())
+          .value_or(GRPC_COMPRESS_NONE);
+  encodings_accepted_by_peer_ =
+      client_initial_metadata_->Take(GrpcAcceptEncodingMetadata())
+          .value_or(CompressionAlgorithmSet{GRPC_COMPRESS_NONE});
+  absl::optional<Timestamp> deadline =
+      client_initial_metadata_->get(GrpcTimeoutMetadata());
+  if (deadline.has_value()) set_send_deadline(*deadline);
+  return [this]() ABSL_NO_THREAD_SAFETY_ANALYSIS { return PollTopOfCall(); };
+}
+
+Poll<ServerMetadataHandle> ServerPromiseBasedCall::PollTopOfCall() {
+  if (!sent_status_ || outstanding_send_.has_value()) return Pending{};
+  // Messages already taken from the application may still be on their way
+  // through the filters, which drop them if the stack resolves first.
+  if (sent_initial_metadata_ && !server_to_client_messages_drained_) {
+    return Pending{};
+  }
+  GPR_ASSERT(send_trailing_metadata_ != nullptr);
+  return std::move(send_trailing_metadata_);
+}
+
+void ServerPromiseBasedCall::ServerToClientMessagesDrained() {
+  server_to_client_messages_drained_ = true;
+  ForceImmediateRepoll();
+}
+
+void ServerPromiseBasedCall::CancelWithError(grpc_error_handle error) {
+  MutexLock lock(mu());
+  ScopedContext context(this);
+  if (!completed_) {
+    Finish(ServerMetadataFromStatus(grpc_error_to_absl_status(error)), true);
+  }
+}
+
+absl::string_view ServerPromiseBasedCall::GetServerAuthority() const {
+  MutexLock lock(mu());
+  if (client_initial_metadata_ == nullptr) return "";
+  const Slice* authority_metadata =
+      client_initial_metadata_->get_pointer(HttpAuthorityMetadata());
+  if (authority_metadata == nullptr) return "";
+  return authority_metadata->as_string_view();
+}
+
+grpc_call_error ServerPromiseBasedCall::ValidateBatch(const grpc_op* ops,
+                                                      size_t nops) const {
+  BitSet<8> got_ops;
+  for (size_t op_idx = 0; op_idx < nops; op_idx++) {
+    const grpc_op& op = ops[op_idx];
+    switch (op.op) {
+      case GRPC_OP_SEND_INITIAL_METADATA:
+        if (!AreInitialMetadataFlagsValid(op.flags)) {
+          return GRPC_CALL_ERROR_INVALID_FLAGS;
+        }
+        if (!ValidateMetadata(op.data.send_initial_metadata.count,
+                              op.data.send_initial_metadata.metadata)) {
+          return GRPC_CALL_ERROR_INVALID_METADATA;
+        }
+        if (sent_initial_metadata_) {
+          return GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
+        }
+        break;
+      case GRPC_OP_SEND_MESSAGE:
+        if (!AreWriteFlagsValid(op.flags)) {
+          return GRPC_CALL_ERROR_INVALID_FLAGS;
+        }
+        break;
+      case GRPC_OP_SEND_STATUS_FROM_SERVER:
+        if (op.flags != 0) return GRPC_CALL_ERROR_INVALID_FLAGS;
+        if (!ValidateMetadata(
+                op.data.send_status_from_server.trailing_metadata_count,
+                op.data.send_status_from_server.trailing_metadata)) {
+          return GRPC_CALL_ERROR_INVALID_METADATA;
+        }
+        if (sent_status_) return GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
+        break;
+      case GRPC_OP_RECV_INITIAL_METADATA:
+      case GRPC_OP_RECV_MESSAGE:
+      case GRPC_OP_RECV_CLOSE_ON_SERVER:
+        if (op.flags != 0) return GRPC_CALL_ERROR_INVALID_FLAGS;
+        break;
+      case GRPC_OP_SEND_CLOSE_FROM_CLIENT:
+      case GRPC_OP_RECV_STATUS_ON_CLIENT:
+        return GRPC_CALL_ERROR_NOT_ON_SERVER;
+    }
+    if (got_ops.is_set(op.op)) return GRPC_CALL_ERROR_TOO_MANY_OPERATIONS;
+    got_ops.set(op.op);
+  }
+  return GRPC_CALL_OK;
+}
+
+void ServerPromiseBasedCall::CommitBatch(const grpc_op* ops, size_t nops,
+                                         const Completion& completion) {
+  for (size_t op_idx = 0; op_idx < nops; op_idx++) {
+    const grpc_op& op = ops[op_idx];
+    switch (op.op) {
+      case GRPC_OP_SEND_INITIAL_METADATA: {
+        sent_initial_metadata_ = true;
+        if (completed_) break;
+        send_initial_metadata_ =
+            GetContext<Arena>()->MakePooled<ServerMetadata>(
+                GetContext<Arena>());
+        CToMetadata(op.data.send_initial_metadata.metadata,
+                    op.data.send_initial_metadata.count,
+                    send_initial_metadata_.get());
+        // Ignore any te metadata key value pairs specified.
+        send_initial_metadata_->Remove(TeMetadata());
+        absl::optional<grpc_compression_level> level;
+        if (op.data.send_initial_metadata.maybe_compression_level.is_set) {
+          level = op.data.send_initial_metadata.maybe_compression_level.level;
+        } else {
+          const grpc_compression_options copts =
+              channel()->compression_options();
+          if (copts.default_level.is_set) level = copts.default_level.level;
+        }
+        if (level.has_value()) {
+          // Checked and removed by the compression filter.
+          send_initial_metadata_->Set(
+              GrpcInternalEncodingRequest(),
+              encodings_accepted_by_peer_.CompressionAlgorithmForLevel(
+                  *level));
+        }
+        server_initial_metadata_->Set(send_initial_metadata_.get());
+      } break;
+      case GRPC_OP_SEND_MESSAGE: {
+        GPR_ASSERT(!outstanding_send_.has_value());
+        if (!completed_) {
+          send_message_completion_ =
+              AddOpToCompletion(completion, PendingOp::kSendMessage);
+          SliceBuffer send;
+          grpc_slice_buffer_swap(
+              &op.data.send_message.send_message->data.raw.slice_buffer,
+              send.c_slice_buffer());
+          outstanding_send_.emplace(server_to_client_messages_.sender.Push(
+              GetContext<Arena>()->MakePooled<Message>(std::move(send),
+                                                       op.flags)));
+        } else {
+          FailCompletion(completion);
+        }
+      } break;
+      case GRPC_OP_SEND_STATUS_FROM_SERVER: {
+        sent_status_ = true;
+        if (completed_) {
+          FailCompletion(completion);
+          break;
+        }
+        send_trailing_metadata_ =
+            GetContext<Arena>()->MakePooled<ServerMetadata>(
+                GetContext<Arena>());
+        CToMetadata(op.data.send_status_from_server.trailing_metadata,
+                    op.data.send_status_from_server.trailing_metadata_count,
+                    send_trailing_metadata_.get());
+        send_trailing_metadata_->Set(GrpcStatusMetadata(),
+                                     op.data.send_status_from_server.status);
+        if (op.data.send_status_from_server.status_details != nullptr) {
+          send_trailing_metadata_->Set(
+              GrpcMessageMetadata(),
+              Slice(grpc_slice_copy(
+                  *op.data.send_status_from_server.status_details)));
+        }
+        // Ignore any te metadata key value pairs specified.
+        send_trailing_metadata_->Remove(TeMetadata());
+        // No more messages: once the filters have passed on everything sent
+        // so far, the transport sees the end of the stream.
+        server_to_client_messages_.sender.Close();
+        send_status_from_server_completion_ =
+            AddOpToCompletion(completion, PendingOp::kSendStatusFromServer);
+      } break;
+      case GRPC_OP_RECV_INITIAL_METADATA: {
+        if (client_initial_metadata_ != nullptr) {
+          PublishMetadataArray(
+              op.data.recv_initial_metadata.recv_initial_metadata,
+              client_initial_metadata_.get());
+        } else {
+          FailCompletion(completion);
+        }
+      } break;
+      case GRPC_OP_RECV_MESSAGE: {
+        GPR_ASSERT(!outstanding_recv_.has_value());
+        recv_message_ = op.data.recv_message.recv_message;
+        recv_message_completion_ =
+            AddOpToCompletion(completion, PendingOp::kReceiveMessage);
+        outstanding_recv_.emplace(client_to_server_messages_.receiver.Next());
+      } break;
+      case GRPC_OP_RECV_CLOSE_ON_SERVER: {
+        if (completed_) {
+          *op.data.recv_close_on_server.cancelled = cancelled_ ? 1 : 0;
+        } else {
+          recv_close_cancelled_ = op.data.recv_close_on_server.cancelled;
+          recv_close_on_server_completion_ =
+              AddOpToCompletion(completion, PendingOp::kReceiveCloseOnServer);
+        }
+      } break;
+      case GRPC_OP_SEND_CLOSE_FROM_CLIENT:
+      case GRPC_OP_RECV_STATUS_ON_CLIENT:
+        abort();  // unreachable
+    }
+  }
+}
+
+grpc_call_error ServerPromiseBasedCall::StartBatch(const grpc_op* ops,
+                                                   size_t nops,
+                                                   void* notify_tag,
+                                                   bool is_notify_tag_closure) {
+  MutexLock lock(mu());
+  ScopedContext activity_context(this);
+  if (nops == 0) {
+    EndOpImmediately(cq(), notify_tag, is_notify_tag_closure);
+    return GRPC_CALL_OK;
+  }
+  const grpc_call_error validation_result = ValidateBatch(ops, nops);
+  if (validation_result != GRPC_CALL_OK) {
+    return validation_result;
+  }
+  Completion completion =
+      StartCompletion(notify_tag, is_notify_tag_closure, ops);
+  CommitBatch(ops, nops, completion);
+  Update();
+  FinishOpOnCompletion(&completion, PendingOp::kStartingBatch);
+  return GRPC_CALL_OK;
+}
+
+void ServerPromiseBasedCall::UpdateOnce() {
+  if (grpc_call_trace.enabled()) {
+    gpr_log(GPR_INFO,
+            "%sUpdateOnce: outstanding_send=%s outstanding_recv=%s "
+            "sent_status=%s has_promise=%s",
+            DebugTag().c_str(),
+            outstanding_send_.has_value() ? "true" : "false",
+            outstanding_recv_.has_value() ? "true" : "false",
+            sent_status_ ? "true" : "false",
+            promise_.has_value() ? "true" : "false");
+  }
+  if (outstanding_send_.has_value()) {
+    Poll<bool> r = (*outstanding_send_)();
+    if (const bool* result = absl::get_if<bool>(&r)) {
+      outstanding_send_.reset();
+      if (!*result) FailCompletion(send_message_completion_);
+      FinishOpOnCompletion(&send_message_completion_, PendingOp::kSendMessage);
+    }
+  }
+  if (outstanding_recv_.has_value()) {
+    Poll<NextResult<MessageHandle>> r = (*outstanding_recv_)();
+    if (auto* result = absl::get_if<NextResult<MessageHandle>>(&r)) {
+      outstanding_recv_.reset();
+      if (result->has_value()) {
+        MessageHandle& message = **result;
+        if ((message->flags() & GRPC_WRITE_INTERNAL_COMPRESS) &&
+            (incoming_compression_algorithm_ != GRPC_COMPRESS_NONE)) {
+          *recv_message_ = grpc_raw_compressed_byte_buffer_create(
+              nullptr, 0, incoming_compression_algorithm_);
+        } else {
+          *recv_message_ = grpc_raw_byte_buffer_create(nullptr, 0);
+        }
+        grpc_slice_buffer_move_into(message->payload()->c_slice_buffer(),
+                                    &(*recv_message_)->data.raw.slice_buffer);
+      } else {
+        *recv_message_ = nullptr;
+      }
+      FinishOpOnCompletion(&recv_message_completion_,
+                           PendingOp::kReceiveMessage);
+    }
+  }
+  if (promise_.has_value()) {
+    Poll<ServerMetadataHandle> r = promise_();
+    if (grpc_call_trace.enabled()) {
+      gpr_log(GPR_INFO, "%sUpdateOnce: promise returns %s", DebugTag().c_str(),
+              PollToString(r, [](const ServerMetadataHandle& h) {
+                return h->DebugString();
+              }).c_str());
+    }
+    if (auto* result = absl::get_if<ServerMetadataHandle>(&r)) {
+      AcceptTransportStatsFromContext();
+      // The connected filter marks a stream that ended without our trailing
+      // metadata reaching the transport.
+      const bool cancelled =
+          !sent_status_ || (*result)->get(GrpcStatusFromWire()).value_or(false);
+      Finish(std::move(*result), cancelled);
+    }
+  }
+}
+
+void ServerPromiseBasedCall::Finish(ServerMetadataHandle result,
+                                    bool cancelled) {
+  if (grpc_call_trace.enabled()) {
+    gpr_log(GPR_INFO, "%sFinish: cancelled=%d %s", DebugTag().c_str(),
+            cancelled, result->DebugString().c_str());
+  }
+  promise_ = ArenaPromise<ServerMetadataHandle>();
+  completed_ = true;
+  cancelled_ = cancelled;
+  if (outstanding_send_.has_value()) {
+    outstanding_send_.reset();
+    FailCompletion(send_message_completion_);
+    FinishOpOnCompletion(&send_message_completion_, PendingOp::kSendMessage);
+  }
+  if (outstanding_recv_.has_value()) {
+    outstanding_recv_.reset();
+    *recv_message_ = nullptr;
+    failed_before_recv_message_ = cancelled;
+    FinishOpOnCompletion(&recv_message_completion_,
+                         PendingOp::kReceiveMessage);
+  }
+  if (send_status_from_server_completion_.has_value()) {
+    if (cancelled) FailCompletion(send_status_from_server_completion_);
+    FinishOpOnCompletion(&send_status_from_server_completion_,
+                         PendingOp::kSendStatusFromServer);
+  }
+  if (recv_close_on_server_completion_.has_value()) {
+    *recv_close_cancelled_ = cancelled ? 1 : 0;
+    FinishOpOnCompletion(&recv_close_on_server_completion_,
+                         PendingOp::kReceiveCloseOnServer);
+  }
+  const grpc_status_code status =
+      result->get(GrpcStatusMetadata()).value_or(GRPC_STATUS_UNKNOWN);
+  if (auto* channelz_node = server_->channelz_node()) {
+    if (cancelled || status != GRPC_STATUS_OK) {
+      channelz_node->RecordCallFailed();
+    } else {
+      channelz_node->RecordCallSucceeded();
+    }
+  }
+  if (const Slice* message = result->get_pointer(GrpcMessageMetadata())) {
+    std::string error_string(message->as_string_view());
+    RunFinalization(status, error_string.c_str());
+  } else {
+    RunFinalization(status, nullptr);
+  }
+  if (!top_reached_) {
+    // No one else has seen this call: drop the ref it was created with.
+    ExecCtx::Run(DEBUG_LOCATION,
+                 NewClosure([this](grpc_error_handle) { ExternalUnref(); }),
+                 absl::OkStatus());
+  }
+}
+
+bool ServerPromiseBasedCall::Completed() {
   MutexLock lock(mu());
   return completed_;
 }
@@ -2881,10 +3396,17 @@ size_t grpc_call_get_initial_size_estimate() {
 
 grpc_error_handle grpc_call_create(grpc_call_create_args* args,
                                    grpc_call** out_call) {
-  if (grpc_core::IsPromiseBasedClientCallEnabled() &&
-      args->channel->is_promising()) {
+  if (args->call_size_estimator == nullptr) {
+    args->call_size_estimator = args->channel->call_size_estimator();
+  }
+  if (args->channel->is_promising()) {
     if (args->server_transport_data == nullptr) {
-      return grpc_core::MakePromiseBasedCall<grpc_core::ClientPromiseBasedCall>(
+      if (grpc_core::IsPromiseBasedClientCallEnabled()) {
+        return grpc_core::MakePromiseBasedCall<
+            grpc_core::ClientPromiseBasedCall>(args, out_call);
+      }
+    } else if (grpc_core::IsPromiseBasedServerCallEnabled()) {
+      return grpc_core::MakePromiseBasedCall<grpc_core::ServerPromiseBasedCall>(
           args, out_call);
     }
   }
@@ -43,12 +43,15 @@
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
 #include "src/core/lib/iomgr/polling_entity.h"
+#include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/pipe.h"
 #include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
+#include "src/core/lib/transport/transport.h"
 
 typedef void (*grpc_ioreq_completion_func)(grpc_call* call, int success,
                                            void* user_data);
@@ -70,10 +73,14 @@ typedef struct grpc_call_create_args {
   absl::optional<grpc_core::Slice> authority;
 
   grpc_core::Timestamp send_deadline;
+
+  /* sizes the call's arena; if NULL, the channel-wide estimate is used */
+  grpc_core::CallSizeEstimator* call_size_estimator;
 } grpc_call_create_args;
 
 namespace grpc_core {
 class PromiseBasedCall;
+class ServerCallContext;
 
 // TODO(ctiller): move more call things into this type
 class CallContext {
@@ -95,6 +102,9 @@ class CallContext {
   gpr_atm* peer_string_atm_ptr();
   grpc_polling_entity* polling_entity() { return &pollent_; }
 
+  // Returns the server half of the call, or nullptr on a client call.
+  ServerCallContext* server_call_context();
+
  private:
   friend class PromiseBasedCall;
   // Call final info.
@@ -109,6 +119,35 @@ class CallContext {
 
 template <>
 struct ContextType<CallContext> {};
+
+// What the ends of a promise based server call stack need from the call:
+// the connected filter at the bottom of the stack feeds the transport's
+// streams into the pipes here, and the server filter at the top hands the
+// call over to the surface once client initial metadata has arrived.
+class ServerCallContext {
+ public:
+  // The transport's stream for this call, as given to grpc_call_create.
+  virtual const void* server_stream_data() = 0;
+  virtual grpc_call* c_call() = 0;
+
+  // The transport ends of the pipes carrying messages to and from the
+  // application.
+  virtual PipeSender<MessageHandle>* client_to_server_messages() = 0;
+  virtual PipeReceiver<MessageHandle>* server_to_client_messages() = 0;
+  // Called by the connected filter when it sees the end of the server to
+  // client messages: everything the application sent has passed through the
+  // filters, and the trailing metadata can follow.
+  virtual void ServerToClientMessagesDrained() = 0;
+
+  // Called by the server filter with the call args that reached the top of
+  // the stack.  The returned promise resolves with the trailing metadata the
+  // application sends.
+  virtual ArenaPromise<ServerMetadataHandle> MakeTopOfServerCallPromise(
+      CallArgs call_args) = 0;
+
+ protected:
+  ~ServerCallContext() = default;
+};
 }  // namespace grpc_core
 
 /* Create a new call based on \a args.
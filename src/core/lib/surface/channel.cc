@@ -27,7 +27,11 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
+#include "absl/hash/hash.h"
 #include "absl/status/status.h"
 
 #include <grpc/compression.h>
@@ -41,6 +45,7 @@
 #include "src/core/lib/channel/channel_stack_builder_impl.h"
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/config/core_configuration.h"
 #include "src/core/lib/debug/stats.h"
 #include "src/core/lib/debug/stats_data.h"
@@ -149,6 +154,9 @@ absl::StatusOr<RefCountedPtr<Channel>> Channel::CreateWithBuilder(
     compression_options.enabled_algorithms_bitset =
         *enabled_algorithms_bitset | 1 /* always support no compression */;
   }
+  // Never accept messages compressed with an algorithm we cannot decompress.
+  compression_options.enabled_algorithms_bitset &=
+      CompressionAlgorithmSet::Supported(channel_args).ToLegacyBitmask();
 
   return RefCountedPtr<Channel>(new Channel(
       grpc_channel_stack_type_is_client(builder->channel_stack_type()),
@@ -230,24 +238,80 @@ absl::StatusOr<RefCountedPtr<Channel>> Channel::Create(
   return CreateWithBuilder(&builder);
 }
 
-void Channel::UpdateCallSizeEstimate(size_t size) {
-  size_t cur = call_size_estimate_.load(std::memory_order_relaxed);
+void CallSizeEstimator::Update(size_t size) {
+  size_t cur = estimate_.load(std::memory_order_relaxed);
   if (cur < size) {
     // size grew: update estimate
-    call_size_estimate_.compare_exchange_weak(
-        cur, size, std::memory_order_relaxed, std::memory_order_relaxed);
+    estimate_.compare_exchange_weak(cur, size, std::memory_order_relaxed,
+                                    std::memory_order_relaxed);
     // if we lose: never mind, something else will likely update soon enough
   } else if (cur == size) {
     // no change: holding pattern
   } else if (cur > 0) {
     // size shrank: decrease estimate
-    call_size_estimate_.compare_exchange_weak(
+    estimate_.compare_exchange_weak(
         cur, std::min(cur - 1, (255 * cur + size) / 256),
         std::memory_order_relaxed, std::memory_order_relaxed);
     // if we lose: never mind, something else will likely update soon enough
   }
 }
 
+Histogram_32768_24 CallSizeEstimator::InitialSizeHistogram() const {
+  Histogram_32768_24 histogram;
+  initial_size_.Collect(&histogram);
+  return histogram;
+}
+
+CallSizeEstimator* Channel::CallSizeEstimatorForMethod(
+    absl::string_view method) {
+  const size_t start =
+      absl::Hash<absl::string_view>()(method) % kCallSizeEstimatorSlots;
+  // Fast path: an existing estimator, found without taking the lock.
+  for (size_t i = 0; i < kCallSizeEstimatorSlots; ++i) {
+    MethodCallSizeEstimator* entry =
+        call_size_estimator_slots_[(start + i) % kCallSizeEstimatorSlots].load(
+            std::memory_order_acquire);
+    if (entry == nullptr) break;
+    if (entry->method == method) return &entry->estimator;
+  }
+  if (num_call_size_estimators_.load(std::memory_order_relaxed) >=
+      kMaxCallSizeEstimators) {
+    return &call_size_estimate_;
+  }
+  MutexLock lock(&call_size_estimators_mu_);
+  if (call_size_estimators_.size() >= kMaxCallSizeEstimators) {
+    return &call_size_estimate_;
+  }
+  // The table is never more than half full, so there is a free slot.
+  for (size_t i = 0;; ++i) {
+    auto& slot =
+        call_size_estimator_slots_[(start + i) % kCallSizeEstimatorSlots];
+    MethodCallSizeEstimator* entry = slot.load(std::memory_order_relaxed);
+    if (entry == nullptr) {
+      // Start from what calls on this channel need so far.
+      call_size_estimators_.push_back(std::make_unique<MethodCallSizeEstimator>(
+          method, call_size_estimate_.Estimate()));
+      entry = call_size_estimators_.back().get();
+      slot.store(entry, std::memory_order_release);
+      num_call_size_estimators_.store(call_size_estimators_.size(),
+                                      std::memory_order_relaxed);
+      return &entry->estimator;
+    }
+    // Another thread may have added it since the fast path looked.
+    if (entry->method == method) return &entry->estimator;
+  }
+}
+
+std::vector<std::pair<std::string, Histogram_32768_24>>
+Channel::CallInitialSizeByMethod() {
+  std::vector<std::pair<std::string, Histogram_32768_24>> result;
+  MutexLock lock(&call_size_estimators_mu_);
+  for (const auto& entry : call_size_estimators_) {
+    result.emplace_back(entry->method, entry->estimator.InitialSizeHistogram());
+  }
+  return result;
+}
+
 }  // namespace grpc_core
 
 char* grpc_channel_get_target(grpc_channel* channel) {
@@ -283,7 +347,8 @@ static grpc_call* grpc_channel_create_call_internal(
     grpc_channel* c_channel, grpc_call* parent_call, uint32_t propagation_mask,
     grpc_completion_queue* cq, grpc_pollset_set* pollset_set_alternative,
     grpc_core::Slice path, absl::optional<grpc_core::Slice> authority,
-    grpc_core::Timestamp deadline) {
+    grpc_core::Timestamp deadline,
+    grpc_core::CallSizeEstimator* call_size_estimator = nullptr) {
   auto channel = grpc_core::Channel::FromC(c_channel)->Ref();
   GPR_ASSERT(channel->is_client());
   GPR_ASSERT(!(cq != nullptr && pollset_set_alternative != nullptr));
@@ -296,6 +361,10 @@ static grpc_call* grpc_channel_create_call_internal(
   args.cq = cq;
   args.pollset_set_alternative = pollset_set_alternative;
   args.server_transport_data = nullptr;
+  args.call_size_estimator =
+      call_size_estimator != nullptr
+          ? call_size_estimator
+          : args.channel->CallSizeEstimatorForMethod(path.as_string_view());
   args.path = std::move(path);
   args.authority = std::move(authority);
   args.send_deadline = deadline;
@@ -349,7 +418,8 @@ RegisteredCall::RegisteredCall(const char* method_arg, const char* host_arg) {
 }
 
 RegisteredCall::RegisteredCall(const RegisteredCall& other)
-    : path(other.path.Ref()) {
+    : path(other.path.Ref()),
+      call_size_estimator(other.call_size_estimator) {
   if (other.authority.has_value()) {
     authority = other.authority->Ref();
   }
@@ -381,8 +451,10 @@ RegisteredCall* Channel::RegisterCall(const char* method, const char* host) {
   if (rc_posn != registration_table_.map.end()) {
     return &rc_posn->second;
   }
-  auto insertion_result = registration_table_.map.insert(
-      {std::move(key), RegisteredCall(method, host)});
+  RegisteredCall rc(method, host);
+  rc.call_size_estimator = CallSizeEstimatorForMethod(key.second);
+  auto insertion_result =
+      registration_table_.map.insert({std::move(key), std::move(rc)});
   return &insertion_result.first->second;
 }
 
@@ -414,7 +486,8 @@ grpc_call* grpc_channel_create_registered_call(
       rc->authority.has_value()
           ? absl::optional<grpc_core::Slice>(rc->authority->Ref())
           : absl::nullopt,
-      grpc_core::Timestamp::FromTimespecRoundUp(deadline));
+      grpc_core::Timestamp::FromTimespecRoundUp(deadline),
+      rc->call_size_estimator);
 
   return call;
 }
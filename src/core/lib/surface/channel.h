@@ -25,9 +25,12 @@
 #include <stdint.h>
 
 #include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/statusor.h"
@@ -45,6 +48,7 @@
 #include "src/core/lib/channel/channel_stack.h"  // IWYU pragma: keep
 #include "src/core/lib/channel/channel_stack_builder.h"
 #include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gprpp/cpp_impl_of.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/ref_counted.h"
@@ -85,9 +89,46 @@ void grpc_channel_update_call_size_estimate(grpc_channel* channel, size_t size);
 
 namespace grpc_core {
 
+// Tracks how much arena memory the calls of one kind need, as a decaying
+// high-watermark: the estimate follows growth immediately and backs off by
+// 1/256th of the difference per call when calls get smaller.
+class CallSizeEstimator {
+ public:
+  explicit CallSizeEstimator(size_t initial_estimate)
+      : estimate_(initial_estimate) {}
+
+  CallSizeEstimator(const CallSizeEstimator&) = delete;
+  CallSizeEstimator& operator=(const CallSizeEstimator&) = delete;
+
+  size_t Estimate() const {
+    // We round up our current estimate to the NEXT value of kRoundUpSize.
+    // This ensures:
+    //  1. a consistent size allocation when our estimate is drifting slowly
+    //     (which is common) - which tends to help most allocators reuse memory
+    //  2. a small amount of allowed growth over the estimate without hitting
+    //     the arena size doubling case, reducing overall memory usage
+    static constexpr size_t kRoundUpSize = 256;
+    return (estimate_.load(std::memory_order_relaxed) + 2 * kRoundUpSize) &
+           ~(kRoundUpSize - 1);
+  }
+
+  // Feeds back the arena size a finished call ended up using.
+  void Update(size_t size);
+
+  // Records the initial arena size of a new call.
+  void RecordInitialSize(size_t size) { initial_size_.Increment(size); }
+  Histogram_32768_24 InitialSizeHistogram() const;
+
+ private:
+  std::atomic<size_t> estimate_;
+  HistogramCollector_32768_24 initial_size_;
+};
+
 struct RegisteredCall {
   Slice path;
   absl::optional<Slice> authority;
+  // Arena sizing for calls to path; owned by the channel.
+  CallSizeEstimator* call_size_estimator = nullptr;
 
   explicit RegisteredCall(const char* method_arg, const char* host_arg);
   RegisteredCall(const RegisteredCall& other);
@@ -125,20 +166,24 @@ class Channel : public RefCounted<Channel>,
 
   channelz::ChannelNode* channelz_node() const { return channelz_node_.get(); }
 
-  size_t CallSizeEstimate() {
-    // We round up our current estimate to the NEXT value of kRoundUpSize.
-    // This ensures:
-    //  1. a consistent size allocation when our estimate is drifting slowly
-    //     (which is common) - which tends to help most allocators reuse memory
-    //  2. a small amount of allowed growth over the estimate without hitting
-    //     the arena size doubling case, reducing overall memory usage
-    static constexpr size_t kRoundUpSize = 256;
-    return (call_size_estimate_.load(std::memory_order_relaxed) +
-            2 * kRoundUpSize) &
-           ~(kRoundUpSize - 1);
+  // Channel-wide arena size estimate, used for calls whose method is not
+  // known up front (e.g. server calls).
+  size_t CallSizeEstimate() { return call_size_estimate_.Estimate(); }
+  void UpdateCallSizeEstimate(size_t size) {
+    call_size_estimate_.Update(size);
   }
+  CallSizeEstimator* call_size_estimator() { return &call_size_estimate_; }
+
+  // Returns the estimator for calls to method, creating it on first use.
+  // Only the first kMaxCallSizeEstimators methods get their own; later ones
+  // share the channel-wide estimator.  Finding an existing estimator takes
+  // no lock.
+  CallSizeEstimator* CallSizeEstimatorForMethod(absl::string_view method);
+
+  // The call_initial_size histogram of each method with its own estimator.
+  std::vector<std::pair<std::string, Histogram_32768_24>>
+  CallInitialSizeByMethod();
 
-  void UpdateCallSizeEstimate(size_t size);
   absl::string_view target() const { return target_; }
   MemoryAllocator* allocator() { return &allocator_; }
   bool is_client() const { return is_client_; }
@@ -168,7 +213,29 @@ class Channel : public RefCounted<Channel>,
   const bool is_client_;
   const bool is_promising_;
   const grpc_compression_options compression_options_;
-  std::atomic<size_t> call_size_estimate_;
+  static constexpr size_t kMaxCallSizeEstimators = 64;
+  // Kept at most half full, so that probe sequences stay short.
+  static constexpr size_t kCallSizeEstimatorSlots = 2 * kMaxCallSizeEstimators;
+
+  struct MethodCallSizeEstimator {
+    MethodCallSizeEstimator(absl::string_view method, size_t initial_estimate)
+        : method(method), estimator(initial_estimate) {}
+
+    const std::string method;
+    CallSizeEstimator estimator;
+  };
+
+  CallSizeEstimator call_size_estimate_;
+  // Open-addressed hash table of the per-method estimators.  Slots are
+  // only ever filled, under call_size_estimators_mu_, and never cleared
+  // while the channel exists, so lookups can read them without the lock.
+  std::atomic<MethodCallSizeEstimator*>
+      call_size_estimator_slots_[kCallSizeEstimatorSlots] = {};
+  std::atomic<size_t> num_call_size_estimators_{0};
+  Mutex call_size_estimators_mu_;
+  // Owns the entries of call_size_estimator_slots_, in creation order.
+  std::vector<std::unique_ptr<MethodCallSizeEstimator>> call_size_estimators_
+      ABSL_GUARDED_BY(call_size_estimators_mu_);
   CallRegistrationTable registration_table_;
   RefCountedPtr<channelz::ChannelNode> channelz_node_;
   MemoryAllocator allocator_;
@@ -238,6 +238,10 @@ class CqEventQueue {
 
   bool Push(grpc_cq_completion* c);
   grpc_cq_completion* Pop();
+  /* Pops up to max_items completions into items, taking the consumer lock
+   * once. Like Pop(), may find nothing even if the queue is not empty.
+   * Returns the number popped. */
+  size_t PopBatch(grpc_cq_completion** items, size_t max_items);
 
  private:
   /* Spinlock to serialize consumers i.e pop() operations */
@@ -400,6 +404,9 @@ static void cq_end_op_for_callback(
 static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
                           void* reserved);
 
+static size_t cq_next_batch(grpc_completion_queue* cq, grpc_event* events,
+                            size_t max_events, gpr_timespec deadline);
+
 static grpc_event cq_pluck(grpc_completion_queue* cq, void* tag,
                            gpr_timespec deadline, void* reserved);
 
@@ -488,18 +495,30 @@ bool CqEventQueue::Push(grpc_cq_completion* c) {
 
 grpc_cq_completion* CqEventQueue::Pop() {
   grpc_cq_completion* c = nullptr;
+  PopBatch(&c, 1);
+  return c;
+}
+
+size_t CqEventQueue::PopBatch(grpc_cq_completion** items, size_t max_items) {
+  size_t n = 0;
 
   if (gpr_spinlock_trylock(&queue_lock_)) {
-    bool is_empty = false;
-    c = reinterpret_cast<grpc_cq_completion*>(queue_.PopAndCheckEnd(&is_empty));
+    while (n < max_items) {
+      bool is_empty = false;
+      grpc_cq_completion* c = reinterpret_cast<grpc_cq_completion*>(
+          queue_.PopAndCheckEnd(&is_empty));
+      if (c == nullptr) break;
+      items[n++] = c;
+    }
     gpr_spinlock_unlock(&queue_lock_);
   }
 
-  if (c) {
-    num_queue_items_.fetch_sub(1, std::memory_order_relaxed);
+  if (n > 0) {
+    num_queue_items_.fetch_sub(static_cast<intptr_t>(n),
+                               std::memory_order_relaxed);
   }
 
-  return c;
+  return n;
 }
 
 grpc_completion_queue* grpc_completion_queue_create_internal(
@@ -821,6 +840,12 @@ static void functor_callback(void* arg, grpc_error_handle error) {
   functor->functor_run(functor, error.ok());
 }
 
+static void functor_callback_with_app_exec_ctx(void* arg,
+                                               grpc_error_handle error) {
+  grpc_core::ApplicationCallbackExecCtx callback_exec_ctx;
+  functor_callback(arg, error);
+}
+
 /* Complete an event on a completion queue of type GRPC_CQ_CALLBACK */
 static void cq_end_op_for_callback(
     grpc_completion_queue* cq, void* tag, grpc_error_handle error,
@@ -865,6 +890,17 @@ static void cq_end_op_for_callback(
     return;
   }
 
+  // A callback that may run on any thread runs from this thread's ExecCtx,
+  // once the caller has released its locks.
+  if (functor->inlineable == GRPC_CQ_FUNCTOR_INLINE_ANY_THREAD) {
+    grpc_core::ExecCtx::Run(
+        DEBUG_LOCATION,
+        GRPC_CLOSURE_CREATE(functor_callback_with_app_exec_ctx, functor,
+                            nullptr),
+        error);
+    return;
+  }
+
   // Schedule the callback on a closure if not internal or triggered
   // from a background poller thread.
   grpc_core::Executor::Run(
@@ -940,11 +976,34 @@ static void dump_pending_tags(grpc_completion_queue* cq) {
 static void dump_pending_tags(grpc_completion_queue* /*cq*/) {}
 #endif
 
+/* Fills *ev with the completion c and releases c */
+static void cq_complete_event(grpc_event* ev, grpc_cq_completion* c) {
+  ev->type = GRPC_OP_COMPLETE;
+  ev->success = c->next & 1u;
+  ev->tag = c->tag;
+  c->done(c->done_arg, c);
+}
+
+/* Fills up to max_events events with completions that are already queued,
+   without waiting for more. Returns the number filled. */
+static size_t cq_take_queued_events(cq_next_data* cqd, grpc_event* events,
+                                    size_t max_events) {
+  static constexpr size_t kChunk = 16;
+  size_t n = 0;
+  while (n < max_events) {
+    grpc_cq_completion* chunk[kChunk];
+    const size_t want = std::min(max_events - n, kChunk);
+    const size_t got = cqd->queue.PopBatch(chunk, want);
+    for (size_t i = 0; i < got; i++) {
+      cq_complete_event(&events[n++], chunk[i]);
+    }
+    if (got < want) break;
+  }
+  return n;
+}
+
 static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
                           void* reserved) {
-  grpc_event ret;
-  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
-
   GRPC_API_TRACE(
       "grpc_completion_queue_next("
       "cq=%p, "
@@ -956,6 +1015,20 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
        reserved));
   GPR_ASSERT(!reserved);
 
+  grpc_event ret;
+  cq_next_batch(cq, &ret, 1, deadline);
+  return ret;
+}
+
+/* Waits like cq_next for a first event, then also returns, up to max_events
+   in all, the completions queued behind it. A GRPC_QUEUE_SHUTDOWN or
+   GRPC_QUEUE_TIMEOUT event is always returned alone. */
+static size_t cq_next_batch(grpc_completion_queue* cq, grpc_event* events,
+                            size_t max_events, gpr_timespec deadline) {
+  GPR_ASSERT(max_events > 0);
+  size_t num_events = 0;
+  cq_next_data* cqd = static_cast<cq_next_data*> DATA_FROM_CQ(cq);
+
   dump_pending_tags(cq);
 
   GRPC_CQ_INTERNAL_REF(cq, "next");
@@ -976,27 +1049,21 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     if (is_finished_arg.stolen_completion != nullptr) {
       grpc_cq_completion* c = is_finished_arg.stolen_completion;
       is_finished_arg.stolen_completion = nullptr;
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+      cq_complete_event(&events[0], c);
+      num_events = 1 + cq_take_queued_events(cqd, events + 1, max_events - 1);
       break;
     }
 
-    grpc_cq_completion* c = cqd->queue.Pop();
+    num_events = cq_take_queued_events(cqd, events, max_events);
 
-    if (c != nullptr) {
-      ret.type = GRPC_OP_COMPLETE;
-      ret.success = c->next & 1u;
-      ret.tag = c->tag;
-      c->done(c->done_arg, c);
+    if (num_events > 0) {
       break;
     } else {
-      /* If c == NULL it means either the queue is empty OR in an transient
-         inconsistent state. If it is the latter, we shold do a 0-timeout poll
-         so that the thread comes back quickly from poll to make a second
-         attempt at popping. Not doing this can potentially deadlock this
-         thread forever (if the deadline is infinity) */
+      /* If nothing was popped it means either the queue is empty OR in an
+         transient inconsistent state. If it is the latter, we shold do a
+         0-timeout poll so that the thread comes back quickly from poll to
+         make a second attempt at popping. Not doing this can potentially
+         deadlock this thread forever (if the deadline is infinity) */
       if (cqd->queue.num_items() > 0) {
         iteration_deadline = grpc_core::Timestamp::ProcessEpoch();
       }
@@ -1015,15 +1082,17 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
         continue;
       }
 
-      ret.type = GRPC_QUEUE_SHUTDOWN;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_SHUTDOWN;
+      events[0].success = 0;
+      num_events = 1;
       break;
     }
 
     if (!is_finished_arg.first_loop &&
         grpc_core::Timestamp::Now() >= deadline_millis) {
-      ret.type = GRPC_QUEUE_TIMEOUT;
-      ret.success = 0;
+      events[0].type = GRPC_QUEUE_TIMEOUT;
+      events[0].success = 0;
+      num_events = 1;
       dump_pending_tags(cq);
       break;
     }
@@ -1039,11 +1108,12 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
       gpr_log(GPR_ERROR, "Completion queue next failed: %s",
               grpc_core::StatusToString(err).c_str());
       if (err == absl::CancelledError()) {
-        ret.type = GRPC_QUEUE_SHUTDOWN;
+        events[0].type = GRPC_QUEUE_SHUTDOWN;
       } else {
-        ret.type = GRPC_QUEUE_TIMEOUT;
+        events[0].type = GRPC_QUEUE_TIMEOUT;
       }
-      ret.success = 0;
+      events[0].success = 0;
+      num_events = 1;
       dump_pending_tags(cq);
       break;
     }
@@ -1057,12 +1127,14 @@ static grpc_event cq_next(grpc_completion_queue* cq, gpr_timespec deadline,
     gpr_mu_unlock(cq->mu);
   }
 
-  GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &ret);
+  for (size_t i = 0; i < num_events; i++) {
+    GRPC_SURFACE_TRACE_RETURNED_EVENT(cq, &events[i]);
+  }
   GRPC_CQ_INTERNAL_UNREF(cq, "next");
 
   GPR_ASSERT(is_finished_arg.stolen_completion == nullptr);
 
-  return ret;
+  return num_events;
 }
 
 /* Finishes the completion queue shutdown. This means that there are no more
@@ -1112,6 +1184,24 @@ grpc_event grpc_completion_queue_next(grpc_completion_queue* cq,
   return cq->vtable->next(cq, deadline, reserved);
 }
 
+size_t grpc_completion_queue_next_batch(grpc_completion_queue* cq,
+                                        grpc_event* events, size_t max_events,
+                                        gpr_timespec deadline,
+                                        void* reserved) {
+  GRPC_API_TRACE(
+      "grpc_completion_queue_next_batch("
+      "cq=%p, events=%p, max_events=%" PRIuPTR ", "
+      "deadline=gpr_timespec { tv_sec: %" PRId64
+      ", tv_nsec: %d, clock_type: %d }, "
+      "reserved=%p)",
+      7,
+      (cq, events, max_events, deadline.tv_sec, deadline.tv_nsec,
+       (int)deadline.clock_type, reserved));
+  GPR_ASSERT(!reserved);
+  GPR_ASSERT(cq->vtable->cq_completion_type == GRPC_CQ_NEXT);
+  return cq_next_batch(cq, events, max_events, deadline);
+}
+
 static int add_plucker(grpc_completion_queue* cq, void* tag,
                        grpc_pollset_worker** worker) {
   cq_pluck_data* cqd = static_cast<cq_pluck_data*> DATA_FROM_CQ(cq);
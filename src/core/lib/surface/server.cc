@@ -24,9 +24,9 @@
 
 #include <algorithm>
 #include <atomic>
+#include <deque>
 #include <list>
 #include <new>
-#include <queue>
 #include <utility>
 #include <vector>
 
@@ -44,12 +44,17 @@
 #include "src/core/lib/channel/channel_trace.h"
 #include "src/core/lib/channel/channelz.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/mpscq.h"
 #include "src/core/lib/gprpp/status_helper.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/pollset_set.h"
+#include "src/core/lib/promise/context.h"
+#include "src/core/lib/promise/promise.h"
+#include "src/core/lib/resource_quota/arena.h"
 #include "src/core/lib/slice/slice_internal.h"
 #include "src/core/lib/surface/api_trace.h"
 #include "src/core/lib/surface/call.h"
@@ -192,125 +197,279 @@ class Server::RequestMatcherInterface {
 // The RealRequestMatcher is an implementation of RequestMatcherInterface that
 // actually uses all the features of RequestMatcherInterface: expecting the
 // application to explicitly request RPCs and then matching those to incoming
-// RPCs, along with a slow path by which incoming RPCs are put on a locked
-// pending list if they aren't able to be matched to an application request.
+// RPCs, along with a slow path by which incoming RPCs are put on a pending
+// list if they aren't able to be matched to an application request.
+//
+// The matcher is sharded by CQ.  Requests made on a CQ go on its shard's
+// lock-free request queue, and incoming RPCs that find no request are queued
+// on the shard of the CQ their channel is bound to, under a lock of that
+// shard only.  A request takes pending RPCs from its own shard first, and
+// steals from the other shards only when its own has none.
+//
+// An RPC that is queued and a request that is made at the same time must
+// still find each other.  The RPC side counts the RPC in num_pending_ before
+// looking for requests, and the request side counts the request in its
+// shard's num_requests before looking at num_pending_: at least one of them
+// sees the other and does the match.
 class Server::RealRequestMatcher : public RequestMatcherInterface {
  public:
   explicit RealRequestMatcher(Server* server)
-      : server_(server), requests_per_cq_(server->cqs_.size()) {}
+      : server_(server), shards_(server->cqs_.size()) {}
 
   ~RealRequestMatcher() override {
-    for (LockedMultiProducerSingleConsumerQueue& queue : requests_per_cq_) {
-      GPR_ASSERT(queue.Pop() == nullptr);
+    for (Shard& shard : shards_) {
+      GPR_ASSERT(shard.requests.Pop() == nullptr);
     }
   }
 
   void ZombifyPending() override {
-    while (!pending_.empty()) {
-      CallData* calld = pending_.front();
-      calld->SetState(CallData::CallState::ZOMBIED);
-      calld->KillZombie();
-      pending_.pop();
+    for (Shard& shard : shards_) {
+      MutexLock lock(&shard.mu);
+      while (!shard.pending.empty()) {
+        CallData* calld = shard.pending.front().calld;
+        calld->SetState(CallData::CallState::ZOMBIED);
+        calld->KillZombie();
+        shard.pending.pop_front();
+        num_pending_.fetch_sub(1, std::memory_order_relaxed);
+      }
     }
   }
 
   void KillRequests(grpc_error_handle error) override {
-    for (size_t i = 0; i < requests_per_cq_.size(); i++) {
+    for (size_t i = 0; i < shards_.size(); i++) {
       RequestedCall* rc;
-      while ((rc = reinterpret_cast<RequestedCall*>(
-                  requests_per_cq_[i].Pop())) != nullptr) {
+      while ((rc = PopRequest(&shards_[i])) != nullptr) {
         server_->FailCall(i, rc, error);
       }
     }
   }
 
-  size_t request_queue_count() const override {
-    return requests_per_cq_.size();
-  }
+  size_t request_queue_count() const override { return shards_.size(); }
 
   void RequestCallWithPossiblePublish(size_t request_queue_index,
                                       RequestedCall* call) override {
-    if (requests_per_cq_[request_queue_index].Push(&call->mpscq_node)) {
-      /* this was the first queued request: we need to lock and start
-         matching calls */
-      struct PendingCall {
-        RequestedCall* rc = nullptr;
-        CallData* calld;
-      };
-      auto pop_next_pending = [this, request_queue_index] {
-        PendingCall pending_call;
-        {
-          MutexLock lock(&server_->mu_call_);
-          if (!pending_.empty()) {
-            pending_call.rc = reinterpret_cast<RequestedCall*>(
-                requests_per_cq_[request_queue_index].Pop());
-            if (pending_call.rc != nullptr) {
-              pending_call.calld = pending_.front();
-              pending_.pop();
-            }
-          }
-        }
-        return pending_call;
-      };
-      while (true) {
-        PendingCall next_pending = pop_next_pending();
-        if (next_pending.rc == nullptr) break;
-        if (!next_pending.calld->MaybeActivate()) {
-          // Zombied Call
-          next_pending.calld->KillZombie();
-        } else {
-          next_pending.calld->Publish(request_queue_index, next_pending.rc);
-        }
-      }
+    Shard& shard = shards_[request_queue_index];
+    shard.requests.Push(&call->mpscq_node);
+    shard.num_requests.fetch_add(1, std::memory_order_seq_cst);
+    if (num_pending_.load(std::memory_order_seq_cst) > 0) {
+      MatchPending(request_queue_index);
     }
   }
 
   void MatchOrQueue(size_t start_request_queue_index,
                     CallData* calld) override {
-    for (size_t i = 0; i < requests_per_cq_.size(); i++) {
-      size_t cq_idx = (start_request_queue_index + i) % requests_per_cq_.size();
-      RequestedCall* rc =
-          reinterpret_cast<RequestedCall*>(requests_per_cq_[cq_idx].TryPop());
+    for (size_t i = 0; i < shards_.size(); i++) {
+      size_t cq_idx = (start_request_queue_index + i) % shards_.size();
+      RequestedCall* rc = TryPopRequest(&shards_[cq_idx]);
       if (rc != nullptr) {
         calld->SetState(CallData::CallState::ACTIVATED);
         calld->Publish(cq_idx, rc);
         return;
       }
     }
-    // No cq to take the request found; queue it on the slow list.
-    // We need to ensure that all the queues are empty.  We do this under
-    // the server mu_call_ lock to ensure that if something is added to
-    // an empty request queue, it will block until the call is actually
-    // added to the pending list.
-    RequestedCall* rc = nullptr;
-    size_t cq_idx = 0;
-    size_t loop_count;
+    // No cq to take the request found; queue it on the slow list of its own
+    // shard.
+    Shard& shard = shards_[start_request_queue_index];
+    std::vector<RejectedCall> rejected;
+    bool queued = false;
     {
-      MutexLock lock(&server_->mu_call_);
-      for (loop_count = 0; loop_count < requests_per_cq_.size(); loop_count++) {
-        cq_idx =
-            (start_request_queue_index + loop_count) % requests_per_cq_.size();
-        rc = reinterpret_cast<RequestedCall*>(requests_per_cq_[cq_idx].Pop());
-        if (rc != nullptr) {
-          break;
-        }
-      }
-      if (rc == nullptr) {
+      MutexLock lock(&shard.mu);
+      const Timestamp now = Timestamp::Now();
+      if (shard.pending.empty()) shard.last_empty = now;
+      DropExpiredLocked(&shard, now, &rejected);
+      const Duration time_left = calld->deadline() - now;
+      if (time_left <= Duration::Zero()) {
+        rejected.push_back({calld, GRPC_STATUS_DEADLINE_EXCEEDED,
+                            "Deadline exceeded before the call was queued"});
+      } else if (num_pending_.load(std::memory_order_relaxed) >=
+                 server_->max_pending_calls_) {
+        rejected.push_back({calld, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                            "Too many calls pending on the server"});
+      } else if (!shard.pending.empty() && time_left < shard.last_queue_time) {
+        // Calls ahead of this one recently waited longer than it can.
+        rejected.push_back({calld, GRPC_STATUS_RESOURCE_EXHAUSTED,
+                            "Deadline cannot be met by the server"});
+      } else {
         calld->SetState(CallData::CallState::PENDING);
-        pending_.push(calld);
-        return;
+        shard.pending.push_back({calld, now});
+        num_pending_.fetch_add(1, std::memory_order_seq_cst);
+        queued = true;
       }
     }
-    calld->SetState(CallData::CallState::ACTIVATED);
-    calld->Publish(cq_idx, rc);
+    RejectAll(&rejected);
+    // A request made since the scan above may not have seen this call.
+    if (queued) MatchPending(start_request_queue_index);
   }
 
   Server* server() const override { return server_; }
 
  private:
+  struct QueuedCall {
+    CallData* calld;
+    Timestamp enqueued;
+  };
+
+  // A call taken off the queue, or turned away, without being published.
+  struct RejectedCall {
+    CallData* calld;
+    grpc_status_code status;
+    const char* message;
+  };
+
+  struct Shard {
+    LockedMultiProducerSingleConsumerQueue requests;
+    // Requests pushed and not yet popped.  Counted after the push, so a
+    // request that is counted can be popped.
+    std::atomic<size_t> num_requests{0};
+    Mutex mu;
+    std::deque<QueuedCall> pending ABSL_GUARDED_BY(mu);
+    // When the queue was last seen empty, and how long the call most recently
+    // taken off it had waited.
+    Timestamp last_empty ABSL_GUARDED_BY(mu);
+    Duration last_queue_time ABSL_GUARDED_BY(mu);
+  };
+
+  static RequestedCall* TryPopRequest(Shard* shard) {
+    auto* rc = reinterpret_cast<RequestedCall*>(shard->requests.TryPop());
+    if (rc != nullptr) shard->num_requests.fetch_sub(1);
+    return rc;
+  }
+
+  static RequestedCall* PopRequest(Shard* shard) {
+    auto* rc = reinterpret_cast<RequestedCall*>(shard->requests.Pop());
+    if (rc != nullptr) shard->num_requests.fetch_sub(1);
+    return rc;
+  }
+
+  // Matches pending calls with the requests of every shard that has some,
+  // starting at start_request_queue_index.
+  void MatchPending(size_t start_request_queue_index) {
+    size_t i = 0;
+    while (i < shards_.size()) {
+      size_t cq_idx = (start_request_queue_index + i) % shards_.size();
+      if (shards_[cq_idx].num_requests.load(std::memory_order_seq_cst) > 0 &&
+          !MatchPendingForShard(cq_idx)) {
+        // A call went back on a queue: look at every shard again.
+        i = 0;
+        continue;
+      }
+      ++i;
+    }
+  }
+
+  // Publishes pending calls to the requests of one shard, for as long as
+  // there are both.  Returns false if a call was taken off a queue and then
+  // put back because another thread took the request first.
+  bool MatchPendingForShard(size_t request_queue_index) {
+    Shard& shard = shards_[request_queue_index];
+    std::vector<RejectedCall> rejected;
+    while (true) {
+      Shard* from = nullptr;
+      QueuedCall call = PopPending(request_queue_index, &from, &rejected);
+      RejectAll(&rejected);
+      if (call.calld == nullptr) return true;
+      RequestedCall* rc = PopRequest(&shard);
+      if (rc == nullptr) {
+        {
+          MutexLock lock(&from->mu);
+          from->pending.push_front(call);
+        }
+        num_pending_.fetch_add(1, std::memory_order_seq_cst);
+        return false;
+      }
+      global_stats().IncrementServerPendingCallQueueTime(
+          (Timestamp::Now() - call.enqueued).millis());
+      if (!call.calld->MaybeActivate()) {
+        // Zombied Call
+        call.calld->KillZombie();
+      } else {
+        call.calld->Publish(request_queue_index, rc);
+      }
+    }
+  }
+
+  // Takes the oldest pending call of the given shard or, if it has none, of
+  // the next shard that does.  Sets *from to the shard it came from.
+  QueuedCall PopPending(size_t request_queue_index, Shard** from,
+                        std::vector<RejectedCall>* rejected) {
+    for (size_t i = 0; i < shards_.size(); i++) {
+      if (num_pending_.load(std::memory_order_relaxed) == 0) break;
+      Shard* shard = &shards_[(request_queue_index + i) % shards_.size()];
+      MutexLock lock(&shard->mu);
+      const Timestamp now = Timestamp::Now();
+      DropExpiredLocked(shard, now, rejected);
+      if (!shard->pending.empty()) {
+        *from = shard;
+        return PopFrontLocked(shard, now);
+      }
+    }
+    return {nullptr, Timestamp()};
+  }
+
+  // The longest the oldest call may have waited.  This is the CoDel scheme
+  // as applied to RPC queues: while the queue keeps draining, calls may wait
+  // for an interval, but once it has not been empty for that long the server
+  // is overloaded and only calls within the target delay are worth serving.
+  Duration MaxQueueTimeLocked(Shard* shard, Timestamp now) const
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard->mu) {
+    if (server_->pending_call_target_delay_ == Duration::Zero()) {
+      return Duration::Infinity();
+    }
+    if (now - shard->last_empty > server_->pending_call_interval_) {
+      return server_->pending_call_target_delay_;
+    }
+    return server_->pending_call_interval_;
+  }
+
+  QueuedCall PopFrontLocked(Shard* shard, Timestamp now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard->mu) {
+    QueuedCall front = shard->pending.front();
+    shard->pending.pop_front();
+    num_pending_.fetch_sub(1, std::memory_order_relaxed);
+    shard->last_queue_time = now - front.enqueued;
+    if (shard->pending.empty()) shard->last_empty = now;
+    return front;
+  }
+
+  // Takes calls that can no longer be served usefully off the front of the
+  // queue.  Calls further back with passed deadlines are taken off when they
+  // reach the front.
+  void DropExpiredLocked(Shard* shard, Timestamp now,
+                         std::vector<RejectedCall>* rejected)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(shard->mu) {
+    const Duration max_queue_time = MaxQueueTimeLocked(shard, now);
+    while (!shard->pending.empty()) {
+      const QueuedCall& front = shard->pending.front();
+      if (front.calld->deadline() <= now) {
+        rejected->push_back(
+            {PopFrontLocked(shard, now).calld, GRPC_STATUS_DEADLINE_EXCEEDED,
+             "Deadline exceeded while waiting for the server"});
+      } else if (now - front.enqueued > max_queue_time) {
+        rejected->push_back({PopFrontLocked(shard, now).calld,
+                             GRPC_STATUS_RESOURCE_EXHAUSTED,
+                             "Server overloaded"});
+      } else {
+        break;
+      }
+    }
+  }
+
+  static void RejectAll(std::vector<RejectedCall>* rejected) {
+    for (const RejectedCall& call : *rejected) {
+      if (call.status == GRPC_STATUS_DEADLINE_EXCEEDED) {
+        global_stats().IncrementServerPendingCallsExpired();
+      } else {
+        global_stats().IncrementServerPendingCallsShed();
+      }
+      call.calld->Reject(call.status, call.message);
+    }
+    rejected->clear();
+  }
+
   Server* const server_;
-  std::queue<CallData*> pending_;
-  std::vector<LockedMultiProducerSingleConsumerQueue> requests_per_cq_;
+  std::vector<Shard> shards_;
+  // Calls queued across all shards.
+  std::atomic<size_t> num_pending_{0};
 };
 
 // AllocatingRequestMatchers don't allow the application to request an RPC in
@@ -492,7 +651,7 @@ class ChannelBroadcaster {
 
 const grpc_channel_filter Server::kServerTopFilter = {
     Server::CallData::StartTransportStreamOpBatch,
-    nullptr,
+    Server::ChannelData::MakeCallPromise,
     grpc_channel_next_op,
     sizeof(Server::CallData),
     Server::CallData::InitCallElement,
@@ -508,6 +667,9 @@ const grpc_channel_filter Server::kServerTopFilter = {
 
 namespace {
 
+constexpr int kDefaultMaxPendingCalls = 10000;
+constexpr Duration kDefaultPendingCallInterval = Duration::Milliseconds(100);
+
 RefCountedPtr<channelz::ServerNode> CreateChannelzNode(
     const ChannelArgs& args) {
   RefCountedPtr<channelz::ServerNode> channelz_node;
@@ -528,7 +690,21 @@ RefCountedPtr<channelz::ServerNode> CreateChannelzNode(
 }  // namespace
 
 Server::Server(const ChannelArgs& args)
-    : channel_args_(args), channelz_node_(CreateChannelzNode(args)) {}
+    : channel_args_(args),
+      channelz_node_(CreateChannelzNode(args)),
+      max_pending_calls_(
+          std::max(0, args.GetInt(GRPC_ARG_SERVER_MAX_PENDING_CALLS)
+                          .value_or(kDefaultMaxPendingCalls))),
+      pending_call_target_delay_(
+          std::max(Duration::Zero(),
+                   args.GetDurationFromIntMillis(
+                           GRPC_ARG_SERVER_PENDING_CALL_TARGET_DELAY_MS)
+                       .value_or(Duration::Zero()))),
+      pending_call_interval_(
+          std::max(Duration::Zero(),
+                   args.GetDurationFromIntMillis(
+                           GRPC_ARG_SERVER_PENDING_CALL_INTERVAL_MS)
+                       .value_or(kDefaultPendingCallInterval))) {}
 
 Server::~Server() {
   // Remove the cq pollsets from the config_fetcher.
@@ -623,6 +799,12 @@ grpc_error_handle Server::SetupTransport(
   return absl::OkStatus();
 }
 
+ChannelArgs Server::ChannelArgsForPort(absl::string_view addr) const {
+  auto it = port_channel_args_.find(addr);
+  if (it == port_channel_args_.end()) return channel_args_;
+  return it->second.UnionWith(channel_args_);
+}
+
 bool Server::HasOpenConnections() {
   MutexLock lock(&mu_global_);
   return !channels_.empty();
@@ -1097,16 +1279,32 @@ void Server::ChannelData::AcceptStream(void* arg, grpc_transport* /*transport*/,
   args.pollset_set_alternative = nullptr;
   args.server_transport_data = transport_server_data;
   args.send_deadline = Timestamp::InfFuture();
+  // The method is not known until the initial metadata arrives.
+  args.call_size_estimator = nullptr;
   grpc_call* call;
   grpc_error_handle error = grpc_call_create(&args, &call);
-  grpc_call_element* elem =
-      grpc_call_stack_element(grpc_call_get_call_stack(call), 0);
+  grpc_call_stack* call_stack = grpc_call_get_call_stack(call);
+  // A promise based call starts itself from MakeCallPromise() once its
+  // initial metadata arrives.
+  if (call_stack == nullptr) return;
+  grpc_call_element* elem = grpc_call_stack_element(call_stack, 0);
   auto* calld = static_cast<Server::CallData*>(elem->call_data);
   if (!error.ok()) {
     calld->FailCallCreation();
     return;
   }
-  calld->Start(elem);
+  calld->Start();
+}
+
+ArenaPromise<ServerMetadataHandle> Server::ChannelData::MakeCallPromise(
+    grpc_channel_element* elem, CallArgs call_args, NextPromiseFactory) {
+  auto* chand = static_cast<Server::ChannelData*>(elem->channel_data);
+  auto* server_call_context =
+      GetContext<CallContext>()->server_call_context();
+  auto* calld = GetContext<Arena>()->ManagedNew<CallData>(
+      chand, server_call_context->c_call(), chand->server());
+  return calld->MakeTopOfCallPromise(std::move(call_args),
+                                     server_call_context);
 }
 
 void Server::ChannelData::FinishDestroy(void* arg,
@@ -1162,14 +1360,19 @@ Server::CallData::CallData(grpc_call_element* elem,
                            const grpc_call_element_args& args,
                            RefCountedPtr<Server> server)
     : server_(std::move(server)),
+      chand_(static_cast<ChannelData*>(elem->channel_data)),
       call_(grpc_call_from_top_element(elem)),
       call_combiner_(args.call_combiner) {
   GRPC_CLOSURE_INIT(&recv_initial_metadata_ready_, RecvInitialMetadataReady,
-                    elem, grpc_schedule_on_exec_ctx);
+                    this, grpc_schedule_on_exec_ctx);
   GRPC_CLOSURE_INIT(&recv_trailing_metadata_ready_, RecvTrailingMetadataReady,
-                    elem, grpc_schedule_on_exec_ctx);
+                    this, grpc_schedule_on_exec_ctx);
 }
 
+Server::CallData::CallData(ChannelData* chand, grpc_call* call,
+                           RefCountedPtr<Server> server)
+    : server_(std::move(server)), chand_(chand), call_(call) {}
+
 Server::CallData::~CallData() {
   GPR_ASSERT(state_.load(std::memory_order_relaxed) != CallState::PENDING);
   grpc_metadata_array_destroy(&initial_metadata_);
@@ -1202,19 +1405,61 @@ void Server::CallData::FailCallCreation() {
   }
 }
 
-void Server::CallData::Start(grpc_call_element* elem) {
+void Server::CallData::Reject(grpc_status_code status, const char* message) {
+  CallState expected_not_started = CallState::NOT_STARTED;
+  CallState expected_pending = CallState::PENDING;
+  // A pending call may have been zombied by a failure in the meantime, in
+  // which case there is no one to send the status to.
+  if (state_.compare_exchange_strong(expected_not_started, CallState::ZOMBIED,
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire) ||
+      state_.compare_exchange_strong(expected_pending, CallState::ZOMBIED,
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_relaxed)) {
+    grpc_call_cancel_with_status(call_, status, message, nullptr);
+  }
+  KillZombie();
+}
+
+void Server::CallData::Start() {
   grpc_op op;
   op.op = GRPC_OP_RECV_INITIAL_METADATA;
   op.flags = 0;
   op.reserved = nullptr;
   op.data.recv_initial_metadata.recv_initial_metadata = &initial_metadata_;
   GRPC_CLOSURE_INIT(&recv_initial_metadata_batch_complete_,
-                    RecvInitialMetadataBatchComplete, elem,
+                    RecvInitialMetadataBatchComplete, this,
                     grpc_schedule_on_exec_ctx);
   grpc_call_start_batch_and_execute(call_, &op, 1,
                                     &recv_initial_metadata_batch_complete_);
 }
 
+ArenaPromise<ServerMetadataHandle> Server::CallData::MakeTopOfCallPromise(
+    CallArgs call_args, ServerCallContext* server_call_context) {
+  ClientMetadata& md = *call_args.client_initial_metadata;
+  path_ = md.Take(HttpPathMetadata());
+  auto* host = md.get_pointer(HttpAuthorityMetadata());
+  if (host != nullptr) host_.emplace(host->Ref());
+  auto deadline = md.get(GrpcTimeoutMetadata());
+  if (deadline.has_value()) deadline_ = *deadline;
+  auto promise = server_call_context->MakeTopOfServerCallPromise(
+      std::move(call_args));
+  // The rest of the work happens outside of the call's activity, as it would
+  // for a filter stack based call.
+  if (!host_.has_value() || !path_.has_value()) {
+    ExecCtx::Run(
+        DEBUG_LOCATION,
+        NewClosure([this](grpc_error_handle) { FailCallCreation(); }),
+        absl::OkStatus());
+    return Immediate(ServerMetadataFromStatus(
+        absl::UnknownError("Missing :authority or :path")));
+  }
+  ExecCtx::Run(DEBUG_LOCATION,
+               NewClosure([this](grpc_error_handle) { Start(); }),
+               absl::OkStatus());
+  return promise;
+}
+
 void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
   grpc_call_set_completion_queue(call_, rc->cq_bound_to_call);
   *rc->call = call_;
@@ -1245,9 +1490,7 @@ void Server::CallData::Publish(size_t cq_idx, RequestedCall* rc) {
 }
 
 void Server::CallData::PublishNewRpc(void* arg, grpc_error_handle error) {
-  grpc_call_element* call_elem = static_cast<grpc_call_element*>(arg);
-  auto* calld = static_cast<Server::CallData*>(call_elem->call_data);
-  auto* chand = static_cast<Server::ChannelData*>(call_elem->channel_data);
+  auto* calld = static_cast<Server::CallData*>(arg);
   RequestMatcherInterface* rm = calld->matcher_;
   Server* server = rm->server();
   if (!error.ok() || server->ShutdownCalled()) {
@@ -1255,7 +1498,7 @@ void Server::CallData::PublishNewRpc(void* arg, grpc_error_handle error) {
     calld->KillZombie();
     return;
   }
-  rm->MatchOrQueue(chand->cq_idx(), calld);
+  rm->MatchOrQueue(calld->chand_->cq_idx(), calld);
 }
 
 namespace {
@@ -1272,8 +1515,7 @@ void Server::CallData::KillZombie() {
   ExecCtx::Run(DEBUG_LOCATION, &kill_zombie_closure_, absl::OkStatus());
 }
 
-void Server::CallData::StartNewRpc(grpc_call_element* elem) {
-  auto* chand = static_cast<ChannelData*>(elem->channel_data);
+void Server::CallData::StartNewRpc() {
   if (server_->ShutdownCalled()) {
     state_.store(CallState::ZOMBIED, std::memory_order_relaxed);
     KillZombie();
@@ -1285,7 +1527,7 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
       GRPC_SRM_PAYLOAD_NONE;
   if (path_.has_value() && host_.has_value()) {
     ChannelRegisteredMethod* rm =
-        chand->GetRegisteredMethod(host_->c_slice(), path_->c_slice());
+        chand_->GetRegisteredMethod(host_->c_slice(), path_->c_slice());
     if (rm != nullptr) {
       matcher_ = rm->server_registered_method->matcher.get();
       payload_handling = rm->server_registered_method->payload_handling;
@@ -1294,7 +1536,7 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
   // Start recv_message op if needed.
   switch (payload_handling) {
     case GRPC_SRM_PAYLOAD_NONE:
-      PublishNewRpc(elem, absl::OkStatus());
+      PublishNewRpc(this, absl::OkStatus());
       break;
     case GRPC_SRM_PAYLOAD_READ_INITIAL_BYTE_BUFFER: {
       grpc_op op;
@@ -1302,7 +1544,7 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
       op.flags = 0;
       op.reserved = nullptr;
       op.data.recv_message.recv_message = &payload_;
-      GRPC_CLOSURE_INIT(&publish_, PublishNewRpc, elem,
+      GRPC_CLOSURE_INIT(&publish_, PublishNewRpc, this,
                         grpc_schedule_on_exec_ctx);
       grpc_call_start_batch_and_execute(call_, &op, 1, &publish_);
       break;
@@ -1312,15 +1554,14 @@ void Server::CallData::StartNewRpc(grpc_call_element* elem) {
 
 void Server::CallData::RecvInitialMetadataBatchComplete(
     void* arg, grpc_error_handle error) {
-  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
-  auto* calld = static_cast<Server::CallData*>(elem->call_data);
+  auto* calld = static_cast<Server::CallData*>(arg);
   if (!error.ok()) {
     gpr_log(GPR_DEBUG, "Failed call creation: %s",
             StatusToString(error).c_str());
     calld->FailCallCreation();
     return;
   }
-  calld->StartNewRpc(elem);
+  calld->StartNewRpc();
 }
 
 void Server::CallData::StartTransportStreamOpBatchImpl(
@@ -1344,8 +1585,7 @@ void Server::CallData::StartTransportStreamOpBatchImpl(
 
 void Server::CallData::RecvInitialMetadataReady(void* arg,
                                                 grpc_error_handle error) {
-  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
-  CallData* calld = static_cast<CallData*>(elem->call_data);
+  CallData* calld = static_cast<CallData*>(arg);
   if (error.ok()) {
     calld->path_ = calld->recv_initial_metadata_->Take(HttpPathMetadata());
     auto* host =
@@ -1377,13 +1617,12 @@ void Server::CallData::RecvInitialMetadataReady(void* arg,
 
 void Server::CallData::RecvTrailingMetadataReady(void* arg,
                                                  grpc_error_handle error) {
-  grpc_call_element* elem = static_cast<grpc_call_element*>(arg);
-  CallData* calld = static_cast<CallData*>(elem->call_data);
+  CallData* calld = static_cast<CallData*>(arg);
   if (calld->original_recv_initial_metadata_ready_ != nullptr) {
     calld->recv_trailing_metadata_error_ = error;
     calld->seen_recv_trailing_metadata_ready_ = true;
     GRPC_CLOSURE_INIT(&calld->recv_trailing_metadata_ready_,
-                      RecvTrailingMetadataReady, elem,
+                      RecvTrailingMetadataReady, calld,
                       grpc_schedule_on_exec_ctx);
     GRPC_CALL_COMBINER_STOP(calld->call_combiner_,
                             "deferring server recv_trailing_metadata_ready "
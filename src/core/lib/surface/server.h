@@ -25,6 +25,7 @@
 #include <atomic>
 #include <functional>
 #include <list>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -32,6 +33,7 @@
 
 #include "absl/base/thread_annotations.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 
 #include <grpc/grpc.h>
@@ -57,6 +59,7 @@
 #include "src/core/lib/iomgr/endpoint.h"
 #include "src/core/lib/iomgr/error.h"
 #include "src/core/lib/iomgr/iomgr_fwd.h"
+#include "src/core/lib/promise/arena_promise.h"
 #include "src/core/lib/slice/slice.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/completion_queue.h"
@@ -68,6 +71,8 @@ struct grpc_server_config_fetcher;
 
 namespace grpc_core {
 
+class ServerCallContext;
+
 extern TraceFlag grpc_server_channel_trace;
 
 class Server : public InternallyRefCounted<Server>,
@@ -144,6 +149,16 @@ class Server : public InternallyRefCounted<Server>,
     config_fetcher_ = std::move(config_fetcher);
   }
 
+  // Sets args that take precedence over the server's for the listening port
+  // at addr, such as the resource quota of the tenant that its connections
+  // are accounted to.  Must be called before the port is added.
+  void SetPortChannelArgs(std::string addr, ChannelArgs args) {
+    port_channel_args_[std::move(addr)] = std::move(args);
+  }
+
+  // The channel args for the listening port at addr.
+  ChannelArgs ChannelArgsForPort(absl::string_view addr) const;
+
   bool HasOpenConnections() ABSL_LOCKS_EXCLUDED(mu_global_);
 
   // Adds a listener to the server.  When the server starts, it will call
@@ -237,6 +252,8 @@ class Server : public InternallyRefCounted<Server>,
     static grpc_error_handle InitChannelElement(
         grpc_channel_element* elem, grpc_channel_element_args* args);
     static void DestroyChannelElement(grpc_channel_element* elem);
+    static ArenaPromise<ServerMetadataHandle> MakeCallPromise(
+        grpc_channel_element* elem, CallArgs call_args, NextPromiseFactory);
 
    private:
     class ConnectivityWatcher;
@@ -275,11 +292,20 @@ class Server : public InternallyRefCounted<Server>,
 
     CallData(grpc_call_element* elem, const grpc_call_element_args& args,
              RefCountedPtr<Server> server);
+    // For promise based calls, which have no call element.
+    CallData(ChannelData* chand, grpc_call* call,
+             RefCountedPtr<Server> server);
     ~CallData();
 
     // Starts the recv_initial_metadata batch on the call.
-    // Invoked from ChannelData::AcceptStream().
-    void Start(grpc_call_element* elem);
+    // Invoked from ChannelData::AcceptStream(), or for promise based calls
+    // from ChannelData::MakeCallPromise().
+    void Start();
+
+    // The server filter's part of a promise based call: records the method
+    // and deadline, then hands the call to the surface to be published.
+    ArenaPromise<ServerMetadataHandle> MakeTopOfCallPromise(
+        CallArgs call_args, ServerCallContext* server_call_context);
 
     void SetState(CallState state);
 
@@ -295,6 +321,11 @@ class Server : public InternallyRefCounted<Server>,
 
     void FailCallCreation();
 
+    // Fails a call that was not published with status, and releases it.
+    void Reject(grpc_status_code status, const char* message);
+
+    Timestamp deadline() const { return deadline_; }
+
     // Filter vtable functions.
     static grpc_error_handle InitCallElement(
         grpc_call_element* elem, const grpc_call_element_args* args);
@@ -308,7 +339,7 @@ class Server : public InternallyRefCounted<Server>,
     // Helper functions for handling calls at the top of the call stack.
     static void RecvInitialMetadataBatchComplete(void* arg,
                                                  grpc_error_handle error);
-    void StartNewRpc(grpc_call_element* elem);
+    void StartNewRpc();
     static void PublishNewRpc(void* arg, grpc_error_handle error);
 
     // Functions used inside the call stack.
@@ -318,6 +349,7 @@ class Server : public InternallyRefCounted<Server>,
     static void RecvTrailingMetadataReady(void* arg, grpc_error_handle error);
 
     RefCountedPtr<Server> server_;
+    ChannelData* const chand_;
 
     grpc_call* call_;
 
@@ -350,7 +382,7 @@ class Server : public InternallyRefCounted<Server>,
 
     grpc_closure publish_;
 
-    CallCombiner* call_combiner_;
+    CallCombiner* call_combiner_ = nullptr;
   };
 
   struct Listener {
@@ -442,7 +474,15 @@ class Server : public InternallyRefCounted<Server>,
 
   ChannelArgs const channel_args_;
   RefCountedPtr<channelz::ServerNode> channelz_node_;
+
+  // Admission control for calls waiting for the application to request
+  // them: see GRPC_ARG_SERVER_MAX_PENDING_CALLS and
+  // GRPC_ARG_SERVER_PENDING_CALL_TARGET_DELAY_MS.
+  const size_t max_pending_calls_;
+  const Duration pending_call_target_delay_;
+  const Duration pending_call_interval_;
   std::unique_ptr<grpc_server_config_fetcher> config_fetcher_;
+  std::map<std::string, ChannelArgs, std::less<>> port_channel_args_;
 
   std::vector<grpc_completion_queue*> cqs_;
   std::vector<grpc_pollset*> pollsets_;
@@ -155,7 +155,8 @@ grpc::internal::Call Channel::CreateCallInternal(
       interceptor_creators_, interceptor_pos);
   context->set_call(c_call, shared_from_this());
 
-  return grpc::internal::Call(c_call, this, cq, info);
+  return grpc::internal::Call(c_call, this, cq, info, pass_messages_,
+                              max_passed_message_size_);
 }
 
 grpc::internal::Call Channel::CreateCall(
@@ -15,6 +15,7 @@
  *
  */
 
+#include <algorithm>
 #include <vector>
 
 #include "absl/base/thread_annotations.h"
@@ -166,6 +167,35 @@ CompletionQueue::NextStatus CompletionQueue::AsyncNextInternal(
   }
 }
 
+size_t CompletionQueue::NextBatch(void** tags, bool* oks,
+                                  size_t max_events) {
+  GPR_ASSERT(max_events >= 1);
+  // Bounds the events taken from the core completion queue at once.
+  constexpr size_t kMaxBatchSize = 32;
+  grpc_event events[kMaxBatchSize];
+  const size_t batch_size = std::min(max_events, kMaxBatchSize);
+  for (;;) {
+    size_t num_core_events = grpc_completion_queue_next_batch(
+        cq_, events, batch_size, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    // With an infinite deadline, a timeout also means the queue has been
+    // shut down.
+    if (events[0].type != GRPC_OP_COMPLETE) return 0;
+    size_t num_events = 0;
+    for (size_t i = 0; i < num_core_events; i++) {
+      auto core_cq_tag =
+          static_cast<grpc::internal::CompletionQueueTag*>(events[i].tag);
+      void* tag = core_cq_tag;
+      bool ok = events[i].success != 0;
+      if (core_cq_tag->FinalizeResult(&tag, &ok)) {
+        tags[num_events] = tag;
+        oks[num_events] = ok;
+        num_events++;
+      }
+    }
+    if (num_events > 0) return num_events;
+  }
+}
+
 CompletionQueue::CompletionQueueTLSCache::CompletionQueueTLSCache(
     CompletionQueue* cq)
     : cq_(cq), flushed_(false) {
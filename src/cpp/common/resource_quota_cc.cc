@@ -30,6 +30,12 @@ ResourceQuota::ResourceQuota() : impl_(grpc_resource_quota_create(nullptr)) {}
 ResourceQuota::ResourceQuota(const std::string& name)
     : impl_(grpc_resource_quota_create(name.c_str())) {}
 
+ResourceQuota::ResourceQuota(const ResourceQuota& parent,
+                             const std::string& name, size_t guaranteed_bytes,
+                             size_t weight)
+    : impl_(grpc_resource_quota_create_tenant(parent.impl_, name.c_str(),
+                                              guaranteed_bytes, weight)) {}
+
 ResourceQuota::~ResourceQuota() { grpc_resource_quota_unref(impl_); }
 
 ResourceQuota& ResourceQuota::Resize(size_t new_size) {
@@ -47,8 +47,11 @@
 #include <grpcpp/support/channel_arguments.h>
 #include <grpcpp/support/server_interceptor.h>
 
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gpr/string.h"
 #include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/surface/server.h"
 #include "src/cpp/server/external_connection_acceptor_impl.h"
 
 namespace grpc {
@@ -85,6 +88,11 @@ ServerBuilder::~ServerBuilder() {
   if (resource_quota_ != nullptr) {
     grpc_resource_quota_unref(resource_quota_);
   }
+  for (const auto& port : ports_) {
+    if (port.resource_quota != nullptr) {
+      grpc_resource_quota_unref(port.resource_quota);
+    }
+  }
 }
 
 std::unique_ptr<grpc::ServerCompletionQueue> ServerBuilder::AddCompletionQueue(
@@ -180,6 +188,12 @@ ServerBuilder& ServerBuilder::SetSyncServerOption(
     case CQ_TIMEOUT_MSEC:
       sync_server_settings_.cq_timeout_msec = val;
       break;
+    case HANDLER_THREADS:
+      sync_server_settings_.handler_threads = val;
+      break;
+    case MAX_PENDING_HANDLERS:
+      sync_server_settings_.max_pending_handlers = val;
+      break;
   }
   return *this;
 }
@@ -233,6 +247,14 @@ ServerBuilder& ServerBuilder::AddListeningPort(
   return *this;
 }
 
+void ServerBuilder::experimental_type::AddListeningPort(
+    const std::string& addr_uri, std::shared_ptr<ServerCredentials> creds,
+    const grpc::ResourceQuota& tenant_quota, int* selected_port) {
+  builder_->AddListeningPort(addr_uri, std::move(creds), selected_port);
+  builder_->ports_.back().resource_quota = tenant_quota.c_resource_quota();
+  grpc_resource_quota_ref(tenant_quota.c_resource_quota());
+}
+
 ChannelArguments ServerBuilder::BuildChannelArgs() {
   ChannelArguments args;
   if (max_receive_message_size_ >= -1) {
@@ -346,10 +368,11 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
     // This is a Sync server
     gpr_log(GPR_INFO,
             "Synchronous server. Num CQs: %d, Min pollers: %d, Max Pollers: "
-            "%d, CQ timeout (msec): %d",
+            "%d, CQ timeout (msec): %d, Handler threads: %d",
             sync_server_settings_.num_cqs, sync_server_settings_.min_pollers,
             sync_server_settings_.max_pollers,
-            sync_server_settings_.cq_timeout_msec);
+            sync_server_settings_.cq_timeout_msec,
+            sync_server_settings_.handler_threads);
   }
 
   if (has_callback_methods) {
@@ -367,7 +390,8 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
       &args, sync_server_cqs, sync_server_settings_.min_pollers,
       sync_server_settings_.max_pollers, sync_server_settings_.cq_timeout_msec,
       std::move(acceptors_), server_config_fetcher_, resource_quota_,
-      std::move(creators)));
+      std::move(creators), sync_server_settings_.handler_threads,
+      sync_server_settings_.max_pending_handlers));
 
   ServerInitializer* initializer = server->initializer();
 
@@ -407,6 +431,9 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
   server->RegisterContextAllocator(std::move(context_allocator_));
 
   for (const auto& value : services_) {
+    if (arena_message_allocation_) {
+      value->service->EnableArenaMessageAllocation();
+    }
     if (!server->RegisterService(value->host.get(), value->service)) {
       return nullptr;
     }
@@ -433,6 +460,14 @@ std::unique_ptr<grpc::Server> ServerBuilder::BuildAndStart() {
 
   bool added_port = false;
   for (auto& port : ports_) {
+    if (port.resource_quota != nullptr) {
+      grpc_core::Server::FromC(server->c_server())
+          ->SetPortChannelArgs(
+              port.addr,
+              grpc_core::ChannelArgs().SetObject(
+                  grpc_core::ResourceQuota::FromC(port.resource_quota)
+                      ->Ref()));
+    }
     int r = server->AddListeningPort(port.addr, port.creds.get());
     if (!r) {
       if (added_port) server->Shutdown();
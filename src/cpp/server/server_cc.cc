@@ -15,7 +15,9 @@
  *
  */
 
+#include <inttypes.h>
 #include <limits.h>
+#include <stdint.h>
 #include <string.h>
 
 #include <algorithm>
@@ -67,6 +69,7 @@
 #include <grpcpp/support/status.h>
 
 #include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/gprpp/manual_constructor.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/iomgr.h"
@@ -76,6 +79,7 @@
 #include "src/cpp/client/create_channel_internal.h"
 #include "src/cpp/server/external_connection_acceptor_impl.h"
 #include "src/cpp/server/health/default_health_check_service.h"
+#include "src/cpp/thread_manager/handler_pool.h"
 #include "src/cpp/thread_manager/thread_manager.h"
 
 namespace grpc {
@@ -127,6 +131,24 @@ class PhonyTag : public internal::CompletionQueueTag {
   }
 };
 
+// Flags a handler run inline that took longer than its method's budget, since
+// it held up the thread that delivered the request.  Logs the first overrun of
+// each method, then each time their number doubles.
+void CheckInlineHandlerBudget(internal::RpcServiceMethod* method,
+                              gpr_timespec start) {
+  const int64_t elapsed_us = static_cast<int64_t>(gpr_timespec_to_micros(
+      gpr_time_sub(gpr_now(GPR_CLOCK_MONOTONIC), start)));
+  const int64_t budget_us = method->inline_budget().count();
+  if (elapsed_us <= budget_us) return;
+  const uint64_t overruns = method->CountInlineOverrun();
+  if ((overruns & (overruns - 1)) != 0) return;
+  gpr_log(GPR_ERROR,
+          "Handler of %s runs inline but took %" PRId64
+          "us, over its budget of %" PRId64 "us (%" PRIu64
+          " overruns so far). Handlers that run inline must not block.",
+          method->name(), elapsed_us, budget_us, overruns);
+}
+
 class UnimplementedAsyncRequestContext {
  protected:
   UnimplementedAsyncRequestContext() : generic_stream_(&server_context_) {}
@@ -556,6 +578,9 @@ class Server::CallbackRequest final
     CommonSetup(server, data);
     data->deadline = &deadline_;
     data->optional_payload = has_request_payload_ ? &request_payload_ : nullptr;
+    if (method->run_inline()) {
+      tag_.inlineable = GRPC_CQ_FUNCTOR_INLINE_ANY_THREAD;
+    }
   }
 
   // For generic services, method is nullptr since these services don't have
@@ -691,9 +716,18 @@ class Server::CallbackRequest final
       auto* handler = (req_->method_ != nullptr)
                           ? req_->method_->handler()
                           : req_->server_->generic_handler_.get();
-      handler->RunHandler(grpc::internal::MethodHandler::HandlerParameter(
+      grpc::internal::MethodHandler::HandlerParameter param(
           call_, req_->ctx_, req_->request_, req_->request_status_,
-          req_->handler_data_, [this] { delete req_; }));
+          req_->handler_data_, [this] { delete req_; });
+      grpc::internal::RpcServiceMethod* method = req_->method_;
+      if (method == nullptr || !method->run_inline()) {
+        handler->RunHandler(param);
+        return;
+      }
+      // req_ may be deleted by the time the handler returns.
+      const gpr_timespec start = gpr_now(GPR_CLOCK_MONOTONIC);
+      handler->RunHandler(param);
+      CheckInlineHandlerBudget(method, start);
     }
   };
 
@@ -773,8 +807,10 @@ class Server::SyncRequestThreadManager : public grpc::ThreadManager {
   SyncRequestThreadManager(Server* server, grpc::CompletionQueue* server_cq,
                            std::shared_ptr<GlobalCallbacks> global_callbacks,
                            grpc_resource_quota* rq, int min_pollers,
-                           int max_pollers, int cq_timeout_msec)
-      : ThreadManager("SyncServer", rq, min_pollers, max_pollers),
+                           int max_pollers, int cq_timeout_msec,
+                           grpc::HandlerPool* handler_pool)
+      : ThreadManager("SyncServer", rq, min_pollers, max_pollers,
+                      handler_pool),
         server_(server),
         server_cq_(server_cq),
         cq_timeout_msec_(cq_timeout_msec),
@@ -880,7 +916,8 @@ Server::Server(
     grpc_resource_quota* server_rq,
     std::vector<
         std::unique_ptr<grpc::experimental::ServerInterceptorFactoryInterface>>
-        interceptor_creators)
+        interceptor_creators,
+    int sync_handler_threads, int sync_max_pending_handlers)
     : acceptors_(std::move(acceptors)),
       interceptor_creators_(std::move(interceptor_creators)),
       max_receive_message_size_(INT_MIN),
@@ -905,10 +942,14 @@ Server::Server(
       default_rq_created = true;
     }
 
+    if (sync_handler_threads != 0) {
+      sync_handler_pool_ = std::make_unique<grpc::HandlerPool>(
+          sync_handler_threads, sync_max_pending_handlers);
+    }
     for (const auto& it : *sync_server_cqs_) {
       sync_req_mgrs_.emplace_back(new SyncRequestThreadManager(
           this, it.get(), global_callbacks_, server_rq, min_pollers,
-          max_pollers, sync_cq_timeout_msec));
+          max_pollers, sync_cq_timeout_msec, sync_handler_pool_.get()));
     }
 
     if (default_rq_created) {
@@ -985,10 +1026,31 @@ grpc_server* Server::c_server() { return server_; }
 std::shared_ptr<grpc::Channel> Server::InProcessChannel(
     const grpc::ChannelArguments& args) {
   grpc_channel_args channel_args = args.c_channel_args();
-  return grpc::CreateChannelInternal(
+  auto channel = grpc::CreateChannelInternal(
       "inproc", grpc_inproc_channel_create(server_, &channel_args, nullptr),
       std::vector<std::unique_ptr<
           grpc::experimental::ClientInterceptorFactoryInterface>>());
+  // Both ends are in this process, so the server can take the client's
+  // message objects as they are.
+  channel->pass_messages_ = grpc_channel_args_find_bool(
+      &channel_args, GRPC_ARG_INPROC_PASS_MESSAGES, false);
+  // Size limits count the bytes on the wire, which passed messages skip, so
+  // the messages passed are limited to what both ends would have allowed.
+  int max_receive_message_size = max_receive_message_size_ == INT_MIN
+                                     ? GRPC_DEFAULT_MAX_RECV_MESSAGE_LENGTH
+                                     : max_receive_message_size_;
+  int max_send_message_size = grpc_channel_args_find_integer(
+      &channel_args, GRPC_ARG_MAX_SEND_MESSAGE_LENGTH,
+      {GRPC_DEFAULT_MAX_SEND_MESSAGE_LENGTH, -1, INT_MAX});
+  size_t max_passed_message_size = SIZE_MAX;
+  for (int limit : {max_receive_message_size, max_send_message_size}) {
+    if (limit >= 0) {
+      max_passed_message_size =
+          std::min(max_passed_message_size, static_cast<size_t>(limit));
+    }
+  }
+  channel->max_passed_message_size_ = max_passed_message_size;
+  return channel;
 }
 
 std::shared_ptr<grpc::Channel>
@@ -0,0 +1,117 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include "src/cpp/thread_manager/handler_pool.h"
+
+#include <utility>
+
+#include <grpc/support/cpu.h>
+#include <grpc/support/log.h>
+
+namespace grpc {
+
+struct HandlerPool::Work {
+  explicit Work(absl::AnyInvocable<void()> fn) : fn(std::move(fn)) {}
+
+  // Must be first: the queue hands back node pointers.
+  grpc_core::MultiProducerSingleConsumerQueue::Node node;
+  absl::AnyInvocable<void()> fn;
+};
+
+HandlerPool::HandlerPool(int num_threads, int max_pending)
+    : max_pending_(max_pending) {
+  if (num_threads == -1) num_threads = gpr_cpu_num_cores();
+  GPR_ASSERT(num_threads > 0);
+  threads_.reserve(num_threads);
+  for (int i = 0; i < num_threads; i++) {
+    threads_.emplace_back(
+        "grpcpp_sync_handler",
+        [](void* pool) { static_cast<HandlerPool*>(pool)->ThreadBody(); },
+        this);
+    threads_.back().Start();
+  }
+}
+
+HandlerPool::~HandlerPool() {
+  {
+    grpc_core::MutexLock lock(&mu_);
+    shutdown_ = true;
+    cv_.SignalAll();
+  }
+  for (grpc_core::Thread& thread : threads_) thread.Join();
+  GPR_ASSERT(queue_.Pop() == nullptr);
+}
+
+bool HandlerPool::TryRun(absl::AnyInvocable<void()> work) {
+  const int pending = num_pending_.fetch_add(1, std::memory_order_relaxed);
+  if (max_pending_ != -1 && pending >= max_pending_) {
+    num_pending_.fetch_sub(1, std::memory_order_relaxed);
+    return false;
+  }
+  Add(std::move(work));
+  return true;
+}
+
+void HandlerPool::Run(absl::AnyInvocable<void()> work) {
+  num_pending_.fetch_add(1, std::memory_order_relaxed);
+  Add(std::move(work));
+}
+
+void HandlerPool::Run(
+    grpc_event_engine::experimental::EventEngine::Closure* closure) {
+  Run([closure] { closure->Run(); });
+}
+
+void HandlerPool::Add(absl::AnyInvocable<void()> work) {
+  queue_.Push(&(new Work(std::move(work)))->node);
+  // Pairs with the fence in ThreadBody: either a thread about to sleep sees
+  // this work when it looks at the queue a last time, or this sees it.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_sleeping_.load(std::memory_order_relaxed) > 0) {
+    grpc_core::MutexLock lock(&mu_);
+    cv_.Signal();
+  }
+}
+
+void HandlerPool::ThreadBody() {
+  while (true) {
+    auto* work = reinterpret_cast<Work*>(queue_.TryPop());
+    if (work == nullptr) {
+      grpc_core::MutexLock lock(&mu_);
+      num_sleeping_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      work = reinterpret_cast<Work*>(queue_.Pop());
+      if (work == nullptr) {
+        // Work added before shutdown still runs: only stop once the queue
+        // is empty.
+        if (shutdown_) {
+          num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+          return;
+        }
+        cv_.Wait(&mu_);
+      }
+      num_sleeping_.fetch_sub(1, std::memory_order_relaxed);
+      if (work == nullptr) continue;
+    }
+    num_pending_.fetch_sub(1, std::memory_order_relaxed);
+    work->fn();
+    delete work;
+  }
+}
+
+}  // namespace grpc
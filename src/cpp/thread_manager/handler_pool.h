@@ -0,0 +1,87 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#ifndef GRPC_INTERNAL_CPP_HANDLER_POOL_H
+#define GRPC_INTERNAL_CPP_HANDLER_POOL_H
+
+#include <atomic>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+
+#include <grpc/event_engine/event_engine.h>
+
+#include "src/core/lib/event_engine/executor/executor.h"
+#include "src/core/lib/gprpp/mpscq.h"
+#include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/thd.h"
+
+namespace grpc {
+
+// A fixed-size pool of threads that runs sync server handlers, so that the
+// threads polling the server's completion queues only hand requests off.
+// Unlike the EventEngine's thread pool it never grows: a handler that
+// blocks holds its thread, and later requests wait for one.
+//
+// Work is handed off through a lock-free queue; a lock is only taken to wake
+// a thread that has gone to sleep, or by the threads taking work.
+class HandlerPool : public grpc_event_engine::experimental::Executor {
+ public:
+  // Starts num_threads threads, or one per core if num_threads is -1.  If
+  // max_pending is not -1, TryRun fails while that much work is waiting for a
+  // thread.
+  HandlerPool(int num_threads, int max_pending);
+  // Runs the work already added, then joins the threads.
+  ~HandlerPool() override;
+
+  HandlerPool(const HandlerPool&) = delete;
+  HandlerPool& operator=(const HandlerPool&) = delete;
+
+  // Adds work unless max_pending is reached.  Returns false if it was not
+  // added.
+  bool TryRun(absl::AnyInvocable<void()> work);
+
+  // Executor.  Adds work regardless of max_pending.
+  void Run(absl::AnyInvocable<void()> work) override;
+  void Run(grpc_event_engine::experimental::EventEngine::Closure* closure)
+      override;
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+ private:
+  struct Work;
+
+  void Add(absl::AnyInvocable<void()> work);
+  void ThreadBody();
+
+  const int max_pending_;
+  grpc_core::LockedMultiProducerSingleConsumerQueue queue_;
+  // Work added and not yet taken by a thread.
+  std::atomic<int> num_pending_{0};
+  // Threads that have announced that they are about to sleep.
+  std::atomic<int> num_sleeping_{0};
+  grpc_core::Mutex mu_;
+  grpc_core::CondVar cv_;
+  bool shutdown_ ABSL_GUARDED_BY(mu_) = false;
+  std::vector<grpc_core::Thread> threads_;
+};
+
+}  // namespace grpc
+
+#endif  // GRPC_INTERNAL_CPP_HANDLER_POOL_H
@@ -54,7 +54,8 @@ ThreadManager::WorkerThread::~WorkerThread() {
 }
 
 ThreadManager::ThreadManager(const char*, grpc_resource_quota* resource_quota,
-                             int min_pollers, int max_pollers)
+                             int min_pollers, int max_pollers,
+                             HandlerPool* handler_pool)
     : shutdown_(false),
       thread_quota_(
           grpc_core::ResourceQuota::FromC(resource_quota)->thread_quota()),
@@ -62,7 +63,8 @@ ThreadManager::ThreadManager(const char*, grpc_resource_quota* resource_quota,
       min_pollers_(min_pollers),
       max_pollers_(max_pollers == -1 ? INT_MAX : max_pollers),
       num_threads_(0),
-      max_active_threads_sofar_(0) {}
+      max_active_threads_sofar_(0),
+      handler_pool_(handler_pool) {}
 
 ThreadManager::~ThreadManager() {
   {
@@ -75,7 +77,7 @@ ThreadManager::~ThreadManager() {
 
 void ThreadManager::Wait() {
   grpc_core::MutexLock lock(&mu_);
-  while (num_threads_ != 0) {
+  while (num_threads_ != 0 || num_handed_off_ != 0) {
     shutdown_cv_.Wait(&mu_);
   }
 }
@@ -104,7 +106,7 @@ void ThreadManager::MarkAsCompleted(WorkerThread* thd) {
   {
     grpc_core::MutexLock lock(&mu_);
     num_threads_--;
-    if (num_threads_ == 0) {
+    if (num_threads_ == 0 && num_handed_off_ == 0) {
       shutdown_cv_.Signal();
     }
   }
@@ -168,6 +170,16 @@ void ThreadManager::MainWorkLoop() {
         done = true;
         break;
       case WORK_FOUND:
+        if (handler_pool_ != nullptr) {
+          // This thread goes back to polling at once, so it never needs
+          // replacing.
+          num_handed_off_++;
+          lock.Release();
+          HandOff(tag, ok);
+          lock.Lock();
+          if (shutdown_) done = true;
+          break;
+        }
         // If we got work and there are now insufficient pollers and there is
         // quota available to create a new thread, start a new poller thread
         bool resource_exhausted = false;
@@ -263,4 +275,22 @@ void ThreadManager::MainWorkLoop() {
   // enough threads.
 }
 
+void ThreadManager::HandOff(void* tag, bool ok) {
+  auto done = [this] {
+    grpc_core::MutexLock lock(&mu_);
+    num_handed_off_--;
+    if (num_threads_ == 0 && num_handed_off_ == 0) {
+      shutdown_cv_.Signal();
+    }
+  };
+  if (!handler_pool_->TryRun([this, tag, ok, done] {
+        DoWork(tag, ok, true);
+        done();
+      })) {
+    // Too much work is already waiting for a handler thread.
+    DoWork(tag, ok, false);
+    done();
+  }
+}
+
 }  // namespace grpc
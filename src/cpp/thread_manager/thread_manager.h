@@ -25,13 +25,18 @@
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/resource_quota/api.h"
 #include "src/core/lib/resource_quota/thread_quota.h"
+#include "src/cpp/thread_manager/handler_pool.h"
 
 namespace grpc {
 
 class ThreadManager {
  public:
+  // If handler_pool is not null, min_pollers threads only poll, and the work
+  // they find is done on handler_pool: the number of threads stays fixed.
+  // Work that handler_pool has no room for is done with no resources.
   explicit ThreadManager(const char* name, grpc_resource_quota* resource_quota,
-                         int min_pollers, int max_pollers);
+                         int min_pollers, int max_pollers,
+                         HandlerPool* handler_pool = nullptr);
   virtual ~ThreadManager();
 
   // Initializes and Starts the Rpc Manager threads
@@ -82,7 +87,8 @@ class ThreadManager {
   bool IsShutdown();
 
   // A blocking call that returns only after the ThreadManager has shutdown and
-  // all the threads have drained all the outstanding work
+  // all the threads have drained all the outstanding work, including the work
+  // handed to the handler pool
   virtual void Wait();
 
   // Max number of concurrent threads that were ever active in this thread
@@ -136,10 +142,13 @@ class ThreadManager {
   // The main function in ThreadManager
   void MainWorkLoop();
 
+  // Hands work found by a poller to handler_pool_.
+  void HandOff(void* tag, bool ok);
+
   void MarkAsCompleted(WorkerThread* thd);
   void CleanupCompletedThreads();
 
-  // Protects shutdown_, num_pollers_, num_threads_ and
+  // Protects shutdown_, num_pollers_, num_threads_, num_handed_off_ and
   // max_active_threads_sofar_
   grpc_core::Mutex mu_;
 
@@ -170,6 +179,11 @@ class ThreadManager {
   // ever set so far
   int max_active_threads_sofar_;
 
+  HandlerPool* const handler_pool_;
+
+  // Work handed to handler_pool_ and not yet done.
+  int num_handed_off_ = 0;
+
   grpc_core::Mutex list_mu_;
   std::list<WorkerThread*> completed_threads_;
 };
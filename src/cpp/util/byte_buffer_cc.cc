@@ -16,6 +16,11 @@
  *
  */
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <random>
 #include <vector>
 
 #include <grpc/byte_buffer.h>
@@ -81,4 +86,62 @@ Status ByteBuffer::Dump(std::vector<Slice>* slices) const {
   return Status::OK;
 }
 
+namespace internal {
+
+namespace {
+
+uint64_t PassedMessageKey() {
+  static const uint64_t key = [] {
+    std::random_device random;
+    return (static_cast<uint64_t>(random()) << 32) | random();
+  }();
+  return key;
+}
+
+}  // namespace
+
+PassedMessage::PassedMessage(void* message, const Type* type)
+    : handle_{PassedMessageKey(), reinterpret_cast<uintptr_t>(this)},
+      message_(message),
+      type_(type) {}
+
+PassedMessage::~PassedMessage() { type_->destroy(message_); }
+
+void PassedMessage::Pass(void* message, const Type* type, ByteBuffer* buffer) {
+  auto* passed = new PassedMessage(message, type);
+  Slice handle(grpc_slice_new_with_user_data(
+                   &passed->handle_, sizeof(Handle),
+                   [](void* p) { delete static_cast<PassedMessage*>(p); },
+                   passed),
+               Slice::STEAL_REF);
+  ByteBuffer tmp(&handle, 1);
+  buffer->Swap(&tmp);
+}
+
+PassedMessage* PassedMessage::FromHandle(const grpc_slice& slice) {
+  Handle handle;
+  memcpy(&handle, GRPC_SLICE_START_PTR(slice), sizeof(handle));
+  if (handle.key != PassedMessageKey()) return nullptr;
+  // The handle must be the one inside the object it points to. Compare
+  // addresses as integers, so that nothing is formed from the handle's
+  // pointer until it is known to be valid.
+  const uintptr_t passed =
+      reinterpret_cast<uintptr_t>(GRPC_SLICE_START_PTR(slice)) -
+      offsetof(PassedMessage, handle_);
+  if (handle.passed_message != passed) return nullptr;
+  return reinterpret_cast<PassedMessage*>(passed);
+}
+
+Status PassedMessage::Serialize(ByteBuffer* buffer) {
+  PassedMessage* passed = FromByteBuffer(buffer);
+  if (passed == nullptr) return Status::OK;
+  ByteBuffer bytes;
+  Status status = passed->type_->serialize(passed->message_, &bytes);
+  // Dropping the handle may destroy the passed message, so swap it out last.
+  if (status.ok()) buffer->Swap(&bytes);
+  return status;
+}
+
+}  // namespace internal
+
 }  // namespace grpc
@@ -426,6 +426,7 @@ CORE_SOURCE_FILES = [
     'src/core/ext/xds/xds_http_stateful_session_filter.cc',
     'src/core/ext/xds/xds_lb_policy_registry.cc',
     'src/core/ext/xds/xds_listener.cc',
+    'src/core/ext/xds/xds_resource_cache.cc',
     'src/core/ext/xds/xds_route_config.cc',
     'src/core/ext/xds/xds_routing.cc',
     'src/core/ext/xds/xds_server_config_fetcher.cc',
@@ -445,8 +446,10 @@ CORE_SOURCE_FILES = [
     'src/core/lib/channel/promise_based_filter.cc',
     'src/core/lib/channel/status_util.cc',
     'src/core/lib/compression/compression.cc',
+    'src/core/lib/compression/compression_dictionary.cc',
     'src/core/lib/compression/compression_internal.cc',
     'src/core/lib/compression/message_compress.cc',
+    'src/core/lib/compression/stream_compress.cc',
     'src/core/lib/config/core_configuration.cc',
     'src/core/lib/debug/event_log.cc',
     'src/core/lib/debug/histogram_view.cc',
@@ -631,6 +634,7 @@ CORE_SOURCE_FILES = [
     'src/core/lib/resource_quota/memory_quota.cc',
     'src/core/lib/resource_quota/periodic_update.cc',
     'src/core/lib/resource_quota/resource_quota.cc',
+    'src/core/lib/resource_quota/slab_allocator.cc',
     'src/core/lib/resource_quota/thread_quota.cc',
     'src/core/lib/resource_quota/trace.cc',
     'src/core/lib/security/authorization/authorization_policy_provider_vtable.cc',
@@ -21,7 +21,9 @@
 #include <stdlib.h>
 
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <string>
 
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -37,6 +39,8 @@
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/json/json.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/surface/channel.h"
 #include "src/core/lib/surface/server.h"
 #include "test/core/util/test_config.h"
@@ -524,6 +528,49 @@ TEST(ChannelzServerTest, BasicServerAPIFunctionality) {
   ValidateServer(channelz_server, {3, 3, 3});
 }
 
+// The socket options of a listen socket, by name.
+std::map<std::string, std::string> GetListenSocketOptions(
+    ListenSocketNode* node) {
+  std::string json_str = node->RenderJsonString();
+  grpc::testing::ValidateSocketProtoJsonTranslation(json_str.c_str());
+  auto json = Json::Parse(json_str);
+  EXPECT_TRUE(json.ok()) << json.status();
+  std::map<std::string, std::string> options;
+  if (!json.ok()) return options;
+  auto data = json->object_value().find("data");
+  if (data == json->object_value().end()) return options;
+  for (const Json& option :
+       data->second.object_value().at("option").array_value()) {
+    options[option.object_value().at("name").string_value()] =
+        option.object_value().at("value").string_value();
+  }
+  return options;
+}
+
+TEST(ChannelzListenSocketTest, ReportsTenantUsage) {
+  ExecCtx exec_ctx;
+  auto server_quota = MakeResourceQuota("server");
+  auto tenant_quota = server_quota->CreateTenant("tenant", 1024, 2);
+  auto allocator =
+      tenant_quota->memory_quota()->CreateMemoryAllocator("connection");
+  allocator.Reserve(MemoryRequest(4096));
+  auto node = MakeRefCounted<ListenSocketNode>(
+      "ipv4:127.0.0.1:443", "listener", tenant_quota->memory_quota());
+  auto options = GetListenSocketOptions(node.get());
+  EXPECT_EQ(options["grpc.tenant"], "tenant");
+  EXPECT_GE(std::stoul(options["grpc.tenant_used_bytes"]), 4096u);
+  EXPECT_EQ(options["grpc.tenant_guaranteed_bytes"], "1024");
+  EXPECT_EQ(options["grpc.tenant_weight"], "2");
+  allocator.Release(4096);
+}
+
+TEST(ChannelzListenSocketTest, NoOptionsWithoutTenant) {
+  ExecCtx exec_ctx;
+  auto node =
+      MakeRefCounted<ListenSocketNode>("ipv4:127.0.0.1:443", "listener");
+  EXPECT_TRUE(GetListenSocketOptions(node.get()).empty());
+}
+
 TEST_F(ChannelzRegistryBasedTest, BasicGetServersTest) {
   ExecCtx exec_ctx;
   ServerFixture server;
@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 
+#include <chrono>
 #include <deque>
 #include <functional>
 #include <map>
@@ -36,6 +37,8 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/string_view.h"
 #include "absl/synchronization/notification.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "absl/types/span.h"
 #include "absl/types/variant.h"
@@ -51,12 +54,12 @@
 #include "src/core/lib/address_utils/sockaddr_utils.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/config/core_configuration.h"
-#include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gprpp/debug_location.h"
 #include "src/core/lib/gprpp/match.h"
 #include "src/core/lib/gprpp/orphanable.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/sync.h"
+#include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/gprpp/work_serializer.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "src/core/lib/iomgr/resolved_address.h"
@@ -67,10 +70,14 @@
 #include "src/core/lib/resolver/server_address.h"
 #include "src/core/lib/transport/connectivity_state.h"
 #include "src/core/lib/uri/uri_parser.h"
+#include "test/core/event_engine/fuzzing_event_engine/fuzzing_event_engine.h"
+#include "test/core/event_engine/fuzzing_event_engine/fuzzing_event_engine.pb.h"
 
 namespace grpc_core {
 namespace testing {
 
+using grpc_event_engine::experimental::FuzzingEventEngine;
+
 class LoadBalancingPolicyTest : public ::testing::Test {
  protected:
   // Channel-level subchannel state for a specific address and channel args.
@@ -231,6 +238,17 @@ class LoadBalancingPolicyTest : public ::testing::Test {
       }
     }
 
+    // Waits up to timeout for the LB policy to report an event.  Returns
+    // true if there is an event in the queue.
+    bool WaitForEvent(absl::Duration timeout) {
+      const absl::Time deadline = absl::Now() + timeout;
+      MutexLock lock(&mu_);
+      while (queue_.empty()) {
+        if (cv_.WaitWithDeadline(&mu_, deadline)) return !queue_.empty();
+      }
+      return true;
+    }
+
     // Returns the next event in the queue if it is a state update.
     // If the queue is empty or the next event is not a state update,
     // fails the test and returns nullopt without removing anything from
@@ -304,17 +322,19 @@ class LoadBalancingPolicyTest : public ::testing::Test {
         RefCountedPtr<LoadBalancingPolicy::SubchannelPicker> picker) override {
       MutexLock lock(&mu_);
       queue_.push_back(StateUpdate{state, status, std::move(picker)});
+      cv_.SignalAll();
     }
 
     void RequestReresolution() override {
       MutexLock lock(&mu_);
       queue_.push_back(ReresolutionRequested());
+      cv_.SignalAll();
     }
 
     absl::string_view GetAuthority() override { return "server.example.com"; }
 
     grpc_event_engine::experimental::EventEngine* GetEventEngine() override {
-      return grpc_event_engine::experimental::GetDefaultEventEngine().get();
+      return test_->fuzzing_ee_.get();
     }
 
     void AddTraceEvent(TraceSeverity, absl::string_view) override {}
@@ -322,6 +342,7 @@ class LoadBalancingPolicyTest : public ::testing::Test {
     LoadBalancingPolicyTest* test_;
     std::shared_ptr<WorkSerializer> work_serializer_;
     Mutex mu_;
+    CondVar cv_;
     std::deque<Event> queue_ ABSL_GUARDED_BY(&mu_);
   };
 
@@ -374,8 +395,18 @@ class LoadBalancingPolicyTest : public ::testing::Test {
     std::vector<void*> allocations_;
   };
 
+  // The LB policy's timers run on a fake clock, which only moves when the
+  // test calls IncrementTimeBy().
   LoadBalancingPolicyTest()
-      : work_serializer_(std::make_shared<WorkSerializer>()) {}
+      : fuzzing_ee_(std::make_shared<FuzzingEventEngine>(
+            FuzzingEventEngineOptions(), fuzzing_event_engine::Actions())),
+        work_serializer_(std::make_shared<WorkSerializer>()) {
+    FuzzingEventEngine::SetGlobalNowImplEngine(fuzzing_ee_.get());
+  }
+
+  ~LoadBalancingPolicyTest() override {
+    FuzzingEventEngine::UnsetGlobalNowImplEngine(fuzzing_ee_.get());
+  }
 
   void TearDown() override {
     // Note: Can't safely trigger this from inside the FakeHelper dtor,
@@ -655,6 +686,19 @@ class LoadBalancingPolicyTest : public ::testing::Test {
     helper_->ExpectQueueEmpty(location);
   }
 
+  // Advances the fake clock by duration, running the timers that expire.
+  void IncrementTimeBy(Duration duration) {
+    fuzzing_ee_->TickForDuration(std::chrono::milliseconds(duration.millis()));
+  }
+
+  static FuzzingEventEngine::Options FuzzingEventEngineOptions() {
+    FuzzingEventEngine::Options options;
+    // Fine enough for tests to step through latencies.
+    options.final_tick_length = std::chrono::milliseconds(1);
+    return options;
+  }
+
+  std::shared_ptr<FuzzingEventEngine> fuzzing_ee_;
   std::shared_ptr<WorkSerializer> work_serializer_;
   FakeHelper* helper_ = nullptr;
   std::map<SubchannelKey, SubchannelState> subchannel_pool_;
@@ -18,12 +18,19 @@
 #include <stdint.h>
 
 #include <algorithm>
+#include <array>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/string_view.h"
+#include "absl/time/time.h"
+#include "absl/types/optional.h"
+#include "absl/types/variant.h"
 #include "gtest/gtest.h"
 
 #include <grpc/grpc.h>
@@ -103,6 +110,23 @@ class OutlierDetectionTest : public LoadBalancingPolicyTest {
       return *this;
     }
 
+    ConfigBuilder& SetLatencyPercentile(uint32_t value) {
+      GetLatency()["percentile"] = value;
+      return *this;
+    }
+    ConfigBuilder& SetLatencyMedianFactor(uint32_t value) {
+      GetLatency()["medianFactor"] = value;
+      return *this;
+    }
+    ConfigBuilder& SetLatencyMinimumHosts(uint32_t value) {
+      GetLatency()["minimumHosts"] = value;
+      return *this;
+    }
+    ConfigBuilder& SetLatencyRequestVolume(uint32_t value) {
+      GetLatency()["requestVolume"] = value;
+      return *this;
+    }
+
     RefCountedPtr<LoadBalancingPolicy::Config> Build() {
       Json config =
           Json::Array{Json::Object{{"outlier_detection_experimental", json_}}};
@@ -121,6 +145,11 @@ class OutlierDetectionTest : public LoadBalancingPolicyTest {
       return *it->second.mutable_object();
     }
 
+    Json::Object& GetLatency() {
+      auto it = json_.emplace("latencyEjection", Json::Object()).first;
+      return *it->second.mutable_object();
+    }
+
     Json::Object json_;
   };
 
@@ -158,6 +187,95 @@ TEST_F(OutlierDetectionTest, Basic) {
   }
 }
 
+TEST_F(OutlierDetectionTest, LatencyEjection) {
+  constexpr std::array<absl::string_view, 3> kAddresses = {
+      "ipv4:127.0.0.1:441", "ipv4:127.0.0.1:442", "ipv4:127.0.0.1:443"};
+  constexpr absl::string_view kSlowAddress = kAddresses[0];
+  constexpr size_t kCallsPerAddress = 10;
+  // Send an update containing the addresses, with an ejection threshold
+  // of 3 times the median latency.
+  absl::Status status = ApplyUpdate(
+      BuildUpdate(kAddresses,
+                  ConfigBuilder()
+                      .SetInterval(Duration::Seconds(1))
+                      .SetBaseEjectionTime(Duration::Milliseconds(500))
+                      .SetLatencyPercentile(50)
+                      .SetLatencyMedianFactor(3000)
+                      .SetLatencyMinimumHosts(3)
+                      .SetLatencyRequestVolume(kCallsPerAddress)
+                      .Build()),
+      lb_policy_.get());
+  EXPECT_TRUE(status.ok()) << status;
+  ExpectConnectingUpdate();
+  for (absl::string_view address : kAddresses) {
+    auto* subchannel = FindSubchannel(address);
+    ASSERT_NE(subchannel, nullptr);
+    subchannel->SetConnectivityState(GRPC_CHANNEL_CONNECTING);
+    subchannel->SetConnectivityState(GRPC_CHANNEL_READY);
+  }
+  // Round robin reports READY once per subchannel; use the last picker.
+  auto picker = WaitForConnected();
+  while (helper_->WaitForEvent(absl::ZeroDuration())) {
+    picker = ExpectState(GRPC_CHANNEL_READY);
+  }
+  ASSERT_NE(picker, nullptr);
+  // Start calls on every address, and finish those on the slow address
+  // well after the others.
+  std::vector<std::unique_ptr<
+      LoadBalancingPolicy::SubchannelCallTrackerInterface>>
+      fast_calls, slow_calls;
+  for (size_t i = 0; i < kCallsPerAddress * kAddresses.size(); ++i) {
+    auto pick_result = DoPick(picker.get());
+    auto* complete = absl::get_if<LoadBalancingPolicy::PickResult::Complete>(
+        &pick_result.result);
+    ASSERT_NE(complete, nullptr) << PickResultString(pick_result);
+    ASSERT_NE(complete->subchannel_call_tracker, nullptr);
+    complete->subchannel_call_tracker->Start();
+    auto* subchannel = static_cast<SubchannelState::FakeSubchannel*>(
+        complete->subchannel.get());
+    (subchannel->state()->address() == kSlowAddress ? slow_calls : fast_calls)
+        .push_back(std::move(complete->subchannel_call_tracker));
+  }
+  ASSERT_EQ(slow_calls.size(), kCallsPerAddress);
+  auto finish_calls = [](std::vector<std::unique_ptr<
+                             LoadBalancingPolicy::
+                                 SubchannelCallTrackerInterface>>* calls) {
+    for (auto& call : *calls) {
+      call->Finish({absl::OkStatus(), nullptr, nullptr});
+    }
+    calls->clear();
+  };
+  IncrementTimeBy(Duration::Milliseconds(1));
+  finish_calls(&fast_calls);
+  IncrementTimeBy(Duration::Milliseconds(30));
+  finish_calls(&slow_calls);
+  // Nothing changes before the end of the interval.
+  IncrementTimeBy(Duration::Milliseconds(900));
+  EXPECT_FALSE(helper_->WaitForEvent(absl::ZeroDuration()));
+  // At the end of the interval, the slow address is ejected.
+  IncrementTimeBy(Duration::Milliseconds(100));
+  ASSERT_TRUE(helper_->WaitForEvent(absl::ZeroDuration()));
+  picker = ExpectState(GRPC_CHANNEL_READY);
+  ASSERT_NE(picker, nullptr);
+  for (size_t i = 0; i < 4; ++i) {
+    EXPECT_NE(ExpectPickComplete(picker.get()), kSlowAddress);
+  }
+  // It stays ejected until the next run of the timer after the base
+  // ejection time has passed.
+  IncrementTimeBy(Duration::Milliseconds(900));
+  EXPECT_FALSE(helper_->WaitForEvent(absl::ZeroDuration()));
+  IncrementTimeBy(Duration::Milliseconds(100));
+  ASSERT_TRUE(helper_->WaitForEvent(absl::ZeroDuration()));
+  picker = ExpectState(GRPC_CHANNEL_READY);
+  ASSERT_NE(picker, nullptr);
+  std::set<std::string> picked;
+  for (size_t i = 0; i < kAddresses.size(); ++i) {
+    auto address = ExpectPickComplete(picker.get());
+    if (address.has_value()) picked.insert(*address);
+  }
+  EXPECT_EQ(picked.size(), kAddresses.size());
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
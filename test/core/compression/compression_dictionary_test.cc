@@ -0,0 +1,222 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/compression/compression_dictionary.h"
+
+#include <string>
+#include <utility>
+
+#include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "gtest/gtest.h"
+
+#include <grpc/impl/compression_types.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/gprpp/ref_counted_ptr.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// A small serialized message in the style of the ones the dictionary is
+// meant for; the record number varies so that no two are alike.
+std::string Record(int n) {
+  return absl::StrCat("\x08", n, "\x12\x08us-east1\x1a\x08", "checkout",
+                      "\"\x0auser-", n * 7919 % 100000, "*\x07PENDING");
+}
+
+std::string Message(int first_record, size_t size) {
+  std::string message;
+  for (int n = first_record; message.size() < size; ++n) {
+    message += Record(n);
+  }
+  message.resize(size);
+  return message;
+}
+
+// Records that do not occur in the messages below.
+std::string DictionaryData() { return Message(1000000, 4096); }
+
+class Buffer {
+ public:
+  Buffer() { grpc_slice_buffer_init(&buffer_); }
+  explicit Buffer(absl::string_view data) : Buffer() {
+    grpc_slice_buffer_add(
+        &buffer_, grpc_slice_from_copied_buffer(data.data(), data.size()));
+  }
+  ~Buffer() { grpc_slice_buffer_destroy(&buffer_); }
+
+  grpc_slice_buffer* get() { return &buffer_; }
+  std::string ToString() const {
+    std::string out;
+    for (size_t i = 0; i < buffer_.count; ++i) {
+      const grpc_slice& slice = buffer_.slices[i];
+      out.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                 GRPC_SLICE_LENGTH(slice));
+    }
+    return out;
+  }
+
+ private:
+  grpc_slice_buffer buffer_;
+};
+
+class CompressionDictionaryTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto dictionary = CompressionDictionary::Create(
+        GRPC_COMPRESS_DEFLATE_DICTIONARY, DictionaryData());
+    ASSERT_TRUE(dictionary.ok()) << dictionary.status();
+    dictionary_ = std::move(*dictionary);
+  }
+
+  ExecCtx exec_ctx_;
+  RefCountedPtr<CompressionDictionary> dictionary_;
+};
+
+TEST_F(CompressionDictionaryTest, DeflateDictionaryIsNamedAfterItsId) {
+  EXPECT_EQ(dictionary_->name(),
+            absl::StrFormat("deflate-dict-%08x", dictionary_->id()));
+  EXPECT_EQ(DeflateDictionaryToken(dictionary_->id()), dictionary_->name());
+  // grpc-encoding does not name the dictionary; messages do.
+  EXPECT_STREQ(CompressionAlgorithmAsString(GRPC_COMPRESS_DEFLATE_DICTIONARY),
+               "deflate-dict");
+  EXPECT_EQ(ParseCompressionAlgorithm("deflate-dict"),
+            GRPC_COMPRESS_DEFLATE_DICTIONARY);
+  EXPECT_FALSE(
+      IsCompressionAlgorithmSupported(GRPC_COMPRESS_DEFLATE_DICTIONARY));
+}
+
+TEST_F(CompressionDictionaryTest, AdvertisedByChannelsThatHaveIt) {
+  EXPECT_FALSE(CompressionAlgorithmSet::FromChannelArgs(ChannelArgs())
+                   .IsSet(GRPC_COMPRESS_DEFLATE_DICTIONARY));
+  const CompressionAlgorithmSet set = CompressionAlgorithmSet::FromChannelArgs(
+      ChannelArgs().SetObject(dictionary_));
+  EXPECT_TRUE(set.HasDictionary(dictionary_->id()));
+  EXPECT_TRUE(absl::StrContains(set.ToString(),
+                                absl::StrCat(", ", dictionary_->name())))
+      << set.ToString();
+  EXPECT_TRUE(CompressionAlgorithmSet::FromString(set.ToString()) == set);
+}
+
+TEST_F(CompressionDictionaryTest, DisabledByTheEnabledAlgorithmsBitset) {
+  const CompressionAlgorithmSet set = CompressionAlgorithmSet::FromChannelArgs(
+      ChannelArgs().SetObject(dictionary_).Set(
+          GRPC_COMPRESSION_CHANNEL_ENABLED_ALGORITHMS_BITSET,
+          (1 << GRPC_COMPRESS_NONE) | (1 << GRPC_COMPRESS_GZIP)));
+  EXPECT_FALSE(set.IsSet(GRPC_COMPRESS_DEFLATE_DICTIONARY));
+  EXPECT_TRUE(set.IsSet(GRPC_COMPRESS_GZIP));
+}
+
+TEST_F(CompressionDictionaryTest, PeerWithAnotherDictionaryIsNotAccepted) {
+  auto other = CompressionDictionary::Create(GRPC_COMPRESS_DEFLATE_DICTIONARY,
+                                             Message(2000000, 1024));
+  ASSERT_TRUE(other.ok()) << other.status();
+  const CompressionAlgorithmSet accepted = CompressionAlgorithmSet::FromString(
+      absl::StrCat("identity, ", (*other)->name()));
+  EXPECT_TRUE(accepted.HasDictionary((*other)->id()));
+  EXPECT_FALSE(accepted.HasDictionary(dictionary_->id()));
+  // Without its ID, the dictionary is not accepted at all.
+  EXPECT_FALSE(CompressionAlgorithmSet::FromString("identity, deflate-dict")
+                   .IsSet(GRPC_COMPRESS_DEFLATE_DICTIONARY));
+}
+
+TEST_F(CompressionDictionaryTest, RoundTrip) {
+  // Run enough messages through to reuse pooled contexts.
+  for (int i = 0; i < 50; ++i) {
+    const std::string message = Message(i * 100, 300 + i);
+    Buffer input(message);
+    Buffer compressed;
+    ASSERT_TRUE(grpc_msg_compress(GRPC_COMPRESS_DEFLATE_DICTIONARY,
+                                  input.get(), compressed.get(),
+                                  dictionary_.get()));
+    Buffer output;
+    ASSERT_TRUE(grpc_msg_decompress(GRPC_COMPRESS_DEFLATE_DICTIONARY,
+                                    compressed.get(), output.get(),
+                                    dictionary_.get()));
+    EXPECT_EQ(output.ToString(), message);
+  }
+}
+
+TEST_F(CompressionDictionaryTest, BeatsPlainDeflateOnSmallMessages) {
+  const std::string message = Message(0, 300);
+  Buffer input(message);
+  Buffer plain;
+  Buffer with_dictionary;
+  ASSERT_TRUE(
+      grpc_msg_compress(GRPC_COMPRESS_DEFLATE, input.get(), plain.get()));
+  ASSERT_TRUE(grpc_msg_compress(GRPC_COMPRESS_DEFLATE_DICTIONARY, input.get(),
+                                with_dictionary.get(), dictionary_.get()));
+  EXPECT_LT(with_dictionary.get()->length, plain.get()->length);
+}
+
+TEST_F(CompressionDictionaryTest, PlainDeflateCannotDecompress) {
+  Buffer input(Message(0, 300));
+  Buffer compressed;
+  ASSERT_TRUE(grpc_msg_compress(GRPC_COMPRESS_DEFLATE_DICTIONARY, input.get(),
+                                compressed.get(), dictionary_.get()));
+  Buffer output;
+  EXPECT_FALSE(grpc_msg_decompress(GRPC_COMPRESS_DEFLATE, compressed.get(),
+                                   output.get()));
+  EXPECT_EQ(output.get()->length, 0);
+}
+
+TEST_F(CompressionDictionaryTest, AnotherDictionaryCannotDecompress) {
+  auto other = CompressionDictionary::Create(GRPC_COMPRESS_DEFLATE_DICTIONARY,
+                                             Message(2000000, 1024));
+  ASSERT_TRUE(other.ok()) << other.status();
+  Buffer input(Message(0, 300));
+  Buffer compressed;
+  ASSERT_TRUE(grpc_msg_compress(GRPC_COMPRESS_DEFLATE_DICTIONARY, input.get(),
+                                compressed.get(), dictionary_.get()));
+  Buffer output;
+  EXPECT_FALSE(grpc_msg_decompress(GRPC_COMPRESS_DEFLATE_DICTIONARY,
+                                   compressed.get(), output.get(),
+                                   other->get()));
+  EXPECT_EQ(output.get()->length, 0);
+}
+
+TEST_F(CompressionDictionaryTest, NothingIsCompressedWithoutADictionary) {
+  const std::string message = Message(0, 300);
+  Buffer input(message);
+  Buffer output;
+  EXPECT_FALSE(grpc_msg_compress(GRPC_COMPRESS_DEFLATE_DICTIONARY, input.get(),
+                                 output.get()));
+  EXPECT_EQ(output.ToString(), message);
+}
+
+TEST(CompressionDictionaryCreateTest, RejectsOtherAlgorithms) {
+  auto dictionary =
+      CompressionDictionary::Create(GRPC_COMPRESS_GZIP, DictionaryData());
+  EXPECT_EQ(dictionary.status().code(), absl::StatusCode::kInvalidArgument);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestGrpcScope grpc_scope;
+  return RUN_ALL_TESTS();
+}
@@ -25,16 +25,20 @@
 #include <grpc/slice.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gpr/useful.h"
 #include "test/core/util/test_config.h"
 
 TEST(CompressionTest, CompressionAlgorithmParse) {
   size_t i;
-  const char* valid_names[] = {"identity", "gzip", "deflate"};
+  const char* valid_names[] = {"identity", "gzip", "deflate",
+                               "deflate-stream"};
   const grpc_compression_algorithm valid_algorithms[] = {
       GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_DEFLATE,
+      GRPC_COMPRESS_DEFLATE_STREAM,
   };
   const char* invalid_names[] = {"gzip2", "foo", "", "2gzip"};
 
@@ -64,11 +68,13 @@ TEST(CompressionTest, CompressionAlgorithmName) {
   int success;
   const char* name;
   size_t i;
-  const char* valid_names[] = {"identity", "gzip", "deflate"};
+  const char* valid_names[] = {"identity", "gzip", "deflate",
+                               "deflate-stream"};
   const grpc_compression_algorithm valid_algorithms[] = {
       GRPC_COMPRESS_NONE,
       GRPC_COMPRESS_GZIP,
       GRPC_COMPRESS_DEFLATE,
+      GRPC_COMPRESS_DEFLATE_STREAM,
   };
 
   gpr_log(GPR_DEBUG, "test_compression_algorithm_name");
@@ -240,6 +246,42 @@ TEST(CompressionTest, CompressionEnableDisableAlgorithm) {
   }
 }
 
+TEST(CompressionTest, UnsupportedAlgorithmsAreNeverEnabled) {
+  const auto supported = grpc_core::CompressionAlgorithmSet::Supported();
+  EXPECT_TRUE(supported.IsSet(GRPC_COMPRESS_NONE));
+  EXPECT_TRUE(supported.IsSet(GRPC_COMPRESS_DEFLATE));
+  EXPECT_TRUE(supported.IsSet(GRPC_COMPRESS_GZIP));
+  // Dictionaries only come with channel args.
+  EXPECT_FALSE(supported.IsSet(GRPC_COMPRESS_DEFLATE_DICTIONARY));
+  // Everything is enabled by default, but only what this process supports
+  // is advertised.
+  EXPECT_EQ(grpc_core::CompressionAlgorithmSet::FromChannelArgs(
+                grpc_core::ChannelArgs()),
+            supported);
+  // The peer accepting an algorithm does not make it usable locally.
+  uint32_t accepted_encodings = 0;
+  grpc_core::SetBit(&accepted_encodings, GRPC_COMPRESS_NONE);
+  grpc_core::SetBit(&accepted_encodings, GRPC_COMPRESS_DEFLATE_DICTIONARY);
+  EXPECT_EQ(grpc_compression_algorithm_for_level(GRPC_COMPRESS_LEVEL_HIGH,
+                                                 accepted_encodings),
+            GRPC_COMPRESS_NONE);
+}
+
+TEST(CompressionTest, DeflateStreamIsNeverChosenByLevel) {
+  EXPECT_TRUE(grpc_core::CompressionAlgorithmSet::Supported().IsSet(
+      GRPC_COMPRESS_DEFLATE_STREAM));
+  uint32_t accepted_encodings = 0;
+  grpc_core::SetBit(&accepted_encodings, GRPC_COMPRESS_NONE);
+  grpc_core::SetBit(&accepted_encodings, GRPC_COMPRESS_DEFLATE_STREAM);
+  for (int level = GRPC_COMPRESS_LEVEL_NONE; level < GRPC_COMPRESS_LEVEL_COUNT;
+       ++level) {
+    EXPECT_EQ(grpc_compression_algorithm_for_level(
+                  static_cast<grpc_compression_level>(level),
+                  accepted_encodings),
+              GRPC_COMPRESS_NONE);
+  }
+}
+
 int main(int argc, char** argv) {
   grpc::testing::TestEnvironment env(&argc, argv);
   ::testing::InitGoogleTest(&argc, argv);
@@ -28,6 +28,7 @@
 #include <grpc/slice_buffer.h>
 #include <grpc/support/log.h>
 
+#include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gpr/useful.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
 #include "test/core/util/slice_splitter.h"
@@ -114,6 +115,10 @@ static grpc_slice repeated(char c, size_t length) {
 static compressability get_compressability(
     test_value id, grpc_compression_algorithm algorithm) {
   if (algorithm == GRPC_COMPRESS_NONE) return SHOULD_NOT_COMPRESS;
+  // Algorithms that this process cannot use fall back to sending uncompressed.
+  if (!grpc_core::IsCompressionAlgorithmSupported(algorithm)) {
+    return SHOULD_NOT_COMPRESS;
+  }
   switch (id) {
     case ONE_A:
       return SHOULD_NOT_COMPRESS;
@@ -216,6 +221,37 @@ TEST(MessageCompressTest, BadDecompressionDataMissingTrailer) {
   grpc_slice_buffer_destroy(&output);
 }
 
+TEST(MessageCompressTest, BadDecompressionDataTruncated) {
+  for (int i = 0; i < GRPC_COMPRESS_ALGORITHMS_COUNT; i++) {
+    const auto algorithm = static_cast<grpc_compression_algorithm>(i);
+    if (algorithm == GRPC_COMPRESS_NONE ||
+        !grpc_core::IsCompressionAlgorithmSupported(algorithm)) {
+      continue;
+    }
+    grpc_slice_buffer input;
+    grpc_slice_buffer compressed;
+    grpc_slice_buffer garbage;
+    grpc_slice_buffer output;
+    grpc_slice_buffer_init(&input);
+    grpc_slice_buffer_init(&compressed);
+    grpc_slice_buffer_init(&garbage);
+    grpc_slice_buffer_init(&output);
+    grpc_slice_buffer_add(&input, create_test_value(ONE_MB_A));
+
+    grpc_core::ExecCtx exec_ctx;
+    ASSERT_EQ(1, grpc_msg_compress(algorithm, &input, &compressed));
+    /* drop the end of the stream */
+    grpc_slice_buffer_trim_end(&compressed, 4, &garbage);
+    ASSERT_EQ(0, grpc_msg_decompress(algorithm, &compressed, &output));
+    ASSERT_EQ(0, output.length);
+
+    grpc_slice_buffer_destroy(&input);
+    grpc_slice_buffer_destroy(&compressed);
+    grpc_slice_buffer_destroy(&garbage);
+    grpc_slice_buffer_destroy(&output);
+  }
+}
+
 TEST(MessageCompressTest, BadDecompressionDataTrailingGarbage) {
   grpc_slice_buffer input;
   grpc_slice_buffer output;
@@ -0,0 +1,183 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/lib/compression/stream_compress.h"
+
+#include <stddef.h>
+
+#include <algorithm>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+// Small messages that are alike, but not identical.
+std::string Message(int n, size_t size) {
+  std::string message;
+  for (int i = n; message.size() < size; ++i) {
+    absl::StrAppend(&message, "\x08", i, "\x12\x08us-east1\x1a\x08",
+                    "checkout\"\x0auser-", i * 7919 % 100000, "*\x07PENDING");
+  }
+  message.resize(size);
+  return message;
+}
+
+class Buffer {
+ public:
+  Buffer() { grpc_slice_buffer_init(&buffer_); }
+  // Adds data in slices of at most split bytes.
+  explicit Buffer(absl::string_view data, size_t split = 65536) : Buffer() {
+    for (size_t i = 0; i < data.size(); i += split) {
+      const size_t length = std::min(split, data.size() - i);
+      grpc_slice_buffer_add(
+          &buffer_, grpc_slice_from_copied_buffer(data.data() + i, length));
+    }
+  }
+  ~Buffer() { grpc_slice_buffer_destroy(&buffer_); }
+
+  grpc_slice_buffer* get() { return &buffer_; }
+  std::string ToString() const {
+    std::string out;
+    for (size_t i = 0; i < buffer_.count; ++i) {
+      const grpc_slice& slice = buffer_.slices[i];
+      out.append(reinterpret_cast<const char*>(GRPC_SLICE_START_PTR(slice)),
+                 GRPC_SLICE_LENGTH(slice));
+    }
+    return out;
+  }
+
+ private:
+  grpc_slice_buffer buffer_;
+};
+
+class StreamCompressSplitTest : public ::testing::TestWithParam<size_t> {};
+
+TEST_P(StreamCompressSplitTest, RoundTripsManyMessages) {
+  const size_t split = GetParam();
+  DeflateStreamCompressor compressor;
+  DeflateStreamDecompressor decompressor;
+  for (int i = 0; i < 100; ++i) {
+    // Mix in empty and large messages.
+    const std::string message =
+        i % 40 == 3 ? "" : Message(i, i == 7 ? 300000 : 300);
+    Buffer input(message, split);
+    Buffer compressed;
+    ASSERT_TRUE(compressor.Compress(input.get(), compressed.get()));
+    const std::string wire = compressed.ToString();
+    if (!message.empty()) {
+      ASSERT_GE(wire.size(), 4);
+      EXPECT_EQ(wire.substr(wire.size() - 4),
+                absl::string_view("\0\0\xff\xff", 4));
+    }
+    Buffer received(wire, split);
+    Buffer output;
+    ASSERT_TRUE(decompressor.Decompress(received.get(), output.get()))
+        << "message " << i;
+    EXPECT_EQ(output.ToString(), message) << "message " << i;
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Splits, StreamCompressSplitTest,
+                         ::testing::Values(1, 7, 65536));
+
+TEST(StreamCompressTest, LaterMessagesReuseHistory) {
+  ExecCtx exec_ctx;
+  DeflateStreamCompressor compressor;
+  size_t stream_size = 0;
+  size_t per_message_size = 0;
+  for (int i = 0; i < 50; ++i) {
+    Buffer input(Message(i * 10, 300));
+    Buffer compressed;
+    Buffer plain;
+    ASSERT_TRUE(compressor.Compress(input.get(), compressed.get()));
+    ASSERT_TRUE(
+        grpc_msg_compress(GRPC_COMPRESS_DEFLATE, input.get(), plain.get()));
+    stream_size += compressed.get()->length;
+    per_message_size += plain.get()->length;
+  }
+  EXPECT_LT(stream_size, per_message_size * 3 / 4);
+}
+
+TEST(StreamCompressTest, MessageThatFillsTheOutputExactly) {
+  // Decompresses to exactly one 1 KiB output block.
+  const std::string message(1024, 'a');
+  DeflateStreamCompressor compressor;
+  DeflateStreamDecompressor decompressor;
+  for (int i = 0; i < 3; ++i) {
+    Buffer input(message);
+    Buffer compressed;
+    ASSERT_TRUE(compressor.Compress(input.get(), compressed.get()));
+    Buffer output;
+    ASSERT_TRUE(decompressor.Decompress(compressed.get(), output.get()));
+    EXPECT_EQ(output.ToString(), message);
+  }
+}
+
+TEST(StreamCompressTest, TruncatedMessageFailsTheStream) {
+  for (size_t cut : {1, 3, 4, 5, 10}) {
+    DeflateStreamCompressor compressor;
+    DeflateStreamDecompressor decompressor;
+    Buffer input(Message(0, 1000));
+    Buffer compressed;
+    Buffer garbage;
+    ASSERT_TRUE(compressor.Compress(input.get(), compressed.get()));
+    grpc_slice_buffer_trim_end(compressed.get(), cut, garbage.get());
+    Buffer output;
+    EXPECT_FALSE(decompressor.Decompress(compressed.get(), output.get()))
+        << "cut " << cut;
+    EXPECT_EQ(output.get()->length, 0);
+    // The stream cannot recover.
+    Buffer next(Message(1, 1000));
+    Buffer next_compressed;
+    ASSERT_TRUE(compressor.Compress(next.get(), next_compressed.get()));
+    EXPECT_FALSE(
+        decompressor.Decompress(next_compressed.get(), output.get()));
+  }
+}
+
+TEST(StreamCompressTest, MessageCompressIsOneMessageStream) {
+  ExecCtx exec_ctx;
+  const std::string message(1024 * 1024, 'a');
+  Buffer input(message);
+  Buffer compressed;
+  ASSERT_TRUE(grpc_msg_compress(GRPC_COMPRESS_DEFLATE_STREAM, input.get(),
+                                compressed.get()));
+  DeflateStreamDecompressor decompressor;
+  Buffer output;
+  ASSERT_TRUE(decompressor.Decompress(compressed.get(), output.get()));
+  EXPECT_EQ(output.ToString(), message);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestGrpcScope grpc_scope;
+  return RUN_ALL_TESTS();
+}
@@ -277,7 +277,8 @@ static void request_with_payload_template_inner(
     grpc_compression_algorithm expected_algorithm_from_server,
     grpc_metadata* client_init_metadata, bool set_server_level,
     grpc_compression_level server_compression_level,
-    bool send_message_before_initial_metadata, bool decompress_in_core) {
+    bool send_message_before_initial_metadata, bool decompress_in_core,
+    bool offload_compression) {
   grpc_call* c;
   grpc_call* s;
   grpc_slice request_payload_slice;
@@ -323,6 +324,11 @@ static void request_with_payload_template_inner(
     server_args =
         server_args.Set(GRPC_ARG_ENABLE_PER_MESSAGE_DECOMPRESSION, false);
   }
+  if (offload_compression) {
+    // Move the work for every message to the EventEngine.
+    client_args = client_args.Set(GRPC_ARG_COMPRESSION_OFFLOAD_THRESHOLD, 1);
+    server_args = server_args.Set(GRPC_ARG_COMPRESSION_OFFLOAD_THRESHOLD, 1);
+  }
   f = begin_test(config, test_name, client_args.ToC().get(),
                  server_args.ToC().get(), decompress_in_core);
   grpc_core::CqVerifier cqv(f.cq);
@@ -569,14 +575,14 @@ static void request_with_payload_template(
       default_server_channel_compression_algorithm,
       expected_algorithm_from_client, expected_algorithm_from_server,
       client_init_metadata, set_server_level, server_compression_level,
-      send_message_before_initial_metadata, false);
+      send_message_before_initial_metadata, false, false);
   request_with_payload_template_inner(
       config, test_name, client_send_flags_bitmask,
       default_client_channel_compression_algorithm,
       default_server_channel_compression_algorithm,
       expected_algorithm_from_client, expected_algorithm_from_server,
       client_init_metadata, set_server_level, server_compression_level,
-      send_message_before_initial_metadata, true);
+      send_message_before_initial_metadata, true, false);
 }
 
 static void test_invoke_request_with_exceptionally_uncompressed_payload(
@@ -615,6 +621,15 @@ static void test_invoke_request_with_send_message_before_initial_metadata(
       /* ignored */ GRPC_COMPRESS_LEVEL_NONE, true);
 }
 
+static void test_invoke_request_with_offloaded_compression(
+    grpc_end2end_test_config config) {
+  request_with_payload_template_inner(
+      config, "test_invoke_request_with_offloaded_compression", 0,
+      GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP, GRPC_COMPRESS_GZIP,
+      GRPC_COMPRESS_GZIP, nullptr, false,
+      /* ignored */ GRPC_COMPRESS_LEVEL_NONE, false, true, true);
+}
+
 static void test_invoke_request_with_server_level(
     grpc_end2end_test_config config) {
   request_with_payload_template(
@@ -680,6 +695,7 @@ void compressed_payload(grpc_end2end_test_config config) {
   test_invoke_request_with_uncompressed_payload(config);
   test_invoke_request_with_compressed_payload(config);
   test_invoke_request_with_send_message_before_initial_metadata(config);
+  test_invoke_request_with_offloaded_compression(config);
   test_invoke_request_with_server_level(config);
   test_invoke_request_with_compressed_payload_md_override(config);
   test_invoke_request_with_disabled_algorithm(config);
@@ -125,6 +125,11 @@ void FuzzingEventEngine::Tick() {
   }
 }
 
+void FuzzingEventEngine::TickForDuration(Duration d) {
+  const Time deadline = Now() + d;
+  while (Now() < deadline) Tick();
+}
+
 FuzzingEventEngine::Time FuzzingEventEngine::Now() {
   grpc_core::MutexLock lock(&mu_);
   return now_;
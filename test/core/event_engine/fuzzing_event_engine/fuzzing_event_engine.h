@@ -52,6 +52,9 @@ class FuzzingEventEngine : public EventEngine {
 
   void FuzzingDone();
   void Tick();
+  // Ticks until Now() has advanced by at least d, running the timers that
+  // expire on the way.
+  void TickForDuration(Duration d);
 
   absl::StatusOr<std::unique_ptr<Listener>> CreateListener(
       Listener::AcceptCallback on_accept,
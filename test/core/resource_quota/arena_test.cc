@@ -22,6 +22,7 @@
 #include <string.h>
 
 #include <algorithm>
+#include <limits>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -33,6 +34,8 @@
 #include <grpc/support/sync.h>
 #include <grpc/support/time.h>
 
+#include "src/core/lib/debug/stats.h"
+#include "src/core/lib/debug/stats_data.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/thd.h"
 #include "src/core/lib/iomgr/exec_ctx.h"
@@ -200,6 +203,107 @@ TEST_F(ArenaTest, CreateManyObjects) {
   }
 }
 
+TEST_F(ArenaTest, LargePooledObjectsArePooled) {
+  struct TestObj {
+    char a[3000];
+  };
+
+  auto arena = MakeScopedArena(1024, &memory_allocator_);
+  auto obj = arena->MakePooled<TestObj>();
+  void* p = obj.get();
+  obj.reset();
+  obj = arena->MakePooled<TestObj>();
+  EXPECT_EQ(p, obj.get());
+}
+
+TEST_F(ArenaTest, ReclaimableScopesKeepStreamingCallsBounded) {
+  struct Message {
+    explicit Message(int* destroyed) : destroyed(destroyed) {}
+    ~Message() { ++*destroyed; }
+    int* destroyed;
+    char payload[1000];
+  };
+
+  ExecCtx exec_ctx;
+  Arena* arena = Arena::Create(1024, &memory_allocator_);
+  int destroyed = 0;
+  for (int i = 0; i < 10000; i++) {
+    Arena::ReclaimableScope scope(arena);
+    memset(scope.Alloc(3000), 0, 3000);
+    scope.New<Message>(&destroyed);
+    scope.ManagedNew<Message>(&destroyed);
+  }
+  EXPECT_EQ(destroyed, 10000);
+  EXPECT_LT(arena->Destroy(), 64 * 1024);
+}
+
+TEST_F(ArenaTest, ReclaimableScopeFallsBackToTheArena) {
+  ExecCtx exec_ctx;
+  Arena* arena = Arena::Create(1024, &memory_allocator_);
+  {
+    Arena::ReclaimableScope scope(arena);
+    memset(scope.Alloc(100 * 1024), 0, 100 * 1024);
+    memset(scope.Alloc(10), 0, 10);
+  }
+  EXPECT_GE(arena->Destroy(), 100 * 1024);
+}
+
+TEST_F(ArenaTest, ArenasOfSimilarSizeReuseMemory) {
+  ExecCtx exec_ctx;
+  Arena* arena = Arena::Create(1000, &memory_allocator_);
+  arena->Destroy();
+  Arena* next = Arena::Create(1100, &memory_allocator_);
+  EXPECT_EQ(next, arena);
+  next->Destroy();
+}
+
+TEST_F(ArenaTest, RoundingIsBoundedToASizeClass) {
+  ExecCtx exec_ctx;
+  Arena* arena = Arena::Create(1000, &memory_allocator_);
+  arena->Destroy();
+  // Would share a power of two with the arena above, but not a size class.
+  Arena* next = Arena::Create(1500, &memory_allocator_);
+  EXPECT_NE(next, arena);
+  next->Destroy();
+}
+
+TEST_F(ArenaTest, RecycledArenasNeedNoHeapAllocations) {
+  ExecCtx exec_ctx;
+  Arena::Create(1000, &memory_allocator_)->Destroy();
+  auto before = global_stats().Collect();
+  for (int i = 0; i < 100; i++) {
+    Arena* arena = Arena::Create(1000, &memory_allocator_);
+    // Fits in the rounded up initial zone.
+    arena->Alloc(1100);
+    arena->Destroy();
+  }
+  EXPECT_EQ(global_stats().Collect()->Diff(*before)->arena_allocations, 0);
+}
+
+TEST_F(ArenaTest, LargeArenasAreNotRecycled) {
+  ExecCtx exec_ctx;
+  Arena::Create(1024 * 1024, &memory_allocator_)->Destroy();
+  auto before = global_stats().Collect();
+  Arena::Create(1024 * 1024, &memory_allocator_)->Destroy();
+  EXPECT_EQ(global_stats().Collect()->Diff(*before)->arena_allocations, 1);
+}
+
+TEST_F(ArenaTest, ReclamationFreesIdleThreadCaches) {
+  ExecCtx exec_ctx;
+  Arena::Create(1000, &memory_allocator_)->Destroy();
+  // Run the default quota short, so that it calls its benign reclaimers.
+  auto memory_quota = ResourceQuota::Default()->memory_quota();
+  memory_quota->SetSize(1024 * 1024);
+  auto pressure = memory_quota->CreateMemoryOwner("pressure");
+  pressure.Reserve(2 * 1024 * 1024);
+  exec_ctx.Flush();
+  pressure.Release(2 * 1024 * 1024);
+  memory_quota->SetSize(std::numeric_limits<intptr_t>::max());
+  auto before = global_stats().Collect();
+  Arena::Create(1000, &memory_allocator_)->Destroy();
+  EXPECT_EQ(global_stats().Collect()->Diff(*before)->arena_allocations, 1);
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char* argv[]) {
@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <random>
 #include <thread>
 #include <vector>
@@ -169,6 +170,70 @@ TEST(MemoryQuotaTest, NoBunchingIfIdle) {
   EXPECT_GE(count_reclaimers_called.load(std::memory_order_relaxed), 8000);
 }
 
+TEST(MemoryQuotaTest, ChildQuotasDrawFromTheirParent) {
+  ExecCtx exec_ctx;
+  MemoryQuota parent("parent");
+  auto child = parent.CreateChild("child", /*guaranteed_bytes=*/1024 * 1024,
+                                  /*weight=*/1);
+  ASSERT_EQ(parent.GetChildUsage().size(), 1);
+  EXPECT_EQ(parent.GetChildUsage()[0].name, "child");
+  auto memory_allocator = child->CreateMemoryAllocator("bar");
+  const size_t used_before = parent.GetChildUsage()[0].used_bytes;
+  auto object = memory_allocator.MakeUnique<Sized<4096>>();
+  EXPECT_GT(parent.GetChildUsage()[0].used_bytes, used_before);
+}
+
+TEST(MemoryQuotaTest, GuaranteedBytesAreSetAsideInTheParent) {
+  ExecCtx exec_ctx;
+  MemoryQuota parent("parent");
+  parent.SetSize(1024 * 1024);
+  auto child = parent.CreateChild("child", /*guaranteed_bytes=*/1024 * 1024,
+                                  /*weight=*/1);
+  auto memory_owner = parent.CreateMemoryOwner("bar");
+  auto object = memory_owner.MakeUnique<Sized<2048>>();
+  auto checker = CallChecker::Make();
+  memory_owner.PostReclaimer(
+      ReclamationPass::kDestructive,
+      [&object, checker](absl::optional<ReclamationSweep> sweep) {
+        checker->Called();
+        EXPECT_TRUE(sweep.has_value());
+        object.reset();
+      });
+  exec_ctx.Flush();
+  EXPECT_EQ(object.get(), nullptr);
+}
+
+TEST(MemoryQuotaTest, ParentReclaimsFromTheHeaviestChild) {
+  ExecCtx exec_ctx;
+  MemoryQuota parent("parent");
+  parent.SetSize(4 * 1024 * 1024);
+  auto quiet = parent.CreateChild("quiet", /*guaranteed_bytes=*/1024 * 1024,
+                                  /*weight=*/1);
+  auto noisy = parent.CreateChild("noisy", /*guaranteed_bytes=*/0,
+                                  /*weight=*/1);
+  auto quiet_owner = quiet->CreateMemoryOwner("quiet");
+  auto noisy_owner = noisy->CreateMemoryOwner("noisy");
+  auto quiet_object = quiet_owner.MakeUnique<Sized<4096>>();
+  quiet_owner.PostReclaimer(
+      ReclamationPass::kDestructive,
+      [&quiet_object](absl::optional<ReclamationSweep> sweep) {
+        if (sweep.has_value()) quiet_object.reset();
+      });
+  std::vector<std::unique_ptr<Sized<256 * 1024>>> noisy_objects;
+  noisy_owner.PostReclaimer(
+      ReclamationPass::kDestructive,
+      [&noisy_objects](absl::optional<ReclamationSweep> sweep) {
+        if (sweep.has_value()) noisy_objects.clear();
+      });
+  // Push the parent into overcommit with the noisy tenant alone.
+  for (int i = 0; i < 16; i++) {
+    noisy_objects.push_back(noisy_owner.MakeUnique<Sized<256 * 1024>>());
+  }
+  exec_ctx.Flush();
+  EXPECT_TRUE(noisy_objects.empty());
+  EXPECT_NE(quiet_object.get(), nullptr);
+}
+
 }  // namespace testing
 
 namespace memory_quota_detail {
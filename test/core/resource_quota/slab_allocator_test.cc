@@ -0,0 +1,115 @@
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "src/core/lib/resource_quota/slab_allocator.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <grpc/slice.h>
+
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+
+class SlabAllocatorTest : public ::testing::Test {
+ protected:
+  MemoryQuota memory_quota_{"test"};
+  MemoryOwner owner_ = memory_quota_.CreateMemoryOwner("owner");
+};
+
+TEST_F(SlabAllocatorTest, SlicesHaveTheBlockSize) {
+  ExecCtx exec_ctx;
+  SlabAllocator slab_allocator(8192, /*use_hugepages=*/false, &memory_quota_);
+  std::vector<grpc_slice> slices;
+  for (int i = 0; i < 10; i++) {
+    slices.push_back(slab_allocator.MakeSlice(&owner_));
+    ASSERT_EQ(GRPC_SLICE_LENGTH(slices.back()), 8192);
+    memset(GRPC_SLICE_START_PTR(slices.back()), i, 8192);
+  }
+  for (int i = 0; i < 10; i++) {
+    EXPECT_EQ(GRPC_SLICE_START_PTR(slices[i])[8191], i);
+    grpc_slice_unref(slices[i]);
+  }
+}
+
+TEST_F(SlabAllocatorTest, FreedBlocksAreReused) {
+  ExecCtx exec_ctx;
+  SlabAllocator slab_allocator(8192, /*use_hugepages=*/true, &memory_quota_);
+  for (int i = 0; i < 1000; i++) {
+    std::vector<grpc_slice> slices;
+    for (int j = 0; j < 10; j++) {
+      slices.push_back(slab_allocator.MakeSlice(&owner_));
+    }
+    for (grpc_slice slice : slices) grpc_slice_unref(slice);
+  }
+  EXPECT_EQ(slab_allocator.slab_count(), 1);
+}
+
+TEST_F(SlabAllocatorTest, SlicesOutliveTheirOwner) {
+  ExecCtx exec_ctx;
+  SlabAllocator slab_allocator(8192, /*use_hugepages=*/false, &memory_quota_);
+  MemoryOwner owner = memory_quota_.CreateMemoryOwner("short_lived");
+  grpc_slice slice = slab_allocator.MakeSlice(&owner);
+  owner.Reset();
+  grpc_slice_unref(slice);
+}
+
+TEST_F(SlabAllocatorTest, OnlyEmptySlabsAreReleased) {
+  ExecCtx exec_ctx;
+  SlabAllocator slab_allocator(65536, /*use_hugepages=*/false, &memory_quota_);
+  std::vector<grpc_slice> slices;
+  // More than one slab's worth.
+  for (int i = 0; i < 40; i++) {
+    slices.push_back(slab_allocator.MakeSlice(&owner_));
+  }
+  EXPECT_EQ(slab_allocator.slab_count(), 2);
+  const grpc_slice kept = slices.back();
+  slices.pop_back();
+  for (grpc_slice slice : slices) grpc_slice_unref(slice);
+  EXPECT_EQ(slab_allocator.ReleaseEmptySlabs(), 1);
+  EXPECT_EQ(slab_allocator.slab_count(), 1);
+  grpc_slice_unref(kept);
+  EXPECT_EQ(slab_allocator.ReleaseEmptySlabs(), 1);
+  EXPECT_EQ(slab_allocator.slab_count(), 0);
+}
+
+TEST_F(SlabAllocatorTest, EmptySlabsAreReleasedUnderPressure) {
+  ExecCtx exec_ctx;
+  memory_quota_.SetSize(8 * 1024 * 1024);
+  SlabAllocator slab_allocator(8192, /*use_hugepages=*/false, &memory_quota_);
+  grpc_slice_unref(slab_allocator.MakeSlice(&owner_));
+  EXPECT_EQ(slab_allocator.slab_count(), 1);
+  // Push the quota into overcommit: the slab's idle memory is charged to it.
+  MemoryAllocator hog = memory_quota_.CreateMemoryAllocator("hog");
+  hog.Reserve(7 * 1024 * 1024);
+  exec_ctx.Flush();
+  EXPECT_EQ(slab_allocator.slab_count(), 0);
+  hog.Release(7 * 1024 * 1024);
+}
+
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment give_me_a_name(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
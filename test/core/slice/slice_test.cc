@@ -243,6 +243,32 @@ INSTANTIATE_TEST_SUITE_P(GrpcSliceSizedTest, GrpcSliceSizedTest,
                            return std::to_string(info.param);
                          });
 
+TEST(GrpcSliceTest, HeadroomIsTheUnusedStartOfAMallocedBuffer) {
+  grpc_slice head = grpc_slice_malloc(100);
+  EXPECT_EQ(grpc_slice_headroom(head), 0u);
+  grpc_slice tail = grpc_slice_split_tail(&head, 10);
+  // The head still uses the start of the buffer.
+  EXPECT_EQ(grpc_slice_headroom(tail), 0u);
+  grpc_slice_unref(head);
+  EXPECT_EQ(grpc_slice_headroom(tail), 10u);
+  memset(GRPC_SLICE_START_PTR(tail), 'b', GRPC_SLICE_LENGTH(tail));
+  uint8_t* start = grpc_slice_extend_into_headroom(&tail, 4);
+  memset(start, 'a', 4);
+  EXPECT_EQ(start, GRPC_SLICE_START_PTR(tail));
+  EXPECT_EQ(grpc_core::StringViewFromSlice(tail),
+            std::string(4, 'a') + std::string(90, 'b'));
+  EXPECT_EQ(grpc_slice_headroom(tail), 6u);
+  grpc_slice_unref(tail);
+
+  grpc_slice inlined = grpc_slice_malloc(4);
+  EXPECT_EQ(grpc_slice_headroom(inlined), 0u);
+  grpc_slice moved = grpc_slice_from_cpp_string(std::string(100, 'x'));
+  grpc_slice moved_tail = grpc_slice_split_tail(&moved, 10);
+  grpc_slice_unref(moved);
+  EXPECT_EQ(grpc_slice_headroom(moved_tail), 0u);
+  grpc_slice_unref(moved_tail);
+}
+
 TEST(GrpcSliceTest, SliceFromCopiedString) {
   static const char* text = "HELLO WORLD!";
   grpc_slice slice;
@@ -0,0 +1,143 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "absl/strings/str_cat.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/impl/codegen/propagation_bits.h>
+#include <grpc/slice.h>
+#include <grpc/status.h>
+#include <grpc/support/time.h>
+
+#include "src/core/lib/debug/stats_data.h"
+#include "src/core/lib/surface/channel.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+uint64_t Count(const Histogram_32768_24& histogram) {
+  uint64_t count = 0;
+  for (int i = 0; i < 24; ++i) count += histogram.buckets()[i];
+  return count;
+}
+
+TEST(CallSizeEstimatorTest, GrowsAtOnceAndShrinksSlowly) {
+  CallSizeEstimator estimator(1000);
+  // Rounded up past the next multiple of 256.
+  EXPECT_EQ(estimator.Estimate(), 1280);
+  estimator.Update(10000);
+  EXPECT_EQ(estimator.Estimate(), 10240);
+  for (int i = 0; i < 10; ++i) estimator.Update(1000);
+  EXPECT_GT(estimator.Estimate(), 9000);
+  for (int i = 0; i < 2000; ++i) estimator.Update(1000);
+  EXPECT_EQ(estimator.Estimate(), 1280);
+}
+
+class ChannelCallSizeTest : public ::testing::Test {
+ protected:
+  ChannelCallSizeTest()
+      : channel_(grpc_lame_client_channel_create(
+            "lame", GRPC_STATUS_UNAVAILABLE, "lame")),
+        cq_(grpc_completion_queue_create_for_next(nullptr)) {}
+
+  ~ChannelCallSizeTest() override {
+    grpc_completion_queue_shutdown(cq_);
+    while (grpc_completion_queue_next(cq_, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .type != GRPC_QUEUE_SHUTDOWN) {
+    }
+    grpc_completion_queue_destroy(cq_);
+    grpc_channel_destroy(channel_);
+  }
+
+  void MakeCall(const char* method) {
+    grpc_slice slice = grpc_slice_from_copied_string(method);
+    grpc_call_unref(grpc_channel_create_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_, slice, nullptr,
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr));
+    grpc_slice_unref(slice);
+  }
+
+  void MakeRegisteredCall(void* handle) {
+    grpc_call_unref(grpc_channel_create_registered_call(
+        channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, cq_, handle,
+        gpr_inf_future(GPR_CLOCK_REALTIME), nullptr));
+  }
+
+  std::map<std::string, uint64_t> CallsByMethod() {
+    std::map<std::string, uint64_t> calls;
+    for (const auto& p : Channel::FromC(channel_)->CallInitialSizeByMethod()) {
+      calls[p.first] = Count(p.second);
+    }
+    return calls;
+  }
+
+  grpc_channel* channel_;
+  grpc_completion_queue* cq_;
+};
+
+TEST_F(ChannelCallSizeTest, HistogramIsBrokenDownByMethod) {
+  void* handle =
+      grpc_channel_register_call(channel_, "/svc/Unary", nullptr, nullptr);
+  MakeRegisteredCall(handle);
+  MakeRegisteredCall(handle);
+  // Unregistered calls to the same method share its estimate.
+  MakeCall("/svc/Unary");
+  MakeCall("/svc/Streaming");
+  EXPECT_EQ(CallsByMethod(),
+            (std::map<std::string, uint64_t>{{"/svc/Unary", 3},
+                                             {"/svc/Streaming", 1}}));
+}
+
+TEST_F(ChannelCallSizeTest, MethodsStartFromTheChannelEstimate) {
+  Channel* channel = Channel::FromC(channel_);
+  channel->UpdateCallSizeEstimate(20000);
+  CallSizeEstimator* estimator =
+      channel->CallSizeEstimatorForMethod("/svc/New");
+  EXPECT_GE(estimator->Estimate(), channel->CallSizeEstimate());
+  EXPECT_LE(estimator->Estimate(), channel->CallSizeEstimate() + 256);
+  estimator->Update(100000);
+  EXPECT_GT(estimator->Estimate(), channel->CallSizeEstimate());
+}
+
+TEST_F(ChannelCallSizeTest, NumberOfMethodsIsBounded) {
+  for (int i = 0; i < 1000; ++i) {
+    MakeCall(absl::StrCat("/svc/Method", i).c_str());
+  }
+  EXPECT_LT(CallsByMethod().size(), 1000);
+  // Later methods share the channel-wide estimator.
+  Channel* channel = Channel::FromC(channel_);
+  EXPECT_EQ(channel->CallSizeEstimatorForMethod("/svc/Method999"),
+            channel->call_size_estimator());
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestGrpcScope grpc_scope;
+  return RUN_ALL_TESTS();
+}
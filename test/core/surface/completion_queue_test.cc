@@ -170,6 +170,64 @@ TEST(GrpcCompletionQueueTest, TestCqEndOp) {
   }
 }
 
+TEST(GrpcCompletionQueueTest, TestNextBatch) {
+  const size_t kNumCompletions = 40;
+  const size_t kBatchSize = 32;
+  grpc_event events[kBatchSize];
+  grpc_completion_queue* cc;
+  grpc_cq_completion completions[kNumCompletions];
+  void* tags[kNumCompletions];
+  grpc_cq_polling_type polling_types[] = {
+      GRPC_CQ_DEFAULT_POLLING, GRPC_CQ_NON_LISTENING, GRPC_CQ_NON_POLLING};
+  grpc_completion_queue_attributes attr;
+
+  LOG_TEST("test_next_batch");
+
+  attr.version = 1;
+  attr.cq_completion_type = GRPC_CQ_NEXT;
+  for (size_t i = 0; i < GPR_ARRAY_SIZE(polling_types); i++) {
+    grpc_core::ExecCtx exec_ctx;
+    attr.cq_polling_type = polling_types[i];
+    cc = grpc_completion_queue_create(
+        grpc_completion_queue_factory_lookup(&attr), &attr, nullptr);
+
+    for (size_t j = 0; j < kNumCompletions; j++) {
+      tags[j] = create_test_tag();
+      ASSERT_TRUE(grpc_cq_begin_op(cc, tags[j]));
+      grpc_cq_end_op(cc, tags[j], absl::OkStatus(), do_nothing_end_completion,
+                     nullptr, &completions[j]);
+    }
+
+    // The events come out in order, at most kBatchSize at a time.
+    size_t num_events = grpc_completion_queue_next_batch(
+        cc, events, kBatchSize, gpr_inf_past(GPR_CLOCK_REALTIME), nullptr);
+    ASSERT_EQ(num_events, kBatchSize);
+    for (size_t j = 0; j < kBatchSize; j++) {
+      ASSERT_EQ(events[j].type, GRPC_OP_COMPLETE);
+      ASSERT_EQ(events[j].tag, tags[j]);
+      ASSERT_TRUE(events[j].success);
+    }
+    num_events = grpc_completion_queue_next_batch(
+        cc, events, kBatchSize, gpr_inf_past(GPR_CLOCK_REALTIME), nullptr);
+    ASSERT_EQ(num_events, kNumCompletions - kBatchSize);
+    for (size_t j = 0; j < num_events; j++) {
+      ASSERT_EQ(events[j].tag, tags[kBatchSize + j]);
+    }
+
+    num_events = grpc_completion_queue_next_batch(
+        cc, events, kBatchSize, gpr_inf_past(GPR_CLOCK_REALTIME), nullptr);
+    ASSERT_EQ(num_events, 1u);
+    ASSERT_EQ(events[0].type, GRPC_QUEUE_TIMEOUT);
+
+    grpc_completion_queue_shutdown(cc);
+    num_events = grpc_completion_queue_next_batch(
+        cc, events, kBatchSize, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    ASSERT_EQ(num_events, 1u);
+    ASSERT_EQ(events[0].type, GRPC_QUEUE_SHUTDOWN);
+    grpc_completion_queue_destroy(cc);
+  }
+}
+
 TEST(GrpcCompletionQueueTest, TestCqTlsCacheFull) {
   grpc_event ev;
   grpc_completion_queue* cc;
@@ -0,0 +1,244 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+#include <grpc/impl/codegen/propagation_bits.h>
+#include <grpc/slice.h>
+#include <grpc/status.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/gprpp/time.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+void DrainAndDestroy(grpc_completion_queue* cq) {
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+// A unary call that sends no message, with its status.
+class ClientCall {
+ public:
+  ClientCall(grpc_channel* channel, grpc_completion_queue* cq, intptr_t tag,
+             gpr_timespec deadline) {
+    grpc_metadata_array_init(&trailing_metadata_);
+    call_ = grpc_channel_create_call(channel, nullptr, GRPC_PROPAGATE_DEFAULTS,
+                                     cq, grpc_slice_from_static_string("/foo"),
+                                     nullptr, deadline, nullptr);
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+    ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+    ops[2].data.recv_status_on_client.trailing_metadata = &trailing_metadata_;
+    ops[2].data.recv_status_on_client.status = &status_;
+    ops[2].data.recv_status_on_client.status_details = &details_;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(call_, ops, 3, Tag(tag), nullptr));
+  }
+  ~ClientCall() {
+    grpc_metadata_array_destroy(&trailing_metadata_);
+    grpc_slice_unref(details_);
+    grpc_call_unref(call_);
+  }
+
+  grpc_status_code status() const { return status_; }
+
+ private:
+  grpc_call* call_;
+  grpc_metadata_array trailing_metadata_;
+  grpc_status_code status_;
+  grpc_slice details_ = grpc_empty_slice();
+};
+
+class ServerPendingCallsTest : public ::testing::Test {
+ protected:
+  ~ServerPendingCallsTest() override {
+    grpc_server_shutdown_and_notify(server_, server_cq_, Tag(1000));
+    grpc_server_cancel_all_calls(server_);
+    while (grpc_completion_queue_next(server_cq_,
+                                      gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .tag != Tag(1000)) {
+    }
+    calls_.clear();
+    grpc_channel_destroy(channel_);
+    grpc_server_destroy(server_);
+    DrainAndDestroy(client_cq_);
+    DrainAndDestroy(server_cq_);
+  }
+
+  void StartServer(ChannelArgs args) {
+    server_ = grpc_server_create(args.ToC().get(), nullptr);
+    grpc_server_register_completion_queue(server_, server_cq_, nullptr);
+    grpc_server_start(server_);
+    channel_ = grpc_inproc_channel_create(server_, nullptr, nullptr);
+  }
+
+  ClientCall* StartCall(intptr_t tag,
+                        Duration timeout = Duration::Seconds(30)) {
+    calls_.push_back(std::make_unique<ClientCall>(
+        channel_, client_cq_, tag,
+        grpc_timeout_milliseconds_to_deadline(timeout.millis())));
+    return calls_.back().get();
+  }
+
+  // Requests a call on the server, and completes it with an OK status.
+  void ServeCall(CqVerifier* server_cqv) {
+    grpc_call* call = nullptr;
+    grpc_call_details details;
+    grpc_metadata_array request_metadata;
+    grpc_call_details_init(&details);
+    grpc_metadata_array_init(&request_metadata);
+    ASSERT_EQ(GRPC_CALL_OK,
+              grpc_server_request_call(server_, &call, &details,
+                                       &request_metadata, server_cq_,
+                                       server_cq_, Tag(100)));
+    server_cqv->Expect(Tag(100), true);
+    server_cqv->Verify();
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    int was_cancelled;
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    ops[1].data.recv_close_on_server.cancelled = &was_cancelled;
+    ops[2].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    ops[2].data.send_status_from_server.status = GRPC_STATUS_OK;
+    ASSERT_EQ(GRPC_CALL_OK,
+              grpc_call_start_batch(call, ops, 3, Tag(101), nullptr));
+    server_cqv->Expect(Tag(101), true);
+    server_cqv->Verify();
+    grpc_call_details_destroy(&details);
+    grpc_metadata_array_destroy(&request_metadata);
+    grpc_call_unref(call);
+  }
+
+  grpc_completion_queue* client_cq_ =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_completion_queue* server_cq_ =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_ = nullptr;
+  std::vector<std::unique_ptr<ClientCall>> calls_;
+};
+
+TEST_F(ServerPendingCallsTest, CallsBeyondTheLimitAreRejected) {
+  StartServer(ChannelArgs().Set(GRPC_ARG_SERVER_MAX_PENDING_CALLS, 1));
+  ClientCall* calls[] = {StartCall(1), StartCall(2), StartCall(3)};
+  // Which call is queued depends on the order the server sees them in.
+  bool done[3] = {};
+  for (int i = 0; i < 2; ++i) {
+    grpc_event ev = grpc_completion_queue_next(
+        client_cq_, grpc_timeout_seconds_to_deadline(10), nullptr);
+    ASSERT_EQ(ev.type, GRPC_OP_COMPLETE);
+    done[reinterpret_cast<intptr_t>(ev.tag) - 1] = true;
+  }
+  int queued = -1;
+  for (int i = 0; i < 3; ++i) {
+    if (done[i]) {
+      EXPECT_EQ(calls[i]->status(), GRPC_STATUS_RESOURCE_EXHAUSTED);
+    } else {
+      EXPECT_EQ(queued, -1);
+      queued = i;
+    }
+  }
+  ASSERT_NE(queued, -1);
+  CqVerifier server_cqv(server_cq_);
+  ServeCall(&server_cqv);
+  CqVerifier client_cqv(client_cq_);
+  client_cqv.Expect(Tag(queued + 1), true);
+  client_cqv.Verify();
+  EXPECT_EQ(calls[queued]->status(), GRPC_STATUS_OK);
+}
+
+TEST_F(ServerPendingCallsTest, ExpiredCallsAreNotPublished) {
+  StartServer(ChannelArgs());
+  ClientCall* call = StartCall(1, Duration::Milliseconds(200));
+  CqVerifier client_cqv(client_cq_);
+  client_cqv.Expect(Tag(1), true);
+  client_cqv.Verify();
+  EXPECT_EQ(call->status(), GRPC_STATUS_DEADLINE_EXCEEDED);
+  // The server drops the call when it is requested instead of handing it to
+  // the application.
+  grpc_call* server_call = nullptr;
+  grpc_call_details details;
+  grpc_metadata_array request_metadata;
+  grpc_call_details_init(&details);
+  grpc_metadata_array_init(&request_metadata);
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_server_request_call(server_, &server_call, &details,
+                                     &request_metadata, server_cq_, server_cq_,
+                                     Tag(100)));
+  CqVerifier server_cqv(server_cq_);
+  server_cqv.VerifyEmpty();
+  // The request fails at shutdown.
+  grpc_server_shutdown_and_notify(server_, server_cq_, Tag(1000));
+  server_cqv.Expect(Tag(100), false);
+  server_cqv.Expect(Tag(1000), true);
+  server_cqv.Verify();
+  grpc_call_details_destroy(&details);
+  grpc_metadata_array_destroy(&request_metadata);
+}
+
+TEST_F(ServerPendingCallsTest, CallsAreShedWhenTheQueueStaysBusy) {
+  StartServer(
+      ChannelArgs()
+          .Set(GRPC_ARG_SERVER_PENDING_CALL_TARGET_DELAY_MS, 10)
+          .Set(GRPC_ARG_SERVER_PENDING_CALL_INTERVAL_MS, 50));
+  ClientCall* first = StartCall(1);
+  gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(300));
+  // The first call has waited through a whole interval, well past the target
+  // delay: the next arrival sheds it.
+  ClientCall* second = StartCall(2);
+  CqVerifier client_cqv(client_cq_);
+  client_cqv.Expect(Tag(1), true);
+  client_cqv.Verify();
+  EXPECT_EQ(first->status(), GRPC_STATUS_RESOURCE_EXHAUSTED);
+  CqVerifier server_cqv(server_cq_);
+  ServeCall(&server_cqv);
+  client_cqv.Expect(Tag(2), true);
+  client_cqv.Verify();
+  EXPECT_EQ(second->status(), GRPC_STATUS_OK);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestGrpcScope grpc_scope;
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,412 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include <grpc/byte_buffer.h>
+#include <grpc/grpc.h>
+#include <grpc/impl/codegen/propagation_bits.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/status.h>
+#include <grpc/support/sync.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/chttp2/transport/chttp2_transport.h"
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "src/core/lib/channel/channel_args.h"
+#include "src/core/lib/channel/channelz.h"
+#include "src/core/lib/experiments/config.h"
+#include "src/core/lib/iomgr/closure.h"
+#include "src/core/lib/iomgr/endpoint.h"
+#include "src/core/lib/iomgr/endpoint_pair.h"
+#include "src/core/lib/iomgr/error.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/call.h"
+#include "src/core/lib/surface/completion_queue.h"
+#include "src/core/lib/surface/server.h"
+#include "test/core/end2end/cq_verifier.h"
+#include "test/core/util/test_config.h"
+
+// Tests for ServerPromiseBasedCall. A minimal stack over an insecure
+// transport is fully promise based, so with the promise_based_server_call
+// experiment forced on by main() every server call here takes that path.
+
+namespace grpc_core {
+namespace {
+
+void* Tag(intptr_t t) { return reinterpret_cast<void*>(t); }
+
+void DrainAndDestroy(grpc_completion_queue* cq) {
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+// HTTP/2 client preface and an empty SETTINGS frame.
+#define PREFACE                      \
+  "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n" \
+  "\x00\x00\x00\x04\x00\x00\x00\x00\x00"
+
+// A HEADERS frame for stream 1 (END_HEADERS) that has every header a gRPC
+// request needs except :path.
+#define HEADERS_WITHOUT_PATH                                 \
+  "\x00\x00\x5e\x01\x04\x00\x00\x00\x01"                     \
+  "\x10\x07:scheme\x04http"                                  \
+  "\x10\x07:method\x04POST"                                  \
+  "\x10\x0a:authority\x09localhost"                          \
+  "\x10\x0c"                                                 \
+  "content-type\x10"                                         \
+  "application/grpc"                                         \
+  "\x10\x02te\x08trailers"
+
+// A complete request for /foo on stream 1 (END_HEADERS).
+#define REQUEST_HEADERS                                      \
+  "\x00\x00\x6a\x01\x04\x00\x00\x00\x01"                     \
+  "\x10\x05:path\x04/foo"                                    \
+  "\x10\x07:scheme\x04http"                                  \
+  "\x10\x07:method\x04POST"                                  \
+  "\x10\x0a:authority\x09localhost"                          \
+  "\x10\x0c"                                                 \
+  "content-type\x10"                                         \
+  "application/grpc"                                         \
+  "\x10\x02te\x08trailers"
+
+// RST_STREAM with CANCEL for stream 1.
+#define RST_STREAM_CANCEL \
+  "\x00\x00\x04\x03\x00\x00\x00\x00\x01\x00\x00\x00\x08"
+
+// The first part of a HEADERS frame for stream 1, without END_HEADERS: the
+// stream exists, but its initial metadata never completes.
+#define PARTIAL_HEADERS                  \
+  "\x00\x00\x10\x01\x00\x00\x00\x00\x01" \
+  "\x10\x05:path\x08/foo/bar"
+
+class ServerPromiseCallTest : public ::testing::Test {
+ protected:
+  ServerPromiseCallTest() {
+    grpc_metadata_array_init(&request_metadata_);
+    grpc_call_details_init(&call_details_);
+    server_ = grpc_server_create(
+        ChannelArgs().Set(GRPC_ARG_MINIMAL_STACK, true).ToC().get(),
+        nullptr);
+    grpc_server_register_completion_queue(server_, server_cq_, nullptr);
+    grpc_server_start(server_);
+  }
+
+  ~ServerPromiseCallTest() override {
+    if (client_endpoint_ != nullptr) Disconnect();
+    grpc_server_shutdown_and_notify(server_, server_cq_, Tag(1000));
+    grpc_server_cancel_all_calls(server_);
+    // Requests that were never matched fail here.
+    while (grpc_completion_queue_next(server_cq_,
+                                      gpr_inf_future(GPR_CLOCK_REALTIME),
+                                      nullptr)
+               .tag != Tag(1000)) {
+    }
+    if (server_call_ != nullptr) grpc_call_unref(server_call_);
+    if (channel_ != nullptr) grpc_channel_destroy(channel_);
+    grpc_server_destroy(server_);
+    grpc_metadata_array_destroy(&request_metadata_);
+    grpc_call_details_destroy(&call_details_);
+    DrainAndDestroy(client_cq_);
+    DrainAndDestroy(server_cq_);
+  }
+
+  void CreateInprocChannel(ChannelArgs args = ChannelArgs()) {
+    channel_ = grpc_inproc_channel_create(server_, args.ToC().get(), nullptr);
+  }
+
+  // Serves an HTTP/2 connection whose client side is driven by the test,
+  // so that it can send requests no gRPC client would.
+  void ConnectRawClient() {
+    ExecCtx exec_ctx;
+    grpc_endpoint_pair endpoints =
+        grpc_iomgr_create_endpoint_pair("server_promise_call_test", nullptr);
+    client_endpoint_ = endpoints.client;
+    Server* core_server = Server::FromC(server_);
+    grpc_transport* transport = grpc_create_chttp2_transport(
+        core_server->channel_args(), endpoints.server, false);
+    ASSERT_TRUE(GRPC_LOG_IF_ERROR(
+        "SetupTransport",
+        core_server->SetupTransport(transport, /*accepting_pollset=*/nullptr,
+                                    core_server->channel_args(),
+                                    /*socket_node=*/nullptr)));
+    grpc_chttp2_transport_start_reading(transport, nullptr, nullptr, nullptr);
+    grpc_endpoint_add_to_pollset(endpoints.server, grpc_cq_pollset(server_cq_));
+    grpc_endpoint_add_to_pollset(endpoints.client, grpc_cq_pollset(server_cq_));
+  }
+
+  // Writes a literal from the raw client, and waits for the write to finish.
+  template <size_t N>
+  void Write(const char (&bytes)[N]) {
+    ExecCtx exec_ctx;
+    gpr_event done;
+    gpr_event_init(&done);
+    grpc_closure on_done;
+    GRPC_CLOSURE_INIT(
+        &on_done,
+        [](void* arg, grpc_error_handle) {
+          gpr_event_set(static_cast<gpr_event*>(arg),
+                        reinterpret_cast<void*>(1));
+        },
+        &done, grpc_schedule_on_exec_ctx);
+    grpc_slice_buffer outgoing;
+    grpc_slice_buffer_init(&outgoing);
+    // The bytes hold NULs, so their length comes from the array.
+    grpc_slice_buffer_add(&outgoing,
+                          grpc_slice_from_copied_buffer(bytes, N - 1));
+    grpc_endpoint_write(client_endpoint_, &outgoing, &on_done, nullptr,
+                        /*max_frame_size=*/INT_MAX);
+    ExecCtx::Get()->Flush();
+    ASSERT_NE(gpr_event_wait(&done, grpc_timeout_seconds_to_deadline(5)),
+              nullptr);
+    grpc_slice_buffer_destroy(&outgoing);
+  }
+
+  void Disconnect() {
+    ExecCtx exec_ctx;
+    grpc_endpoint_shutdown(client_endpoint_,
+                           GRPC_ERROR_CREATE("Forced Disconnect"));
+    grpc_endpoint_destroy(client_endpoint_);
+    client_endpoint_ = nullptr;
+  }
+
+  void RequestCall() {
+    ASSERT_EQ(GRPC_CALL_OK, grpc_server_request_call(
+                                server_, &server_call_, &call_details_,
+                                &request_metadata_, server_cq_, server_cq_,
+                                Tag(100)));
+  }
+
+  // Returns true once the server's channelz node has counted one call,
+  // which failed.
+  bool ServerCallFailed() {
+    std::string json =
+        Server::FromC(server_)->channelz_node()->RenderJsonString();
+    return json.find("\"callsStarted\":\"1\"") != json.npos &&
+           json.find("\"callsFailed\":\"1\"") != json.npos;
+  }
+
+  // Polls the server until it has failed a call it never published.
+  void WaitForServerCallToFail() {
+    gpr_timespec deadline = grpc_timeout_seconds_to_deadline(10);
+    while (!ServerCallFailed()) {
+      ASSERT_LT(gpr_time_cmp(gpr_now(deadline.clock_type), deadline), 0);
+      // The request for a call, if any, must still be outstanding.
+      ASSERT_EQ(grpc_completion_queue_next(
+                    server_cq_, grpc_timeout_milliseconds_to_deadline(100),
+                    nullptr)
+                    .type,
+                GRPC_QUEUE_TIMEOUT);
+    }
+  }
+
+  grpc_completion_queue* client_cq_ =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_completion_queue* server_cq_ =
+      grpc_completion_queue_create_for_next(nullptr);
+  grpc_server* server_ = nullptr;
+  grpc_channel* channel_ = nullptr;
+  grpc_endpoint* client_endpoint_ = nullptr;
+  grpc_call* server_call_ = nullptr;
+  grpc_metadata_array request_metadata_;
+  grpc_call_details call_details_;
+};
+
+TEST_F(ServerPromiseCallTest, TrailersWaitForServerToClientMessages) {
+  CreateInprocChannel();
+  CqVerifier client_cqv(client_cq_);
+  CqVerifier server_cqv(server_cq_);
+  grpc_call* call = grpc_channel_create_call(
+      channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq_,
+      grpc_slice_from_static_string("/foo"), nullptr,
+      grpc_timeout_seconds_to_deadline(30), nullptr);
+  grpc_metadata_array initial_metadata;
+  grpc_metadata_array_init(&initial_metadata);
+  grpc_op ops[3];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[2].op = GRPC_OP_RECV_INITIAL_METADATA;
+  ops[2].data.recv_initial_metadata.recv_initial_metadata = &initial_metadata;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(call, ops, 3, Tag(1), nullptr));
+  RequestCall();
+  server_cqv.Expect(Tag(100), true);
+  server_cqv.Verify();
+  // Only promise based calls have no call stack.
+  ASSERT_EQ(grpc_call_get_call_stack(server_call_), nullptr);
+  // Send the last message in the same batch as the status, so that the
+  // status is ready while the message is still in the filters.
+  grpc_slice first_slice = grpc_slice_from_static_string("first");
+  grpc_slice last_slice = grpc_slice_from_static_string("last");
+  grpc_byte_buffer* first = grpc_raw_byte_buffer_create(&first_slice, 1);
+  grpc_byte_buffer* last = grpc_raw_byte_buffer_create(&last_slice, 1);
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_MESSAGE;
+  ops[1].data.send_message.send_message = first;
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_call_start_batch(server_call_, ops, 2, Tag(101), nullptr));
+  server_cqv.Expect(Tag(101), true);
+  server_cqv.Verify();
+  int was_cancelled = 2;
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_MESSAGE;
+  ops[0].data.send_message.send_message = last;
+  ops[1].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[1].data.recv_close_on_server.cancelled = &was_cancelled;
+  ops[2].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  ops[2].data.send_status_from_server.status = GRPC_STATUS_OK;
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_call_start_batch(server_call_, ops, 3, Tag(102), nullptr));
+  client_cqv.Expect(Tag(1), true);
+  client_cqv.Verify();
+  // Both messages arrive ahead of the status.
+  const char* const kExpected[] = {"first", "last"};
+  for (const char* expected : kExpected) {
+    grpc_byte_buffer* message = nullptr;
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_RECV_MESSAGE;
+    ops[0].data.recv_message.recv_message = &message;
+    ASSERT_EQ(GRPC_CALL_OK,
+              grpc_call_start_batch(call, ops, 1, Tag(2), nullptr));
+    client_cqv.Expect(Tag(2), true);
+    client_cqv.Verify();
+    ASSERT_NE(message, nullptr) << expected;
+    EXPECT_TRUE(byte_buffer_eq_string(message, expected));
+    grpc_byte_buffer_destroy(message);
+  }
+  grpc_metadata_array trailing_metadata;
+  grpc_metadata_array_init(&trailing_metadata);
+  grpc_status_code status;
+  grpc_slice details;
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[0].data.recv_status_on_client.trailing_metadata = &trailing_metadata;
+  ops[0].data.recv_status_on_client.status = &status;
+  ops[0].data.recv_status_on_client.status_details = &details;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(call, ops, 1, Tag(3), nullptr));
+  client_cqv.Expect(Tag(3), true);
+  client_cqv.Verify();
+  EXPECT_EQ(status, GRPC_STATUS_OK);
+  server_cqv.Expect(Tag(102), true);
+  server_cqv.Verify();
+  EXPECT_EQ(was_cancelled, 0);
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&trailing_metadata);
+  grpc_metadata_array_destroy(&initial_metadata);
+  grpc_byte_buffer_destroy(first);
+  grpc_byte_buffer_destroy(last);
+  grpc_call_unref(call);
+}
+
+TEST_F(ServerPromiseCallTest, MissingAuthorityIsNotPublished) {
+  // Without the authority filter the inproc client sends no :authority.
+  CreateInprocChannel(
+      ChannelArgs().Set(GRPC_ARG_DISABLE_CLIENT_AUTHORITY_FILTER, true));
+  RequestCall();
+  grpc_call* call = grpc_channel_create_call(
+      channel_, nullptr, GRPC_PROPAGATE_DEFAULTS, client_cq_,
+      grpc_slice_from_static_string("/foo"), nullptr,
+      grpc_timeout_seconds_to_deadline(30), nullptr);
+  grpc_metadata_array trailing_metadata;
+  grpc_metadata_array_init(&trailing_metadata);
+  grpc_status_code status;
+  grpc_slice details;
+  grpc_op ops[3];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[2].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[2].data.recv_status_on_client.trailing_metadata = &trailing_metadata;
+  ops[2].data.recv_status_on_client.status = &status;
+  ops[2].data.recv_status_on_client.status_details = &details;
+  ASSERT_EQ(GRPC_CALL_OK, grpc_call_start_batch(call, ops, 3, Tag(1), nullptr));
+  CqVerifier client_cqv(client_cq_);
+  client_cqv.Expect(Tag(1), true);
+  client_cqv.Verify();
+  EXPECT_NE(status, GRPC_STATUS_OK);
+  WaitForServerCallToFail();
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&trailing_metadata);
+  grpc_call_unref(call);
+}
+
+TEST_F(ServerPromiseCallTest, MissingPathFinishesBeforeTheTop) {
+  // The HTTP server filter rejects the request before the call args reach
+  // the top of the stack, so the call must drop its own creation ref.
+  ConnectRawClient();
+  RequestCall();
+  Write(PREFACE HEADERS_WITHOUT_PATH);
+  WaitForServerCallToFail();
+}
+
+TEST_F(ServerPromiseCallTest, CancelBeforePublishFinishesBeforeTheTop) {
+  // The client goes away while the server is still reading the initial
+  // metadata, so the call finishes before anything has seen it.
+  ConnectRawClient();
+  RequestCall();
+  Write(PREFACE PARTIAL_HEADERS);
+  Disconnect();
+  WaitForServerCallToFail();
+}
+
+TEST_F(ServerPromiseCallTest, ClientResetMidCallCancelsTheCall) {
+  // chttp2 reports the reset as a successful receive of trailing metadata
+  // that carries a CANCELLED status.
+  ConnectRawClient();
+  RequestCall();
+  Write(PREFACE REQUEST_HEADERS);
+  CqVerifier server_cqv(server_cq_);
+  server_cqv.Expect(Tag(100), true);
+  server_cqv.Verify();
+  ASSERT_EQ(grpc_call_get_call_stack(server_call_), nullptr);
+  int was_cancelled = 2;
+  grpc_op ops[1];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  ops[0].data.recv_close_on_server.cancelled = &was_cancelled;
+  ASSERT_EQ(GRPC_CALL_OK,
+            grpc_call_start_batch(server_call_, ops, 1, Tag(101), nullptr));
+  Write(RST_STREAM_CANCEL);
+  server_cqv.Expect(Tag(101), true);
+  server_cqv.Verify();
+  EXPECT_EQ(was_cancelled, 1);
+}
+
+}  // namespace
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_core::ForceEnableExperiment("promise_based_server_call", true);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
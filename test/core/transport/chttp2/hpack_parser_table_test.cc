@@ -134,6 +134,27 @@ TEST(HpackParserTableTest, ManyAdditions) {
   }
 }
 
+TEST(HpackParserTableTest, ShrinkToFitKeepsEntries) {
+  HPackTable tbl;
+  ExecCtx exec_ctx;
+
+  // Wrap around the ring buffer, then shrink at different points.
+  for (int i = 0; i < 1000; i++) {
+    std::string key = absl::StrCat("K.", i);
+    std::string value = absl::StrCat("VALUE.", i);
+    ASSERT_EQ(tbl.Add(HPackTable::Memento(Slice::FromCopiedString(key),
+                                          Slice::FromCopiedString(value))),
+              absl::OkStatus());
+    if (i % 37 == 0) tbl.ShrinkToFit();
+    const uint32_t num_entries = tbl.num_entries();
+    for (uint32_t j = 0; j < num_entries; j++) {
+      AssertIndex(&tbl, 1 + hpack_constants::kLastStaticEntry + j,
+                  absl::StrCat("K.", i - j).c_str(),
+                  absl::StrCat("VALUE.", i - j).c_str());
+    }
+  }
+}
+
 }  // namespace grpc_core
 
 int main(int argc, char** argv) {
@@ -169,6 +169,35 @@ static void test_periodic_compaction(uint32_t n) {
   grpc_chttp2_stream_map_destroy(&map);
 }
 
+TEST(StreamMapTest, ShrinkReleasesSpareCapacity) {
+  grpc_chttp2_stream_map map;
+  grpc_chttp2_stream_map_init(&map, 8);
+  for (uint32_t i = 1; i <= 1000; i++) {
+    grpc_chttp2_stream_map_add(&map, i, reinterpret_cast<void*>(i));
+  }
+  for (uint32_t i = 1; i <= 1000; i++) {
+    if (i % 100 != 0) grpc_chttp2_stream_map_delete(&map, i);
+  }
+  ASSERT_GE(map.capacity, 1000);
+  grpc_chttp2_stream_map_shrink(&map, 8);
+  EXPECT_EQ(map.capacity, 10);
+  EXPECT_EQ(grpc_chttp2_stream_map_size(&map), 10);
+  for (uint32_t i = 100; i <= 1000; i += 100) {
+    EXPECT_EQ(reinterpret_cast<void*>(i), grpc_chttp2_stream_map_find(&map, i));
+  }
+  EXPECT_EQ(nullptr, grpc_chttp2_stream_map_find(&map, 150));
+  // The map keeps working after shrinking.
+  grpc_chttp2_stream_map_add(&map, 1001, reinterpret_cast<void*>(1001));
+  EXPECT_EQ(grpc_chttp2_stream_map_size(&map), 11);
+  for (uint32_t i = 100; i <= 1000; i += 100) {
+    grpc_chttp2_stream_map_delete(&map, i);
+  }
+  grpc_chttp2_stream_map_delete(&map, 1001);
+  grpc_chttp2_stream_map_shrink(&map, 8);
+  EXPECT_EQ(map.capacity, 8);
+  grpc_chttp2_stream_map_destroy(&map);
+}
+
 TEST(StreamMapTest, MainTest) {
   uint32_t n = 1;
   uint32_t prev = 1;
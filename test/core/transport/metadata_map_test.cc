@@ -24,7 +24,9 @@
 #include "gtest/gtest.h"
 
 #include <grpc/event_engine/memory_allocator.h>
+#include <grpc/impl/compression_types.h>
 
+#include "src/core/lib/compression/compression_internal.h"
 #include "src/core/lib/gprpp/ref_counted_ptr.h"
 #include "src/core/lib/gprpp/time.h"
 #include "src/core/lib/resource_quota/arena.h"
@@ -141,6 +143,33 @@ TEST_F(MetadataMapTest, NonEncodableTrait) {
   EXPECT_EQ(map.DebugString(), "GrpcStreamNetworkState: not sent on wire");
 }
 
+TEST(CompressionAlgorithmMetadataTest, EncodesAlgorithmNames) {
+  EXPECT_EQ(GrpcEncodingMetadata::Encode(GRPC_COMPRESS_GZIP).as_string_view(),
+            "gzip");
+  EXPECT_EQ(GrpcInternalEncodingRequest::Encode(GRPC_COMPRESS_DEFLATE)
+                .as_string_view(),
+            "deflate");
+}
+
+TEST(CompressionAlgorithmMetadataTest, DictionaryIsNotPartOfTheEncoding) {
+  // Messages identify their dictionary themselves.
+  EXPECT_EQ(GrpcEncodingMetadata::Encode(GRPC_COMPRESS_DEFLATE_DICTIONARY)
+                .as_string_view(),
+            "deflate-dict");
+}
+
+TEST(CompressionAlgorithmMetadataTest, AcceptEncodingNamesTheDictionary) {
+  CompressionAlgorithmSet accepted{GRPC_COMPRESS_NONE, GRPC_COMPRESS_GZIP};
+  accepted.SetDictionary(0x1a2b3c4d);
+  const Slice encoded = GrpcAcceptEncodingMetadata::Encode(accepted);
+  EXPECT_EQ(encoded.as_string_view(), "identity, gzip, deflate-dict-1a2b3c4d");
+  auto parsed = GrpcAcceptEncodingMetadata::ParseMemento(
+      encoded.Ref(), [](absl::string_view, const Slice&) {});
+  EXPECT_EQ(parsed, accepted);
+  EXPECT_TRUE(parsed.HasDictionary(0x1a2b3c4d));
+  EXPECT_FALSE(parsed.HasDictionary(0x1a2b3c4e));
+}
+
 TEST(DebugStringBuilderTest, AddOne) {
   metadata_detail::DebugStringBuilder b;
   b.Add("a", "b");
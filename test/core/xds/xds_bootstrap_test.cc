@@ -133,6 +133,7 @@ TEST(XdsBootstrapTest, Basic) {
       "    \"ignore\": \"whee\""
       "  },"
       "  \"server_listener_resource_name_template\": \"example/resource\","
+      "  \"resource_cache_dir\": \"/var/cache/xds\","
       "  \"ignore\": {}"
       "}";
   auto bootstrap_or = GrpcXdsBootstrap::Create(json_str);
@@ -191,6 +192,7 @@ TEST(XdsBootstrapTest, Basic) {
                           ::testing::Property(&Json::string_value, "1")))));
   EXPECT_EQ(bootstrap->server_listener_resource_name_template(),
             "example/resource");
+  EXPECT_EQ(bootstrap->resource_cache_dir(), "/var/cache/xds");
   UnsetEnv("GRPC_EXPERIMENTAL_XDS_FEDERATION");
 }
 
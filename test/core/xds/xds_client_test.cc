@@ -21,6 +21,7 @@
 #include "src/core/ext/xds/xds_client.h"
 
 #include <stdint.h>
+#include <stdio.h>
 
 #include <algorithm>
 #include <deque>
@@ -32,6 +33,7 @@
 #include <google/protobuf/struct.pb.h>
 
 #include "absl/strings/str_cat.h"
+#include "absl/time/clock.h"
 #include "absl/time/time.h"
 #include "absl/types/optional.h"
 #include "absl/types/variant.h"
@@ -43,6 +45,7 @@
 #include <grpcpp/impl/codegen/config_protobuf.h>
 
 #include "src/core/ext/xds/xds_bootstrap.h"
+#include "src/core/ext/xds/xds_resource_cache.h"
 #include "src/core/ext/xds/xds_resource_type_impl.h"
 #include "src/core/lib/event_engine/default_event_engine.h"
 #include "src/core/lib/gprpp/debug_location.h"
@@ -61,6 +64,8 @@
 // IWYU pragma: no_include <google/protobuf/unknown_field_set.h>
 // IWYU pragma: no_include <google/protobuf/util/json_util.h>
 
+using envoy::service::discovery::v3::DeltaDiscoveryRequest;
+using envoy::service::discovery::v3::DeltaDiscoveryResponse;
 using envoy::service::discovery::v3::DiscoveryRequest;
 using envoy::service::discovery::v3::DiscoveryResponse;
 
@@ -119,10 +124,12 @@ class XdsClientTest : public ::testing::Test {
       bool IgnoreResourceDeletion() const override {
         return ignore_resource_deletion_;
       }
+      bool UseDeltaProtocol() const override { return use_delta_protocol_; }
       bool Equals(const XdsServer& other) const override {
         const auto& o = static_cast<const FakeXdsServer&>(other);
         return server_uri_ == o.server_uri_ &&
-               ignore_resource_deletion_ == o.ignore_resource_deletion_;
+               ignore_resource_deletion_ == o.ignore_resource_deletion_ &&
+               use_delta_protocol_ == o.use_delta_protocol_;
       }
 
       void set_server_uri(std::string server_uri) {
@@ -131,10 +138,14 @@ class XdsClientTest : public ::testing::Test {
       void set_ignore_resource_deletion(bool ignore_resource_deletion) {
         ignore_resource_deletion_ = ignore_resource_deletion;
       }
+      void set_use_delta_protocol(bool use_delta_protocol) {
+        use_delta_protocol_ = use_delta_protocol;
+      }
 
      private:
       std::string server_uri_ = "default_xds_server";
       bool ignore_resource_deletion_ = false;
+      bool use_delta_protocol_ = false;
     };
 
     class FakeAuthority : public Authority {
@@ -168,11 +179,20 @@ class XdsClientTest : public ::testing::Test {
         server_.set_ignore_resource_deletion(ignore_resource_deletion);
         return *this;
       }
+      Builder& set_use_delta_protocol(bool use_delta_protocol) {
+        server_.set_use_delta_protocol(use_delta_protocol);
+        return *this;
+      }
+      Builder& set_resource_cache_dir(std::string resource_cache_dir) {
+        resource_cache_dir_ = std::move(resource_cache_dir);
+        return *this;
+      }
       std::unique_ptr<XdsBootstrap> Build() {
         auto bootstrap = std::make_unique<FakeXdsBootstrap>();
         bootstrap->server_ = std::move(server_);
         bootstrap->node_ = std::move(node_);
         bootstrap->authorities_ = std::move(authorities_);
+        bootstrap->resource_cache_dir_ = std::move(resource_cache_dir_);
         return bootstrap;
       }
 
@@ -180,6 +200,7 @@ class XdsClientTest : public ::testing::Test {
       FakeXdsServer server_;
       absl::optional<FakeNode> node_;
       std::map<std::string, FakeAuthority> authorities_;
+      std::string resource_cache_dir_;
     };
 
     std::string ToString() const override { return "<fake>"; }
@@ -205,11 +226,15 @@ class XdsClientTest : public ::testing::Test {
       }
       return nullptr;
     }
+    const std::string& resource_cache_dir() const override {
+      return resource_cache_dir_;
+    }
 
    private:
     FakeXdsServer server_;
     absl::optional<FakeNode> node_;
     std::map<std::string, FakeAuthority> authorities_;
+    std::string resource_cache_dir_;
   };
 
   // A template for a test xDS resource type with an associated watcher impl.
@@ -547,6 +572,60 @@ class XdsClientTest : public ::testing::Test {
     DiscoveryResponse response_;
   };
 
+  // A helper class to build and serialize a DeltaDiscoveryResponse.
+  class DeltaResponseBuilder {
+   public:
+    explicit DeltaResponseBuilder(absl::string_view type_url) {
+      response_.set_type_url(absl::StrCat("type.googleapis.com/", type_url));
+    }
+
+    DeltaResponseBuilder& set_system_version_info(
+        absl::string_view system_version_info) {
+      response_.set_system_version_info(std::string(system_version_info));
+      return *this;
+    }
+    DeltaResponseBuilder& set_nonce(absl::string_view nonce) {
+      response_.set_nonce(std::string(nonce));
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddFooResource(const XdsFooResource& resource,
+                                         absl::string_view version) {
+      auto* res = response_.add_resources();
+      res->set_name(resource.name);
+      res->set_version(std::string(version));
+      *res->mutable_resource() = XdsFooResourceType::EncodeAsAny(resource);
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddInvalidResource(absl::string_view type_url,
+                                             absl::string_view name,
+                                             absl::string_view version,
+                                             absl::string_view value) {
+      auto* res = response_.add_resources();
+      res->set_name(std::string(name));
+      res->set_version(std::string(version));
+      res->mutable_resource()->set_type_url(
+          absl::StrCat("type.googleapis.com/", type_url));
+      res->mutable_resource()->set_value(std::string(value));
+      return *this;
+    }
+
+    DeltaResponseBuilder& AddRemovedResource(absl::string_view name) {
+      response_.add_removed_resources(std::string(name));
+      return *this;
+    }
+
+    std::string Serialize() {
+      std::string serialized_response;
+      EXPECT_TRUE(response_.SerializeToString(&serialized_response));
+      return serialized_response;
+    }
+
+   private:
+    DeltaDiscoveryResponse response_;
+  };
+
   class ScopedExperimentalEnvVar {
    public:
     explicit ScopedExperimentalEnvVar(const char* env_var) : env_var_(env_var) {
@@ -572,6 +651,33 @@ class XdsClientTest : public ::testing::Test {
         "foo version", resource_request_timeout * grpc_test_slowdown_factor());
   }
 
+  // Returns the resource cache that a client with the default bootstrap
+  // config uses in cache_dir.
+  static std::unique_ptr<XdsResourceCache> ResourceCache(
+      const std::string& cache_dir) {
+    return std::make_unique<XdsResourceCache>(
+        *FakeXdsBootstrap::Builder().set_resource_cache_dir(cache_dir).Build());
+  }
+
+  // Waits for the resource cache file in cache_dir to hold exactly one
+  // resource with the specified version, and returns its contents.  The
+  // client writes the file asynchronously, so it may lag behind the
+  // resources that have been delivered to watchers.
+  static absl::StatusOr<XdsResourceCache::EntryMap> WaitForCachedResource(
+      const std::string& cache_dir, absl::string_view version) {
+    const absl::Time deadline =
+        absl::Now() + absl::Seconds(5 * grpc_test_slowdown_factor());
+    while (true) {
+      auto entries = ResourceCache(cache_dir)->Load();
+      if ((entries.ok() && entries->size() == 1 &&
+           entries->begin()->second.version == version) ||
+          absl::Now() > deadline) {
+        return entries;
+      }
+      absl::SleepFor(absl::Milliseconds(10));
+    }
+  }
+
   // Starts and cancels a watch for a Foo resource.
   RefCountedPtr<XdsFooResourceType::Watcher> StartFooWatch(
       absl::string_view resource_name) {
@@ -638,6 +744,14 @@ class XdsClientTest : public ::testing::Test {
     return WaitForAdsStream(xds_client_->bootstrap().server(), timeout);
   }
 
+  RefCountedPtr<FakeXdsTransportFactory::FakeStreamingCall>
+  WaitForDeltaAdsStream(absl::Duration timeout = absl::Seconds(5)) {
+    return transport_factory_->WaitForStream(
+        xds_client_->bootstrap().server(),
+        FakeXdsTransportFactory::kDeltaAdsMethod,
+        timeout * grpc_test_slowdown_factor());
+  }
+
   // Gets the latest request sent to the fake xDS server.
   absl::optional<DiscoveryRequest> WaitForRequest(
       FakeXdsTransportFactory::FakeStreamingCall* stream,
@@ -654,6 +768,53 @@ class XdsClientTest : public ::testing::Test {
     return std::move(request);
   }
 
+  // Gets the latest request sent to the fake delta xDS server.
+  absl::optional<DeltaDiscoveryRequest> WaitForDeltaRequest(
+      FakeXdsTransportFactory::FakeStreamingCall* stream,
+      absl::Duration timeout = absl::Seconds(3),
+      SourceLocation location = SourceLocation()) {
+    auto message =
+        stream->WaitForMessageFromClient(timeout * grpc_test_slowdown_factor());
+    if (!message.has_value()) return absl::nullopt;
+    DeltaDiscoveryRequest request;
+    bool success = request.ParseFromString(*message);
+    EXPECT_TRUE(success) << "Failed to deserialize DeltaDiscoveryRequest at "
+                         << location.file() << ":" << location.line();
+    if (!success) return absl::nullopt;
+    return std::move(request);
+  }
+
+  // Helper function to check the fields of a DeltaDiscoveryRequest.
+  void CheckDeltaRequest(
+      const DeltaDiscoveryRequest& request, absl::string_view type_url,
+      absl::string_view response_nonce, absl::Status error_detail,
+      std::set<absl::string_view> resource_names_subscribe,
+      std::set<absl::string_view> resource_names_unsubscribe,
+      SourceLocation location = SourceLocation()) {
+    EXPECT_EQ(request.type_url(),
+              absl::StrCat("type.googleapis.com/", type_url))
+        << location.file() << ":" << location.line();
+    EXPECT_EQ(request.response_nonce(), response_nonce)
+        << location.file() << ":" << location.line();
+    if (error_detail.ok()) {
+      EXPECT_FALSE(request.has_error_detail())
+          << location.file() << ":" << location.line();
+    } else {
+      EXPECT_EQ(request.error_detail().code(),
+                static_cast<int>(error_detail.code()))
+          << location.file() << ":" << location.line();
+      EXPECT_EQ(request.error_detail().message(), error_detail.message())
+          << location.file() << ":" << location.line();
+    }
+    EXPECT_THAT(request.resource_names_subscribe(),
+                ::testing::UnorderedElementsAreArray(resource_names_subscribe))
+        << location.file() << ":" << location.line();
+    EXPECT_THAT(
+        request.resource_names_unsubscribe(),
+        ::testing::UnorderedElementsAreArray(resource_names_unsubscribe))
+        << location.file() << ":" << location.line();
+  }
+
   // Helper function to check the fields of a DiscoveryRequest.
   void CheckRequest(const DiscoveryRequest& request, absl::string_view type_url,
                     absl::string_view version_info,
@@ -683,8 +844,10 @@ class XdsClientTest : public ::testing::Test {
   }
 
   // Helper function to check the contents of the node message in a
-  // request against the client's node info.
-  void CheckRequestNode(const DiscoveryRequest& request,
+  // request against the client's node info.  Works for both
+  // DiscoveryRequest and DeltaDiscoveryRequest.
+  template <typename Request>
+  void CheckRequestNode(const Request& request,
                         SourceLocation location = SourceLocation()) {
     // These fields come from the bootstrap config.
     EXPECT_EQ(request.node().id(), xds_client_->bootstrap().node()->id())
@@ -2801,6 +2964,408 @@ TEST_F(XdsClientTest, FederationChannelFailureReportedToWatchers) {
   }
 }
 
+TEST_F(XdsClientTest, DeltaBasicWatch) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  // XdsClient should have created a delta ADS stream.
+  auto stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  // XdsClient should have sent a subscription request on the stream.
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo1"},
+                    /*resource_names_unsubscribe=*/{});
+  CheckRequestNode(*request);  // Should be present on the first request.
+  EXPECT_TRUE(request->initial_resource_versions().empty());
+  // Send a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  // XdsClient should have delivered the response to the watcher.
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 6);
+  // XdsClient should ACK without repeating the subscription.
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"A", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  EXPECT_FALSE(request->has_node());
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+  // The XdsClient may or may not send an unsubscription message
+  // before it closes the transport, depending on callback timing.
+  request = WaitForDeltaRequest(stream.get());
+  if (request.has_value()) {
+    CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                      /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                      /*resource_names_subscribe=*/{},
+                      /*resource_names_unsubscribe=*/{"foo1"});
+  }
+}
+
+TEST_F(XdsClientTest, DeltaSubscriptionChangesAreIncremental) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo1"},
+                    /*resource_names_unsubscribe=*/{});
+  // Start a watch for "foo2".  Only the new name should be sent.
+  auto watcher2 = StartFooWatch("foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo2"},
+                    /*resource_names_unsubscribe=*/{});
+  // Server sends only foo2.  Unlike in SotW, this says nothing about foo1.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo2", 7), "v1")
+          .Serialize());
+  auto resource = watcher2->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo2");
+  EXPECT_EQ(resource->value, 7);
+  EXPECT_FALSE(watcher->HasEvent());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"A", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // Cancel the watch for "foo2".  Only that name should be unsubscribed.
+  CancelFooWatch(watcher2.get(), "foo2");
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{"foo2"});
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+  // The XdsClient may or may not send an unsubscription message
+  // before it closes the transport, depending on callback timing.
+  request = WaitForDeltaRequest(stream.get());
+  if (request.has_value()) {
+    CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                      /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                      /*resource_names_subscribe=*/{},
+                      /*resource_names_unsubscribe=*/{"foo1"});
+  }
+}
+
+TEST_F(XdsClientTest, DeltaResourceRemoval) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Send a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server removes the resource.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("B")
+          .AddRemovedResource("foo1")
+          .Serialize());
+  EXPECT_TRUE(watcher->WaitForDoesNotExist(absl::Seconds(1)));
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, DeltaResourceRemovalIgnoredWhenConfigured) {
+  InitXdsClient(FakeXdsBootstrap::Builder()
+                    .set_use_delta_protocol(true)
+                    .set_ignore_resource_deletion(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Send a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server removes the resource.  The watcher should not be notified.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("B")
+          .AddRemovedResource("foo1")
+          .Serialize());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  EXPECT_TRUE(watcher->ExpectNoEvent(absl::Seconds(1)));
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, DeltaStreamRestartSendsInitialResourceVersions) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Send a response.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6), "v1")
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Server sends the same resource with a new version.  The watcher is
+  // not notified, but the cached version is updated.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource("foo1", 6), "v2")
+          .Serialize());
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"B", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{},
+                    /*resource_names_unsubscribe=*/{});
+  EXPECT_FALSE(watcher->HasEvent());
+  // Server terminates the stream.
+  stream->MaybeSendStatusToClient(absl::OkStatus());
+  // XdsClient should create a new stream and resubscribe, telling the
+  // server which version it already has.
+  stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(*request, XdsFooResourceType::Get()->type_url(),
+                    /*response_nonce=*/"", /*error_detail=*/absl::OkStatus(),
+                    /*resource_names_subscribe=*/{"foo1"},
+                    /*resource_names_unsubscribe=*/{});
+  CheckRequestNode(*request);
+  EXPECT_THAT(request->initial_resource_versions(),
+              ::testing::UnorderedElementsAre(::testing::Pair("foo1", "v2")));
+  // The server does not need to resend the resource, and the client
+  // should not consider it missing.
+  EXPECT_TRUE(watcher->ExpectNoEvent(absl::Seconds(1)));
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, DeltaResourceValidationFailure) {
+  InitXdsClient(FakeXdsBootstrap::Builder().set_use_delta_protocol(true));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForDeltaAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Send a response containing an invalid resource.
+  stream->SendMessageToClient(
+      DeltaResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_nonce("A")
+          .AddInvalidResource(XdsFooResourceType::Get()->type_url(), "foo1",
+                              "v1", "{\"name\":\"foo1\",\"value\":[]}")
+          .Serialize());
+  // XdsClient should deliver an error to the watcher.
+  auto error = watcher->WaitForNextError();
+  ASSERT_TRUE(error.has_value());
+  EXPECT_EQ(error->code(), absl::StatusCode::kUnavailable);
+  // XdsClient should NACK the update.
+  request = WaitForDeltaRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckDeltaRequest(
+      *request, XdsFooResourceType::Get()->type_url(),
+      /*response_nonce=*/"A",
+      /*error_detail=*/
+      absl::InvalidArgumentError(
+          "xDS response validation errors: ["
+          "resource index 0: foo1: INVALID_ARGUMENT: errors validating JSON: "
+          "[field:value error:is not a number]]"),
+      /*resource_names_subscribe=*/{}, /*resource_names_unsubscribe=*/{});
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, ResourceCacheServesLastKnownGoodConfigOnStartup) {
+  const std::string cache_dir = ::testing::TempDir();
+  remove(ResourceCache(cache_dir)->path().c_str());
+  InitXdsClient(FakeXdsBootstrap::Builder().set_resource_cache_dir(cache_dir));
+  // Start a watch for "foo1".
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // Send a response.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6))
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // The resource should be written to the cache.
+  auto entries = WaitForCachedResource(cache_dir, "1");
+  ASSERT_TRUE(entries.ok()) << entries.status();
+  ASSERT_EQ(entries->size(), 1);
+  EXPECT_EQ(entries->begin()->first.first,
+            XdsFooResourceType::Get()->type_url());
+  EXPECT_EQ(entries->begin()->first.second, "foo1");
+  EXPECT_EQ(entries->begin()->second.version, "1");
+  EXPECT_EQ(entries->begin()->second.serialized_resource,
+            XdsFooResource("foo1", 6).AsJsonString());
+  // Simulate a restart.
+  CancelFooWatch(watcher.get(), "foo1");
+  stream.reset();
+  xds_client_.reset();
+  InitXdsClient(FakeXdsBootstrap::Builder().set_resource_cache_dir(cache_dir));
+  // The new watcher should get the cached resource before the server
+  // has responded.
+  watcher = StartFooWatch("foo1");
+  resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->name, "foo1");
+  EXPECT_EQ(resource->value, 6);
+  stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"", /*response_nonce=*/"",
+               /*error_detail=*/absl::OkStatus(),
+               /*resource_names=*/{"foo1"});
+  // The server sends the same resource, which the watcher has already
+  // seen.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6))
+          .Serialize());
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  CheckRequest(*request, XdsFooResourceType::Get()->type_url(),
+               /*version_info=*/"1", /*response_nonce=*/"A",
+               /*error_detail=*/absl::OkStatus(),
+               /*resource_names=*/{"foo1"});
+  EXPECT_FALSE(watcher->HasEvent());
+  // The server then sends an update, which is delivered and cached.
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("2")
+          .set_nonce("B")
+          .AddFooResource(XdsFooResource("foo1", 9))
+          .Serialize());
+  resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 9);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  entries = WaitForCachedResource(cache_dir, "2");
+  ASSERT_TRUE(entries.ok()) << entries.status();
+  ASSERT_EQ(entries->size(), 1);
+  EXPECT_EQ(entries->begin()->second.version, "2");
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+}
+
+TEST_F(XdsClientTest, ResourceCacheIgnoresCorruptFile) {
+  const std::string cache_dir = ::testing::TempDir();
+  const std::string cache_path = ResourceCache(cache_dir)->path();
+  FILE* file = fopen(cache_path.c_str(), "wb");
+  ASSERT_NE(file, nullptr);
+  fputs("not a cache file", file);
+  fclose(file);
+  InitXdsClient(FakeXdsBootstrap::Builder().set_resource_cache_dir(cache_dir));
+  // Start a watch for "foo1".  Nothing is delivered until the server
+  // responds.
+  auto watcher = StartFooWatch("foo1");
+  auto stream = WaitForAdsStream();
+  ASSERT_TRUE(stream != nullptr);
+  auto request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  EXPECT_FALSE(watcher->HasEvent());
+  stream->SendMessageToClient(
+      ResponseBuilder(XdsFooResourceType::Get()->type_url())
+          .set_version_info("1")
+          .set_nonce("A")
+          .AddFooResource(XdsFooResource("foo1", 6))
+          .Serialize());
+  auto resource = watcher->WaitForNextResource();
+  ASSERT_TRUE(resource.has_value());
+  EXPECT_EQ(resource->value, 6);
+  request = WaitForRequest(stream.get());
+  ASSERT_TRUE(request.has_value());
+  // The corrupt file should be replaced.
+  auto entries = WaitForCachedResource(cache_dir, "1");
+  ASSERT_TRUE(entries.ok()) << entries.status();
+  EXPECT_EQ(entries->size(), 1);
+  // Cancel watch.
+  CancelFooWatch(watcher.get(), "foo1");
+  remove(cache_path.c_str());
+}
+
+TEST_F(XdsClientTest, ResourceCacheFileIsKeyedByNodeAndServer) {
+  const std::string cache_dir = ::testing::TempDir();
+  const std::string path =
+      XdsResourceCache(cache_dir, "node", "server").path();
+  EXPECT_EQ(XdsResourceCache(cache_dir, "node", "server").path(), path);
+  EXPECT_NE(XdsResourceCache(cache_dir, "other_node", "server").path(), path);
+  EXPECT_NE(XdsResourceCache(cache_dir, "node", "other_server").path(), path);
+  // The two parts are kept apart, not just concatenated.
+  EXPECT_NE(XdsResourceCache(cache_dir, "nodes", "erver").path(), path);
+}
+
 }  // namespace
 }  // namespace testing
 }  // namespace grpc_core
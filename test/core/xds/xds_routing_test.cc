@@ -0,0 +1,242 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/core/ext/xds/xds_routing.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "gtest/gtest.h"
+
+#include <grpc/grpc.h>
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/memory_quota.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc_core {
+namespace testing {
+namespace {
+
+using Matchers = XdsRouteConfigResource::Route::Matchers;
+
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  RouteList& Add(StringMatcher::Type type, absl::string_view path,
+                 bool case_sensitive = true) {
+    Matchers matchers;
+    matchers.path_matcher =
+        StringMatcher::Create(type, path, case_sensitive).value();
+    routes_.push_back(std::move(matchers));
+    return *this;
+  }
+
+  // Adds a header matcher to the last route.
+  RouteList& WithHeader(absl::string_view name, HeaderMatcher::Type type,
+                        absl::string_view value) {
+    routes_.back().header_matchers.push_back(
+        HeaderMatcher::Create(name, type, value).value());
+    return *this;
+  }
+
+  // Sets the runtime fraction of the last route.
+  RouteList& WithFraction(uint32_t fraction_per_million) {
+    routes_.back().fraction_per_million = fraction_per_million;
+    return *this;
+  }
+
+  size_t Size() const override { return routes_.size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return routes_[index];
+  }
+
+ private:
+  std::vector<Matchers> routes_;
+};
+
+class XdsRoutingTest : public ::testing::Test {
+ protected:
+  XdsRoutingTest()
+      : memory_allocator_(ResourceQuota::Default()
+                              ->memory_quota()
+                              ->CreateMemoryAllocator("xds_routing_test")),
+        arena_(MakeScopedArena(1024, &memory_allocator_)) {}
+
+  // Returns the route selected for a request by the linear scan, after
+  // checking that the index selects the same one.
+  absl::optional<size_t> GetRoute(
+      const RouteList& routes, absl::string_view path,
+      std::vector<std::pair<std::string, std::string>> headers = {}) {
+    ExecCtx exec_ctx;
+    grpc_metadata_batch initial_metadata(arena_.get());
+    for (const auto& header : headers) {
+      initial_metadata.Append(
+          header.first, Slice::FromCopiedString(header.second),
+          [](absl::string_view error, const Slice&) { FAIL() << error; });
+    }
+    XdsRouting::RouteIndex route_index(routes);
+    auto linear =
+        XdsRouting::GetRouteForRequest(routes, path, &initial_metadata);
+    auto indexed = XdsRouting::GetRouteForRequest(routes, route_index, path,
+                                                  &initial_metadata);
+    EXPECT_EQ(indexed, linear) << "path: " << path;
+    return linear;
+  }
+
+ private:
+  MemoryAllocator memory_allocator_;
+  ScopedArenaPtr arena_;
+};
+
+TEST_F(XdsRoutingTest, ExactPrefixAndRegexPaths) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kExact, "/svc/Get")
+      .Add(StringMatcher::Type::kPrefix, "/svc/")
+      .Add(StringMatcher::Type::kSafeRegex, "/other/(List|Watch)")
+      .Add(StringMatcher::Type::kPrefix, "/other/");
+  EXPECT_EQ(GetRoute(routes, "/svc/Get"), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/GetMore"), 1);
+  EXPECT_EQ(GetRoute(routes, "/svc/"), 1);
+  EXPECT_EQ(GetRoute(routes, "/other/List"), 2);
+  EXPECT_EQ(GetRoute(routes, "/other/Watch"), 2);
+  // Regexes must match the whole path.
+  EXPECT_EQ(GetRoute(routes, "/other/ListAll"), 3);
+  EXPECT_EQ(GetRoute(routes, "/x/other/List"), absl::nullopt);
+  EXPECT_EQ(GetRoute(routes, "/sv"), absl::nullopt);
+  EXPECT_EQ(GetRoute(routes, ""), absl::nullopt);
+}
+
+TEST_F(XdsRoutingTest, CaseInsensitivePaths) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kExact, "/Svc/Get", false)
+      .Add(StringMatcher::Type::kPrefix, "/svc/list", true)
+      .Add(StringMatcher::Type::kPrefix, "/SVC/L", false)
+      .Add(StringMatcher::Type::kExact, "/svc/put", true)
+      .Add(StringMatcher::Type::kPrefix, "/OTHER/", false);
+  EXPECT_EQ(GetRoute(routes, "/svc/get"), 0);
+  EXPECT_EQ(GetRoute(routes, "/SVC/GET"), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/list"), 1);
+  EXPECT_EQ(GetRoute(routes, "/svc/List"), 2);
+  EXPECT_EQ(GetRoute(routes, "/sVc/lIsT"), 2);
+  EXPECT_EQ(GetRoute(routes, "/svc/put"), 3);
+  EXPECT_EQ(GetRoute(routes, "/svc/Put"), absl::nullopt);
+  EXPECT_EQ(GetRoute(routes, "/other/Anything"), 4);
+}
+
+TEST_F(XdsRoutingTest, HeaderAndFractionMatchersFallThrough) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kPrefix, "/svc/")
+      .WithHeader("x-canary", HeaderMatcher::Type::kExact, "true")
+      .Add(StringMatcher::Type::kPrefix, "/svc/")
+      .WithFraction(0)
+      .Add(StringMatcher::Type::kExact, "/svc/Get")
+      .WithHeader("x-user", HeaderMatcher::Type::kSafeRegex, "admin-[0-9]+")
+      .Add(StringMatcher::Type::kSafeRegex, "/svc/.*")
+      .WithFraction(1000000)
+      .Add(StringMatcher::Type::kPrefix, "");
+  EXPECT_EQ(GetRoute(routes, "/svc/Get", {{"x-canary", "true"}}), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/Get", {{"x-user", "admin-1"}}), 2);
+  EXPECT_EQ(GetRoute(routes, "/svc/Get", {{"x-user", "alice"}}), 3);
+  EXPECT_EQ(GetRoute(routes, "/svc/Get"), 3);
+  EXPECT_EQ(GetRoute(routes, "/other/Get", {{"x-canary", "true"}}), 4);
+}
+
+TEST_F(XdsRoutingTest, FirstMatchWins) {
+  RouteList routes;
+  routes.Add(StringMatcher::Type::kSafeRegex, "/svc/G.*")
+      .Add(StringMatcher::Type::kExact, "/svc/Get")
+      .Add(StringMatcher::Type::kPrefix, "/svc/")
+      .Add(StringMatcher::Type::kExact, "/svc/Put")
+      .Add(StringMatcher::Type::kPrefix, "/svc/", false)
+      .Add(StringMatcher::Type::kPrefix, "/");
+  EXPECT_EQ(GetRoute(routes, "/svc/Get"), 0);
+  EXPECT_EQ(GetRoute(routes, "/svc/Put"), 2);
+  EXPECT_EQ(GetRoute(routes, "/SVC/Put"), 4);
+  EXPECT_EQ(GetRoute(routes, "/x"), 5);
+}
+
+// Compares the index with the linear scan on random route lists and
+// paths drawn from a small alphabet, so that matchers overlap a lot.
+TEST_F(XdsRoutingTest, RandomRouteListsMatchLinearScan) {
+  std::mt19937 rng(1234);
+  auto random_string = [&](size_t max_length) {
+    static constexpr absl::string_view kChars = "/abAB";
+    std::string s;
+    size_t length = std::uniform_int_distribution<size_t>(0, max_length)(rng);
+    for (size_t i = 0; i < length; ++i) {
+      s.push_back(kChars[std::uniform_int_distribution<size_t>(
+          0, kChars.size() - 1)(rng)]);
+    }
+    return s;
+  };
+  for (int iteration = 0; iteration < 50; ++iteration) {
+    RouteList routes;
+    const int num_routes = std::uniform_int_distribution<int>(1, 30)(rng);
+    for (int i = 0; i < num_routes; ++i) {
+      const bool case_sensitive = rng() % 2 == 0;
+      switch (rng() % 3) {
+        case 0:
+          routes.Add(StringMatcher::Type::kExact, random_string(4),
+                     case_sensitive);
+          break;
+        case 1:
+          routes.Add(StringMatcher::Type::kPrefix, random_string(3),
+                     case_sensitive);
+          break;
+        default:
+          routes.Add(StringMatcher::Type::kSafeRegex,
+                     absl::StrCat(random_string(2), ".*"));
+      }
+      if (rng() % 4 == 0) {
+        routes.WithHeader("x-flag", HeaderMatcher::Type::kExact, "on");
+      }
+      if (rng() % 8 == 0) routes.WithFraction(0);
+    }
+    for (int i = 0; i < 20; ++i) {
+      const std::string path = random_string(5);
+      GetRoute(routes, path);
+      GetRoute(routes, path, {{"x-flag", "on"}});
+    }
+  }
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc_core
+
+int main(int argc, char** argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
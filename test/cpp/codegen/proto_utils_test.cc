@@ -16,6 +16,10 @@
  *
  */
 
+#include <string.h>
+
+#include <string>
+
 #include <gtest/gtest.h>
 
 #include <grpc/byte_buffer.h>
@@ -88,6 +92,32 @@ TEST_F(ProtoUtilsTest, TinyBackupThenNext) {
   EXPECT_EQ(block_size, size);
 }
 
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+TEST_F(ProtoUtilsTest, ReadCordSharesLargeSlices) {
+  grpc_slice big = grpc_slice_malloc(4096);
+  memset(GRPC_SLICE_START_PTR(big), 'a', 4096);
+  Slice slices[] = {Slice(big, Slice::STEAL_REF), Slice("bcd", 3)};
+  ByteBuffer bb(slices, 2);
+  absl::Cord cord;
+  {
+    ProtoBufferReader reader(&bb);
+    const void* data;
+    int size;
+    ASSERT_TRUE(reader.Next(&data, &size));
+    reader.BackUp(size - 1);
+    ASSERT_TRUE(reader.ReadCord(&cord, 4097));
+    EXPECT_EQ(reader.ByteCount(), 4098);
+    EXPECT_FALSE(reader.ReadCord(&cord, 2));
+  }
+  bb.Clear();
+  // The first 4095 bytes still point into the received slice, which the cord
+  // keeps alive; the tail was copied.
+  EXPECT_EQ(cord.chunk_begin()->data(),
+            reinterpret_cast<const char*>(slices[0].begin()) + 1);
+  EXPECT_EQ(std::string(cord), std::string(4095, 'a') + "bc" + "d");
+}
+#endif
+
 namespace {
 
 // Set backup_size to 0 to indicate no backup is needed.
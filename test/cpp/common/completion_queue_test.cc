@@ -0,0 +1,148 @@
+//
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+
+#include <stddef.h>
+
+#include "absl/status/status.h"
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/log.h>
+#include <grpcpp/completion_queue.h>
+#include <grpcpp/impl/completion_queue_tag.h>
+
+#include "src/core/lib/gpr/useful.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/surface/completion_queue.h"
+#include "test/core/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+namespace {
+
+class TestTag : public internal::CompletionQueueTag {
+ public:
+  explicit TestTag(bool finalize = true) : finalize_(finalize) {}
+
+  bool FinalizeResult(void** /*tag*/, bool* /*status*/) override {
+    return finalize_;
+  }
+
+ private:
+  const bool finalize_;
+};
+
+class CompletionQueueTest : public ::testing::Test {
+ protected:
+  // Queues a completion for tag, with the given result.
+  void Post(TestTag* tag, bool ok = true) {
+    grpc_core::ExecCtx exec_ctx;
+    GPR_ASSERT(num_completions_ < GPR_ARRAY_SIZE(completions_));
+    GPR_ASSERT(grpc_cq_begin_op(cq_.cq(), tag));
+    grpc_cq_end_op(
+        cq_.cq(), tag, ok ? absl::OkStatus() : absl::CancelledError(),
+        [](void* /*done_arg*/, grpc_cq_completion* /*storage*/) {}, nullptr,
+        &completions_[num_completions_++]);
+  }
+
+  CompletionQueue cq_;
+
+ private:
+  // Storage for the queued completions, which must outlive them.
+  grpc_cq_completion completions_[8];
+  size_t num_completions_ = 0;
+};
+
+TEST_F(CompletionQueueTest, NextBatchReturnsQueuedEventsTogether) {
+  TestTag tags[3];
+  Post(&tags[0]);
+  Post(&tags[1], /*ok=*/false);
+  Post(&tags[2]);
+  void* got_tags[8];
+  bool oks[8];
+  ASSERT_EQ(cq_.NextBatch(got_tags, oks, 8), 3u);
+  for (size_t i = 0; i < 3; i++) EXPECT_EQ(got_tags[i], &tags[i]);
+  EXPECT_TRUE(oks[0]);
+  EXPECT_FALSE(oks[1]);
+  EXPECT_TRUE(oks[2]);
+}
+
+TEST_F(CompletionQueueTest, NextBatchReturnsAtMostMaxEvents) {
+  TestTag tags[5];
+  for (TestTag& tag : tags) Post(&tag);
+  void* got_tags[5];
+  bool oks[5];
+  ASSERT_EQ(cq_.NextBatch(got_tags, oks, 2), 2u);
+  EXPECT_EQ(got_tags[0], &tags[0]);
+  EXPECT_EQ(got_tags[1], &tags[1]);
+  ASSERT_EQ(cq_.NextBatch(got_tags, oks, 5), 3u);
+  for (size_t i = 0; i < 3; i++) EXPECT_EQ(got_tags[i], &tags[i + 2]);
+}
+
+TEST_F(CompletionQueueTest, NextBatchSkipsEventsThatAreNotFinalized) {
+  TestTag hidden_tags[2] = {TestTag(false), TestTag(false)};
+  TestTag tags[2];
+  Post(&hidden_tags[0]);
+  Post(&tags[0]);
+  Post(&hidden_tags[1]);
+  Post(&tags[1]);
+  void* got_tags[4];
+  bool oks[4];
+  ASSERT_EQ(cq_.NextBatch(got_tags, oks, 4), 2u);
+  EXPECT_EQ(got_tags[0], &tags[0]);
+  EXPECT_EQ(got_tags[1], &tags[1]);
+}
+
+TEST_F(CompletionQueueTest, NextBatchKeepsWaitingPastHiddenBatches) {
+  TestTag hidden_tag(false);
+  TestTag tag;
+  Post(&hidden_tag);
+  Post(&tag);
+  void* got_tags[1];
+  bool oks[1];
+  // The first core batch holds only the hidden tag.
+  ASSERT_EQ(cq_.NextBatch(got_tags, oks, 1), 1u);
+  EXPECT_EQ(got_tags[0], &tag);
+}
+
+TEST_F(CompletionQueueTest, NextBatchReturnsZeroAfterShutdown) {
+  TestTag tag;
+  Post(&tag);
+  cq_.Shutdown();
+  void* got_tags[2];
+  bool oks[2];
+  // Events queued before the shutdown are still returned.
+  ASSERT_EQ(cq_.NextBatch(got_tags, oks, 2), 1u);
+  EXPECT_EQ(got_tags[0], &tag);
+  EXPECT_EQ(cq_.NextBatch(got_tags, oks, 2), 0u);
+  EXPECT_EQ(cq_.NextBatch(got_tags, oks, 2), 0u);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  grpc_init();
+  int ret = RUN_ALL_TESTS();
+  grpc_shutdown();
+  return ret;
+}
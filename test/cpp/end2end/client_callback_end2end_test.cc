@@ -17,6 +17,8 @@
  */
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <mutex>
@@ -38,6 +40,7 @@
 #include <grpcpp/support/client_callback.h>
 
 #include "src/core/lib/gprpp/env.h"
+#include "src/core/lib/iomgr/executor.h"
 #include "src/core/lib/iomgr/iomgr.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/core/util/port.h"
@@ -100,6 +103,7 @@ class ClientCallbackEnd2endTest
       server_address_ << "localhost:" << picked_port_;
       builder.AddListeningPort(server_address_.str(), server_creds);
     }
+    ConfigureServices(&builder);
     if (!GetParam().callback_server) {
       builder.RegisterService(&service_);
     } else {
@@ -122,6 +126,9 @@ class ClientCallbackEnd2endTest
     is_server_started_ = true;
   }
 
+  // Called before the services are registered.  May register more of them.
+  virtual void ConfigureServices(ServerBuilder* /*builder*/) {}
+
   void ResetStub(
       std::unique_ptr<experimental::ClientInterceptorFactoryInterface>
           interceptor = nullptr) {
@@ -1521,6 +1528,120 @@ TEST_P(ClientCallbackEnd2endTest,
   EXPECT_EQ(client.status().error_code(), grpc::StatusCode::OK);
 }
 
+// Echoes after blocking for server_sleep_us, which handlers that run inline
+// must not do.
+class BlockingEchoService : public EchoTest1Service::CallbackService {
+ public:
+  ServerUnaryReactor* Echo(CallbackServerContext* context,
+                           const EchoRequest* request,
+                           EchoResponse* response) override {
+    if (grpc_core::Executor::IsExecutorThread()) {
+      ran_on_executor_thread_.store(true, std::memory_order_relaxed);
+    }
+    gpr_sleep_until(gpr_time_add(
+        gpr_now(GPR_CLOCK_MONOTONIC),
+        gpr_time_from_micros(request->param().server_sleep_us(),
+                             GPR_TIMESPAN)));
+    response->set_message(request->message());
+    auto* reactor = context->DefaultReactor();
+    reactor->Finish(Status::OK);
+    return reactor;
+  }
+
+  bool ran_on_executor_thread() const {
+    return ran_on_executor_thread_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<bool> ran_on_executor_thread_{false};
+};
+
+class InlineHandlerEnd2endTest : public ClientCallbackEnd2endTest {
+ protected:
+  void ConfigureServices(ServerBuilder* builder) override {
+    EXPECT_FALSE(callback_service_.SetMethodRunInline(
+        "NoSuchMethod", std::chrono::milliseconds(10)));
+    EXPECT_TRUE(callback_service_.SetMethodRunInline(
+        "Echo", std::chrono::milliseconds(10)));
+    EXPECT_TRUE(blocking_service_.SetMethodRunInline(
+        "Echo", std::chrono::milliseconds(1)));
+    builder->RegisterService(&blocking_service_);
+  }
+
+  // Sends a unary RPC to blocking_service_ and waits for it to finish.
+  void SendBlockingEcho(int server_sleep_us) {
+    auto stub = EchoTest1Service::NewStub(channel_);
+    EchoRequest request;
+    EchoResponse response;
+    ClientContext cli_ctx;
+    request.set_message("Hello inline");
+    request.mutable_param()->set_server_sleep_us(server_sleep_us);
+    std::mutex mu;
+    std::condition_variable cv;
+    bool done = false;
+    stub->async()->Echo(&cli_ctx, &request, &response,
+                        [&done, &mu, &cv](Status s) {
+                          EXPECT_TRUE(s.ok()) << s.error_message();
+                          std::lock_guard<std::mutex> l(mu);
+                          done = true;
+                          cv.notify_one();
+                        });
+    std::unique_lock<std::mutex> l(mu);
+    while (!done) {
+      cv.wait(l);
+    }
+    EXPECT_EQ(response.message(), request.message());
+  }
+
+  BlockingEchoService blocking_service_;
+};
+
+TEST_P(InlineHandlerEnd2endTest, SequentialRpcs) {
+  ResetStub();
+  SendRpcs(10, false);
+}
+
+TEST_P(InlineHandlerEnd2endTest, HandlerRunsOffTheExecutor) {
+  ResetStub();
+  for (int i = 0; i < 5; i++) SendBlockingEcho(0);
+  EXPECT_FALSE(blocking_service_.ran_on_executor_thread());
+  EXPECT_EQ(callback_service_.MethodInlineOverruns("NoSuchMethod"), 0u);
+}
+
+TEST_P(InlineHandlerEnd2endTest, HandlerOverBudgetIsCounted) {
+  ResetStub();
+  EXPECT_EQ(blocking_service_.MethodInlineOverruns("Echo"), 0u);
+  // Well over the 1ms budget, even on a slow machine.
+  SendBlockingEcho(20000);
+  EXPECT_GT(blocking_service_.MethodInlineOverruns("Echo"), 0u);
+  EXPECT_FALSE(blocking_service_.ran_on_executor_thread());
+}
+
+TEST_P(InlineHandlerEnd2endTest, SimpleRpcExpectedError) {
+  ResetStub();
+
+  EchoRequest request;
+  EchoResponse response;
+  ClientContext cli_ctx;
+  request.set_message("Hello failure");
+  request.mutable_param()->mutable_expected_error()->set_code(1);  // CANCELLED
+
+  std::mutex mu;
+  std::condition_variable cv;
+  bool done = false;
+  stub_->async()->Echo(&cli_ctx, &request, &response,
+                       [&done, &mu, &cv](Status s) {
+                         EXPECT_EQ(StatusCode::CANCELLED, s.error_code());
+                         std::lock_guard<std::mutex> l(mu);
+                         done = true;
+                         cv.notify_one();
+                       });
+  std::unique_lock<std::mutex> l(mu);
+  while (!done) {
+    cv.wait(l);
+  }
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
 #if TARGET_OS_IPHONE
   // Workaround Apple CFStream bug
@@ -1562,6 +1683,17 @@ std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
 
 INSTANTIATE_TEST_SUITE_P(ClientCallbackEnd2endTest, ClientCallbackEnd2endTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
+// Only callback servers run handlers inline.
+std::vector<TestScenario> CreateCallbackServerScenarios() {
+  std::vector<TestScenario> scenarios;
+  for (const TestScenario& scenario : CreateTestScenarios(true)) {
+    if (scenario.callback_server) scenarios.push_back(scenario);
+  }
+  return scenarios;
+}
+
+INSTANTIATE_TEST_SUITE_P(InlineHandlerEnd2endTest, InlineHandlerEnd2endTest,
+                         ::testing::ValuesIn(CreateCallbackServerScenarios()));
 
 }  // namespace
 }  // namespace testing
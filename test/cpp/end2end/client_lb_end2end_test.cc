@@ -399,6 +399,8 @@ class ClientLbEnd2endTest : public ::testing::Test {
     grpc_core::CondVar cond_;
     bool server_ready_ ABSL_GUARDED_BY(mu_) = false;
     bool started_ ABSL_GUARDED_BY(mu_) = false;
+    // Set before Start().
+    bool accept_deflate_stream_ = true;
 
     explicit ServerData(int port = 0)
         : port_(port > 0 ? port : grpc_pick_unused_port_or_die()),
@@ -427,6 +429,10 @@ class ClientLbEnd2endTest : public ::testing::Test {
       builder.AddListeningPort(server_address.str(), std::move(creds));
       builder.RegisterService(&service_);
       builder.RegisterService(&orca_service_);
+      if (!accept_deflate_stream_) {
+        builder.SetCompressionAlgorithmSupportStatus(
+            GRPC_COMPRESS_DEFLATE_STREAM, false);
+      }
       server_ = builder.BuildAndStart();
       grpc_core::MutexLock lock(&mu_);
       server_ready_ = true;
@@ -1509,6 +1515,28 @@ TEST_F(RoundRobinTest, ProcessPending) {
   CheckRpcSendOk(DEBUG_LOCATION, second_stub);
 }
 
+TEST_F(RoundRobinTest, DeflateStreamOnlySentToServersThatAcceptIt) {
+  // Only the first server accepts deflate-stream.  The second one fails
+  // any call that uses it with UNIMPLEMENTED.
+  CreateServers(2);
+  servers_[1]->accept_deflate_stream_ = false;
+  StartServer(0);
+  StartServer(1);
+  auto response_generator = BuildResolverResponseGenerator();
+  ChannelArguments args;
+  args.SetCompressionAlgorithm(GRPC_COMPRESS_DEFLATE_STREAM);
+  auto channel = BuildChannel("round_robin", response_generator, args);
+  auto stub = BuildStub(channel);
+  response_generator.SetNextResolution(GetServersPorts());
+  WaitForServers(DEBUG_LOCATION, stub);
+  // By now the client has seen grpc-accept-encoding from both servers.
+  // Only calls to the first server may use deflate-stream.
+  ResetCounters();
+  for (size_t i = 0; i < 20; ++i) CheckRpcSendOk(DEBUG_LOCATION, stub);
+  EXPECT_EQ(10, servers_[0]->service_.request_count());
+  EXPECT_EQ(10, servers_[1]->service_.request_count());
+}
+
 TEST_F(RoundRobinTest, Updates) {
   // Start servers.
   const int kNumServers = 3;
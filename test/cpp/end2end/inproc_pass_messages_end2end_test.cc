@@ -0,0 +1,291 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <grpc/grpc.h>
+#include <grpc/support/time.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/client_context.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/impl/client_unary_call.h>
+#include <grpcpp/impl/proto_utils.h>
+#include <grpcpp/impl/rpc_method.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/server_context.h>
+#include <grpcpp/support/client_callback.h>
+#include <grpcpp/support/byte_buffer.h>
+#include <grpcpp/support/channel_arguments.h>
+#include <grpcpp/support/slice.h>
+
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/test_config.h"
+
+// Tests for GRPC_ARG_INPROC_PASS_MESSAGES. Bytes that are not UTF-8 fail to
+// parse from a proto3 string field, so requests that hold them get through
+// only if they were passed as objects.
+
+namespace grpc {
+namespace testing {
+namespace {
+
+constexpr int kMaxReceiveMessageSize = 4096;
+
+EchoRequest LargeRequest(char c = 'a') {
+  EchoRequest request;
+  request.set_message(std::string(1024, c));
+  return request;
+}
+
+EchoRequest NotUtf8Request(size_t size = 1024) {
+  EchoRequest request;
+  request.set_message(std::string(size, '\xff'));
+  return request;
+}
+
+class PassMessagesService : public EchoTestService::Service {
+ public:
+  // Replies with the size of the request's message, which need not be
+  // UTF-8.
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(std::to_string(request->message().size()));
+    return Status::OK;
+  }
+
+  // Replies with the total size of the requests' messages.
+  Status RequestStream(ServerContext* /*context*/,
+                       ServerReader<EchoRequest>* reader,
+                       EchoResponse* response) override {
+    EchoRequest request;
+    size_t size = 0;
+    while (reader->Read(&request)) size += request.message().size();
+    response->set_message(std::to_string(size));
+    return Status::OK;
+  }
+
+  // Waits for the client to cancel, without reading what it sent.
+  Status BidiStream(
+      ServerContext* context,
+      ServerReaderWriter<EchoResponse, EchoRequest>* /*stream*/) override {
+    while (!context->IsCancelled()) {
+      gpr_sleep_until(grpc_timeout_milliseconds_to_deadline(10));
+    }
+    return Status::CANCELLED;
+  }
+};
+
+// Handles the methods PassMessagesService leaves generic, echoing the bytes
+// it receives: an EchoRequest parses as an EchoResponse.
+class GenericEchoService : public CallbackGenericService {
+ private:
+  ServerGenericBidiReactor* CreateReactor(
+      GenericCallbackServerContext* /*context*/) override {
+    class Reactor : public ServerGenericBidiReactor {
+     public:
+      Reactor() { StartRead(&request_); }
+
+     private:
+      void OnReadDone(bool ok) override {
+        if (!ok) {
+          Finish(Status(StatusCode::INVALID_ARGUMENT, "No request"));
+          return;
+        }
+        // Byte buffer receivers get bytes, never a passed message.
+        EXPECT_EQ(internal::PassedMessage::FromByteBuffer(&request_), nullptr);
+        StartWriteAndFinish(&request_, WriteOptions(), Status::OK);
+      }
+      void OnDone() override { delete this; }
+
+      ByteBuffer request_;
+    };
+    return new Reactor;
+  }
+};
+
+class InprocPassMessagesTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ServerBuilder builder;
+    builder.RegisterService(&service_);
+    builder.RegisterCallbackGenericService(&generic_service_);
+    builder.SetMaxReceiveMessageSize(kMaxReceiveMessageSize);
+    server_ = builder.BuildAndStart();
+    ChannelArguments args;
+    args.SetInt(GRPC_ARG_INPROC_PASS_MESSAGES, 1);
+    channel_ = server_->InProcessChannel(args);
+    stub_ = EchoTestService::NewStub(channel_);
+  }
+
+  void TearDown() override { server_->Shutdown(); }
+
+  EchoTestService::WithGenericMethod_Echo1<PassMessagesService> service_;
+  GenericEchoService generic_service_;
+  std::unique_ptr<Server> server_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+TEST_F(InprocPassMessagesTest, UnaryCallPassesTheRequest) {
+  EchoRequest request = NotUtf8Request();
+  EchoResponse response;
+  ClientContext context;
+  Status status = stub_->Echo(&context, request, &response);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(response.message(), "1024");
+  // The server got a copy: the caller's message is as it was.
+  EXPECT_EQ(request.message(), NotUtf8Request().message());
+}
+
+TEST_F(InprocPassMessagesTest, CallbackUnaryCallPassesTheRequest) {
+  EchoRequest request = NotUtf8Request();
+  EchoResponse response;
+  ClientContext context;
+  std::mutex mu;
+  std::condition_variable cv;
+  bool done = false;
+  Status status;
+  stub_->async()->Echo(&context, &request, &response,
+                       [&status, &done, &mu, &cv](Status s) {
+                         std::lock_guard<std::mutex> l(mu);
+                         status = std::move(s);
+                         done = true;
+                         cv.notify_one();
+                       });
+  std::unique_lock<std::mutex> l(mu);
+  while (!done) cv.wait(l);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(response.message(), "1024");
+}
+
+TEST_F(InprocPassMessagesTest, ChannelWithoutTheArgumentSendsBytes) {
+  auto stub =
+      EchoTestService::NewStub(server_->InProcessChannel(ChannelArguments()));
+  EchoResponse response;
+  ClientContext context;
+  EXPECT_EQ(stub->Echo(&context, NotUtf8Request(), &response).error_code(),
+            StatusCode::INTERNAL);
+}
+
+TEST_F(InprocPassMessagesTest, RequestOverTheReceiveLimitIsSent) {
+  // Passing it would get around the server's limit, so it is sent as bytes
+  // and rejected.
+  EchoResponse response;
+  ClientContext context;
+  EXPECT_EQ(stub_->Echo(&context, NotUtf8Request(kMaxReceiveMessageSize),
+                        &response)
+                .error_code(),
+            StatusCode::RESOURCE_EXHAUSTED);
+}
+
+TEST_F(InprocPassMessagesTest, ClientStreamingWritesPassEachRequest) {
+  EchoResponse response;
+  ClientContext context;
+  auto writer = stub_->RequestStream(&context, &response);
+  // Each write takes its own copy, so the caller may reuse the message.
+  EchoRequest request;
+  for (size_t size : {100, 200, 300}) {
+    request = NotUtf8Request(size);
+    ASSERT_TRUE(writer->Write(request));
+  }
+  ASSERT_TRUE(writer->WritesDone());
+  Status status = writer->Finish();
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(response.message(), "600");
+}
+
+TEST_F(InprocPassMessagesTest, ByteBufferReceiverGetsSerializedBytes) {
+  EchoRequest request = LargeRequest();
+  EchoResponse response;
+  ClientContext context;
+  Status status = stub_->Echo1(&context, request, &response);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(response.message(), request.message());
+}
+
+TEST_F(InprocPassMessagesTest, TypeMismatchFallsBackToSerializing) {
+  // Send an EchoResponse where the server expects an EchoRequest, through
+  // the base class as generated stubs do. Both have the same first field.
+  internal::RpcMethod method("/grpc.testing.EchoTestService/Echo",
+                             internal::RpcMethod::NORMAL_RPC, channel_);
+  EchoResponse request;
+  request.set_message(std::string(1024, 'a'));
+  EchoResponse response;
+  ClientContext context;
+  Status status =
+      internal::BlockingUnaryCall<EchoResponse, EchoResponse,
+                                  protobuf::MessageLite, protobuf::MessageLite>(
+          channel_.get(), method, &context, request, &response);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(response.message(), "1024");
+}
+
+TEST_F(InprocPassMessagesTest, CancelledCallFreesThePassedRequest) {
+  // The server never reads the request, so it is freed with the call; the
+  // sanitizers catch it if not.
+  ClientContext context;
+  auto stream = stub_->BidiStream(&context);
+  stream->Write(LargeRequest());
+  context.TryCancel();
+  EXPECT_EQ(stream->Finish().error_code(), StatusCode::CANCELLED);
+}
+
+TEST_F(InprocPassMessagesTest, SixteenBytePayloadIsNotTakenForAHandle) {
+  // Bytes from a client that does not pass messages, the size of a handle.
+  auto stub =
+      EchoTestService::NewStub(server_->InProcessChannel(ChannelArguments()));
+  EchoRequest request;
+  request.set_message(std::string(14, 'a'));
+  ASSERT_EQ(request.ByteSizeLong(), 16u);
+  EchoResponse response;
+  ClientContext context;
+  Status status = stub->Echo(&context, request, &response);
+  ASSERT_TRUE(status.ok()) << status.error_message();
+  EXPECT_EQ(response.message(), "14");
+}
+
+TEST(PassedMessageTest, CopiedHandleIsNotTakenForAMessage) {
+  ByteBuffer buffer;
+  internal::PassedMessage::Pass(
+      new EchoRequest(LargeRequest()),
+      &internal::PassedProtoType<EchoRequest>::kType, &buffer);
+  EXPECT_NE(internal::PassedMessage::FromByteBuffer(&buffer), nullptr);
+  // The same bytes somewhere else do not refer to the message.
+  std::vector<Slice> slices;
+  ASSERT_TRUE(buffer.Dump(&slices).ok());
+  ASSERT_EQ(slices.size(), 1u);
+  Slice copy(slices[0].begin(), slices[0].size());
+  ByteBuffer copied(&copy, 1);
+  EXPECT_EQ(internal::PassedMessage::FromByteBuffer(&copied), nullptr);
+}
+
+}  // namespace
+}  // namespace testing
+}  // namespace grpc
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
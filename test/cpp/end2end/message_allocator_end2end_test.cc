@@ -107,8 +107,12 @@ class MessageAllocatorEnd2endTestBase
 
   ~MessageAllocatorEnd2endTestBase() override = default;
 
-  void CreateServer(MessageAllocator<EchoRequest, EchoResponse>* allocator) {
+  void CreateServer(MessageAllocator<EchoRequest, EchoResponse>* allocator,
+                    bool arena_message_allocation = false) {
     ServerBuilder builder;
+    if (arena_message_allocation) {
+      builder.experimental().EnableArenaMessageAllocation();
+    }
 
     auto server_creds = GetCredentialsProvider()->GetServerCredentials(
         GetParam().credentials_type);
@@ -352,6 +356,25 @@ TEST_P(ArenaAllocatorTest, SimpleRpc) {
   EXPECT_EQ(kRpcCount, allocator->allocation_count);
 }
 
+class DefaultArenaAllocatorTest : public MessageAllocatorEnd2endTestBase {};
+
+TEST_P(DefaultArenaAllocatorTest, SimpleRpc) {
+  const int kRpcCount = 10;
+  CreateServer(nullptr, /*arena_message_allocation=*/true);
+  ResetStub();
+  SendRpcs(kRpcCount);
+}
+
+TEST_P(DefaultArenaAllocatorTest, UserAllocatorTakesPrecedence) {
+  const int kRpcCount = 10;
+  std::unique_ptr<ArenaAllocatorTest::ArenaAllocator> allocator(
+      new ArenaAllocatorTest::ArenaAllocator);
+  CreateServer(allocator.get(), /*arena_message_allocation=*/true);
+  ResetStub();
+  SendRpcs(kRpcCount);
+  EXPECT_EQ(kRpcCount, allocator->allocation_count);
+}
+
 std::vector<TestScenario> CreateTestScenarios(bool test_insecure) {
   std::vector<TestScenario> scenarios;
   std::vector<std::string> credentials_types{
@@ -387,6 +410,8 @@ INSTANTIATE_TEST_SUITE_P(SimpleAllocatorTest, SimpleAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
 INSTANTIATE_TEST_SUITE_P(ArenaAllocatorTest, ArenaAllocatorTest,
                          ::testing::ValuesIn(CreateTestScenarios(true)));
+INSTANTIATE_TEST_SUITE_P(DefaultArenaAllocatorTest, DefaultArenaAllocatorTest,
+                         ::testing::ValuesIn(CreateTestScenarios(true)));
 
 }  // namespace
 }  // namespace testing
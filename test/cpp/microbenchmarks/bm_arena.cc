@@ -33,9 +33,11 @@ static void BM_Arena_NoOp(benchmark::State& state) {
       grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
                                      ->memory_quota()
                                      ->CreateMemoryAllocator("test"));
+  ArenaAllocationCounter allocations;
   for (auto _ : state) {
     Arena::Create(state.range(0), &memory_allocator)->Destroy();
   }
+  allocations.Finish(state);
 }
 BENCHMARK(BM_Arena_NoOp)->Range(1, 1024 * 1024);
 
@@ -64,6 +66,7 @@ static void BM_Arena_Batch(benchmark::State& state) {
       grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
                                      ->memory_quota()
                                      ->CreateMemoryAllocator("test"));
+  ArenaAllocationCounter allocations;
   for (auto _ : state) {
     Arena* a = Arena::Create(state.range(0), &memory_allocator);
     for (int i = 0; i < state.range(1); i++) {
@@ -71,9 +74,45 @@ static void BM_Arena_Batch(benchmark::State& state) {
     }
     a->Destroy();
   }
+  allocations.Finish(state);
 }
 BENCHMARK(BM_Arena_Batch)->Ranges({{1, 64 * 1024}, {1, 64}, {1, 1024}});
 
+// A streaming call: each of range(0) messages allocates payload and
+// per-message state, in a ReclaimableScope if range(1) is set.  Reports the
+// arena size at the end of the call.
+static void BM_Arena_StreamingCall(benchmark::State& state) {
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  struct MessageState {
+    char data[512];
+  };
+  size_t arena_size = 0;
+  for (auto _ : state) {
+    Arena* a = Arena::Create(1024, &memory_allocator);
+    for (int i = 0; i < state.range(0); i++) {
+      if (state.range(1)) {
+        Arena::ReclaimableScope scope(a);
+        benchmark::DoNotOptimize(scope.Alloc(2048));
+        benchmark::DoNotOptimize(scope.New<MessageState>());
+      } else {
+        benchmark::DoNotOptimize(a->Alloc(2048));
+        benchmark::DoNotOptimize(a->New<MessageState>());
+      }
+    }
+    arena_size = a->Destroy();
+  }
+  state.counters["arena_bytes"] = arena_size;
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Arena_StreamingCall)
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({100000, 0})
+    ->Args({100000, 1});
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
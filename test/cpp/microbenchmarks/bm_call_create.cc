@@ -38,11 +38,13 @@
 #include "src/core/ext/filters/http/message_compress/compression_filter.h"
 #include "src/core/ext/filters/http/server/http_server_filter.h"
 #include "src/core/ext/filters/message_size/message_size_filter.h"
+#include "src/core/ext/transport/inproc/inproc_transport.h"
 #include "src/core/lib/channel/channel_args.h"
 #include "src/core/lib/channel/channel_stack.h"
 #include "src/core/lib/channel/channel_stack_builder_impl.h"
 #include "src/core/lib/channel/connected_channel.h"
 #include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/experiments/experiments.h"
 #include "src/core/lib/iomgr/call_combiner.h"
 #include "src/core/lib/resource_quota/resource_quota.h"
 #include "src/core/lib/surface/channel.h"
@@ -115,11 +117,13 @@ static void BM_CallCreateDestroy(benchmark::State& state) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   void* method_hdl = grpc_channel_register_call(fixture.channel(), "/foo/bar",
                                                 nullptr, nullptr);
+  ArenaAllocationCounter allocations;
   for (auto _ : state) {
     grpc_call_unref(grpc_channel_create_registered_call(
         fixture.channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, cq, method_hdl,
         deadline, nullptr));
   }
+  allocations.Finish(state);
   grpc_completion_queue_destroy(cq);
 }
 
@@ -176,6 +180,7 @@ static void BM_LameChannelCallCreateCore(benchmark::State& state) {
   cq = grpc_completion_queue_create_for_next(nullptr);
   void* rc = grpc_channel_register_call(
       channel, "/grpc.testing.EchoTestService/Echo", nullptr, nullptr);
+  ArenaAllocationCounter allocations;
   for (auto _ : state) {
     grpc_call* call = grpc_channel_create_registered_call(
         channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq, rc,
@@ -223,6 +228,7 @@ static void BM_LameChannelCallCreateCore(benchmark::State& state) {
     grpc_metadata_array_destroy(&initial_metadata_recv);
     grpc_metadata_array_destroy(&trailing_metadata_recv);
   }
+  allocations.Finish(state);
   grpc_channel_destroy(channel);
   grpc_completion_queue_destroy(cq);
   grpc_slice_unref(send_request_slice);
@@ -732,11 +738,13 @@ static void BM_IsolatedCall_NoOp(benchmark::State& state) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   void* method_hdl = grpc_channel_register_call(fixture.channel(), "/foo/bar",
                                                 nullptr, nullptr);
+  ArenaAllocationCounter allocations;
   for (auto _ : state) {
     grpc_call_unref(grpc_channel_create_registered_call(
         fixture.channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, fixture.cq(),
         method_hdl, deadline, nullptr));
   }
+  allocations.Finish(state);
   fixture.Finish(state);
 }
 BENCHMARK(BM_IsolatedCall_NoOp);
@@ -770,6 +778,7 @@ static void BM_IsolatedCall_Unary(benchmark::State& state) {
   ops[5].data.recv_status_on_client.status = &status_code;
   ops[5].data.recv_status_on_client.status_details = &status_details;
   ops[5].data.recv_status_on_client.trailing_metadata = &recv_trailing_metadata;
+  ArenaAllocationCounter allocations;
   for (auto _ : state) {
     grpc_call* call = grpc_channel_create_registered_call(
         fixture.channel(), nullptr, GRPC_PROPAGATE_DEFAULTS, fixture.cq(),
@@ -779,6 +788,7 @@ static void BM_IsolatedCall_Unary(benchmark::State& state) {
                                gpr_inf_future(GPR_CLOCK_MONOTONIC), nullptr);
     grpc_call_unref(call);
   }
+  allocations.Finish(state);
   fixture.Finish(state);
   grpc_metadata_array_destroy(&recv_initial_metadata);
   grpc_metadata_array_destroy(&recv_trailing_metadata);
@@ -825,6 +835,119 @@ static void BM_IsolatedCall_StreamingSend(benchmark::State& state) {
 }
 BENCHMARK(BM_IsolatedCall_StreamingSend);
 
+// A unary call through an inproc server with a minimal stack, which is fully
+// promise based. Run with GRPC_EXPERIMENTS=promise_based_server_call to
+// measure ServerPromiseBasedCall, and without it for FilterStackCall; the
+// label records which one ran.
+static void BM_InprocServerCall_Unary(benchmark::State& state) {
+  grpc_init();
+  grpc_arg server_arg = grpc_channel_arg_integer_create(
+      const_cast<char*>(GRPC_ARG_MINIMAL_STACK), 1);
+  grpc_channel_args server_args = {1, &server_arg};
+  grpc_server* server = grpc_server_create(&server_args, nullptr);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  grpc_server_register_completion_queue(server, cq, nullptr);
+  grpc_server_start(server);
+  grpc_channel* channel = grpc_inproc_channel_create(server, nullptr, nullptr);
+  void* method_hdl =
+      grpc_channel_register_call(channel, "/foo/bar", nullptr, nullptr);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  grpc_slice slice = grpc_slice_from_static_string("hello world");
+  grpc_byte_buffer* send_message = grpc_raw_byte_buffer_create(&slice, 1);
+  grpc_byte_buffer* client_recv_message = nullptr;
+  grpc_byte_buffer* server_recv_message = nullptr;
+  grpc_status_code status_code;
+  grpc_slice status_details = grpc_empty_slice();
+  int was_cancelled;
+  grpc_metadata_array recv_initial_metadata;
+  grpc_metadata_array_init(&recv_initial_metadata);
+  grpc_metadata_array recv_trailing_metadata;
+  grpc_metadata_array_init(&recv_trailing_metadata);
+  grpc_metadata_array request_metadata;
+  grpc_metadata_array_init(&request_metadata);
+  grpc_call_details call_details;
+  grpc_call_details_init(&call_details);
+  grpc_op client_ops[6];
+  memset(client_ops, 0, sizeof(client_ops));
+  client_ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  client_ops[1].op = GRPC_OP_SEND_MESSAGE;
+  client_ops[1].data.send_message.send_message = send_message;
+  client_ops[2].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  client_ops[3].op = GRPC_OP_RECV_INITIAL_METADATA;
+  client_ops[3].data.recv_initial_metadata.recv_initial_metadata =
+      &recv_initial_metadata;
+  client_ops[4].op = GRPC_OP_RECV_MESSAGE;
+  client_ops[4].data.recv_message.recv_message = &client_recv_message;
+  client_ops[5].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  client_ops[5].data.recv_status_on_client.status = &status_code;
+  client_ops[5].data.recv_status_on_client.status_details = &status_details;
+  client_ops[5].data.recv_status_on_client.trailing_metadata =
+      &recv_trailing_metadata;
+  grpc_op server_ops[5];
+  memset(server_ops, 0, sizeof(server_ops));
+  server_ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  server_ops[1].op = GRPC_OP_RECV_MESSAGE;
+  server_ops[1].data.recv_message.recv_message = &server_recv_message;
+  server_ops[2].op = GRPC_OP_SEND_MESSAGE;
+  server_ops[2].data.send_message.send_message = send_message;
+  server_ops[3].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+  server_ops[3].data.recv_close_on_server.cancelled = &was_cancelled;
+  server_ops[4].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+  server_ops[4].data.send_status_from_server.status = GRPC_STATUS_OK;
+  ArenaAllocationCounter allocations;
+  for (auto _ : state) {
+    grpc_call* server_call = nullptr;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_server_request_call(server, &server_call, &call_details,
+                                        &request_metadata, cq, cq, tag(100)));
+    grpc_call* call = grpc_channel_create_registered_call(
+        channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq, method_hdl, deadline,
+        nullptr);
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(call, client_ops, 6, tag(1), nullptr));
+    // The client batch cannot complete before the server has answered.
+    GPR_ASSERT(grpc_completion_queue_next(cq, deadline, nullptr).tag ==
+               tag(100));
+    GPR_ASSERT(GRPC_CALL_OK == grpc_call_start_batch(server_call, server_ops,
+                                                     5, tag(101), nullptr));
+    for (int i = 0; i < 2; i++) {
+      GPR_ASSERT(grpc_completion_queue_next(cq, deadline, nullptr).type ==
+                 GRPC_OP_COMPLETE);
+    }
+    grpc_call_unref(call);
+    grpc_call_unref(server_call);
+    grpc_byte_buffer_destroy(client_recv_message);
+    grpc_byte_buffer_destroy(server_recv_message);
+    grpc_slice_unref(status_details);
+    grpc_call_details_destroy(&call_details);
+    grpc_call_details_init(&call_details);
+    recv_initial_metadata.count = 0;
+    recv_trailing_metadata.count = 0;
+    request_metadata.count = 0;
+  }
+  allocations.Finish(state);
+  state.SetLabel(grpc_core::IsPromiseBasedServerCallEnabled()
+                     ? "promise_based_server_call"
+                     : "filter_stack_server_call");
+  grpc_channel_destroy(channel);
+  grpc_server_shutdown_and_notify(server, cq, tag(1000));
+  while (grpc_completion_queue_next(cq, deadline, nullptr).tag != tag(1000)) {
+  }
+  grpc_server_destroy(server);
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, deadline, nullptr).type !=
+         GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+  grpc_metadata_array_destroy(&recv_initial_metadata);
+  grpc_metadata_array_destroy(&recv_trailing_metadata);
+  grpc_metadata_array_destroy(&request_metadata);
+  grpc_call_details_destroy(&call_details);
+  grpc_byte_buffer_destroy(send_message);
+  grpc_shutdown();
+}
+BENCHMARK(BM_InprocServerCall_Unary);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -20,9 +20,15 @@
 
 #include <string.h>
 
+// After string.h, which defines __GLIBC__ on glibc.
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
 #include <memory>
 #include <queue>
 #include <sstream>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -408,6 +414,84 @@ static void BM_TransportEmptyOp(benchmark::State& state) {
 }
 BENCHMARK(BM_TransportEmptyOp);
 
+// Heap bytes in use, or 0 where the C library cannot tell.
+static size_t HeapBytesInUse() {
+#ifdef __GLIBC__
+#if __GLIBC_PREREQ(2, 33)
+  struct mallinfo2 info = mallinfo2();
+  return info.uordblks + info.hblkhd;
+#endif
+#endif
+  return 0;
+}
+
+// Heap memory per connection for transports that have run one call and gone
+// idle, before and after compaction.  The first argument is the number of
+// connections, the second whether the transports are compacted.
+static void BM_IdleTransportMemory(benchmark::State& state) {
+  const int num_transports = state.range(0);
+  const bool compact = state.range(1) != 0;
+  grpc_core::ExecCtx exec_ctx;
+  grpc_core::MemoryAllocator memory_allocator =
+      grpc_core::MemoryAllocator(grpc_core::ResourceQuota::Default()
+                                     ->memory_quota()
+                                     ->CreateMemoryAllocator("test"));
+  auto arena = grpc_core::MakeScopedArena(1024, &memory_allocator);
+  grpc_metadata_batch b(arena.get());
+  RepresentativeClientInitialMetadata::Prepare(&b);
+  for (auto _ : state) {
+    const size_t heap_before = HeapBytesInUse();
+    std::vector<std::unique_ptr<Fixture>> fixtures;
+    fixtures.reserve(num_transports);
+    for (int i = 0; i < num_transports; ++i) {
+      fixtures.emplace_back(
+          std::make_unique<Fixture>(grpc::ChannelArguments(), true));
+      Fixture* f = fixtures.back().get();
+      auto* s = new Stream(f);
+      s->Init(state);
+      grpc_transport_stream_op_batch op;
+      grpc_transport_stream_op_batch_payload op_payload(nullptr);
+      op = {};
+      op.payload = &op_payload;
+      op.on_complete = MakeOnceClosure([](grpc_error_handle /*error*/) {});
+      op.send_initial_metadata = true;
+      op_payload.send_initial_metadata.send_initial_metadata = &b;
+      s->Op(&op);
+      f->FlushExecCtx();
+      op = {};
+      op.payload = &op_payload;
+      op.cancel_stream = true;
+      op_payload.cancel_stream.cancel_error = absl::CancelledError();
+      s->Op(&op);
+      s->DestroyThen(MakeOnceClosure([](grpc_error_handle /*error*/) {}));
+      f->FlushExecCtx();
+      delete s;
+    }
+    if (compact) {
+      for (auto& f : fixtures) {
+        grpc_chttp2_transport* t = f->chttp2_transport();
+        t->combiner->Run(MakeOnceClosure([t](grpc_error_handle /*error*/) {
+                           grpc_chttp2_compact_idle_transport_locked(t);
+                         }),
+                         absl::OkStatus());
+      }
+      exec_ctx.Flush();
+    }
+    const size_t heap_idle = HeapBytesInUse();
+    state.counters["bytes_per_connection"] =
+        (static_cast<double>(heap_idle) - static_cast<double>(heap_before)) /
+        num_transports;
+    fixtures.clear();
+    exec_ctx.Flush();
+  }
+}
+BENCHMARK(BM_IdleTransportMemory)
+    ->Args({1000, 0})
+    ->Args({1000, 1})
+    ->Args({100000, 0})
+    ->Args({100000, 1})
+    ->Iterations(1);
+
 // Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
 // and others do not. This allows us to support both modes.
 namespace benchmark {
@@ -0,0 +1,259 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks per-message compression throughput and ratio for each
+// compression algorithm over a few kinds of payload.  Dictionary compression
+// uses a deflate dictionary built from a separate sample of the payloads, so
+// that it can be compared with plain deflate.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/string_view.h"
+
+#include <grpc/compression.h>
+#include <grpc/slice.h>
+#include <grpc/slice_buffer.h>
+#include <grpc/support/log.h>
+
+#include "src/core/lib/compression/compression_dictionary.h"
+#include "src/core/lib/compression/compression_internal.h"
+#include "src/core/lib/compression/message_compress.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+enum class Corpus {
+  // Serialized protobuf-like records: field tags, small varints, and
+  // strings drawn from a limited vocabulary.
+  kProto,
+  // Line-oriented JSON, as sent by services that wrap text payloads.
+  kJson,
+  // Random bytes, which no algorithm can compress.
+  kRandom,
+};
+
+const char* CorpusName(Corpus corpus) {
+  switch (corpus) {
+    case Corpus::kProto:
+      return "proto";
+    case Corpus::kJson:
+      return "json";
+    case Corpus::kRandom:
+      return "random";
+  }
+  GPR_UNREACHABLE_CODE(return "unknown");
+}
+
+// Different seeds give different records of the same shape.
+std::string MakeCorpus(Corpus corpus, size_t size, uint32_t seed = 42) {
+  static const char* const kWords[] = {
+      "us-east1",   "us-central1", "europe-west4", "frontend", "backend",
+      "checkout",   "inventory",   "OK",           "PENDING",  "CANCELLED",
+      "user-12345", "user-67890",  "sku-000042",   "sku-001337"};
+  constexpr size_t kNumWords = sizeof(kWords) / sizeof(kWords[0]);
+  std::mt19937 rng(seed);
+  std::string out;
+  out.reserve(size + 256);
+  while (out.size() < size) {
+    switch (corpus) {
+      case Corpus::kProto: {
+        // field 1: int64, field 2: string, field 3: nested message with a
+        // string and a fixed64 timestamp.
+        out.push_back(0x08);
+        uint32_t id = rng() % 100000;
+        for (; id >= 0x80; id >>= 7) {
+          out.push_back(static_cast<char>((id & 0x7f) | 0x80));
+        }
+        out.push_back(static_cast<char>(id));
+        absl::string_view word = kWords[rng() % kNumWords];
+        out.push_back(0x12);
+        out.push_back(static_cast<char>(word.size()));
+        out.append(word.data(), word.size());
+        absl::string_view nested = kWords[rng() % kNumWords];
+        out.push_back(0x1a);
+        out.push_back(static_cast<char>(nested.size() + 11));
+        out.push_back(0x0a);
+        out.push_back(static_cast<char>(nested.size()));
+        out.append(nested.data(), nested.size());
+        out.push_back(0x11);
+        uint64_t timestamp = 1700000000000ull + rng() % 1000000;
+        for (int i = 0; i < 8; ++i) {
+          out.push_back(static_cast<char>(timestamp >> (8 * i)));
+        }
+        break;
+      }
+      case Corpus::kJson:
+        absl::StrAppend(&out, "{\"region\":\"", kWords[rng() % 3],
+                        "\",\"service\":\"", kWords[3 + rng() % 4],
+                        "\",\"status\":\"", kWords[7 + rng() % 3],
+                        "\",\"user\":\"", kWords[10 + rng() % 2],
+                        "\",\"latency_ms\":", rng() % 1000, "}\n");
+        break;
+      case Corpus::kRandom:
+        out.push_back(static_cast<char>(rng()));
+        break;
+    }
+  }
+  out.resize(size);
+  return out;
+}
+
+// Payload split into transport-sized slices, the way messages arrive from
+// the wire.
+class Payload {
+ public:
+  Payload(Corpus corpus, size_t size) {
+    grpc_slice_buffer_init(&buffer_);
+    const std::string data = MakeCorpus(corpus, size);
+    constexpr size_t kSliceSize = 16384;
+    for (size_t i = 0; i < data.size(); i += kSliceSize) {
+      const size_t length = std::min(kSliceSize, data.size() - i);
+      grpc_slice_buffer_add(
+          &buffer_, grpc_slice_from_copied_buffer(data.data() + i, length));
+    }
+  }
+  ~Payload() { grpc_slice_buffer_destroy(&buffer_); }
+
+  grpc_slice_buffer* buffer() { return &buffer_; }
+
+ private:
+  grpc_slice_buffer buffer_;
+};
+
+// The dictionary samples the proto and JSON corpora together, with records
+// other than the ones being compressed.
+CompressionDictionary* DeflateDictionary() {
+  static CompressionDictionary* dictionary = [] {
+    auto dictionary = CompressionDictionary::Create(
+        GRPC_COMPRESS_DEFLATE_DICTIONARY,
+        absl::StrCat(MakeCorpus(Corpus::kProto, 8192, /*seed=*/7),
+                     MakeCorpus(Corpus::kJson, 8192, /*seed=*/7)));
+    GPR_ASSERT(dictionary.ok());
+    return dictionary->release();
+  }();
+  return dictionary;
+}
+
+bool SetUp(benchmark::State& state, grpc_compression_algorithm* algorithm,
+           Corpus* corpus, size_t* size) {
+  *algorithm = static_cast<grpc_compression_algorithm>(state.range(0));
+  *corpus = static_cast<Corpus>(state.range(1));
+  *size = static_cast<size_t>(state.range(2));
+  state.SetLabel(absl::StrCat(CompressionAlgorithmAsString(*algorithm), "/",
+                              CorpusName(*corpus)));
+  if (*algorithm != GRPC_COMPRESS_DEFLATE_DICTIONARY &&
+      !IsCompressionAlgorithmSupported(*algorithm)) {
+    state.SkipWithError("algorithm not supported by this process");
+    return false;
+  }
+  return true;
+}
+
+void BM_Compress(benchmark::State& state) {
+  grpc_compression_algorithm algorithm;
+  Corpus corpus;
+  size_t size;
+  if (!SetUp(state, &algorithm, &corpus, &size)) return;
+  ExecCtx exec_ctx;
+  Payload payload(corpus, size);
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  size_t compressed_size = 0;
+  for (auto _ : state) {
+    grpc_msg_compress(algorithm, payload.buffer(), &output,
+                      DeflateDictionary());
+    compressed_size = output.length;
+    grpc_slice_buffer_reset_and_unref(&output);
+  }
+  grpc_slice_buffer_destroy(&output);
+  state.SetBytesProcessed(state.iterations() * size);
+  state.counters["ratio"] =
+      static_cast<double>(size) / static_cast<double>(compressed_size);
+}
+
+void BM_Decompress(benchmark::State& state) {
+  grpc_compression_algorithm algorithm;
+  Corpus corpus;
+  size_t size;
+  if (!SetUp(state, &algorithm, &corpus, &size)) return;
+  ExecCtx exec_ctx;
+  Payload payload(corpus, size);
+  grpc_slice_buffer compressed;
+  grpc_slice_buffer_init(&compressed);
+  // Messages that do not compress are sent as-is, so that is what the
+  // receiver sees.
+  if (!grpc_msg_compress(algorithm, payload.buffer(), &compressed,
+                         DeflateDictionary())) {
+    algorithm = GRPC_COMPRESS_NONE;
+  }
+  grpc_slice_buffer output;
+  grpc_slice_buffer_init(&output);
+  for (auto _ : state) {
+    GPR_ASSERT(grpc_msg_decompress(algorithm, &compressed, &output,
+                                   DeflateDictionary()));
+    grpc_slice_buffer_reset_and_unref(&output);
+  }
+  // Throughput is measured in uncompressed bytes, as for compression.
+  state.SetBytesProcessed(state.iterations() * size);
+  state.counters["ratio"] =
+      static_cast<double>(size) / static_cast<double>(compressed.length);
+  grpc_slice_buffer_destroy(&output);
+  grpc_slice_buffer_destroy(&compressed);
+}
+
+void CompressionArgs(benchmark::internal::Benchmark* b) {
+  for (int algorithm = GRPC_COMPRESS_DEFLATE;
+       algorithm < GRPC_COMPRESS_ALGORITHMS_COUNT; ++algorithm) {
+    for (Corpus corpus : {Corpus::kProto, Corpus::kJson, Corpus::kRandom}) {
+      for (int size : {256, 1024, 64 * 1024, 1024 * 1024}) {
+        b->Args({algorithm, static_cast<int>(corpus), size});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_Compress)->Apply(CompressionArgs);
+BENCHMARK(BM_Decompress)->Apply(CompressionArgs);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -19,6 +19,9 @@
 /* This benchmark exists to ensure that the benchmark integration is
  * working */
 
+#include <memory>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include <grpc/grpc.h>
@@ -111,6 +114,78 @@ static void BM_Pass1Core(benchmark::State& state) {
 }
 BENCHMARK(BM_Pass1Core);
 
+// Queues state.range(0) completions, then takes them off the queue one call
+// each.
+static void BM_PassNCore(benchmark::State& state) {
+  const size_t n = state.range(0);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  std::vector<grpc_cq_completion> completions(n);
+  for (auto _ : state) {
+    grpc_core::ExecCtx exec_ctx;
+    for (grpc_cq_completion& completion : completions) {
+      GPR_ASSERT(grpc_cq_begin_op(cq, nullptr));
+      grpc_cq_end_op(cq, nullptr, absl::OkStatus(), DoneWithCompletionOnStack,
+                     nullptr, &completion);
+    }
+    for (size_t i = 0; i < n; i++) {
+      grpc_completion_queue_next(cq, deadline, nullptr);
+    }
+  }
+  grpc_completion_queue_destroy(cq);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PassNCore)->Range(1, 64);
+
+// As BM_PassNCore, but takes the completions off with
+// grpc_completion_queue_next_batch.
+static void BM_PassNBatchCore(benchmark::State& state) {
+  const size_t n = state.range(0);
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
+  std::vector<grpc_cq_completion> completions(n);
+  std::vector<grpc_event> events(n);
+  for (auto _ : state) {
+    grpc_core::ExecCtx exec_ctx;
+    for (grpc_cq_completion& completion : completions) {
+      GPR_ASSERT(grpc_cq_begin_op(cq, nullptr));
+      grpc_cq_end_op(cq, nullptr, absl::OkStatus(), DoneWithCompletionOnStack,
+                     nullptr, &completion);
+    }
+    for (size_t taken = 0; taken < n;) {
+      taken += grpc_completion_queue_next_batch(cq, events.data(), n - taken,
+                                                deadline, nullptr);
+    }
+  }
+  grpc_completion_queue_destroy(cq);
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PassNBatchCore)->Range(1, 64);
+
+// As BM_PassNBatchCore, through CompletionQueue::NextBatch.
+static void BM_PassNBatchCpp(benchmark::State& state) {
+  const size_t n = state.range(0);
+  CompletionQueue cq;
+  grpc_completion_queue* c_cq = cq.cq();
+  std::vector<grpc_cq_completion> completions(n);
+  std::vector<PhonyTag> phony_tags(n);
+  std::vector<void*> tags(n);
+  std::unique_ptr<bool[]> oks(new bool[n]);
+  for (auto _ : state) {
+    grpc_core::ExecCtx exec_ctx;
+    for (size_t i = 0; i < n; i++) {
+      GPR_ASSERT(grpc_cq_begin_op(c_cq, &phony_tags[i]));
+      grpc_cq_end_op(c_cq, &phony_tags[i], absl::OkStatus(),
+                     DoneWithCompletionOnStack, nullptr, &completions[i]);
+    }
+    for (size_t taken = 0; taken < n;) {
+      taken += cq.NextBatch(tags.data(), oks.get(), n - taken);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_PassNBatchCpp)->Range(1, 64);
+
 static void BM_Pluck1Core(benchmark::State& state) {
   // TODO(sreek): Templatize this benchmark and pass polling_type as a param
   grpc_completion_queue* cq = grpc_completion_queue_create_for_pluck(nullptr);
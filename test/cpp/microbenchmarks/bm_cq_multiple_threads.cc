@@ -19,6 +19,7 @@
 #include <string.h>
 
 #include <atomic>
+#include <vector>
 
 #include <benchmark/benchmark.h>
 
@@ -42,6 +43,8 @@ static gpr_mu g_mu;
 static gpr_cv g_cv;
 static int g_threads_active;
 static bool g_active;
+// Completions that each call to pollset_work queues.
+static int g_completions_per_poll = 1;
 
 namespace grpc {
 namespace testing {
@@ -68,7 +71,7 @@ static void cq_done_cb(void* /*done_arg*/, grpc_cq_completion* cq_completion) {
   gpr_free(cq_completion);
 }
 
-/* Queues a completion tag if deadline is > 0.
+/* Queues g_completions_per_poll completion tags if deadline is > 0.
  * Does nothing if deadline is 0 (i.e gpr_time_0(GPR_CLOCK_MONOTONIC)) */
 static grpc_error_handle pollset_work(grpc_pollset* ps,
                                       grpc_pollset_worker** /*worker*/,
@@ -81,10 +84,12 @@ static grpc_error_handle pollset_work(grpc_pollset* ps,
   gpr_mu_unlock(&ps->mu);
 
   void* tag = reinterpret_cast<void*>(10);  // Some random number
-  GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
-  grpc_cq_end_op(
-      g_cq, tag, absl::OkStatus(), cq_done_cb, nullptr,
-      static_cast<grpc_cq_completion*>(gpr_malloc(sizeof(grpc_cq_completion))));
+  for (int i = 0; i < g_completions_per_poll; i++) {
+    GPR_ASSERT(grpc_cq_begin_op(g_cq, tag));
+    grpc_cq_end_op(g_cq, tag, absl::OkStatus(), cq_done_cb, nullptr,
+                   static_cast<grpc_cq_completion*>(
+                       gpr_malloc(sizeof(grpc_cq_completion))));
+  }
   grpc_core::ExecCtx::Get()->Flush();
   gpr_mu_lock(&ps->mu);
   return absl::OkStatus();
@@ -114,7 +119,8 @@ static grpc_event_engine_vtable make_engine_vtable(const char* name) {
   return vtable;
 }
 
-static void setup() {
+static void setup(int completions_per_poll) {
+  g_completions_per_poll = completions_per_poll;
   grpc_init();
   GPR_ASSERT(strcmp(grpc_get_poll_strategy_name(), "none") == 0 ||
              strcmp(grpc_get_poll_strategy_name(), "bm_cq_multiple_threads") ==
@@ -157,14 +163,18 @@ static void teardown() {
  and its Finish call must take place before grpc_shutdown so that it can use
  grpc_stats).
 */
-static void BM_Cq_Throughput(benchmark::State& state) {
+// Each poll queues completions_per_poll completions.  They are taken off the
+// queue one at a time with grpc_completion_queue_next if batch_size is 0, or
+// else up to batch_size at a time with grpc_completion_queue_next_batch.
+static void RunCqThroughput(benchmark::State& state, int completions_per_poll,
+                            size_t batch_size) {
   gpr_timespec deadline = gpr_inf_future(GPR_CLOCK_MONOTONIC);
   auto thd_idx = state.thread_index();
 
   gpr_mu_lock(&g_mu);
   g_threads_active++;
   if (thd_idx == 0) {
-    setup();
+    setup(completions_per_poll);
     g_active = true;
     gpr_cv_broadcast(&g_cv);
   } else {
@@ -174,12 +184,24 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
   gpr_mu_unlock(&g_mu);
 
-  for (auto _ : state) {
-    GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
-               GRPC_OP_COMPLETE);
+  int64_t events = 0;
+  if (batch_size == 0) {
+    for (auto _ : state) {
+      GPR_ASSERT(grpc_completion_queue_next(g_cq, deadline, nullptr).type ==
+                 GRPC_OP_COMPLETE);
+    }
+    events = state.iterations();
+  } else {
+    std::vector<grpc_event> batch(batch_size);
+    for (auto _ : state) {
+      size_t n = grpc_completion_queue_next_batch(
+          g_cq, batch.data(), batch_size, deadline, nullptr);
+      GPR_ASSERT(batch[0].type == GRPC_OP_COMPLETE);
+      events += n;
+    }
   }
 
-  state.SetItemsProcessed(state.iterations());
+  state.SetItemsProcessed(events);
 
   gpr_mu_lock(&g_mu);
   g_threads_active--;
@@ -198,8 +220,32 @@ static void BM_Cq_Throughput(benchmark::State& state) {
   }
 }
 
+static void BM_Cq_Throughput(benchmark::State& state) {
+  RunCqThroughput(state, 1, 0);
+}
 BENCHMARK(BM_Cq_Throughput)->ThreadRange(1, 16)->UseRealTime();
 
+// The argument is the number of completions queued by each poll, which the
+// first benchmark drains with one grpc_completion_queue_next call per event
+// and the second with grpc_completion_queue_next_batch.
+static void BM_Cq_BurstThroughput(benchmark::State& state) {
+  RunCqThroughput(state, state.range(0), 0);
+}
+BENCHMARK(BM_Cq_BurstThroughput)
+    ->Arg(8)
+    ->Arg(64)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+static void BM_Cq_BatchThroughput(benchmark::State& state) {
+  RunCqThroughput(state, state.range(0), state.range(0));
+}
+BENCHMARK(BM_Cq_BatchThroughput)
+    ->Arg(8)
+    ->Arg(64)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 namespace {
 const grpc_event_engine_vtable g_none_vtable =
     grpc::testing::make_engine_vtable("none");
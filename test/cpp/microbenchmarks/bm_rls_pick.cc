@@ -0,0 +1,188 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks RPCs routed by the RLS LB policy from several threads at
+// once.  The RLS cache is warmed before measuring, so every pick is a hit
+// on an entry with fresh data.
+
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+
+#include <grpc/support/log.h>
+#include <grpcpp/channel.h>
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <grpcpp/security/server_credentials.h>
+#include <grpcpp/server.h>
+#include <grpcpp/server_builder.h>
+#include <grpcpp/support/channel_arguments.h>
+
+#include "src/core/ext/filters/client_channel/resolver/fake/fake_resolver.h"
+#include "src/core/lib/config/core_configuration.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/service_config/service_config_impl.h"
+#include "src/proto/grpc/testing/echo.grpc.pb.h"
+#include "test/core/util/port.h"
+#include "test/core/util/test_config.h"
+#include "test/core/util/test_lb_policies.h"
+#include "test/cpp/end2end/rls_server.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+constexpr char kServerName[] = "rls.benchmark.example.com";
+constexpr char kKeyHeader[] = "x-rls-key";
+constexpr int kNumKeys = 256;
+
+class EchoServiceImpl : public EchoTestService::Service {
+ public:
+  Status Echo(ServerContext* /*context*/, const EchoRequest* request,
+              EchoResponse* response) override {
+    response->set_message(request->message());
+    return Status::OK;
+  }
+};
+
+// A backend, an RLS server that maps every key to that backend, and a
+// channel that uses the RLS policy to talk to it.
+class RlsFixture {
+ public:
+  RlsFixture() {
+    const int backend_port = grpc_pick_unused_port_or_die();
+    backend_ = StartServer(backend_port, &echo_service_);
+    const int rls_port = grpc_pick_unused_port_or_die();
+    rls_server_ = StartServer(rls_port, &rls_service_);
+    for (int i = 0; i < kNumKeys; ++i) {
+      rls_service_.SetResponse(
+          BuildRlsRequest({{"key", absl::StrCat(i)}}),
+          BuildRlsResponse({absl::StrCat("ipv4:127.0.0.1:", backend_port)}));
+    }
+    response_generator_ =
+        grpc_core::MakeRefCounted<grpc_core::FakeResolverResponseGenerator>();
+    ChannelArguments args;
+    args.SetPointer(GRPC_ARG_FAKE_RESOLVER_RESPONSE_GENERATOR,
+                    response_generator_.get());
+    channel_ = grpc::CreateCustomChannel(
+        absl::StrCat("fake:///", kServerName),
+        grpc::InsecureChannelCredentials(), args);
+    {
+      grpc_core::ExecCtx exec_ctx;
+      grpc_core::Resolver::Result result;
+      result.service_config = grpc_core::ServiceConfigImpl::Create(
+          result.args, ServiceConfigJson(rls_port));
+      GPR_ASSERT(result.service_config.ok());
+      response_generator_->SetResponse(std::move(result));
+    }
+    stub_ = EchoTestService::NewStub(channel_);
+    // Warm the cache, so that only cache hits are measured.
+    for (int i = 0; i < kNumKeys; ++i) {
+      GPR_ASSERT(SendRpc(i).ok());
+    }
+  }
+
+  ~RlsFixture() {
+    channel_.reset();
+    backend_->Shutdown();
+    rls_server_->Shutdown();
+  }
+
+  Status SendRpc(int key) {
+    ClientContext context;
+    context.AddMetadata(kKeyHeader, absl::StrCat(key));
+    context.set_wait_for_ready(true);
+    EchoRequest request;
+    request.set_message("ping");
+    EchoResponse response;
+    return stub_->Echo(&context, request, &response);
+  }
+
+ private:
+  static std::unique_ptr<Server> StartServer(int port, Service* service) {
+    ServerBuilder builder;
+    builder.AddListeningPort(absl::StrCat("localhost:", port),
+                             InsecureServerCredentials());
+    builder.RegisterService(service);
+    return builder.BuildAndStart();
+  }
+
+  static std::string ServiceConfigJson(int rls_port) {
+    return absl::StrFormat(
+        "{\"loadBalancingConfig\":[{\"rls_experimental\":{"
+        "  \"routeLookupConfig\":{"
+        "    \"lookupService\":\"localhost:%d\","
+        "    \"cacheSizeBytes\":1048576,"
+        "    \"grpcKeybuilders\":[{"
+        "      \"names\":[{\"service\":\"grpc.testing.EchoTestService\"}],"
+        "      \"headers\":[{\"key\":\"key\",\"names\":[\"%s\"]}]"
+        "    }]"
+        "  },"
+        "  \"childPolicy\":[{\"fixed_address_lb\":{}}],"
+        "  \"childPolicyConfigTargetFieldName\":\"address\""
+        "}}]}",
+        rls_port, kKeyHeader);
+  }
+
+  EchoServiceImpl echo_service_;
+  RlsServiceImpl rls_service_;
+  std::unique_ptr<Server> backend_;
+  std::unique_ptr<Server> rls_server_;
+  grpc_core::RefCountedPtr<grpc_core::FakeResolverResponseGenerator>
+      response_generator_;
+  std::shared_ptr<Channel> channel_;
+  std::unique_ptr<EchoTestService::Stub> stub_;
+};
+
+static RlsFixture* g_fixture;
+
+static void BM_RlsPickFromCache(benchmark::State& state) {
+  // Spread threads over the keys, so that they hit different cache shards.
+  int key = state.thread_index() * (kNumKeys / state.threads());
+  for (auto _ : state) {
+    GPR_ASSERT(g_fixture->SendRpc(key).ok());
+    key = (key + 1) % kNumKeys;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RlsPickFromCache)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  grpc_core::CoreConfiguration::RegisterBuilder(
+      grpc_core::RegisterFixedAddressLoadBalancingPolicy);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  grpc::testing::g_fixture = new grpc::testing::RlsFixture();
+  benchmark::RunTheBenchmarksNamespaced();
+  delete grpc::testing::g_fixture;
+  return 0;
+}
@@ -0,0 +1,247 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks the rate of unary calls through an async server with one CQ and
+// one serving thread per CQ, with many clients.  Each client has its own
+// inproc channel, so calls arrive on every CQ's shard of the request matcher.
+
+#include <stdint.h>
+#include <string.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <grpc/grpc.h>
+#include <grpc/impl/codegen/propagation_bits.h>
+#include <grpc/slice.h>
+#include <grpc/status.h>
+#include <grpc/support/log.h>
+#include <grpc/support/time.h>
+
+#include "src/core/ext/transport/inproc/inproc_transport.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc {
+namespace testing {
+
+// Requests kept outstanding on each server CQ.
+static constexpr int kRequestsPerCq = 8;
+
+static void DrainAndDestroy(grpc_completion_queue* cq) {
+  grpc_completion_queue_shutdown(cq);
+  while (grpc_completion_queue_next(cq, gpr_inf_future(GPR_CLOCK_REALTIME),
+                                    nullptr)
+             .type != GRPC_QUEUE_SHUTDOWN) {
+  }
+  grpc_completion_queue_destroy(cq);
+}
+
+// One requested call on the server, which it answers with an OK status and
+// then requests again.  Its completion queue tag is the ServerCall itself.
+class ServerCall {
+ public:
+  ServerCall(grpc_server* server, grpc_completion_queue* cq)
+      : server_(server), cq_(cq) {
+    grpc_call_details_init(&details_);
+    grpc_metadata_array_init(&request_metadata_);
+    Request();
+  }
+  ~ServerCall() {
+    grpc_call_details_destroy(&details_);
+    grpc_metadata_array_destroy(&request_metadata_);
+  }
+
+  // Called when the last operation completes.  Returns false once the
+  // request has failed because the server is shutting down.
+  bool Step(bool ok) {
+    if (responding_) {
+      grpc_call_unref(call_);
+      call_ = nullptr;
+      responding_ = false;
+      Request();
+      return true;
+    }
+    if (!ok) return false;
+    grpc_op ops[3];
+    memset(ops, 0, sizeof(ops));
+    ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+    ops[1].op = GRPC_OP_RECV_CLOSE_ON_SERVER;
+    ops[1].data.recv_close_on_server.cancelled = &was_cancelled_;
+    ops[2].op = GRPC_OP_SEND_STATUS_FROM_SERVER;
+    ops[2].data.send_status_from_server.status = GRPC_STATUS_OK;
+    GPR_ASSERT(GRPC_CALL_OK ==
+               grpc_call_start_batch(call_, ops, 3, this, nullptr));
+    responding_ = true;
+    return true;
+  }
+
+ private:
+  void Request() {
+    GPR_ASSERT(GRPC_CALL_OK == grpc_server_request_call(
+                                   server_, &call_, &details_,
+                                   &request_metadata_, cq_, cq_, this));
+  }
+
+  grpc_server* const server_;
+  grpc_completion_queue* const cq_;
+  grpc_call* call_ = nullptr;
+  grpc_call_details details_;
+  grpc_metadata_array request_metadata_;
+  int was_cancelled_;
+  bool responding_ = false;
+};
+
+// Serves calls on cq until every request has failed at server shutdown.
+static void ServeCalls(grpc_server* server, grpc_completion_queue* cq) {
+  std::vector<std::unique_ptr<ServerCall>> calls;
+  for (int i = 0; i < kRequestsPerCq; ++i) {
+    calls.push_back(std::make_unique<ServerCall>(server, cq));
+  }
+  int failed = 0;
+  while (failed < kRequestsPerCq) {
+    grpc_event ev = grpc_completion_queue_next(
+        cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+    GPR_ASSERT(ev.type == GRPC_OP_COMPLETE);
+    if (!static_cast<ServerCall*>(ev.tag)->Step(ev.success)) ++failed;
+  }
+}
+
+static void MakeCall(grpc_channel* channel, grpc_completion_queue* cq) {
+  grpc_call* call = grpc_channel_create_call(
+      channel, nullptr, GRPC_PROPAGATE_DEFAULTS, cq,
+      grpc_slice_from_static_string("/bm/Unary"), nullptr,
+      gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  grpc_metadata_array initial_metadata;
+  grpc_metadata_array trailing_metadata;
+  grpc_metadata_array_init(&initial_metadata);
+  grpc_metadata_array_init(&trailing_metadata);
+  grpc_status_code status;
+  grpc_slice details;
+  grpc_op ops[4];
+  memset(ops, 0, sizeof(ops));
+  ops[0].op = GRPC_OP_SEND_INITIAL_METADATA;
+  ops[1].op = GRPC_OP_SEND_CLOSE_FROM_CLIENT;
+  ops[2].op = GRPC_OP_RECV_INITIAL_METADATA;
+  ops[2].data.recv_initial_metadata.recv_initial_metadata = &initial_metadata;
+  ops[3].op = GRPC_OP_RECV_STATUS_ON_CLIENT;
+  ops[3].data.recv_status_on_client.trailing_metadata = &trailing_metadata;
+  ops[3].data.recv_status_on_client.status = &status;
+  ops[3].data.recv_status_on_client.status_details = &details;
+  GPR_ASSERT(GRPC_CALL_OK ==
+             grpc_call_start_batch(call, ops, 4, call, nullptr));
+  grpc_event ev = grpc_completion_queue_next(
+      cq, gpr_inf_future(GPR_CLOCK_REALTIME), nullptr);
+  GPR_ASSERT(ev.type == GRPC_OP_COMPLETE && ev.success);
+  GPR_ASSERT(status == GRPC_STATUS_OK);
+  grpc_slice_unref(details);
+  grpc_metadata_array_destroy(&initial_metadata);
+  grpc_metadata_array_destroy(&trailing_metadata);
+  grpc_call_unref(call);
+}
+
+static void BM_MultiCqUnaryCalls(benchmark::State& state) {
+  const int num_cqs = state.range(0);
+  const int num_clients = state.range(1);
+  grpc_server* server = grpc_server_create(nullptr, nullptr);
+  std::vector<grpc_completion_queue*> server_cqs;
+  for (int i = 0; i < num_cqs; ++i) {
+    server_cqs.push_back(grpc_completion_queue_create_for_next(nullptr));
+    grpc_server_register_completion_queue(server, server_cqs.back(), nullptr);
+  }
+  grpc_server_start(server);
+  std::vector<std::thread> server_threads;
+  for (grpc_completion_queue* cq : server_cqs) {
+    server_threads.emplace_back(ServeCalls, server, cq);
+  }
+
+  // The benchmark thread is one of the clients.
+  std::vector<grpc_channel*> channels;
+  for (int i = 0; i < num_clients; ++i) {
+    channels.push_back(grpc_inproc_channel_create(server, nullptr, nullptr));
+  }
+  std::atomic<bool> done{false};
+  std::atomic<int64_t> background_calls{0};
+  std::vector<std::thread> client_threads;
+  for (int i = 1; i < num_clients; ++i) {
+    client_threads.emplace_back([&, channel = channels[i]]() {
+      grpc_completion_queue* cq =
+          grpc_completion_queue_create_for_next(nullptr);
+      while (!done.load(std::memory_order_relaxed)) {
+        MakeCall(channel, cq);
+        background_calls.fetch_add(1, std::memory_order_relaxed);
+      }
+      DrainAndDestroy(cq);
+    });
+  }
+  grpc_completion_queue* cq = grpc_completion_queue_create_for_next(nullptr);
+  for (auto _ : state) {
+    MakeCall(channels[0], cq);
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (std::thread& thread : client_threads) thread.join();
+  DrainAndDestroy(cq);
+  state.counters["calls_per_second"] = benchmark::Counter(
+      static_cast<double>(state.iterations() + background_calls.load()),
+      benchmark::Counter::kIsRate);
+
+  for (grpc_channel* channel : channels) grpc_channel_destroy(channel);
+  grpc_completion_queue* shutdown_cq =
+      grpc_completion_queue_create_for_pluck(nullptr);
+  grpc_server_shutdown_and_notify(server, shutdown_cq, nullptr);
+  GPR_ASSERT(grpc_completion_queue_pluck(shutdown_cq, nullptr,
+                                         gpr_inf_future(GPR_CLOCK_REALTIME),
+                                         nullptr)
+                 .type == GRPC_OP_COMPLETE);
+  grpc_completion_queue_destroy(shutdown_cq);
+  for (std::thread& thread : server_threads) thread.join();
+  grpc_server_destroy(server);
+  for (grpc_completion_queue* server_cq : server_cqs) {
+    DrainAndDestroy(server_cq);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// First argument is the number of server CQs, second the number of clients.
+BENCHMARK(BM_MultiCqUnaryCalls)
+    ->Args({1, 32})
+    ->Args({4, 32})
+    ->Args({16, 32})
+    ->Args({16, 64})
+    ->UseRealTime();
+
+}  // namespace testing
+}  // namespace grpc
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
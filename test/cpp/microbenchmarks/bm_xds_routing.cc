@@ -0,0 +1,199 @@
+//
+// Copyright 2023 gRPC authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Benchmarks xDS route selection for a large RouteConfiguration.
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "absl/strings/str_cat.h"
+
+#include <grpc/support/log.h>
+
+#include "src/core/ext/xds/xds_route_config.h"
+#include "src/core/ext/xds/xds_routing.h"
+#include "src/core/lib/iomgr/exec_ctx.h"
+#include "src/core/lib/matchers/matchers.h"
+#include "src/core/lib/resource_quota/arena.h"
+#include "src/core/lib/resource_quota/resource_quota.h"
+#include "src/core/lib/slice/slice.h"
+#include "src/core/lib/transport/metadata_batch.h"
+#include "test/core/util/test_config.h"
+#include "test/cpp/microbenchmarks/helpers.h"
+#include "test/cpp/util/test_config.h"
+
+namespace grpc_core {
+namespace {
+
+using Matchers = XdsRouteConfigResource::Route::Matchers;
+
+class RouteList : public XdsRouting::RouteListIterator {
+ public:
+  // Builds a route list shaped like the ones a service mesh pushes for a
+  // large virtual host.  For each of num_services services there is:
+  // - a canary route on the service prefix, selected by a header
+  // - an exact-path route for one method with a regex header match
+  // - a regex route for a family of methods
+  // - a catch-all route on the service prefix
+  // The list ends with a default route matching every path.
+  explicit RouteList(int num_services) {
+    for (int i = 0; i < num_services; ++i) {
+      const std::string service = ServiceName(i);
+      Matchers canary;
+      canary.path_matcher =
+          StringMatcher::Create(StringMatcher::Type::kPrefix,
+                                absl::StrCat("/", service, "/"))
+              .value();
+      canary.header_matchers.push_back(
+          HeaderMatcher::Create("x-canary", HeaderMatcher::Type::kExact, "true")
+              .value());
+      routes_.push_back(std::move(canary));
+      Matchers exact;
+      exact.path_matcher =
+          StringMatcher::Create(StringMatcher::Type::kExact,
+                                absl::StrCat("/", service, "/Get"))
+              .value();
+      exact.header_matchers.push_back(
+          HeaderMatcher::Create("x-user", HeaderMatcher::Type::kSafeRegex,
+                                "admin-[0-9]+")
+              .value());
+      routes_.push_back(std::move(exact));
+      Matchers regex;
+      regex.path_matcher =
+          StringMatcher::Create(StringMatcher::Type::kSafeRegex,
+                                absl::StrCat("/", service, "/(List|Watch).*"))
+              .value();
+      routes_.push_back(std::move(regex));
+      Matchers prefix;
+      prefix.path_matcher =
+          StringMatcher::Create(StringMatcher::Type::kPrefix,
+                                absl::StrCat("/", service, "/"))
+              .value();
+      routes_.push_back(std::move(prefix));
+    }
+    Matchers default_route;
+    default_route.path_matcher =
+        StringMatcher::Create(StringMatcher::Type::kPrefix, "").value();
+    routes_.push_back(std::move(default_route));
+  }
+
+  static std::string ServiceName(int i) {
+    return absl::StrCat("mesh.example.v1.Service", i);
+  }
+
+  size_t Size() const override { return routes_.size(); }
+
+  const Matchers& GetMatchersForRoute(size_t index) const override {
+    return routes_[index];
+  }
+
+ private:
+  std::vector<Matchers> routes_;
+};
+
+// Fixture holding request metadata that does not select the canary or
+// admin routes, so that the lookup has to skip past them.
+class RequestMetadata {
+ public:
+  RequestMetadata()
+      : memory_allocator_(ResourceQuota::Default()
+                              ->memory_quota()
+                              ->CreateMemoryAllocator("bm_xds_routing")),
+        arena_(MakeScopedArena(1024, &memory_allocator_)),
+        batch_(arena_.get()) {
+    batch_.Append("x-user", Slice::FromStaticString("alice"),
+                  [](absl::string_view, const Slice&) { abort(); });
+  }
+
+  grpc_metadata_batch* batch() { return &batch_; }
+
+ private:
+  MemoryAllocator memory_allocator_;
+  ScopedArenaPtr arena_;
+  grpc_metadata_batch batch_;
+};
+
+// Looks up a request that matches the catch-all route of the last
+// service, which is the worst case for a linear scan.
+std::string PathForLastService(int num_services) {
+  return absl::StrCat("/", RouteList::ServiceName(num_services - 1), "/Update");
+}
+
+void BM_GetRouteLinearScan(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  const int num_services = state.range(0);
+  RouteList routes(num_services);
+  RequestMetadata metadata;
+  const std::string path = PathForLastService(num_services);
+  for (auto _ : state) {
+    auto index =
+        XdsRouting::GetRouteForRequest(routes, path, metadata.batch());
+    GPR_ASSERT(index.has_value());
+    benchmark::DoNotOptimize(index);
+  }
+  state.counters["routes"] = routes.Size();
+}
+BENCHMARK(BM_GetRouteLinearScan)->RangeMultiplier(10)->Range(10, 1000);
+
+void BM_GetRouteIndexed(benchmark::State& state) {
+  ExecCtx exec_ctx;
+  const int num_services = state.range(0);
+  RouteList routes(num_services);
+  XdsRouting::RouteIndex route_index(routes);
+  RequestMetadata metadata;
+  const std::string path = PathForLastService(num_services);
+  for (auto _ : state) {
+    auto index = XdsRouting::GetRouteForRequest(routes, route_index, path,
+                                                metadata.batch());
+    GPR_ASSERT(index.has_value());
+    benchmark::DoNotOptimize(index);
+  }
+  state.counters["routes"] = routes.Size();
+}
+BENCHMARK(BM_GetRouteIndexed)->RangeMultiplier(10)->Range(10, 1000);
+
+// Cost paid once per RDS update to build the index.
+void BM_BuildRouteIndex(benchmark::State& state) {
+  RouteList routes(state.range(0));
+  for (auto _ : state) {
+    XdsRouting::RouteIndex route_index(routes);
+    benchmark::DoNotOptimize(&route_index);
+  }
+  state.counters["routes"] = routes.Size();
+}
+BENCHMARK(BM_BuildRouteIndex)->RangeMultiplier(10)->Range(10, 1000);
+
+}  // namespace
+}  // namespace grpc_core
+
+// Some distros have RunSpecifiedBenchmarks under the benchmark namespace,
+// and others do not. This allows us to support both modes.
+namespace benchmark {
+void RunTheBenchmarksNamespaced() { RunSpecifiedBenchmarks(); }
+}  // namespace benchmark
+
+int main(int argc, char** argv) {
+  grpc::testing::TestEnvironment env(&argc, argv);
+  LibraryInitializer libInit;
+  ::benchmark::Initialize(&argc, argv);
+  grpc::testing::InitTest(&argc, &argv, false);
+  benchmark::RunTheBenchmarksNamespaced();
+  return 0;
+}
@@ -21,6 +21,7 @@
 #ifndef TEST_CPP_MICROBENCHMARKS_CALLBACK_UNARY_PING_PONG_H
 #define TEST_CPP_MICROBENCHMARKS_CALLBACK_UNARY_PING_PONG_H
 
+#include <chrono>
 #include <sstream>
 
 #include <benchmark/benchmark.h>
@@ -60,11 +61,17 @@ inline void SendCallbackUnaryPingPong(
       });
 };
 
-template <class Fixture, class ClientContextMutator, class ServerContextMutator>
-static void BM_CallbackUnaryPingPong(benchmark::State& state) {
+template <class Fixture>
+static void RunCallbackUnaryPingPong(benchmark::State& state,
+                                     bool arena_messages, bool inline_echo) {
   int request_msgs_size = state.range(0);
   int response_msgs_size = state.range(1);
   CallbackStreamingTestService service;
+  if (arena_messages) service.EnableArenaMessageAllocation();
+  if (inline_echo) {
+    GPR_ASSERT(
+        service.SetMethodRunInline("Echo", std::chrono::milliseconds(10)));
+  }
   std::unique_ptr<Fixture> fixture(new Fixture(&service));
   std::unique_ptr<EchoTestService::Stub> stub_(
       EchoTestService::NewStub(fixture->channel()));
@@ -94,6 +101,26 @@ static void BM_CallbackUnaryPingPong(benchmark::State& state) {
                           response_msgs_size * state.iterations());
 }
 
+template <class Fixture, class ClientContextMutator, class ServerContextMutator>
+static void BM_CallbackUnaryPingPong(benchmark::State& state) {
+  RunCallbackUnaryPingPong<Fixture>(state, /*arena_messages=*/false,
+                                    /*inline_echo=*/false);
+}
+
+// Allocates the server's requests and responses with ArenaMessageAllocator.
+template <class Fixture>
+static void BM_CallbackUnaryPingPongArena(benchmark::State& state) {
+  RunCallbackUnaryPingPong<Fixture>(state, /*arena_messages=*/true,
+                                    /*inline_echo=*/false);
+}
+
+// Runs the server's Echo handler inline, where the request is delivered.
+template <class Fixture>
+static void BM_CallbackUnaryPingPongInline(benchmark::State& state) {
+  RunCallbackUnaryPingPong<Fixture>(state, /*arena_messages=*/false,
+                                    /*inline_echo=*/true);
+}
+
 }  // namespace testing
 }  // namespace grpc
 
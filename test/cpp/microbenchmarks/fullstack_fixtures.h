@@ -157,6 +157,21 @@ class InProcess : public FullstackFixture {
   ~InProcess() override {}
 };
 
+// In-process channel that hands request messages to the server as objects
+// instead of serializing them; see GRPC_ARG_INPROC_PASS_MESSAGES.
+class PassMessagesConfiguration : public FixtureConfiguration {
+  void ApplyCommonChannelArguments(ChannelArguments* a) const override {
+    a->SetInt(GRPC_ARG_INPROC_PASS_MESSAGES, 1);
+    FixtureConfiguration::ApplyCommonChannelArguments(a);
+  }
+};
+
+class InProcessPassMessages : public InProcess {
+ public:
+  explicit InProcessPassMessages(Service* service)
+      : InProcess(service, PassMessagesConfiguration()) {}
+};
+
 class EndpointPairFixture : public BaseFixture {
  public:
   EndpointPairFixture(Service* service, grpc_endpoint_pair endpoints,
@@ -25,6 +25,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include <grpcpp/support/proto_buffer_reader.h>
+
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/cpp/microbenchmarks/fullstack_context_mutators.h"
 #include "test/cpp/microbenchmarks/fullstack_fixtures.h"
@@ -105,6 +107,123 @@ static void BM_PumpStreamClientToServer(benchmark::State& state) {
   state.SetBytesProcessed(state.range(0) * state.iterations());
 }
 
+// Reads a received message like ProtoBufferReader, counting the bytes the
+// parser reads through Next(), which it copies when they are field data, and
+// those read into cord fields, which can share the received slices.
+class CountingProtoBufferReader : public ProtoBufferReader {
+ public:
+  using ProtoBufferReader::ProtoBufferReader;
+
+#ifdef GRPC_PROTOBUF_CORD_SUPPORT_ENABLED
+  bool ReadCord(absl::Cord* cord, int count) override {
+    cord_bytes_ += count;
+    return ProtoBufferReader::ReadCord(cord, count);
+  }
+#endif
+
+  int64_t copied_bytes() const { return ByteCount() - cord_bytes_; }
+  int64_t cord_bytes() const { return cord_bytes_; }
+
+ private:
+  int64_t cord_bytes_ = 0;
+};
+
+// Like BM_PumpStreamClientToServer, but the server receives raw messages and
+// parses them into a message with a cord field, to report the bytes copied per
+// message.
+template <class Fixture>
+static void BM_PumpStreamClientToServerParse(benchmark::State& state) {
+  EchoTestService::WithRawMethod_BidiStream<EchoTestService::AsyncService>
+      service;
+  std::unique_ptr<Fixture> fixture(new Fixture(&service));
+  int64_t messages = 0;
+  int64_t copied_bytes = 0;
+  int64_t cord_bytes = 0;
+  {
+    EchoRequest send_request;
+    ByteBuffer recv_buffer;
+    EchoRequestCord recv_request;
+    if (state.range(0) > 0) {
+      send_request.set_message(std::string(state.range(0), 'a'));
+    }
+    ServerContext svr_ctx;
+    ServerAsyncReaderWriter<ByteBuffer, ByteBuffer> response_rw(&svr_ctx);
+    service.RequestBidiStream(&svr_ctx, &response_rw, fixture->cq(),
+                              fixture->cq(), tag(0));
+    std::unique_ptr<EchoTestService::Stub> stub(
+        EchoTestService::NewStub(fixture->channel()));
+    ClientContext cli_ctx;
+    auto request_rw = stub->AsyncBidiStream(&cli_ctx, fixture->cq(), tag(1));
+    int need_tags = (1 << 0) | (1 << 1);
+    void* t;
+    bool ok;
+    while (need_tags) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      GPR_ASSERT(ok);
+      int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+    auto parse = [&]() {
+      {
+        CountingProtoBufferReader reader(&recv_buffer);
+        GPR_ASSERT(recv_request.ParseFromZeroCopyStream(&reader));
+        copied_bytes += reader.copied_bytes();
+        cord_bytes += reader.cord_bytes();
+      }
+      recv_buffer.Clear();
+      ++messages;
+    };
+    response_rw.Read(&recv_buffer, tag(0));
+    for (auto _ : state) {
+      request_rw->Write(send_request, tag(1));
+      while (true) {
+        GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+        if (t == tag(0)) {
+          parse();
+          response_rw.Read(&recv_buffer, tag(0));
+        } else if (t == tag(1)) {
+          break;
+        } else {
+          GPR_ASSERT(false);
+        }
+      }
+    }
+    request_rw->WritesDone(tag(1));
+    need_tags = (1 << 0) | (1 << 1);
+    while (need_tags) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      if (t == tag(0) && ok) {
+        parse();
+        response_rw.Read(&recv_buffer, tag(0));
+        continue;
+      }
+      int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+    response_rw.Finish(Status::OK, tag(0));
+    Status final_status;
+    request_rw->Finish(&final_status, tag(1));
+    need_tags = (1 << 0) | (1 << 1);
+    while (need_tags) {
+      GPR_ASSERT(fixture->cq()->Next(&t, &ok));
+      int i = static_cast<int>(reinterpret_cast<intptr_t>(t));
+      GPR_ASSERT(need_tags & (1 << i));
+      need_tags &= ~(1 << i);
+    }
+    GPR_ASSERT(final_status.ok());
+  }
+  fixture.reset();
+  if (messages > 0) {
+    state.counters["bytes_copied_per_message"] =
+        static_cast<double>(copied_bytes) / messages;
+    state.counters["bytes_in_cords_per_message"] =
+        static_cast<double>(cord_bytes) / messages;
+  }
+  state.SetBytesProcessed(state.range(0) * state.iterations());
+}
+
 template <class Fixture>
 static void BM_PumpStreamServerToClient(benchmark::State& state) {
   EchoTestService::AsyncService service;
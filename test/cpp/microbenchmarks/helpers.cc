@@ -36,3 +36,10 @@ LibraryInitializer& LibraryInitializer::get() {
   GPR_ASSERT(g_libraryInitializer != nullptr);
   return *g_libraryInitializer;
 }
+
+void ArenaAllocationCounter::Finish(benchmark::State& state) {
+  auto diff = grpc_core::global_stats().Collect()->Diff(*start_);
+  state.counters["arena_allocs_per_iter"] =
+      benchmark::Counter(static_cast<double>(diff->arena_allocations),
+                         benchmark::Counter::kAvgIterations);
+}
@@ -21,6 +21,7 @@
 
 #include <grpc/support/port_platform.h>
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -42,4 +43,16 @@ class LibraryInitializer {
   grpc::internal::GrpcLibrary init_lib_;
 };
 
+// Counts the heap allocations made by arenas from construction until
+// Finish(), which reports them per iteration as "arena_allocs_per_iter".
+class ArenaAllocationCounter {
+ public:
+  ArenaAllocationCounter() : start_(grpc_core::global_stats().Collect()) {}
+
+  void Finish(benchmark::State& state);
+
+ private:
+  std::unique_ptr<grpc_core::GlobalStats> start_;
+};
+
 #endif
@@ -166,6 +166,10 @@ class SynchronousServer final : public grpc::testing::Server {
     }
 
     ApplyConfigToBuilder(config, builder.get());
+    if (config.sync_server_handler_threads() != 0) {
+      builder->SetSyncServerOption(ServerBuilder::HANDLER_THREADS,
+                                   config.sync_server_handler_threads());
+    }
 
     builder->RegisterService(&service_);
 
@@ -19,10 +19,13 @@
 #include <gtest/gtest.h>
 
 #include <grpc/grpc.h>
+#include <grpc/support/alloc.h>
+#include <grpcpp/resource_quota.h>
 #include <grpcpp/server.h>
 #include <grpcpp/server_builder.h>
 #include <grpcpp/support/config.h>
 
+#include "src/core/lib/json/json.h"
 #include "src/proto/grpc/testing/echo.grpc.pb.h"
 #include "test/core/util/port.h"
 #include "test/core/util/test_config.h"
@@ -83,6 +86,48 @@ TEST_F(ServerBuilderTest, CreateServerRepeatedPortWithDisallowedReusePort) {
             nullptr);
 }
 
+// Returns the channelz JSON for the socket with the given id.
+grpc_core::Json GetChannelzSocket(const std::string& socket_id) {
+  char* json_str = grpc_channelz_get_socket(std::stoll(socket_id));
+  auto json = grpc_core::Json::Parse(json_str);
+  gpr_free(json_str);
+  EXPECT_TRUE(json.ok()) << json.status();
+  if (!json.ok()) return grpc_core::Json();
+  return json->object_value().at("socket");
+}
+
+TEST_F(ServerBuilderTest, CreateServerWithTenantPort) {
+  ResourceQuota server_quota("server");
+  ResourceQuota tenant_quota(server_quota, "tenant", 1024, 1);
+  ServerBuilder builder;
+  builder.RegisterService(&g_service).SetResourceQuota(server_quota);
+  builder.experimental().AddListeningPort(
+      MakePort(), InsecureServerCredentials(), tenant_quota);
+  auto server = builder.BuildAndStart();
+  ASSERT_NE(server, nullptr);
+  // The port's listen socket reports the tenant it is accounted to.
+  char* servers_str = grpc_channelz_get_servers(0);
+  auto servers = grpc_core::Json::Parse(servers_str);
+  gpr_free(servers_str);
+  ASSERT_TRUE(servers.ok()) << servers.status();
+  const grpc_core::Json::Array& server_array =
+      servers->object_value().at("server").array_value();
+  ASSERT_EQ(server_array.size(), 1u);
+  const grpc_core::Json::Array& listen_sockets =
+      server_array[0].object_value().at("listenSocket").array_value();
+  ASSERT_EQ(listen_sockets.size(), 1u);
+  grpc_core::Json socket = GetChannelzSocket(
+      listen_sockets[0].object_value().at("socketId").string_value());
+  const grpc_core::Json::Object& data =
+      socket.object_value().at("data").object_value();
+  const grpc_core::Json::Array& options = data.at("option").array_value();
+  ASSERT_FALSE(options.empty());
+  EXPECT_EQ(options[0].object_value().at("name").string_value(),
+            "grpc.tenant");
+  EXPECT_EQ(options[0].object_value().at("value").string_value(), "tenant");
+  server->Shutdown();
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -31,6 +31,8 @@
 #include <grpc/support/log.h>
 #include <grpcpp/grpcpp.h>
 
+#include "src/core/lib/gprpp/notification.h"
+#include "src/cpp/thread_manager/handler_pool.h"
 #include "test/core/util/test_config.h"
 
 namespace grpc {
@@ -57,13 +59,18 @@ struct TestThreadManagerSettings {
 
   // How many should be instantiated
   int thread_manager_count;
+
+  // If not 0, the size of a handler pool shared by the thread managers
+  int handler_threads;
 };
 
 class TestThreadManager final : public grpc::ThreadManager {
  public:
   TestThreadManager(const char* name, grpc_resource_quota* rq,
-                    const TestThreadManagerSettings& settings)
-      : ThreadManager(name, rq, settings.min_pollers, settings.max_pollers),
+                    const TestThreadManagerSettings& settings,
+                    HandlerPool* handler_pool)
+      : ThreadManager(name, rq, settings.min_pollers, settings.max_pollers,
+                      handler_pool),
         settings_(settings),
         num_do_work_(0),
         num_poll_for_work_(0),
@@ -132,9 +139,13 @@ class ThreadManagerTest
     if (GetParam().thread_limit > 0) {
       grpc_resource_quota_set_max_threads(rq, GetParam().thread_limit);
     }
+    if (GetParam().handler_threads != 0) {
+      handler_pool_ =
+          std::make_unique<HandlerPool>(GetParam().handler_threads, -1);
+    }
     for (int i = 0; i < GetParam().thread_manager_count; i++) {
-      thread_manager_.emplace_back(
-          new TestThreadManager("TestThreadManager", rq, GetParam()));
+      thread_manager_.emplace_back(new TestThreadManager(
+          "TestThreadManager", rq, GetParam(), handler_pool_.get()));
     }
     grpc_resource_quota_unref(rq);
     for (auto& tm : thread_manager_) {
@@ -145,16 +156,22 @@ class ThreadManagerTest
     }
   }
 
+  std::unique_ptr<HandlerPool> handler_pool_;
   std::vector<std::unique_ptr<TestThreadManager>> thread_manager_;
 };
 
 TestThreadManagerSettings scenarios[] = {
     {2 /* min_pollers */, 10 /* max_pollers */, 10 /* poll_duration_ms */,
      1 /* work_duration_ms */, 50 /* max_poll_calls */,
-     INT_MAX /* thread_limit */, 1 /* thread_manager_count */},
+     INT_MAX /* thread_limit */, 1 /* thread_manager_count */,
+     0 /* handler_threads */},
     {1 /* min_pollers */, 1 /* max_pollers */, 1 /* poll_duration_ms */,
      10 /* work_duration_ms */, 50 /* max_poll_calls */, 3 /* thread_limit */,
-     2 /* thread_manager_count */}};
+     2 /* thread_manager_count */, 0 /* handler_threads */},
+    {2 /* min_pollers */, 10 /* max_pollers */, 1 /* poll_duration_ms */,
+     10 /* work_duration_ms */, 50 /* max_poll_calls */,
+     INT_MAX /* thread_limit */, 2 /* thread_manager_count */,
+     2 /* handler_threads */}};
 
 INSTANTIATE_TEST_SUITE_P(ThreadManagerTest, ThreadManagerTest,
                          ::testing::ValuesIn(scenarios));
@@ -178,6 +195,34 @@ TEST_P(ThreadManagerTest, TestThreadQuota) {
   }
 }
 
+TEST_P(ThreadManagerTest, TestHandlerPoolKeepsThreadCountFixed) {
+  if (GetParam().handler_threads != 0) {
+    for (auto& tm : thread_manager_) {
+      EXPECT_EQ(tm->GetMaxActiveThreadsSoFar(), GetParam().min_pollers);
+    }
+  }
+}
+
+TEST(HandlerPoolTest, TryRunFailsWhenTooMuchWorkIsWaiting) {
+  grpc_core::Notification started;
+  grpc_core::Notification release;
+  std::atomic<int> done{0};
+  {
+    HandlerPool pool(1, 1);
+    pool.Run([&] {
+      started.Notify();
+      release.WaitForNotification();
+      done.fetch_add(1);
+    });
+    started.WaitForNotification();
+    EXPECT_TRUE(pool.TryRun([&] { done.fetch_add(1); }));
+    EXPECT_FALSE(pool.TryRun([&] { done.fetch_add(1); }));
+    release.Notify();
+  }
+  // Work that was added runs before the pool is destroyed.
+  EXPECT_EQ(done.load(), 2);
+}
+
 }  // namespace
 }  // namespace grpc
 
@@ -107,5 +107,9 @@ void ValidateGetServersResponseProtoJsonTranslation(const char* json_c_str) {
       json_c_str);
 }
 
+void ValidateSocketProtoJsonTranslation(const char* json_c_str) {
+  VaidateProtoJsonTranslation<grpc::channelz::v1::Socket>(json_c_str);
+}
+
 }  // namespace testing
 }  // namespace grpc
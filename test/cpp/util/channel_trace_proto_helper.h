@@ -30,6 +30,7 @@ void ValidateGetServerResponseProtoJsonTranslation(const char* json_c_str);
 void ValidateSubchannelProtoJsonTranslation(const char* json_c_str);
 void ValidateServerProtoJsonTranslation(const char* json_c_str);
 void ValidateGetServersResponseProtoJsonTranslation(const char* json_c_str);
+void ValidateSocketProtoJsonTranslation(const char* json_c_str);
 
 }  // namespace testing
 }  // namespace grpc
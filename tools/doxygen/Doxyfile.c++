@@ -1046,6 +1046,7 @@ include/grpcpp/server_builder.h \
 include/grpcpp/server_context.h \
 include/grpcpp/server_interface.h \
 include/grpcpp/server_posix.h \
+include/grpcpp/support/arena_message_allocator.h \
 include/grpcpp/support/async_stream.h \
 include/grpcpp/support/async_unary_call.h \
 include/grpcpp/support/byte_buffer.h \
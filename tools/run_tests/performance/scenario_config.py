@@ -126,6 +126,7 @@ def _ping_pong_scenario(name,
                         client_processes=0,
                         server_processes=0,
                         server_threads_per_cq=0,
+                        sync_server_handler_threads=None,
                         client_threads_per_cq=0,
                         warmup_seconds=WARMUP_SECONDS,
                         categories=None,
@@ -169,6 +170,9 @@ def _ping_pong_scenario(name,
     }
     if resource_quota_size:
         scenario['server_config']['resource_quota_size'] = resource_quota_size
+    if sync_server_handler_threads is not None:
+        scenario['server_config'][
+            'sync_server_handler_threads'] = sync_server_handler_threads
     if use_generic_payload:
         if server_type != 'ASYNC_GENERIC_SERVER':
             raise Exception('Use ASYNC_GENERIC_SERVER for generic payload.')
@@ -462,6 +466,21 @@ class CXXLanguage(Language):
                 categories=smoketest_categories + inproc_categories +
                 [SCALABLE])
 
+            # Same as above, with handlers run on a fixed pool of one thread
+            # per core.
+            yield _ping_pong_scenario(
+                'cpp_protobuf_async_client_sync_server_handler_pool_unary_qps_unconstrained_%s'
+                % (secstr),
+                rpc_type='UNARY',
+                client_type='ASYNC_CLIENT',
+                server_type='SYNC_SERVER',
+                unconstrained_client='async',
+                sync_server_handler_threads=-1,
+                secure=secure,
+                minimal_stack=not secure,
+                categories=smoketest_categories + inproc_categories +
+                [SCALABLE])
+
             yield _ping_pong_scenario(
                 'cpp_protobuf_async_client_unary_1channel_64wide_128Breq_8MBresp_%s'
                 % (secstr),